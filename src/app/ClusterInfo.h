@@ -36,6 +36,14 @@ struct ClusterInfo
     bool IsDirty() { return mDirty; }
     void SetDirty() { mDirty = true; }
     void ClearDirty() { mDirty = false; }
+
+    // True if this attribute path covers the attribute path of aOther, e.g. when this one leaves out the field id.
+    bool IsAttributePathSupersetOf(const ClusterInfo & aOther) const
+    {
+        return mEndpointId == aOther.mEndpointId && mClusterId == aOther.mClusterId &&
+            (!mFlags.Has(Flags::kFieldIdValid) || (aOther.mFlags.Has(Flags::kFieldIdValid) && mFieldId == aOther.mFieldId));
+    }
+
     NodeId mNodeId         = 0;
     ClusterId mClusterId   = 0;
     ListIndex mListIndex   = 0;
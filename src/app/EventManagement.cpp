@@ -16,6 +16,7 @@
  *    limitations under the License.
  */
 
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <core/CHIPEventLoggingConfig.h>
@@ -62,6 +63,7 @@ EventManagement & EventManagement::GetInstance(void)
 
 struct ReclaimEventCtx
 {
+    EventManagement * mpEventManagement = nullptr;
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
 };
@@ -156,6 +158,8 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
     CircularEventBuffer backup = *nextBuffer;
+    CircularEventBuffer::IndexEntry entry;
+    const uint32_t offset = nextBuffer->GetOffset(nextBuffer->QueueTail());
 
     // Set up the next buffer s.t. it fails if needs to evict an element
     nextBuffer->mProcessEvictedElement = AlwaysFail;
@@ -174,6 +178,13 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = writer.Finalize();
     SuccessOrExit(err);
 
+    // The head event is evicted from this buffer next, and its index entry moves along with it.
+    if (apEventBuffer->RemoveHeadIndexEntry(entry))
+    {
+        entry.mOffset = offset;
+        nextBuffer->AddIndexEntry(entry, false /* aSparse */);
+    }
+
     ChipLogProgress(EventLogging, "Copy Event to next buffer with priority %u",
                     static_cast<unsigned>(nextBuffer->GetPriorityLevel()));
 exit:
@@ -184,11 +195,11 @@ exit:
     return err;
 }
 
-CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
+CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(CircularEventBuffer * apEventBuffer, size_t aRequiredSpace)
 {
     CHIP_ERROR err                    = CHIP_NO_ERROR;
     size_t requiredSpace              = aRequiredSpace;
-    CircularEventBuffer * eventBuffer = mpEventBuffer;
+    CircularEventBuffer * eventBuffer = apEventBuffer;
     ReclaimEventCtx ctx;
 
     // check whether we actually need to do anything, exit if we don't
@@ -256,7 +267,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
         {
             // this branch is only taken when we go back in the buffer chain since we have free/spare enough space in next buffer,
             // and need to retry to copy event from current buffer to next buffer, and free space for current buffer
-            if (eventBuffer == mpEventBuffer)
+            if (eventBuffer == apEventBuffer)
                 break;
             eventBuffer   = eventBuffer->GetPreviousCircularEventBuffer();
             requiredSpace = eventBuffer->GetRequiredSpaceforEvicted();
@@ -264,39 +275,15 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
         }
     }
 
-    // On exit, configure the top-level s.t. it will always fail to evict an element
-    mpEventBuffer->mProcessEvictedElement = AlwaysFail;
-    mpEventBuffer->mAppData               = nullptr;
+    // On exit, configure the starting buffer s.t. it will always fail to evict an element
+    apEventBuffer->mProcessEvictedElement = AlwaysFail;
+    apEventBuffer->mAppData               = nullptr;
 
 exit:
     ChipLogFunctError(err);
     return err;
 }
 
-CHIP_ERROR EventManagement::CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions,
-                                               uint32_t & requiredSize)
-{
-    CHIP_ERROR err = CHIP_NO_ERROR;
-    System::PacketBufferTLVWriter writer;
-    EventLoadOutContext ctxt       = EventLoadOutContext(writer, apOptions->mpEventSchema->mPriority,
-                                                   GetPriorityBuffer(apOptions->mpEventSchema->mPriority)->GetLastEventNumber());
-    System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
-    if (buf.IsNull())
-    {
-        return CHIP_ERROR_NO_MEMORY;
-    }
-    writer.Init(std::move(buf));
-
-    ctxt.mCurrentEventNumber       = GetPriorityBuffer(apOptions->mpEventSchema->mPriority)->GetLastEventNumber();
-    ctxt.mCurrentSystemTime.mValue = GetPriorityBuffer(apOptions->mpEventSchema->mPriority)->GetLastEventSystemTimestamp();
-    err                            = ConstructEvent(&ctxt, apDelegate, apOptions);
-    if (CHIP_NO_ERROR == err)
-    {
-        requiredSize = writer.GetLengthWritten();
-    }
-    return err;
-}
-
 CHIP_ERROR EventManagement::ConstructEvent(EventLoadOutContext * apContext, EventLoggingDelegate * apDelegate,
                                            const EventOptions * apOptions)
 {
@@ -492,17 +479,17 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, E
                                             EventNumber & aEventNumber)
 {
     CircularTLVWriter writer;
-    CHIP_ERROR err                 = CHIP_NO_ERROR;
-    uint32_t requestSize           = 0;
-    aEventNumber                   = 0;
-    CircularEventBuffer checkpoint = *mpEventBuffer;
-    CircularEventBuffer * buffer   = nullptr;
-    EventLoadOutContext ctxt       = EventLoadOutContext(writer, aEventOptions.mpEventSchema->mPriority,
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    aEventNumber                 = 0;
+    uint8_t * checkpoint         = mpEventBuffer->QueueTail();
+    CircularEventBuffer * buffer = nullptr;
+    uint32_t maxEventSize        = 0;
+    EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mpEventSchema->mPriority,
                                                    GetPriorityBuffer(aEventOptions.mpEventSchema->mPriority)->GetLastEventNumber());
     Timestamp timestamp(Timestamp::Type::kSystem, System::Clock::GetMonotonicMilliseconds());
     EventOptions opts = EventOptions(timestamp);
-    // Start the event container (anonymous structure) in the circular buffer
-    writer.Init(*mpEventBuffer);
+    ReclaimEventCtx reclaimCtx;
+    CircularEventBuffer::IndexEntry entry;
 
     // check whether the entry is to be logged or discarded silently
     VerifyOrExit(aEventOptions.mpEventSchema->mPriority >= CHIP_CONFIG_EVENT_GLOBAL_PRIORITY, /* no-op */);
@@ -525,41 +512,46 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, E
     ctxt.mCurrentEventNumber       = GetPriorityBuffer(opts.mpEventSchema->mPriority)->GetLastEventNumber();
     ctxt.mCurrentSystemTime.mValue = GetPriorityBuffer(opts.mpEventSchema->mPriority)->GetLastEventSystemTimestamp();
 
-    err = CalculateEventSize(apDelegate, &opts, requestSize);
-    SuccessOrExit(err);
+    // An event too large to be evicted from subsequent buffers is dropped.  Limit the writer to the smallest of them, s.t.
+    // such an event fails as soon as it outgrows that size.
+    buffer       = mpEventBuffer;
+    maxEventSize = buffer->GetTotalDataLength();
+    while (!buffer->IsFinalDestinationForPriority(opts.mpEventSchema->mPriority))
+    {
+        buffer = buffer->GetNextCircularEventBuffer();
+        assert(buffer != nullptr);
+        // code guarantees that every PriorityLevel has a buffer destination.
+        maxEventSize = std::min(maxEventSize, buffer->GetTotalDataLength());
+    }
+
+    // Encode the event straight into the circular buffer.  Older events are only evicted, or moved to the buffers of higher
+    // priority, when the writer actually runs out of space.
+    reclaimCtx.mpEventManagement          = this;
+    reclaimCtx.mpEventBuffer              = mpEventBuffer;
+    mpEventBuffer->mProcessEvictedElement = EvictOrMoveEvent;
+    mpEventBuffer->mAppData               = &reclaimCtx;
 
-    // Ensure we have space in the in-memory logging queues
-    err = EnsureSpaceInCircularBuffer(requestSize);
+    err = writer.Init(*mpEventBuffer, maxEventSize);
     SuccessOrExit(err);
 
+    entry.mBaseSystemTimestamp = ctxt.mCurrentSystemTime.mValue;
+    entry.mOffset              = mpEventBuffer->GetOffset(checkpoint);
+    entry.mPriority            = opts.mpEventSchema->mPriority;
+
     err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
-    // Check the number of bytes written.  If the event is too large
-    // to be evicted from subsequent buffers, drop it now.
-    buffer = mpEventBuffer;
-    while (true)
-    {
-        VerifyOrExit(buffer->GetTotalDataLength() >= writer.GetLengthWritten(), err = CHIP_ERROR_BUFFER_TOO_SMALL);
-        if (buffer->IsFinalDestinationForPriority(opts.mpEventSchema->mPriority))
-        {
-            break;
-        }
-        else
-        {
-            buffer = buffer->GetNextCircularEventBuffer();
-            assert(buffer != nullptr);
-            // code guarantees that every PriorityLevel has a buffer destination.
-        }
-    }
-
     mBytesWritten += writer.GetLengthWritten();
 
 exit:
+    mpEventBuffer->mProcessEvictedElement = AlwaysFail;
+    mpEventBuffer->mAppData               = nullptr;
+
     ChipLogFunctError(err);
     if (err != CHIP_NO_ERROR)
     {
-        *mpEventBuffer = checkpoint;
+        // Drop whatever part of the event made it into the buffer.  Events evicted to make room for it stay evicted.
+        mpEventBuffer->DiscardTail(checkpoint);
     }
     else if (opts.mpEventSchema->mPriority >= CHIP_CONFIG_EVENT_GLOBAL_PRIORITY)
     {
@@ -567,6 +559,9 @@ exit:
         aEventNumber                        = currentBuffer->VendEventNumber();
         currentBuffer->UpdateFirstLastEventTime(opts.mTimestamp);
 
+        entry.mEventNumber = aEventNumber;
+        mpEventBuffer->AddIndexEntry(entry, true /* aSparse */);
+
 #if CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         ChipLogDetail(EventLogging,
                       "LogEvent event number: 0x" ChipLogFormatX64 " schema priority: %u cluster id: 0x%" PRIx32
@@ -654,10 +649,13 @@ CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDep
     }
     ReturnErrorOnFailure(err);
 
+    // Event numbers are vended per priority, so only the events of the fetched priority advance the current number.
     if (event.mPriority == apEventLoadOutContext->mPriority)
     {
         apEventLoadOutContext->mCurrentSystemTime.mValue += event.mDeltaSystemTime.mValue;
-        if (IsInterestedEventPaths(apEventLoadOutContext, event))
+        const bool interested = IsInterestedEventPaths(apEventLoadOutContext, event);
+        apEventLoadOutContext->mCurrentEventNumber++;
+        if (interested)
         {
             return CHIP_EVENT_ID_FOUND;
         }
@@ -670,7 +668,6 @@ CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aD
 {
     EventLoadOutContext * const loadOutContext = static_cast<EventLoadOutContext *>(apContext);
     CHIP_ERROR err                             = EventIterator(aReader, aDepth, loadOutContext);
-    loadOutContext->mCurrentEventNumber++;
     if (err == CHIP_EVENT_ID_FOUND)
     {
         // checkpoint the writer
@@ -705,21 +702,43 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, ClusterInfo *
     CircularEventBufferWrapper bufWrapper;
     EventLoadOutContext context(aWriter, aPriority, aEventNumber);
 
-    CircularEventBuffer * buf = mpEventBuffer;
+    CircularEventBuffer * buf                     = mpEventBuffer;
+    const CircularEventBuffer::IndexEntry * entry = nullptr;
 #if !CHIP_SYSTEM_CONFIG_NO_LOCKING
     ScopedLock lock(sInstance);
 #endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
 
-    while (!buf->IsFinalDestinationForPriority(aPriority))
+    // Events of this priority are anywhere from the first buffer to its final one, newest first.  Look for the newest indexed
+    // event that is not past the requested one, and start reading there rather than from the oldest event.
+    while (true)
     {
+        entry = buf->FindIndexEntry(aPriority, aEventNumber);
+        if (entry != nullptr || buf->IsFinalDestinationForPriority(aPriority))
+        {
+            break;
+        }
         buf = buf->GetNextCircularEventBuffer();
     }
 
-    context.mpInterestedEventPaths    = apClusterInfolist;
-    context.mCurrentSystemTime.mValue = buf->GetFirstEventSystemTimestamp();
-    context.mCurrentEventNumber       = buf->GetFirstEventNumber();
-    err                               = GetEventReader(reader, aPriority, &bufWrapper);
-    SuccessOrExit(err);
+    context.mpInterestedEventPaths = apClusterInfolist;
+    if (entry != nullptr)
+    {
+        CircularEventReader circularReader;
+
+        context.mCurrentSystemTime.mValue = entry->mBaseSystemTimestamp;
+        context.mCurrentEventNumber       = entry->mEventNumber;
+        bufWrapper.mpCurrent              = buf;
+        bufWrapper.mpStart                = buf->GetQueue() + entry->mOffset;
+        circularReader.Init(&bufWrapper);
+        reader.Init(circularReader);
+    }
+    else
+    {
+        context.mCurrentSystemTime.mValue = buf->GetFirstEventSystemTimestamp();
+        context.mCurrentEventNumber       = buf->GetFirstEventNumber();
+        err                               = GetEventReader(reader, aPriority, &bufWrapper);
+        SuccessOrExit(err);
+    }
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
     if (err == CHIP_END_OF_TLV)
@@ -808,6 +827,8 @@ CHIP_ERROR EventManagement::EvictEvent(CHIPCircularTLVBuffer & apBuffer, void *
     {
         // event is getting dropped.  Increase the event number and first timestamp.
         EventNumber numEventsToDrop = 1;
+        CircularEventBuffer::IndexEntry entry;
+        eventBuffer->RemoveHeadIndexEntry(entry);
         eventBuffer->RemoveEvent(numEventsToDrop);
         eventBuffer->SetFirstEventSystemTimestamp(eventBuffer->GetFirstEventSystemTimestamp() + context.mDeltaSystemTime.mValue);
         ChipLogProgress(
@@ -824,6 +845,23 @@ CHIP_ERROR EventManagement::EvictEvent(CHIPCircularTLVBuffer & apBuffer, void *
     return CHIP_END_OF_TLV;
 }
 
+CHIP_ERROR EventManagement::EvictOrMoveEvent(CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLVReader & aReader)
+{
+    ReclaimEventCtx * const ctx = static_cast<ReclaimEventCtx *>(apAppData);
+    TLVReader reader(aReader);
+
+    CHIP_ERROR err = EvictEvent(aBuffer, apAppData, reader);
+    if (err == CHIP_END_OF_TLV && ctx->mSpaceNeededForMovedEvent != 0)
+    {
+        // The event belongs in a buffer of higher priority: make room for it there and move it before it gets evicted.
+        CircularEventBuffer * const nextBuffer = ctx->mpEventBuffer->GetNextCircularEventBuffer();
+        VerifyOrReturnError(nextBuffer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        ReturnErrorOnFailure(ctx->mpEventManagement->EnsureSpaceInCircularBuffer(nextBuffer, ctx->mSpaceNeededForMovedEvent));
+        err = ctx->mpEventManagement->CopyToNextBuffer(ctx->mpEventBuffer);
+    }
+    return err;
+}
+
 CHIP_ERROR EventManagement::ScheduleFlushIfNeeded(EventOptions::Type aUrgent)
 {
     // TODO: Implement ScheduleFlushIfNeeded
@@ -860,6 +898,8 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
     mFirstEventSystemTimestamp = Timestamp::System(0);
     mLastEventSystemTimestamp  = Timestamp::System(0);
     mpEventNumberCounter       = nullptr;
+    mIndexFirst                = 0;
+    mIndexCount                = 0;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -882,6 +922,73 @@ void CircularEventBuffer::RemoveEvent(EventNumber aNumEvents)
     mFirstEventNumber = mFirstEventNumber + aNumEvents;
 }
 
+void CircularEventBuffer::AddIndexEntry(const IndexEntry & aEntry, bool aSparse)
+{
+    constexpr size_t kIndexSize = CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES;
+    size_t last                 = mIndexCount;
+
+    // Find the newest entry of the same priority.
+    while (last > 0 && mIndex[(mIndexFirst + last - 1) % kIndexSize].mPriority != aEntry.mPriority)
+    {
+        last--;
+    }
+
+    if (aSparse && last > 0)
+    {
+        // Keep the entries of each priority spread over the whole buffer.
+        const uint32_t lastOffset = mIndex[(mIndexFirst + last - 1) % kIndexSize].mOffset;
+        const uint32_t distance   = (aEntry.mOffset >= lastOffset) ? aEntry.mOffset - lastOffset
+                                                                   : GetTotalDataLength() - lastOffset + aEntry.mOffset;
+        VerifyOrReturn(distance >= GetTotalDataLength() / kIndexSize);
+    }
+
+    if (mIndexCount == kIndexSize)
+    {
+        // The index is full: move the newest entry of the same priority up to this event, s.t. the most recent events, which
+        // are the ones fetched most often, stay close to an entry.
+        VerifyOrReturn(last > 0);
+        for (size_t i = last; i < mIndexCount; i++)
+        {
+            mIndex[(mIndexFirst + i - 1) % kIndexSize] = mIndex[(mIndexFirst + i) % kIndexSize];
+        }
+        mIndexCount--;
+    }
+
+    mIndex[(mIndexFirst + mIndexCount) % kIndexSize] = aEntry;
+    mIndexCount++;
+}
+
+bool CircularEventBuffer::RemoveHeadIndexEntry(IndexEntry & aEntry)
+{
+    constexpr size_t kIndexSize = CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES;
+
+    if (mIndexCount == 0 || mIndex[mIndexFirst].mOffset != GetOffset(QueueHead()))
+    {
+        return false;
+    }
+
+    aEntry      = mIndex[mIndexFirst];
+    mIndexFirst = (mIndexFirst + 1) % kIndexSize;
+    mIndexCount--;
+    return true;
+}
+
+const CircularEventBuffer::IndexEntry * CircularEventBuffer::FindIndexEntry(PriorityLevel aPriority,
+                                                                            EventNumber aEventNumber) const
+{
+    constexpr size_t kIndexSize = CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES;
+
+    for (size_t i = mIndexCount; i > 0; i--)
+    {
+        const IndexEntry & entry = mIndex[(mIndexFirst + i - 1) % kIndexSize];
+        if (entry.mPriority == aPriority && entry.mEventNumber <= aEventNumber)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
 void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 {
     CircularEventBuffer * prev;
@@ -889,8 +996,17 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
     if (apBufWrapper->mpCurrent == nullptr)
         return;
 
-    TLVReader::Init(*apBufWrapper, apBufWrapper->mpCurrent->DataLength());
-    mMaxLen = apBufWrapper->mpCurrent->DataLength();
+    // Nothing before the starting point of the current buffer is read.
+    uint32_t skipped = 0;
+    if (apBufWrapper->mpStart != nullptr)
+    {
+        const uint32_t start = apBufWrapper->mpCurrent->GetOffset(apBufWrapper->mpStart);
+        const uint32_t head  = apBufWrapper->mpCurrent->GetOffset(apBufWrapper->mpCurrent->QueueHead());
+        skipped              = (start >= head) ? start - head : apBufWrapper->mpCurrent->GetTotalDataLength() - head + start;
+    }
+
+    TLVReader::Init(*apBufWrapper, apBufWrapper->mpCurrent->DataLength() - skipped);
+    mMaxLen = apBufWrapper->mpCurrent->DataLength() - skipped;
     for (prev = apBufWrapper->mpCurrent->GetPreviousCircularEventBuffer(); prev != nullptr;
          prev = prev->GetPreviousCircularEventBuffer())
     {
@@ -903,6 +1019,18 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (aBufStart == nullptr && mpStart != nullptr)
+    {
+        // Read from the starting point up to the tail, or to the end of the storage if the data wraps around.
+        uint8_t * const tail = mpCurrent->QueueTail();
+        aBufStart            = mpStart;
+        aBufLen              = (tail <= mpStart) ? mpCurrent->GetTotalDataLength() - mpCurrent->GetOffset(mpStart)
+                                                 : static_cast<uint32_t>(tail - mpStart);
+        mpStart              = nullptr;
+        ExitNow();
+    }
+
     mpCurrent->GetNextBuffer(aReader, aBufStart, aBufLen);
     SuccessOrExit(err);
 
@@ -32,6 +32,7 @@
 #include <app/MessageDef/EventDataElement.h>
 #include <app/util/basic-types.h>
 #include <core/CHIPCircularTLVBuffer.h>
+#include <core/CHIPEventLoggingConfig.h>
 #include <messaging/ExchangeMgr.h>
 #include <support/PersistedCounter.h>
 #include <system/SystemMutex.h>
@@ -138,10 +139,54 @@ public:
     EventNumber GetLastEventNumber() { return mLastEventNumber; }
 
     uint64_t GetFirstEventSystemTimestamp() { return mFirstEventSystemTimestamp.mValue; }
-    void SetFirstEventSystemTimestamp(uint64_t aValue) { mLastEventSystemTimestamp.mValue = aValue; }
+    void SetFirstEventSystemTimestamp(uint64_t aValue) { mFirstEventSystemTimestamp.mValue = aValue; }
 
     uint64_t GetLastEventSystemTimestamp() { return mLastEventSystemTimestamp.mValue; }
 
+    /**
+     * @brief
+     *   An entry of the sparse index of the events stored in this buffer.
+     */
+    struct IndexEntry
+    {
+        EventNumber mEventNumber      = 0; ///< Number of the indexed event
+        uint64_t mBaseSystemTimestamp = 0; ///< The timestamp the delta time of the indexed event is relative to
+        uint32_t mOffset              = 0; ///< Where the indexed event starts, from the start of the storage
+        PriorityLevel mPriority       = PriorityLevel::Invalid;
+    };
+
+    /**
+     * @brief
+     *   Index the event starting at aEntry.mOffset, which must be the newest event in the buffer.
+     *
+     * @param[in] aEntry   The entry to add.
+     * @param[in] aSparse  When true, skip the entry if the last one of the same priority is close enough to it.
+     */
+    void AddIndexEntry(const IndexEntry & aEntry, bool aSparse);
+
+    /**
+     * @brief
+     *   Remove the entry of the oldest event in the buffer, as that event is about to be evicted.
+     *
+     * @param[out] aEntry  The removed entry.
+     *
+     * @retval true/false whether the oldest event was indexed.
+     */
+    bool RemoveHeadIndexEntry(IndexEntry & aEntry);
+
+    /**
+     * @brief
+     *   Find the newest indexed event of the given priority whose number is at most aEventNumber.
+     *
+     * @return A pointer to the entry, or nullptr if there is none.
+     */
+    const IndexEntry * FindIndexEntry(PriorityLevel aPriority, EventNumber aEventNumber) const;
+
+    uint32_t GetOffset(const uint8_t * apPosition) const
+    {
+        return static_cast<uint32_t>(apPosition - GetQueue()) % GetTotalDataLength();
+    }
+
     virtual ~CircularEventBuffer() = default;
 
 private:
@@ -162,6 +207,10 @@ private:
     EventNumber mLastEventNumber    = 0;  ///< Last event Number vended for this priority
     Timestamp mFirstEventSystemTimestamp; ///< The timestamp of the first event in this buffer
     Timestamp mLastEventSystemTimestamp;  ///< The timestamp of the last event in this buffer
+
+    IndexEntry mIndex[CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES]; ///< Ring of index entries, oldest event first
+    size_t mIndexFirst = 0;                                     ///< Position of the oldest entry in mIndex
+    size_t mIndexCount = 0;                                     ///< Number of entries in mIndex
 };
 
 class CircularEventReader;
@@ -175,8 +224,10 @@ class CircularEventReader;
 class CircularEventBufferWrapper : public TLV::CHIPCircularTLVBuffer
 {
 public:
-    CircularEventBufferWrapper() : CHIPCircularTLVBuffer(nullptr, 0), mpCurrent(nullptr){};
+    CircularEventBufferWrapper() : CHIPCircularTLVBuffer(nullptr, 0), mpCurrent(nullptr), mpStart(nullptr){};
     CircularEventBuffer * mpCurrent;
+    // Where to start reading mpCurrent, instead of its oldest event.  nullptr to read mpCurrent whole.
+    uint8_t * mpStart;
 
 private:
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
@@ -462,7 +513,6 @@ public:
     void SetScheduledEventEndpoint(EventNumber * aEventEndpoints);
 
 private:
-    CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t & requiredSize);
     /**
      * @brief Helper function for writing event header and data according to event
      *   logging protocol.
@@ -494,10 +544,11 @@ private:
      * @brief eusure current buffer has enough space, if not, when current buffer is final destination of last tail's event
      * priority, we need to drop event, otherwises, move the last event to the buffer with higher priority
      *
+     * @param[in] apEventBuffer   the buffer to make space in
      * @param[in] aRequiredSpace  require space
      *
      */
-    CHIP_ERROR EnsureSpaceInCircularBuffer(size_t aRequiredSpace);
+    CHIP_ERROR EnsureSpaceInCircularBuffer(CircularEventBuffer * apEventBuffer, size_t aRequiredSpace);
 
     /**
      * @brief
@@ -544,6 +595,12 @@ private:
      * requires, and return.
      */
     static CHIP_ERROR EvictEvent(chip::TLV::CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
+
+    /**
+     * @brief Eviction callback installed on the first buffer while LogEvent writes into it. Drops the oldest event if that
+     * buffer is its final destination, otherwise makes room in the next buffer and moves the event there first.
+     */
+    static CHIP_ERROR EvictOrMoveEvent(chip::TLV::CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
     static CHIP_ERROR AlwaysFail(chip::TLV::CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
     {
         return CHIP_ERROR_NO_MEMORY;
@@ -261,6 +261,36 @@ exit:
     return err;
 }
 
+CHIP_ERROR InteractionModelEngine::OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext,
+                                                      const PacketHeader & aPacketHeader, const PayloadHeader & aPayloadHeader,
+                                                      System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    ChipLogDetail(DataManagement, "Receive Subscribe request");
+
+    for (auto & readHandler : mReadHandlers)
+    {
+        if (readHandler.IsFree())
+        {
+            err = readHandler.Init(mpDelegate, ReadHandler::InteractionType::Subscribe);
+            SuccessOrExit(err);
+            err               = readHandler.OnSubscribeRequest(apExchangeContext, std::move(aPayload));
+            apExchangeContext = nullptr;
+            break;
+        }
+    }
+
+exit:
+    ChipLogFunctError(err);
+
+    if (nullptr != apExchangeContext)
+    {
+        apExchangeContext->Abort();
+    }
+    return err;
+}
+
 CHIP_ERROR InteractionModelEngine::OnWriteRequest(Messaging::ExchangeContext * apExchangeContext,
                                                   const PacketHeader & aPacketHeader, const PayloadHeader & aPayloadHeader,
                                                   System::PacketBufferHandle && aPayload)
@@ -308,6 +338,10 @@ CHIP_ERROR InteractionModelEngine::OnMessageReceived(Messaging::ExchangeContext
     {
         err = OnWriteRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
     }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::SubscribeRequest))
+    {
+        err = OnSubscribeRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
+    }
     else
     {
         err = OnUnknownMsgType(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
@@ -351,6 +385,18 @@ WriteSingleClusterData(ClusterInfo & aClusterInfo, TLV::TLVReader & aReader, Wri
     return CHIP_NO_ERROR;
 }
 
+void InteractionModelReportingAttributeChangeCallback(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    ClusterInfo info;
+    info.mEndpointId = aEndpointId;
+    info.mClusterId  = aClusterId;
+    info.mFieldId    = aAttributeId;
+    info.mFlags.Set(ClusterInfo::Flags::kFieldIdValid);
+
+    CHIP_ERROR err = InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info);
+    ChipLogFunctError(err);
+}
+
 uint16_t InteractionModelEngine::GetReadClientArrayIndex(const ReadClient * const apReadClient) const
 {
     return static_cast<uint16_t>(apReadClient - mReadClients);
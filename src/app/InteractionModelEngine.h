@@ -156,6 +156,7 @@ public:
 
 private:
     friend class reporting::Engine;
+    friend class TestReadInteraction;
     CHIP_ERROR OnUnknownMsgType(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                                 const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
     CHIP_ERROR OnInvokeCommandRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
@@ -171,6 +172,13 @@ private:
     CHIP_ERROR OnReadRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                              const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
 
+    /**
+     * Called when Interaction Model receives a Subscribe Request message.  Errors processing
+     * the Subscribe Request are handled entirely within this function.
+     */
+    CHIP_ERROR OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                  const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
+
     /**
      * Called when Interaction Model receives a Write Request message.  Errors processing
      * the Write Request are handled entirely within this function.
@@ -237,5 +245,11 @@ bool ServerClusterCommandExists(chip::ClusterId aClusterId, chip::CommandId aCom
  */
 CHIP_ERROR ReadSingleClusterData(ClusterInfo & aClusterInfo, TLV::TLVWriter * apWriter, bool * apDataExists);
 CHIP_ERROR WriteSingleClusterData(ClusterInfo & aClusterInfo, TLV::TLVReader & aReader, WriteHandler * apWriteHandler);
+
+/**
+ *  Notify the interaction model that the value of an attribute has changed, so that the subscriptions covering it
+ *  report it.  This is called by the cluster data storage whenever it changes the value of a server attribute.
+ */
+void InteractionModelReportingAttributeChangeCallback(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId);
 } // namespace app
 } // namespace chip
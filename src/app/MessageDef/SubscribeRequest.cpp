@@ -197,12 +197,12 @@ CHIP_ERROR SubscribeRequest::Parser::GetEventNumber(uint64_t * const apEventNumb
 
 CHIP_ERROR SubscribeRequest::Parser::GetMinIntervalMs(uint16_t * const apMinIntervalMs) const
 {
-    return GetUnsignedInteger(kCsTag_EventNumber, apMinIntervalMs);
+    return GetUnsignedInteger(kCsTag_MinIntervalMs, apMinIntervalMs);
 }
 
 CHIP_ERROR SubscribeRequest::Parser::GetMaxIntervalMs(uint16_t * const apMaxIntervalMs) const
 {
-    return GetUnsignedInteger(kCsTag_EventNumber, apMaxIntervalMs);
+    return GetUnsignedInteger(kCsTag_MaxIntervalMs, apMaxIntervalMs);
 }
 
 CHIP_ERROR SubscribeRequest::Parser::GetKeepExistingSubscriptions(bool * const apKeepExistingSubscription) const
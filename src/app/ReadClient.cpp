@@ -42,6 +42,8 @@ CHIP_ERROR ReadClient::Init(Messaging::ExchangeManager * apExchangeMgr, Interact
     mState         = ClientState::Initialized;
     mAppIdentifier = aAppIdentifier;
 
+    mMoreChunkedMessages = false;
+
     AbortExistingExchangeContext();
 
 exit:
@@ -225,6 +227,15 @@ CHIP_ERROR ReadClient::OnMessageReceived(Messaging::ExchangeContext * apExchange
     VerifyOrExit(aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReportData),
                  err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
     err = ProcessReportData(std::move(aPayload));
+    SuccessOrExit(err);
+
+    if (mMoreChunkedMessages)
+    {
+        // Ask for the next chunk, and keep waiting on this exchange.
+        err = SendStatusResponse(CHIP_NO_ERROR);
+        SuccessOrExit(err);
+        return err;
+    }
 
 exit:
     ChipLogFunctError(err);
@@ -246,7 +257,6 @@ exit:
         }
     }
 
-    // TODO(#7521): Should close it after checking moreChunkedMessages flag is not set.
     Shutdown();
 
     return err;
@@ -300,6 +310,7 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
         err = CHIP_NO_ERROR;
     }
     SuccessOrExit(err);
+    mMoreChunkedMessages = moreChunkedMessages;
 
     err                = report.GetEventDataList(&eventList);
     isEventListPresent = (err == CHIP_NO_ERROR);
@@ -324,7 +335,7 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
         err = CHIP_NO_ERROR;
     }
     SuccessOrExit(err);
-    if (isAttributeDataListPresent && nullptr != mpDelegate && !moreChunkedMessages)
+    if (isAttributeDataListPresent && nullptr != mpDelegate)
     {
         chip::TLV::TLVReader attributeDataListReader;
         attributeDataList.GetReader(&attributeDataListReader);
@@ -332,17 +343,36 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
         SuccessOrExit(err);
     }
 
-    if (!suppressResponse)
-    {
-        // TODO: Add status report support and correspond handler in ReadHandler, particular for situation when there
-        // are multiple reports
-    }
-
 exit:
     ChipLogFunctError(err);
     return err;
 }
 
+CHIP_ERROR ReadClient::SendStatusResponse(CHIP_ERROR aError)
+{
+    System::PacketBufferTLVWriter writer;
+    StatusElement::Builder statusElementBuilder;
+    const bool success                = (aError == CHIP_NO_ERROR);
+    System::PacketBufferHandle msgBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+    VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    writer.Init(std::move(msgBuf));
+    ReturnErrorOnFailure(statusElementBuilder.Init(&writer));
+    statusElementBuilder
+        .EncodeStatusElement(success ? Protocols::SecureChannel::GeneralStatusCode::kSuccess
+                                     : Protocols::SecureChannel::GeneralStatusCode::kFailure,
+                             Protocols::InteractionModel::Id.ToFullyQualifiedSpecForm(),
+                             to_underlying(success ? Protocols::InteractionModel::ProtocolCode::Success
+                                                   : Protocols::InteractionModel::ProtocolCode::Failure))
+        .EndOfStatusElement();
+    ReturnErrorOnFailure(statusElementBuilder.GetError());
+    ReturnErrorOnFailure(writer.Finalize(&msgBuf));
+
+    VerifyOrReturnError(mpExchangeCtx != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::StatusResponse, std::move(msgBuf),
+                                      Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+}
+
 void ReadClient::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext)
 {
     ChipLogProgress(DataManagement, "Time out! failed to receive report data from Exchange: %d",
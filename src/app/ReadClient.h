@@ -124,6 +124,7 @@ private:
 
     void MoveToState(const ClientState aTargetState);
     CHIP_ERROR ProcessReportData(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendStatusResponse(CHIP_ERROR aError);
     CHIP_ERROR AbortExistingExchangeContext();
     const char * GetStateStr() const;
 
@@ -132,6 +133,8 @@ private:
     InteractionModelDelegate * mpDelegate      = nullptr;
     ClientState mState                         = ClientState::Uninitialized;
     intptr_t mAppIdentifier                    = 0;
+    // Set while the report being received has more chunks to come
+    bool mMoreChunkedMessages = false;
 };
 
 }; // namespace app
@@ -25,12 +25,15 @@
 #include <app/AppBuildConfig.h>
 #include <app/InteractionModelEngine.h>
 #include <app/MessageDef/EventPath.h>
+#include <app/MessageDef/SubscribeRequest.h>
+#include <app/MessageDef/SubscribeResponse.h>
 #include <app/ReadHandler.h>
 #include <app/reporting/Engine.h>
+#include <support/RandUtils.h>
 
 namespace chip {
 namespace app {
-CHIP_ERROR ReadHandler::Init(InteractionModelDelegate * apDelegate)
+CHIP_ERROR ReadHandler::Init(InteractionModelDelegate * apDelegate, InteractionType aInteractionType)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     // Error if already initialized.
@@ -38,9 +41,18 @@ CHIP_ERROR ReadHandler::Init(InteractionModelDelegate * apDelegate)
     mpExchangeCtx              = nullptr;
     mpDelegate                 = apDelegate;
     mSuppressResponse          = true;
-    mpAttributeClusterInfoList = nullptr;
-    mpEventClusterInfoList     = nullptr;
-    mCurrentPriority           = PriorityLevel::Invalid;
+    mpAttributeClusterInfoList   = nullptr;
+    mpEventClusterInfoList       = nullptr;
+    mpAttributeClusterInfoCursor = nullptr;
+    mCurrentPriority             = PriorityLevel::Invalid;
+    mInteractionType             = aInteractionType;
+    mChunkedReport               = false;
+    mDirty                       = false;
+    mActiveSubscription          = false;
+    mSubscriptionId              = 0;
+    mLastReportMs                = 0;
+    mMinIntervalFloorMs          = 0;
+    mMaxIntervalCeilingMs        = 0;
     MoveToState(HandlerState::Initialized);
 
 exit:
@@ -50,14 +62,25 @@ exit:
 
 void ReadHandler::Shutdown()
 {
+    // However the exchange ends, a report still awaiting its status response is no longer in flight.
+    if (IsAwaitingReportResponse())
+    {
+        InteractionModelEngine::GetInstance()->GetReportingEngine().OnReportConfirm();
+    }
+
     InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpAttributeClusterInfoList);
     InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpEventClusterInfoList);
     AbortExistingExchangeContext();
     MoveToState(HandlerState::Uninitialized);
-    mpDelegate                 = nullptr;
-    mpAttributeClusterInfoList = nullptr;
-    mpEventClusterInfoList     = nullptr;
-    mCurrentPriority           = PriorityLevel::Invalid;
+    mpDelegate                   = nullptr;
+    mpAttributeClusterInfoList   = nullptr;
+    mpEventClusterInfoList       = nullptr;
+    mpAttributeClusterInfoCursor = nullptr;
+    mCurrentPriority             = PriorityLevel::Invalid;
+    mInteractionType             = InteractionType::Read;
+    mChunkedReport               = false;
+    mDirty                       = false;
+    mActiveSubscription          = false;
 }
 
 CHIP_ERROR ReadHandler::AbortExistingExchangeContext()
@@ -90,11 +113,84 @@ CHIP_ERROR ReadHandler::OnReadRequest(Messaging::ExchangeContext * apExchangeCon
     return err;
 }
 
-CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload)
+CHIP_ERROR ReadHandler::OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mpExchangeCtx = apExchangeContext;
+    err           = ProcessSubscribeRequest(std::move(aPayload));
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogFunctError(err);
+        // Keep Shutdown() from double-closing our exchange.
+        mpExchangeCtx = nullptr;
+        Shutdown();
+    }
+
+    return err;
+}
+
+bool ReadHandler::IsReportable(uint64_t aNowMs) const
+{
+    if (mState != HandlerState::Reportable)
+    {
+        return false;
+    }
+
+    if (!IsSubscription() || !mActiveSubscription || mChunkedReport)
+    {
+        return true;
+    }
+
+    return aNowMs >= GetNextReportTimeMs();
+}
+
+uint64_t ReadHandler::GetNextReportTimeMs() const
+{
+    if (!mActiveSubscription || mState != HandlerState::Reportable)
+    {
+        return kNever;
+    }
+
+    return mLastReportMs + (mDirty ? mMinIntervalFloorMs : mMaxIntervalCeilingMs);
+}
+
+void ReadHandler::StartReport(uint64_t aNowMs)
+{
+    mDirty        = false;
+    mLastReportMs = aNowMs;
+}
+
+CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, bool aMoreChunks)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (mpExchangeCtx == nullptr && mActiveSubscription)
+    {
+        mpExchangeCtx = InteractionModelEngine::GetInstance()->GetExchangeManager()->NewContext(mSessionHandle, this);
+    }
     VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
+    if (aMoreChunks || IsSubscription())
+    {
+        // The status response for this report comes back to us rather than to the InteractionModelEngine.
+        mpExchangeCtx->SetDelegate(this);
+        mpExchangeCtx->SetResponseTimeout(kImMessageTimeoutMsec);
+        err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::ReportData, std::move(aPayload),
+                                         Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+        SuccessOrExit(err);
+
+        mChunkedReport = aMoreChunks;
+        if (!aMoreChunks)
+        {
+            // The next report of the subscription walks all the attribute paths again.
+            mpAttributeClusterInfoCursor = mpAttributeClusterInfoList;
+        }
+        MoveToState(HandlerState::AwaitingReportResponse);
+        return err;
+    }
+
     err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::ReportData, std::move(aPayload));
 exit:
     ChipLogFunctError(err);
@@ -102,6 +198,84 @@ exit:
     return err;
 }
 
+CHIP_ERROR ReadHandler::OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                          const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err                   = CHIP_NO_ERROR;
+    reporting::Engine & reportEngine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    VerifyOrExit(apExchangeContext == mpExchangeCtx, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mState == HandlerState::AwaitingReportResponse, err = CHIP_ERROR_INCORRECT_STATE);
+
+    // The chunk in flight has been answered, one way or the other.
+    MoveToState(HandlerState::Reportable);
+    reportEngine.OnReportConfirm();
+
+    VerifyOrExit(aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::StatusResponse),
+                 err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+    err = ProcessStatusResponse(std::move(aPayload));
+    SuccessOrExit(err);
+
+    if (mChunkedReport)
+    {
+        // The next chunk goes out on this exchange.
+        mpExchangeCtx->WillSendMessage();
+    }
+    else if (!mActiveSubscription)
+    {
+        // The first report has made it through, which establishes the subscription.
+        err = SendSubscribeResponse();
+        SuccessOrExit(err);
+        mActiveSubscription = true;
+        mpExchangeCtx       = nullptr;
+    }
+    else
+    {
+        // The exchange closes once this message is handled; the next report gets a new one.
+        mpExchangeCtx = nullptr;
+    }
+
+    err = reportEngine.ScheduleRun();
+
+exit:
+    ChipLogFunctError(err);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Null out mpExchangeCtx, so our Shutdown() call below won't try to abort
+        // it and fail to send an ack for the message we just received.
+        mpExchangeCtx = nullptr;
+        Shutdown();
+    }
+    return err;
+}
+
+void ReadHandler::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext)
+{
+    ChipLogProgress(DataManagement, "Time out! failed to receive status response from Exchange: %d",
+                    apExchangeContext->GetExchangeId());
+    Shutdown();
+}
+
+CHIP_ERROR ReadHandler::ProcessStatusResponse(System::PacketBufferHandle && aPayload)
+{
+    System::PacketBufferTLVReader reader;
+    StatusElement::Parser statusElementParser;
+    Protocols::SecureChannel::GeneralStatusCode generalCode = Protocols::SecureChannel::GeneralStatusCode::kFailure;
+    uint32_t protocolId                                     = 0;
+    uint16_t protocolCode                                   = 0;
+
+    reader.Init(std::move(aPayload));
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(statusElementParser.Init(reader));
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    ReturnErrorOnFailure(statusElementParser.CheckSchemaValidity());
+#endif
+    ReturnErrorOnFailure(statusElementParser.DecodeStatusElement(&generalCode, &protocolId, &protocolCode));
+
+    VerifyOrReturnError(generalCode == Protocols::SecureChannel::GeneralStatusCode::kSuccess, CHIP_ERROR_STATUS_REPORT_RECEIVED);
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle && aPayload)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -152,6 +326,7 @@ CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle && aPayloa
         err = CHIP_NO_ERROR;
     }
 
+    mpAttributeClusterInfoCursor = mpAttributeClusterInfoList;
     MoveToState(HandlerState::Reportable);
 
     err = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
@@ -172,6 +347,95 @@ exit:
     return err;
 }
 
+CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+
+    SubscribeRequest::Parser subscribeRequestParser;
+    EventPathList::Parser eventPathListParser;
+    AttributePathList::Parser attributePathListParser;
+
+    // Later reports need a session to go out on.
+    VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    mSessionHandle = mpExchangeCtx->GetSecureSession();
+
+    reader.Init(std::move(aPayload));
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = subscribeRequestParser.Init(reader);
+    SuccessOrExit(err);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = subscribeRequestParser.CheckSchemaValidity();
+    SuccessOrExit(err);
+#endif
+
+    err = subscribeRequestParser.GetAttributePathList(&attributePathListParser);
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    else
+    {
+        SuccessOrExit(err);
+        err = ProcessAttributePathList(attributePathListParser);
+    }
+    SuccessOrExit(err);
+    err = subscribeRequestParser.GetEventPathList(&eventPathListParser);
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    else
+    {
+        SuccessOrExit(err);
+        err = ProcessEventPathList(eventPathListParser);
+    }
+    SuccessOrExit(err);
+
+    err = subscribeRequestParser.GetMinIntervalMs(&mMinIntervalFloorMs);
+    SuccessOrExit(err);
+    err = subscribeRequestParser.GetMaxIntervalMs(&mMaxIntervalCeilingMs);
+    SuccessOrExit(err);
+    VerifyOrExit(mMaxIntervalCeilingMs > 0 && mMinIntervalFloorMs <= mMaxIntervalCeilingMs, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSubscriptionId              = GetRandU64();
+    mDirty                       = true;
+    mpAttributeClusterInfoCursor = mpAttributeClusterInfoList;
+    MoveToState(HandlerState::Reportable);
+
+    err = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+    SuccessOrExit(err);
+
+    mpExchangeCtx->WillSendMessage();
+
+    // There must be no code after the WillSendMessage() call that can cause
+    // this method to return a failure.
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR ReadHandler::SendSubscribeResponse()
+{
+    System::PacketBufferHandle packet = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    VerifyOrReturnError(!packet.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    System::PacketBufferTLVWriter writer;
+    SubscribeResponse::Builder response;
+
+    writer.Init(std::move(packet));
+    ReturnErrorOnFailure(response.Init(&writer));
+    response.SubscriptionId(mSubscriptionId).FinalSyncIntervalMs(mMaxIntervalCeilingMs).EndOfSubscribeResponse();
+    ReturnErrorOnFailure(response.GetError());
+    ReturnErrorOnFailure(writer.Finalize(&packet));
+
+    return mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::SubscribeResponse, std::move(packet));
+}
+
 CHIP_ERROR ReadHandler::ProcessAttributePathList(AttributePathList::Parser & aAttributePathListParser)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -288,6 +552,9 @@ const char * ReadHandler::GetStateStr() const
 
     case HandlerState::Reportable:
         return "Reportable";
+
+    case HandlerState::AwaitingReportResponse:
+        return "AwaitingReportResponse";
     }
 #endif // CHIP_DETAIL_LOGGING
     return "N/A";
@@ -37,6 +37,9 @@
 #include <support/DLLUtil.h>
 #include <support/logging/CHIPLogging.h>
 #include <system/SystemPacketBuffer.h>
+#include <transport/SecureSessionHandle.h>
+
+#include <limits>
 
 namespace chip {
 namespace app {
@@ -46,10 +49,22 @@ namespace app {
  *  @brief The read handler is responsible for processing a read request, asking the attribute/event store
  *         for the relevant data, and sending a reply.
  *
+ *         A handler serving a subscription stays around after the first report: it is reported again when
+ *         the attributes it covers change, at most once per minimum interval, and at least once per maximum
+ *         interval even if nothing changed.
+ *
  */
-class ReadHandler
+class ReadHandler : public Messaging::ExchangeDelegate
 {
 public:
+    enum class InteractionType : uint8_t
+    {
+        Read,
+        Subscribe,
+    };
+
+    static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
     /**
      *  Initialize the ReadHandler. Within the lifetime
      *  of this instance, this method is invoked once after object
@@ -57,13 +72,14 @@ public:
      *  instance.
      *
      *  @param[in]    apDelegate       InteractionModelDelegate set by application.
+     *  @param[in]    aInteractionType Whether the handler serves a read or a subscription.
      *
      *  @retval #CHIP_ERROR_INCORRECT_STATE If the state is not equal to
      *          kState_NotInitialized.
      *  @retval #CHIP_NO_ERROR On success.
      *
      */
-    CHIP_ERROR Init(InteractionModelDelegate * apDelegate);
+    CHIP_ERROR Init(InteractionModelDelegate * apDelegate, InteractionType aInteractionType = InteractionType::Read);
 
     /**
      *  Shut down the ReadHandler. This terminates this instance
@@ -85,24 +101,75 @@ public:
      */
     CHIP_ERROR OnReadRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
 
+    /**
+     *  Process a subscribe request.  The first report goes out on the exchange of the request, and the subscription
+     *  is established once it is acknowledged and the SubscribeResponse is sent.  Later reports go out on exchanges of
+     *  their own.  As with OnReadRequest, the ReadHandler calls Shutdown on itself when the subscription ends, or when
+     *  processing fails.
+     *
+     *  @param[in]    apExchangeContext    A pointer to the ExchangeContext.
+     *  @param[in]    aPayload             A payload that has subscribe request data
+     *
+     *  @retval #Others If fails to process subscribe request
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
+
     /**
      *  Send ReportData to initiator
      *
      *  @param[in]    aPayload             A payload that has read request data
+     *  @param[in]    aMoreChunks          True if the report continues in further chunks. The handler then keeps
+     *                                     the exchange open and becomes reportable again once the initiator
+     *                                     acknowledges this chunk with a status response.
      *
      *  @retval #Others If fails to send report data
      *  @retval #CHIP_NO_ERROR On success.
      *
      */
-    CHIP_ERROR SendReportData(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendReportData(System::PacketBufferHandle && aPayload, bool aMoreChunks = false);
 
     bool IsFree() const { return mState == HandlerState::Uninitialized; }
-    bool IsReportable() const { return mState == HandlerState::Reportable; }
+    bool IsSubscription() const { return mInteractionType == InteractionType::Subscribe; }
+    bool IsAwaitingReportResponse() const { return mState == HandlerState::AwaitingReportResponse; }
+
+    /**
+     *  Whether a report should be generated at aNowMs.  Reads, the rest of a chunked report and the first report of a
+     *  subscription are always due; later reports of a subscription are due as described for GetNextReportTimeMs.
+     */
+    bool IsReportable(uint64_t aNowMs) const;
+
+    /**
+     *  When the next report of an established subscription is due: a minimum interval after the last report if
+     *  something has changed since, a maximum interval after it otherwise.  kNever if the handler is not waiting for
+     *  the next report of a subscription.
+     */
+    uint64_t GetNextReportTimeMs() const;
+
+    /**
+     *  Called by the reporting engine as it starts on a new report, as opposed to the next chunk of a report.
+     *  Changes from here on go into the next report, and the intervals count from aNowMs.
+     */
+    void StartReport(uint64_t aNowMs);
+
+    // True between the chunks of a report that did not fit in one message.
+    bool IsChunkedReport() const { return mChunkedReport; }
+
+    // Something this subscription covers has changed.
+    void SetDirty() { mDirty = true; }
+    bool IsDirty() const { return mDirty; }
+
+    uint64_t GetSubscriptionId() const { return mSubscriptionId; }
 
     virtual ~ReadHandler() = default;
 
     ClusterInfo * GetAttributeClusterInfolist() { return mpAttributeClusterInfoList; }
     ClusterInfo * GetEventClusterInfolist() { return mpEventClusterInfoList; }
+
+    // The attribute path the next chunk of the report starts from, or nullptr once all attribute paths are reported
+    ClusterInfo * GetAttributeClusterInfoCursor() { return mpAttributeClusterInfoCursor; }
+    void SetAttributeClusterInfoCursor(ClusterInfo * apClusterInfo) { mpAttributeClusterInfoCursor = apClusterInfo; }
     EventNumber * GetVendedEventNumberList() { return mSelfProcessedEvents; }
     PriorityLevel GetCurrentPriority() { return mCurrentPriority; }
 
@@ -117,12 +184,22 @@ public:
 private:
     enum class HandlerState
     {
-        Uninitialized = 0, ///< The handler has not been initialized
-        Initialized,       ///< The handler has been initialized and is ready
-        Reportable,        ///< The handler has received read request and is waiting for the data to send to be available
+        Uninitialized = 0,      ///< The handler has not been initialized
+        Initialized,            ///< The handler has been initialized and is ready
+        Reportable,             ///< The handler has received read request and is waiting for the data to send to be available
+        AwaitingReportResponse, ///< The handler has sent a chunk of the report and is waiting for the status response
     };
 
+    CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                 const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload) override;
+    void OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext) override;
+
+    friend class TestReadInteraction;
+
     CHIP_ERROR ProcessReadRequest(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR ProcessSubscribeRequest(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendSubscribeResponse();
+    CHIP_ERROR ProcessStatusResponse(System::PacketBufferHandle && aPayload);
     CHIP_ERROR ProcessAttributePathList(AttributePathList::Parser & aAttributePathListParser);
     CHIP_ERROR ProcessEventPathList(EventPathList::Parser & aEventPathListParser);
     void MoveToState(const HandlerState aTargetState);
@@ -136,10 +213,25 @@ private:
     // Don't need the response for report data if true
     bool mSuppressResponse = false;
 
+    InteractionType mInteractionType = InteractionType::Read;
+    bool mChunkedReport              = false;
+    bool mDirty                      = false;
+
+    // The first report of the subscription has been acknowledged, and the SubscribeResponse sent
+    bool mActiveSubscription = false;
+
+    // Subscription reports after the first one go out on new exchanges over this session
+    SecureSessionHandle mSessionHandle;
+    uint64_t mSubscriptionId       = 0;
+    uint64_t mLastReportMs         = 0;
+    uint16_t mMinIntervalFloorMs   = 0;
+    uint16_t mMaxIntervalCeilingMs = 0;
+
     // Current Handler state
-    HandlerState mState                      = HandlerState::Uninitialized;
-    ClusterInfo * mpAttributeClusterInfoList = nullptr;
-    ClusterInfo * mpEventClusterInfoList     = nullptr;
+    HandlerState mState                        = HandlerState::Uninitialized;
+    ClusterInfo * mpAttributeClusterInfoList   = nullptr;
+    ClusterInfo * mpEventClusterInfoList       = nullptr;
+    ClusterInfo * mpAttributeClusterInfoCursor = nullptr;
 
     PriorityLevel mCurrentPriority = PriorityLevel::Invalid;
 
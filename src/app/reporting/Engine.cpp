@@ -33,6 +33,7 @@ namespace reporting {
 CHIP_ERROR Engine::Init()
 {
     mMoreChunkedMessages = false;
+    mRunScheduled        = false;
     mNumReportsInFlight  = 0;
     mCurReadHandlerIdx   = 0;
     return CHIP_NO_ERROR;
@@ -72,6 +73,12 @@ Engine::RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElemen
     err = aAttributeDataElementBuilder.GetError();
 
 exit:
+    // Data that did not fit stays dirty, for the next chunk.
+    if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        return err;
+    }
+
     aClusterInfo.ClearDirty();
 
     if (err != CHIP_NO_ERROR)
@@ -86,25 +93,55 @@ exit:
 CHIP_ERROR Engine::BuildSingleReportDataAttributeDataList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler)
 {
     CHIP_ERROR err                               = CHIP_NO_ERROR;
-    ClusterInfo * clusterInfo                    = apReadHandler->GetAttributeClusterInfolist();
+    bool hasAttributeData                        = false;
+    ClusterInfo * clusterInfo                    = apReadHandler->GetAttributeClusterInfoCursor();
     AttributeDataList::Builder attributeDataList = reportDataBuilder.CreateAttributeDataListBuilder();
     SuccessOrExit(err = reportDataBuilder.GetError());
-    // TODO: Need to handle multiple chunk of message
+
+    // Start from where the previous chunk stopped; paths before the cursor have been reported already.
     while (clusterInfo != nullptr)
     {
         if (clusterInfo->IsDirty())
         {
+            // A failed element may also leave an error on the list builder, so keep a copy of it as well.
+            TLV::TLVWriter backup;
+            AttributeDataList::Builder attributeDataListBackup = attributeDataList;
+            attributeDataList.Checkpoint(backup);
             AttributeDataElement::Builder attributeDataElementBuilder = attributeDataList.CreateAttributeDataElementBuilder();
             ChipLogDetail(DataManagement, "<RE:Run> Cluster %" PRIx32 ", Field %" PRIx32 " is dirty", clusterInfo->mClusterId,
                           clusterInfo->mFieldId);
             // Retrieve data for this cluster instance and clear its dirty flag.
             err = RetrieveClusterData(attributeDataElementBuilder, *clusterInfo);
-            VerifyOrExit(err == CHIP_NO_ERROR,
-                         ChipLogError(DataManagement, "<RE:Run> Error retrieving data from cluster, aborting"));
+            if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+            {
+                // Drop the partial element, and send what we have so far.
+                attributeDataList = attributeDataListBackup;
+                attributeDataList.Rollback(backup);
+                err = CHIP_NO_ERROR;
+                if (hasAttributeData)
+                {
+                    mMoreChunkedMessages = true;
+                    break;
+                }
+
+                // It would not fit in a chunk of its own either, so the report cannot be completed.
+                ChipLogError(DataManagement, "<RE:Run> Cluster %" PRIx32 ", Field %" PRIx32 " is too large to report",
+                             clusterInfo->mClusterId, clusterInfo->mFieldId);
+                clusterInfo->ClearDirty();
+                ExitNow(err = CHIP_ERROR_BUFFER_TOO_SMALL);
+            }
+            else
+            {
+                VerifyOrExit(err == CHIP_NO_ERROR,
+                             ChipLogError(DataManagement, "<RE:Run> Error retrieving data from cluster, aborting"));
+                hasAttributeData = true;
+            }
         }
 
         clusterInfo = clusterInfo->mpNext;
     }
+    apReadHandler->SetAttributeClusterInfoCursor(clusterInfo);
+
     attributeDataList.EndOfAttributeDataList();
     err = attributeDataList.GetError();
 
@@ -233,18 +270,42 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 
     reportDataWriter.Init(std::move(bufHandle));
 
+    // Keep room for the MoreChunkedMessages flag however much data goes into the report. The writer itself
+    // keeps room to close every container it opens.
+    err = reportDataWriter.ReserveBuffer(kReservedSizeForMoreChunksFlag);
+    SuccessOrExit(err);
+
     // Create a report data.
     err = reportDataBuilder.Init(&reportDataWriter);
     SuccessOrExit(err);
 
+    if (apReadHandler->IsSubscription())
+    {
+        reportDataBuilder.SubscriptionId(apReadHandler->GetSubscriptionId());
+        SuccessOrExit(err = reportDataBuilder.GetError());
+    }
+
+    if (!apReadHandler->IsChunkedReport())
+    {
+        apReadHandler->StartReport(System::Clock::GetMonotonicMilliseconds());
+    }
+
+    mMoreChunkedMessages = false;
+
     err = BuildSingleReportDataAttributeDataList(reportDataBuilder, apReadHandler);
     SuccessOrExit(err);
 
-    err = BuildSingleReportDataEventList(reportDataBuilder, apReadHandler);
+    // Events follow once every attribute path has been reported.
+    if (!mMoreChunkedMessages)
+    {
+        err = BuildSingleReportDataEventList(reportDataBuilder, apReadHandler);
+        SuccessOrExit(err);
+    }
+
+    err = reportDataWriter.UnreserveBuffer(kReservedSizeForMoreChunksFlag);
     SuccessOrExit(err);
 
     // TODO: Add mechanism to set mSuppressResponse to handle status reports for multiple reports
-    // TODO: Add more chunk message support, currently mMoreChunkedMessages is always false.
     if (mMoreChunkedMessages)
     {
         reportDataBuilder.MoreChunkedMessages(mMoreChunkedMessages);
@@ -274,21 +335,21 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 #endif // CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
 
     ChipLogDetail(DataManagement, "<RE> Sending report...");
-    err = SendReport(apReadHandler, std::move(bufHandle));
+    err = SendReport(apReadHandler, std::move(bufHandle), mMoreChunkedMessages);
     VerifyOrExit(err == CHIP_NO_ERROR,
                  ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err));
 
     ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %" PRIu32 " with readHandler %" PRIu32 ", RE has %s", mNumReportsInFlight,
                   mCurReadHandlerIdx, mMoreChunkedMessages ? "more messages" : "no more messages");
 
-    if (!mMoreChunkedMessages)
+    if (!apReadHandler->IsAwaitingReportResponse())
     {
         OnReportConfirm();
     }
 
 exit:
     ChipLogFunctError(err);
-    if (!mMoreChunkedMessages || err != CHIP_NO_ERROR)
+    if (err != CHIP_NO_ERROR || (!mMoreChunkedMessages && !apReadHandler->IsSubscription()))
     {
         apReadHandler->Shutdown();
     }
@@ -301,11 +362,26 @@ void Engine::Run(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR)
     pEngine->Run();
 }
 
+void Engine::OnReportTimer(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR)
+{
+    Engine * const pEngine = reinterpret_cast<Engine *>(apAppState);
+    pEngine->Run();
+}
+
 CHIP_ERROR Engine::ScheduleRun()
 {
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (mRunScheduled)
+    {
+        return CHIP_NO_ERROR;
+    }
+
     if (InteractionModelEngine::GetInstance()->GetExchangeManager() != nullptr)
     {
-        return InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionMgr()->SystemLayer()->ScheduleWork(Run, this);
+        err = InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionMgr()->SystemLayer()->ScheduleWork(Run, this);
+        mRunScheduled = (err == CHIP_NO_ERROR);
+        return err;
     }
     else
     {
@@ -316,32 +392,70 @@ CHIP_ERROR Engine::ScheduleRun()
 void Engine::Run()
 {
     uint32_t numReadHandled = 0;
+    const uint64_t nowMs    = System::Clock::GetMonotonicMilliseconds();
 
     InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
     ReadHandler * readHandler         = imEngine->mReadHandlers + mCurReadHandlerIdx;
 
+    mRunScheduled = false;
+
     while ((mNumReportsInFlight < CHIP_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < CHIP_MAX_NUM_READ_HANDLER))
     {
-        if (readHandler->IsReportable())
+        if (readHandler->IsReportable(nowMs))
         {
             CHIP_ERROR err = BuildAndSendSingleReportData(readHandler);
             ChipLogFunctError(err);
-            return;
         }
         numReadHandled++;
         mCurReadHandlerIdx = (mCurReadHandlerIdx + 1) % CHIP_MAX_NUM_READ_HANDLER;
         readHandler        = imEngine->mReadHandlers + mCurReadHandlerIdx;
     }
+
+    ScheduleNextReport(nowMs);
 }
 
-CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload)
+void Engine::ScheduleNextReport(uint64_t aNowMs)
+{
+    uint64_t nextReportMs             = ReadHandler::kNever;
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+
+    // Reports that are due already go out as soon as a report in flight is confirmed.
+    VerifyOrReturn(imEngine->GetExchangeManager() != nullptr && mNumReportsInFlight < CHIP_MAX_REPORTS_IN_FLIGHT);
+    System::Layer * systemLayer = imEngine->GetExchangeManager()->GetSessionMgr()->SystemLayer();
+
+    for (auto & readHandler : imEngine->mReadHandlers)
+    {
+        const uint64_t reportMs = readHandler.GetNextReportTimeMs();
+        if (reportMs < nextReportMs)
+        {
+            nextReportMs = reportMs;
+        }
+    }
+
+    if (nextReportMs == ReadHandler::kNever)
+    {
+        systemLayer->CancelTimer(OnReportTimer, this);
+        return;
+    }
+
+    uint64_t delayMs = (nextReportMs > aNowMs) ? nextReportMs - aNowMs : 0;
+    if (delayMs > UINT32_MAX)
+    {
+        delayMs = UINT32_MAX;
+    }
+
+    CHIP_ERROR err = systemLayer->StartTimer(static_cast<uint32_t>(delayMs), OnReportTimer, this);
+    ChipLogFunctError(err);
+}
+
+CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     // We can only have 1 report in flight for any given read - increment and break out.
     mNumReportsInFlight++;
 
-    err = apReadHandler->SendReportData(std::move(aPayload));
+    err = apReadHandler->SendReportData(std::move(aPayload), aMoreChunks);
 
     if (err != CHIP_NO_ERROR)
     {
@@ -356,6 +470,40 @@ void Engine::OnReportConfirm()
 
     mNumReportsInFlight--;
     ChipLogDetail(DataManagement, "<RE> OnReportConfirm: NumReports = %" PRIu32, mNumReportsInFlight);
+
+    // Reports may have been held back for want of room.
+    if (mNumReportsInFlight == CHIP_MAX_REPORTS_IN_FLIGHT - 1)
+    {
+        CHIP_ERROR err = ScheduleRun();
+        ChipLogFunctError(err);
+    }
+}
+
+CHIP_ERROR Engine::SetDirty(ClusterInfo & aClusterInfo)
+{
+    bool isDirty = false;
+
+    for (auto & readHandler : InteractionModelEngine::GetInstance()->mReadHandlers)
+    {
+        if (readHandler.IsFree() || !readHandler.IsSubscription())
+        {
+            continue;
+        }
+
+        for (ClusterInfo * clusterInfo = readHandler.GetAttributeClusterInfolist(); clusterInfo != nullptr;
+             clusterInfo               = clusterInfo->mpNext)
+        {
+            if (clusterInfo->IsAttributePathSupersetOf(aClusterInfo))
+            {
+                clusterInfo->SetDirty();
+                readHandler.SetDirty();
+                isDirty = true;
+            }
+        }
+    }
+
+    // The run works out when the change can be reported, given the minimum intervals.
+    return isDirty ? ScheduleRun() : CHIP_NO_ERROR;
 }
 
 }; // namespace reporting
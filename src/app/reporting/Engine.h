@@ -70,6 +70,20 @@ public:
      */
     CHIP_ERROR ScheduleRun();
 
+    /**
+     * Should be invoked when the device receives a Status report, or when the Report data request times out.
+     * This allows the engine to do some clean-up.
+     *
+     */
+    void OnReportConfirm();
+
+    /**
+     * Marks the attribute dirty for every subscription that covers it, so that it goes into the next report of each.
+     * Should be invoked when the value of the attribute changes.
+     *
+     */
+    CHIP_ERROR SetDirty(ClusterInfo & aClusterInfo);
+
 private:
     friend class TestReportingEngine;
     /**
@@ -84,23 +98,24 @@ private:
     EventNumber CountEvents(ReadHandler * apReadHandler, EventNumber * apInitialEvents);
 
     /**
-     * Send Report via ReadHandler
+     * Send Report via ReadHandler. A report with more chunks to come stays in flight until the
+     * ReadHandler receives the status response for it.
      *
      */
-    CHIP_ERROR SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aMoreChunks);
 
     /**
-     * Should be invoked when the device receives a Status report, or when the Report data request times out.
-     * This allows the engine to do some clean-up.
+     * Generate and send the report data request when there exists subscription or read request
      *
      */
-    void OnReportConfirm();
+    static void Run(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR);
 
     /**
-     * Generate and send the report data request when there exists subscription or read request
+     * Arm the timer for the next subscription report that is not due yet, if any.
      *
      */
-    static void Run(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR);
+    void ScheduleNextReport(uint64_t aNowMs);
+    static void OnReportTimer(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR);
 
     /**
      * Boolean to show if more chunk message on the way
@@ -108,6 +123,19 @@ private:
      */
     bool mMoreChunkedMessages = false;
 
+    /**
+     * Boolean to show if a run is already scheduled, so that bursts of changes schedule it only once
+     *
+     */
+    bool mRunScheduled = false;
+
+    /**
+     * Bytes kept free while a report is filled with data, to be sure the MoreChunkedMessages flag (a context tag and a
+     * boolean) still fits. The end-of-container markers are kept free by the TLV writer itself.
+     *
+     */
+    static constexpr uint32_t kReservedSizeForMoreChunksFlag = 2;
+
     /**
      * The number of report date request in flight
      *
@@ -35,6 +35,7 @@
 #include <platform/KeyValueStoreManager.h>
 #include <protocols/secure_channel/CASEServer.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
 #include <setup_payload/SetupPayload.h>
 #include <support/CodeUtils.h>
 #include <support/ErrorStr.h>
@@ -294,6 +295,7 @@ DemoTransportMgr gTransports;
 SecureSessionMgr gSessions;
 RendezvousServer gRendezvousServer;
 CASEServer gCASEServer;
+SessionResumptionStorage gCASEResumptionStorage;
 Messaging::ExchangeManager gExchangeMgr;
 ServerRendezvousAdvertisementDelegate gAdvDelegate;
 
@@ -477,6 +479,9 @@ void InitServer(AppDelegate * delegate)
     err = gAdminPairings.Init(&gServerStorage);
     SuccessOrExit(err);
 
+    err = gCASEResumptionStorage.Init(&gServerStorage);
+    SuccessOrExit(err);
+
     // Init transport before operations with secure session mgr.
     err = gTransports.Init(UdpListenParameters(&DeviceLayer::InetLayer).SetAddressType(kIPAddressType_IPv6)
 
@@ -550,7 +555,7 @@ void InitServer(AppDelegate * delegate)
     VerifyOrExit(err == CHIP_NO_ERROR, err = CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER);
 
     err = gCASEServer.ListenForSessionEstablishment(&gExchangeMgr, &gTransports, &gSessions, &GetGlobalAdminPairingTable(),
-                                                    &gSessionIDAllocator);
+                                                    &gSessionIDAllocator, &gCASEResumptionStorage);
     SuccessOrExit(err);
 
 exit:
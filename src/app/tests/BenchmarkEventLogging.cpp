@@ -0,0 +1,234 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks of CHIP Interaction Model Event logging.
+ *      They are built with chip_build_benchmarks and are not part of the unit tests.
+ *
+ */
+
+#include <app/ClusterInfo.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventLoggingTypes.h>
+#include <app/EventManagement.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVUtilities.hpp>
+#include <messaging/ExchangeMgr.h>
+#include <protocols/secure_channel/MessageCounterManager.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/raw/UDP.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+static const chip::NodeId kTestDeviceNodeId     = 0x18B4300000000001ULL;
+static const chip::ClusterId kLivenessClusterId = 0x00000022;
+static const uint32_t kLivenessChangeEvent      = 1;
+static const chip::EndpointId kTestEndpointId   = 2;
+static const uint64_t kLivenessDeviceStatus     = chip::TLV::ContextTag(1);
+static const chip::Transport::AdminId gAdminId  = 0;
+static chip::TransportMgr<chip::Transport::UDP> gTransportManager;
+static chip::System::Layer gSystemLayer;
+
+static constexpr uint64_t kIterations = 10000;
+
+static uint8_t gEventBuffers[3][4096];
+static chip::app::CircularEventBuffer gCircularEventBuffer[3];
+static uint8_t gFetchBuffer[16384];
+
+chip::SecureSessionMgr gSessionManager;
+chip::Messaging::ExchangeManager gExchangeManager;
+chip::secure_channel::MessageCounterManager gMessageCounterManager;
+
+void InitializeChip(nlTestSuite * apSuite)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::Transport::AdminPairingTable admins;
+    chip::Transport::AdminPairingInfo * adminInfo = admins.AssignAdminId(gAdminId, kTestDeviceNodeId);
+
+    NL_TEST_ASSERT(apSuite, adminInfo != nullptr);
+
+    err = chip::Platform::MemoryInit();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    gSystemLayer.Init(nullptr);
+
+    err = gSessionManager.Init(kTestDeviceNodeId, &gSystemLayer, &gTransportManager, &admins, &gMessageCounterManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = gExchangeManager.Init(&gSessionManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = gMessageCounterManager.Init(&gExchangeManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+void InitializeEventLogging()
+{
+    chip::app::LogStorageResources logStorageResources[] = {
+        { &gEventBuffers[0][0], sizeof(gEventBuffers[0]), nullptr, 0, nullptr, chip::app::PriorityLevel::Debug },
+        { &gEventBuffers[1][0], sizeof(gEventBuffers[1]), nullptr, 0, nullptr, chip::app::PriorityLevel::Info },
+        { &gEventBuffers[2][0], sizeof(gEventBuffers[2]), nullptr, 0, nullptr, chip::app::PriorityLevel::Critical },
+    };
+
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::app::EventManagement::CreateEventManagement(
+        &gExchangeManager, sizeof(logStorageResources) / sizeof(logStorageResources[0]), gCircularEventBuffer, logStorageResources);
+}
+
+uint64_t PerSecond(uint64_t aCount, uint64_t aElapsedUs)
+{
+    return aCount * 1000000 / ((aElapsedUs > 0) ? aElapsedUs : 1);
+}
+
+class TestEventGenerator : public chip::app::EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(chip::TLV::TLVWriter & aWriter) { return aWriter.Put(kLivenessDeviceStatus, mStatus); }
+
+    void SetStatus(int32_t aStatus) { mStatus = aStatus; }
+
+private:
+    int32_t mStatus = 0;
+};
+
+class TestBlobEventGenerator : public chip::app::EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(chip::TLV::TLVWriter & aWriter) { return aWriter.PutBytes(kLivenessDeviceStatus, mBlob, mBlobLength); }
+
+    void SetBlobLength(uint32_t aBlobLength) { mBlobLength = aBlobLength; }
+
+private:
+    uint8_t mBlob[chip::app::kMaxEventSizeReserve] = { 0 };
+    uint32_t mBlobLength                           = 0;
+};
+
+// Logs kIterations info events, and returns how long that took in microseconds.
+uint64_t TimeLogEvents(nlTestSuite * apSuite, chip::app::EventLoggingDelegate & aDelegate)
+{
+    chip::EventNumber eid;
+    chip::app::EventSchema schema = { kTestDeviceNodeId, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                      chip::app::PriorityLevel::Info };
+    chip::app::EventOptions options;
+    size_t failures = 0;
+
+    options.mpEventSchema = &schema;
+
+    // Info events go through the debug buffer into the info buffer, so once the buffers are full every event both moves
+    // and drops older ones.
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    uint64_t start                       = chip::System::Clock::GetMonotonicMicroseconds();
+    for (uint64_t i = 0; i < kIterations; i++)
+    {
+        failures += (logMgmt.LogEvent(&aDelegate, options, eid) != CHIP_NO_ERROR);
+    }
+    uint64_t elapsed = chip::System::Clock::GetMonotonicMicroseconds() - start;
+
+    NL_TEST_ASSERT(apSuite, failures == 0);
+    return elapsed;
+}
+
+void BenchmarkLogEvent(nlTestSuite * apSuite, void * apContext)
+{
+    InitializeEventLogging();
+
+    TestEventGenerator smallEventGenerator;
+    smallEventGenerator.SetStatus(1);
+    uint64_t smallUs = TimeLogEvents(apSuite, smallEventGenerator);
+
+    // Leave room for the event path, priority and timestamp around the payload.
+    TestBlobEventGenerator largeEventGenerator;
+    largeEventGenerator.SetBlobLength(chip::app::kMaxEventSizeReserve - 96);
+    uint64_t largeUs = TimeLogEvents(apSuite, largeEventGenerator);
+
+    printf("LogEvent: %" PRIu64 " small events/s, %" PRIu64 " events/s of up to %zu bytes\n", PerSecond(kIterations, smallUs),
+           PerSecond(kIterations, largeUs), chip::app::kMaxEventSizeReserve);
+}
+
+void BenchmarkFetchEventsSince(nlTestSuite * apSuite, void * apContext)
+{
+    size_t fetched = 0;
+    chip::app::ClusterInfo testClusterInfo;
+    TestEventGenerator testEventGenerator;
+
+    testClusterInfo.mNodeId     = kTestDeviceNodeId;
+    testClusterInfo.mEndpointId = kTestEndpointId;
+    testClusterInfo.mClusterId  = kLivenessClusterId;
+    testClusterInfo.mEventId    = kLivenessChangeEvent;
+
+    InitializeEventLogging();
+    testEventGenerator.SetStatus(1);
+    TimeLogEvents(apSuite, testEventGenerator);
+
+    // A subscription mostly asks for the few events logged since its last report, with all the buffers full.
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    const chip::EventNumber last         = logMgmt.GetLastEventNumber(chip::app::PriorityLevel::Info);
+    uint64_t start                       = chip::System::Clock::GetMonotonicMicroseconds();
+    for (uint64_t i = 0; i < kIterations; i++)
+    {
+        chip::TLV::TLVWriter writer;
+        chip::TLV::TLVReader reader;
+        chip::EventNumber eventNumber = last;
+        size_t elementCount           = 0;
+
+        writer.Init(gFetchBuffer, sizeof(gFetchBuffer));
+        NL_TEST_ASSERT(apSuite,
+                       logMgmt.FetchEventsSince(writer, &testClusterInfo, chip::app::PriorityLevel::Info, eventNumber) ==
+                           CHIP_NO_ERROR);
+        reader.Init(gFetchBuffer, writer.GetLengthWritten());
+        NL_TEST_ASSERT(apSuite, chip::TLV::Utilities::Count(reader, elementCount, false) == CHIP_NO_ERROR);
+        fetched += elementCount;
+    }
+    uint64_t elapsed = chip::System::Clock::GetMonotonicMicroseconds() - start;
+
+    NL_TEST_ASSERT(apSuite, fetched == kIterations);
+    printf("FetchEventsSince: %" PRIu64 " fetches/s of the newest event\n", PerSecond(kIterations, elapsed));
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("BenchmarkLogEvent", BenchmarkLogEvent),
+                          NL_TEST_DEF("BenchmarkFetchEventsSince", BenchmarkFetchEventsSince), NL_TEST_SENTINEL() };
+} // namespace
+
+int BenchmarkEventLogging()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+	{
+        "EventLoggingBenchmark",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    InitializeChip(&theSuite);
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkEventLogging)
@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks of the report rate of CHIP Interaction Model subscriptions.
+ *      They are built with chip_build_benchmarks and are not part of the unit tests.
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/tests/SubscriptionTestHelpers.h>
+#include <messaging/tests/MessagingContext.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <stdio.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+chip::TransportMgrBase gLoopbackTransportManager;
+chip::Test::LoopbackTransport gLoopback;
+
+using TestContext = chip::Test::MessagingContext;
+TestContext sContext;
+
+// An attribute changes every 10 ms, 1000 times. The reports a subscription to it produces are counted until the changes
+// stop, and for two more seconds.
+constexpr uint32_t kNumChanges      = 1000;
+constexpr uint32_t kChangePeriodMs  = 10;
+constexpr uint32_t kMaxChangingMs   = 60000;
+constexpr uint32_t kQuietPeriodMs   = 2000;
+constexpr uint32_t kSubscribeWaitMs = 1000;
+
+uint32_t gNumChanges = 0;
+
+void ChangeAttribute(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR aError)
+{
+    app::Test::SetAttributeDirty(app::Test::kChangedFieldId);
+
+    if (++gNumChanges < kNumChanges)
+    {
+        aSystemLayer->StartTimer(kChangePeriodMs, ChangeAttribute, apAppState);
+    }
+}
+
+/**
+ *  Count the reports that a stream of changes produces under different min and max intervals.
+ */
+void BenchmarkSubscribeReportRate(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    const struct
+    {
+        uint16_t minIntervalMs;
+        uint16_t maxIntervalMs;
+    } testCases[] = {
+        { 0, 60000 },    // The first report, then one per change
+        { 100, 60000 },  // At most one report per min interval while the attribute keeps changing
+        { 1000, 60000 }, //
+        { 1000, 2000 },  // Plus one per max interval once the changes stop
+        { 5000, 5000 },  //
+    };
+
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    InteractionModelDelegate delegate;
+
+    for (const auto & testCase : testCases)
+    {
+        app::Test::TestSubscriber subscriber(ctx.GetSystemLayer());
+
+        NL_TEST_ASSERT(apSuite, engine->Init(&ctx.GetExchangeManager(), &delegate) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite,
+                       app::Test::Subscribe(ctx, subscriber, testCase.minIntervalMs, testCase.maxIntervalMs) == CHIP_NO_ERROR);
+        ctx.DriveIOUntil(kSubscribeWaitMs, [&subscriber] { return subscriber.mSubscribed; });
+        NL_TEST_ASSERT(apSuite, subscriber.mSubscribed);
+
+        gNumChanges          = 0;
+        const uint64_t start = System::Clock::GetMonotonicMilliseconds();
+        NL_TEST_ASSERT(apSuite, ctx.GetSystemLayer().StartTimer(kChangePeriodMs, ChangeAttribute, nullptr) == CHIP_NO_ERROR);
+        ctx.DriveIOUntil(kMaxChangingMs, [] { return gNumChanges == kNumChanges; });
+        ctx.DriveIOUntil(kQuietPeriodMs, [] { return false; });
+        const uint64_t elapsedMs = System::Clock::GetMonotonicMilliseconds() - start;
+
+        NL_TEST_ASSERT(apSuite, gNumChanges == kNumChanges);
+
+        // Besides the first report, there is at most one per change, and at most one per min interval.
+        const uint64_t maxReports = 1 + ((testCase.minIntervalMs == 0) ? kNumChanges : elapsedMs / testCase.minIntervalMs + 1);
+        NL_TEST_ASSERT(apSuite, subscriber.mNumReports >= 2 && subscriber.mNumReports <= maxReports);
+
+        printf("Subscription with min interval %u ms, max interval %u ms: %u reports for %u changes in %u ms\n",
+               static_cast<unsigned>(testCase.minIntervalMs), static_cast<unsigned>(testCase.maxIntervalMs),
+               static_cast<unsigned>(subscriber.mNumReports), static_cast<unsigned>(kNumChanges),
+               static_cast<unsigned>(elapsedMs));
+
+        app::Test::Unsubscribe(ctx);
+        engine->Shutdown();
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Benchmark subscription report rate", BenchmarkSubscribeReportRate),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext);
+int Finalize(void * aContext);
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Benchmark-CHIP-ReadInteraction",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+int Initialize(void * aContext)
+{
+    // Initializes the platform memory as well.
+    gLoopbackTransportManager.Init(&gLoopback);
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Init(&sSuite, &gLoopbackTransportManager);
+    if (err != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+    gLoopbackTransportManager.SetSecureSessionMgr(&sContext.GetSecureSessionManager());
+
+    return SUCCESS;
+}
+
+int Finalize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+int BenchmarkReadInteraction()
+{
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkReadInteraction)
@@ -0,0 +1,181 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a subscriber and helpers shared by the subscription
+ *      tests and benchmarks, which drive subscriptions end to end over a
+ *      loopback messaging context.
+ */
+
+#pragma once
+
+#include <app/ClusterInfo.h>
+#include <app/InteractionModelEngine.h>
+#include <app/MessageDef/StatusElement.h>
+#include <app/MessageDef/SubscribeRequest.h>
+#include <core/CHIPError.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/interaction_model/Constants.h>
+#include <protocols/secure_channel/Constants.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+
+namespace chip {
+namespace app {
+namespace Test {
+
+constexpr EndpointId kTestEndpointId = 2;
+constexpr ClusterId kTestClusterId   = 3;
+constexpr FieldId kChangedFieldId    = 4;
+constexpr FieldId kOtherFieldId      = 5;
+
+/// Marks an attribute of the test cluster as changed.
+inline void SetAttributeDirty(FieldId aFieldId)
+{
+    ClusterInfo path;
+    path.mEndpointId = kTestEndpointId;
+    path.mClusterId  = kTestClusterId;
+    path.mFieldId    = aFieldId;
+    path.mFlags.Set(ClusterInfo::Flags::kFieldIdValid);
+    InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(path);
+}
+
+/// Counts the reports of a subscription, and acknowledges each of them with a status response.
+class TestSubscriber : public Messaging::ExchangeDelegate
+{
+public:
+    TestSubscriber(System::Layer & aSystemLayer) : mSystemLayer(aSystemLayer) {}
+
+    CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                 const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload) override
+    {
+        if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::SubscribeResponse))
+        {
+            mSubscribed = true;
+        }
+
+        if (!aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReportData))
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        mNumReports++;
+
+        // Answer after this message has been handled, as a subscriber at the other end of a network would.
+        mpExchangeCtx = apExchangeContext;
+        mpExchangeCtx->WillSendMessage();
+        return mSystemLayer.ScheduleWork(SendStatusResponse, this);
+    }
+
+    void OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext) override {}
+
+    uint32_t mNumReports = 0;
+    bool mSubscribed     = false;
+
+private:
+    static void SendStatusResponse(System::Layer * aSystemLayer, void * apAppState, CHIP_ERROR aError)
+    {
+        TestSubscriber * const subscriber = static_cast<TestSubscriber *>(apAppState);
+        Messaging::ExchangeContext * ec   = subscriber->mpExchangeCtx;
+        System::PacketBufferHandle msgBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+        System::PacketBufferTLVWriter writer;
+        StatusElement::Builder statusElementBuilder;
+
+        subscriber->mpExchangeCtx = nullptr;
+        VerifyOrReturn(ec != nullptr && !msgBuf.IsNull());
+
+        writer.Init(std::move(msgBuf));
+        statusElementBuilder.Init(&writer);
+        statusElementBuilder
+            .EncodeStatusElement(Protocols::SecureChannel::GeneralStatusCode::kSuccess,
+                                 Protocols::InteractionModel::Id.ToFullyQualifiedSpecForm(),
+                                 to_underlying(Protocols::InteractionModel::ProtocolCode::Success))
+            .EndOfStatusElement();
+        if (statusElementBuilder.GetError() != CHIP_NO_ERROR || writer.Finalize(&msgBuf) != CHIP_NO_ERROR)
+        {
+            ec->Close();
+            return;
+        }
+
+        // The first report is followed by the subscribe response, on the same exchange.
+        if (!subscriber->mSubscribed)
+        {
+            ec->SendMessage(Protocols::InteractionModel::MsgType::StatusResponse, std::move(msgBuf),
+                            Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+            return;
+        }
+
+        ec->SendMessage(Protocols::InteractionModel::MsgType::StatusResponse, std::move(msgBuf));
+        ec->Close();
+    }
+
+    System::Layer & mSystemLayer;
+    Messaging::ExchangeContext * mpExchangeCtx = nullptr;
+};
+
+/// Subscribes [aSubscriber] to the changed attribute of the test cluster, with the given intervals. Later reports start
+/// exchanges of their own, so the subscriber is also registered for unsolicited reports; the caller unregisters it.
+inline CHIP_ERROR Subscribe(chip::Test::MessagingContext & aContext, TestSubscriber & aSubscriber, uint16_t aMinIntervalMs,
+                            uint16_t aMaxIntervalMs)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle subscribeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    SubscribeRequest::Builder subscribeRequestBuilder;
+
+    ReturnErrorCodeIf(subscribeRequestbuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(aContext.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+        Protocols::InteractionModel::Id, to_underlying(Protocols::InteractionModel::MsgType::ReportData), &aSubscriber));
+
+    writer.Init(std::move(subscribeRequestbuf));
+    ReturnErrorOnFailure(subscribeRequestBuilder.Init(&writer));
+
+    AttributePathList::Builder attributePathListBuilder = subscribeRequestBuilder.CreateAttributePathListBuilder();
+    AttributePath::Builder attributePathBuilder         = attributePathListBuilder.CreateAttributePathBuilder();
+    attributePathBuilder.NodeId(1)
+        .EndpointId(kTestEndpointId)
+        .ClusterId(kTestClusterId)
+        .FieldId(kChangedFieldId)
+        .EndOfAttributePath();
+    attributePathListBuilder.EndOfAttributePathList();
+    subscribeRequestBuilder.MinIntervalMs(aMinIntervalMs).MaxIntervalMs(aMaxIntervalMs).EndOfSubscribeRequest();
+    ReturnErrorOnFailure(subscribeRequestBuilder.GetError());
+    ReturnErrorOnFailure(writer.Finalize(&subscribeRequestbuf));
+
+    Messaging::ExchangeContext * exchangeCtx = aContext.NewExchangeToPeer(&aSubscriber);
+    VerifyOrReturnError(exchangeCtx != nullptr, CHIP_ERROR_NO_MEMORY);
+    return exchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::SubscribeRequest, std::move(subscribeRequestbuf),
+                                    Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+}
+
+/// Undoes the registration of Subscribe().
+inline void Unsubscribe(chip::Test::MessagingContext & aContext)
+{
+    aContext.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(
+        Protocols::InteractionModel::Id, to_underlying(Protocols::InteractionModel::MsgType::ReportData));
+}
+
+} // namespace Test
+} // namespace app
+} // namespace chip
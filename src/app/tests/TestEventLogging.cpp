@@ -63,6 +63,12 @@ static uint8_t gInfoEventBuffer[128];
 static uint8_t gCritEventBuffer[128];
 static chip::app::CircularEventBuffer gCircularEventBuffer[3];
 
+static uint8_t gLargeEventBuffers[3][4096];
+
+static constexpr uint32_t kFetchTestEvents = 3000;
+static uint64_t gEventTimestamps[3][kFetchTestEvents + 1];
+static uint8_t gFetchBuffer[16384];
+
 chip::SecureSessionMgr gSessionManager;
 chip::Messaging::ExchangeManager gExchangeManager;
 chip::secure_channel::MessageCounterManager gMessageCounterManager;
@@ -103,6 +109,19 @@ void InitializeEventLogging()
         &gExchangeManager, sizeof(logStorageResources) / sizeof(logStorageResources[0]), gCircularEventBuffer, logStorageResources);
 }
 
+void InitializeLargeEventLogging()
+{
+    chip::app::LogStorageResources logStorageResources[] = {
+        { &gLargeEventBuffers[0][0], sizeof(gLargeEventBuffers[0]), nullptr, 0, nullptr, chip::app::PriorityLevel::Debug },
+        { &gLargeEventBuffers[1][0], sizeof(gLargeEventBuffers[1]), nullptr, 0, nullptr, chip::app::PriorityLevel::Info },
+        { &gLargeEventBuffers[2][0], sizeof(gLargeEventBuffers[2]), nullptr, 0, nullptr, chip::app::PriorityLevel::Critical },
+    };
+
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::app::EventManagement::CreateEventManagement(
+        &gExchangeManager, sizeof(logStorageResources) / sizeof(logStorageResources[0]), gCircularEventBuffer, logStorageResources);
+}
+
 void SimpleDumpWriter(const char * aFormat, ...)
 {
     va_list args;
@@ -180,6 +199,24 @@ private:
     int32_t mStatus;
 };
 
+class TestBlobEventGenerator : public chip::app::EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(chip::TLV::TLVWriter & aWriter)
+    {
+        CHIP_ERROR err = aWriter.PutBytes(kLivenessDeviceStatus, mBlob, mBlobLength);
+        return (err == CHIP_NO_ERROR) ? mError : err;
+    }
+
+    void SetBlobLength(uint32_t aBlobLength) { mBlobLength = aBlobLength; }
+    void SetError(CHIP_ERROR aError) { mError = aError; }
+
+private:
+    uint8_t mBlob[chip::app::kMaxEventSizeReserve] = { 0 };
+    uint32_t mBlobLength                           = 0;
+    CHIP_ERROR mError                              = CHIP_NO_ERROR;
+};
+
 static void CheckLogEventWithEvictToNextBuffer(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -290,12 +327,134 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
+static void CheckLogEventFailureLeavesNoTrace(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::EventNumber eid;
+    chip::app::EventSchema schema = { kTestDeviceNodeId1, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                      chip::app::PriorityLevel::Debug };
+    chip::app::EventOptions options;
+    TestBlobEventGenerator testEventGenerator;
+
+    options.mpEventSchema = &schema;
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber lastEventNumber    = logMgmt.GetLastEventNumber(chip::app::PriorityLevel::Debug);
+
+    // The event is written straight into the buffer, so a delegate failing halfway through must not leave part of it behind.
+    // The full buffer had to drop its oldest event to make room before the delegate failed.
+    testEventGenerator.SetBlobLength(16);
+    testEventGenerator.SetError(CHIP_ERROR_INTERNAL);
+    err = logMgmt.LogEvent(&testEventGenerator, options, eid);
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_INTERNAL);
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber(chip::app::PriorityLevel::Debug) == lastEventNumber);
+    CheckLogState(apSuite, logMgmt, 2, chip::app::PriorityLevel::Debug);
+
+    // Events that cannot fit in the buffers are rejected.
+    testEventGenerator.SetBlobLength(sizeof(gDebugEventBuffer));
+    testEventGenerator.SetError(CHIP_NO_ERROR);
+    err = logMgmt.LogEvent(&testEventGenerator, options, eid);
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber(chip::app::PriorityLevel::Debug) == lastEventNumber);
+    CheckLogState(apSuite, logMgmt, 2, chip::app::PriorityLevel::Debug);
+
+    testEventGenerator.SetBlobLength(4);
+    err = logMgmt.LogEvent(&testEventGenerator, options, eid);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eid == lastEventNumber + 1);
+    CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
+}
+
+// Fetches the events of aPriority since aEventNumber, and returns how many there were along with the timestamp of the first.
+static size_t FetchEvents(nlTestSuite * apSuite, chip::app::PriorityLevel aPriority, chip::EventNumber & aEventNumber,
+                          chip::app::ClusterInfo * apClusterInfo, uint64_t & aFirstTimestamp)
+{
+    chip::TLV::TLVWriter writer;
+    chip::TLV::TLVReader reader;
+    chip::TLV::TLVType containerType;
+    size_t elementCount = 0;
+
+    writer.Init(gFetchBuffer, sizeof(gFetchBuffer));
+    CHIP_ERROR err = chip::app::EventManagement::GetInstance().FetchEventsSince(writer, apClusterInfo, aPriority, aEventNumber);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    reader.Init(gFetchBuffer, writer.GetLengthWritten());
+    err = chip::TLV::Utilities::Count(reader, elementCount, false);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    aFirstTimestamp = 0;
+    reader.Init(gFetchBuffer, writer.GetLengthWritten());
+    if (elementCount > 0 && reader.Next() == CHIP_NO_ERROR && reader.EnterContainer(containerType) == CHIP_NO_ERROR)
+    {
+        while (reader.Next() == CHIP_NO_ERROR)
+        {
+            if (reader.GetTag() == chip::TLV::ContextTag(chip::app::EventDataElement::kCsTag_SystemTimestamp))
+            {
+                reader.Get(aFirstTimestamp);
+            }
+        }
+    }
+    return elementCount;
+}
+
+static void CheckFetchEventsSince(nlTestSuite * apSuite, void * apContext)
+{
+    const chip::app::PriorityLevel priorities[] = { chip::app::PriorityLevel::Debug, chip::app::PriorityLevel::Info,
+                                                    chip::app::PriorityLevel::Critical };
+    chip::EventNumber eid;
+    chip::app::EventSchema schema = { kTestDeviceNodeId1, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                      chip::app::PriorityLevel::Debug };
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+    chip::app::ClusterInfo testClusterInfo;
+
+    options.mpEventSchema       = &schema;
+    testClusterInfo.mNodeId     = kTestDeviceNodeId1;
+    testClusterInfo.mEndpointId = kTestEndpointId;
+    testClusterInfo.mClusterId  = kLivenessClusterId;
+    testClusterInfo.mEventId    = kLivenessChangeEvent;
+
+    InitializeLargeEventLogging();
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // Interleave the priorities, s.t. every buffer holds events of several of them, and log enough events for all of them
+    // to be both moved and dropped.
+    for (uint32_t i = 0; i < kFetchTestEvents; i++)
+    {
+        schema.mPriority   = priorities[(i % 5 == 0) ? 2 : (i % 2)];
+        options.mTimestamp = chip::app::Timestamp::System(1000 + i);
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eid) == CHIP_NO_ERROR);
+        gEventTimestamps[static_cast<uint8_t>(schema.mPriority)][eid] = options.mTimestamp.mValue;
+    }
+
+    for (chip::app::PriorityLevel priority : priorities)
+    {
+        const chip::EventNumber first = logMgmt.GetFirstEventNumber(priority);
+        const chip::EventNumber last  = logMgmt.GetLastEventNumber(priority);
+        NL_TEST_ASSERT(apSuite, first > 1 && first < last);
+
+        // Event numbers and timestamps follow each priority, whatever the events of other priorities stored alongside.
+        for (chip::EventNumber start : { first, (first + last) / 2, last - 1, last })
+        {
+            chip::EventNumber eventNumber = start;
+            uint64_t timestamp            = 0;
+            NL_TEST_ASSERT(apSuite, FetchEvents(apSuite, priority, eventNumber, &testClusterInfo, timestamp) == last - start + 1);
+            NL_TEST_ASSERT(apSuite, eventNumber == last + 1);
+            NL_TEST_ASSERT(apSuite, timestamp == gEventTimestamps[static_cast<uint8_t>(priority)][start]);
+        }
+    }
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
 
 const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
-                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent), NL_TEST_SENTINEL() };
+                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+                          NL_TEST_DEF("CheckLogEventFailureLeavesNoTrace", CheckLogEventFailureLeavesNoTrace),
+                          NL_TEST_DEF("CheckFetchEventsSince", CheckFetchEventsSince),
+                          NL_TEST_SENTINEL() };
 } // namespace
 
 int TestEventLogging()
@@ -23,6 +23,7 @@
  */
 
 #include <app/InteractionModelEngine.h>
+#include <app/tests/SubscriptionTestHelpers.h>
 #include <core/CHIPCore.h>
 #include <core/CHIPTLV.h>
 #include <core/CHIPTLVDebug.hpp>
@@ -30,6 +31,7 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeMgr.h>
 #include <messaging/Flags.h>
+#include <messaging/tests/MessagingContext.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
 #include <protocols/secure_channel/PASESession.h>
@@ -39,9 +41,22 @@
 #include <system/TLVPacketBufferBackingStore.h>
 #include <transport/SecureSessionMgr.h>
 #include <transport/raw/UDP.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
 
 #include <nlunit-test.h>
 
+namespace {
+// Subscriptions are driven end to end over a loopback transport.
+chip::TransportMgrBase gLoopbackTransportManager;
+chip::Test::LoopbackTransport gLoopback;
+
+using TestContext = chip::Test::MessagingContext;
+TestContext sContext;
+
+// Upper bound for each step of a subscription over the loopback transport.
+constexpr uint32_t kSubscribeTimeoutMs = 1000;
+} // namespace
+
 namespace chip {
 System::Layer gSystemLayer;
 SecureSessionMgr gSessionManager;
@@ -62,6 +77,7 @@ public:
     static void TestReadClientGenerateTwoEventPathList(nlTestSuite * apSuite, void * apContext);
     static void TestReadClientInvalidReport(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandlerInvalidAttributePath(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeReport(nlTestSuite * apSuite, void * apContext);
 
 private:
     static void GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
@@ -429,6 +445,40 @@ void TestReadInteraction::TestReadClientGenerateTwoEventPathList(nlTestSuite * a
 #endif
 }
 
+void TestReadInteraction::TestSubscribeReport(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    CHIP_ERROR err                  = CHIP_NO_ERROR;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    chip::app::InteractionModelDelegate delegate;
+    Test::TestSubscriber subscriber(ctx.GetSystemLayer());
+
+    err = engine->Init(&ctx.GetExchangeManager(), &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = Test::Subscribe(ctx, subscriber, 0, 60000);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(kSubscribeTimeoutMs, [&subscriber] { return subscriber.mSubscribed; });
+    NL_TEST_ASSERT(apSuite, subscriber.mSubscribed);
+    NL_TEST_ASSERT(apSuite, subscriber.mNumReports == 1);
+
+    // A change of a subscribed path is reported.
+    Test::SetAttributeDirty(Test::kChangedFieldId);
+    ctx.DriveIOUntil(kSubscribeTimeoutMs, [&subscriber] { return subscriber.mNumReports == 2; });
+    NL_TEST_ASSERT(apSuite, subscriber.mNumReports == 2);
+
+    // Changes outside the subscribed paths do not trigger a report.
+    ReadHandler & readHandler = engine->mReadHandlers[0];
+    NL_TEST_ASSERT(apSuite, readHandler.IsSubscription() && !readHandler.IsDirty());
+    Test::SetAttributeDirty(Test::kOtherFieldId);
+    NL_TEST_ASSERT(apSuite, !readHandler.IsDirty());
+
+    Test::Unsubscribe(ctx);
+    engine->Shutdown();
+}
+
 } // namespace app
 } // namespace chip
 
@@ -443,8 +493,11 @@ void InitializeChip(nlTestSuite * apSuite)
 
     NL_TEST_ASSERT(apSuite, adminInfo != nullptr);
 
-    err = chip::Platform::MemoryInit();
+    // Initializes the platform memory as well.
+    gLoopbackTransportManager.Init(&gLoopback);
+    err = sContext.Init(apSuite, &gLoopbackTransportManager);
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    gLoopbackTransportManager.SetSecureSessionMgr(&sContext.GetSecureSessionManager());
 
     chip::gSystemLayer.Init(nullptr);
 
@@ -474,6 +527,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestReadClientGenerateTwoEventPathList", chip::app::TestReadInteraction::TestReadClientGenerateTwoEventPathList),
     NL_TEST_DEF("TestReadClientInvalidReport", chip::app::TestReadInteraction::TestReadClientInvalidReport),
     NL_TEST_DEF("TestReadHandlerInvalidAttributePath", chip::app::TestReadInteraction::TestReadHandlerInvalidAttributePath),
+    NL_TEST_DEF("TestSubscribeReport", chip::app::TestReadInteraction::TestSubscribeReport),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -494,7 +548,9 @@ int TestReadInteraction()
 
     InitializeChip(&theSuite);
 
-    nlTestRunner(&theSuite, nullptr);
+    nlTestRunner(&theSuite, &sContext);
+
+    sContext.Shutdown();
 
     return (nlTestRunnerStats(&theSuite));
 }
@@ -86,6 +86,7 @@ class TestReportingEngine
 {
 public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
+    static void TestBuildChunkedAttributeDataList(nlTestSuite * apSuite, void * apContext);
 };
 
 class TestExchangeDelegate : public Messaging::ExchangeDelegate
@@ -139,6 +140,101 @@ void TestReportingEngine::TestBuildAndSendSingleReportData(nlTestSuite * apSuite
     err = reportingEngine.BuildAndSendSingleReportData(&readHandler);
     NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_NOT_CONNECTED);
 }
+void TestReportingEngine::TestBuildChunkedAttributeDataList(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err             = CHIP_NO_ERROR;
+    constexpr size_t kNumPaths = 6;
+    app::ReadHandler readHandler;
+    Engine reportingEngine;
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequest::Builder readRequestBuilder;
+    AttributePathList::Builder attributePathListBuilder;
+
+    err = InteractionModelEngine::GetInstance()->Init(&gExchangeManager, nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    Messaging::ExchangeContext * exchangeCtx = gExchangeManager.NewContext({ 0, 0, 0 }, nullptr);
+    TestExchangeDelegate delegate;
+    exchangeCtx->SetDelegate(&delegate);
+
+    writer.Init(std::move(readRequestbuf));
+    err = readRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    attributePathListBuilder = readRequestBuilder.CreateAttributePathListBuilder();
+    for (size_t i = 0; i < kNumPaths; i++)
+    {
+        AttributePath::Builder attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
+        attributePathBuilder = attributePathBuilder.NodeId(1)
+                                   .EndpointId(kTestEndpointId)
+                                   .ClusterId(kTestClusterId)
+                                   .FieldId(kTestFieldId1)
+                                   .EndOfAttributePath();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    }
+    attributePathListBuilder.EndOfAttributePathList();
+    readRequestBuilder.EndOfReadRequest();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    err = writer.Finalize(&readRequestbuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    readHandler.OnReadRequest(exchangeCtx, std::move(readRequestbuf));
+    reportingEngine.Init();
+
+    // A buffer this small only holds a couple of attributes, so the paths are spread over several chunks,
+    // each picking up where the previous one stopped.
+    size_t numChunks   = 0;
+    size_t numReported = 0;
+    do
+    {
+        uint8_t buf[64];
+        TLV::TLVWriter reportWriter;
+        TLV::TLVReader reader;
+        TLV::TLVReader attributeDataListReader;
+        ReportData::Builder reportDataBuilder;
+        ReportData::Parser report;
+        AttributeDataList::Parser attributeDataList;
+
+        reportWriter.Init(buf, sizeof(buf));
+        err = reportDataBuilder.Init(&reportWriter);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        reportingEngine.mMoreChunkedMessages = false;
+        err = reportingEngine.BuildSingleReportDataAttributeDataList(reportDataBuilder, &readHandler);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        reportDataBuilder.EndOfReportData();
+        NL_TEST_ASSERT(apSuite, reportDataBuilder.GetError() == CHIP_NO_ERROR);
+
+        reader.Init(buf, reportWriter.GetLengthWritten());
+        NL_TEST_ASSERT(apSuite, reader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, report.Init(reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, report.GetAttributeDataList(&attributeDataList) == CHIP_NO_ERROR);
+        attributeDataList.GetReader(&attributeDataListReader);
+        while (attributeDataListReader.Next() == CHIP_NO_ERROR)
+        {
+            numReported++;
+        }
+        numChunks++;
+    } while (reportingEngine.mMoreChunkedMessages && numChunks <= kNumPaths);
+
+    NL_TEST_ASSERT(apSuite, numChunks > 1);
+    NL_TEST_ASSERT(apSuite, numReported == kNumPaths);
+    NL_TEST_ASSERT(apSuite, readHandler.GetAttributeClusterInfoCursor() == nullptr);
+
+    // An attribute that does not fit even in a chunk of its own fails the report rather than being left out.
+    readHandler.GetAttributeClusterInfolist()->SetDirty();
+    readHandler.SetAttributeClusterInfoCursor(readHandler.GetAttributeClusterInfolist());
+    {
+        uint8_t buf[16];
+        TLV::TLVWriter reportWriter;
+        ReportData::Builder reportDataBuilder;
+
+        reportWriter.Init(buf, sizeof(buf));
+        err = reportDataBuilder.Init(&reportWriter);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        reportingEngine.mMoreChunkedMessages = false;
+        err = reportingEngine.BuildSingleReportDataAttributeDataList(reportDataBuilder, &readHandler);
+        NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    }
+}
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -173,6 +269,7 @@ void InitializeChip(nlTestSuite * apSuite)
 const nlTest sTests[] =
         {
                 NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
+                NL_TEST_DEF("CheckBuildChunkedAttributeDataList", chip::app::reporting::TestReportingEngine::TestBuildChunkedAttributeDataList),
                 NL_TEST_SENTINEL()
         };
 // clang-format on
@@ -40,6 +40,7 @@
  ******************************************************************************/
 
 #include "app/util/common.h"
+#include <app/InteractionModelEngine.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 
@@ -115,6 +116,11 @@ const uint16_t attributeManufacturerCodeCount                   = GENERATED_ATTR
 // Returns endpoint index within a given cluster
 static uint16_t findClusterEndpointIndex(EndpointId endpoint, ClusterId clusterId, uint8_t mask, uint16_t manufacturerCode);
 
+// Rebuild the endpoint and attribute lookup indexes, or update them for one endpoint
+static void rebuildLookupIndex(void);
+static void addEndpointToLookupIndex(uint16_t index);
+static void removeEndpointFromLookupIndex(uint16_t index);
+
 #ifdef ZCL_USING_DESCRIPTOR_CLUSTER_SERVER
 void emberAfPluginDescriptorServerInitCallback(void);
 #endif
@@ -152,11 +158,19 @@ void emberAfEndpointConfigure(void)
                sizeof(EmberAfDefinedEndpoint) * (MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT));
     }
 #endif
+
+    rebuildLookupIndex();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
-    emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    uint16_t endpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+
+    if (emberEndpointCount != endpointCount)
+    {
+        emberEndpointCount = endpointCount;
+        rebuildLookupIndex();
+    }
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -191,6 +205,8 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, EmberAfEn
         }
     }
 
+    removeEndpointFromLookupIndex(index);
+
     emAfEndpoints[index].endpoint      = id;
     emAfEndpoints[index].deviceId      = deviceId;
     emAfEndpoints[index].deviceVersion = deviceVersion;
@@ -198,6 +214,7 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, EmberAfEn
     emAfEndpoints[index].networkIndex  = 0;
     emAfEndpoints[index].bitmask       = EMBER_AF_ENDPOINT_ENABLED;
 
+    addEndpointToLookupIndex(index);
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
     emberAfSetDeviceEnabled(id, true);
 
@@ -221,6 +238,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         if (ep)
         {
             emberAfSetDeviceEnabled(ep, false);
+            removeEndpointFromLookupIndex(index);
             emAfEndpoints[index].endpoint = 0;
             emAfEndpoints[index].bitmask  = 0;
         }
@@ -249,6 +267,449 @@ bool emberAfEndpointIndexIsEnabled(uint16_t index)
     return (emAfEndpoints[index].bitmask & EMBER_AF_ENDPOINT_ENABLED);
 }
 
+//------------------------------------------------------------------------------
+// Lookup index
+//
+// Endpoint ids, and the (endpoint, cluster, attribute, manufacturer code) of
+// every attribute on an enabled endpoint, are hashed into open-addressed
+// tables so that finding an attribute does not walk every endpoint, cluster
+// and attribute. Adding, removing, enabling or disabling an endpoint only
+// touches that endpoint's entries; the tables are rebuilt when the fixed
+// endpoints are configured and when the endpoint count changes. Whatever they
+// cannot answer exactly is left to the walk.
+
+// Smallest power of two that keeps a table with the given number of entries at
+// most half full.
+static constexpr uint32_t lookupTableSize(uint32_t entries, uint32_t size = 1)
+{
+    return (size >= 2 * entries) ? size : lookupTableSize(entries, 2 * size);
+}
+
+#define LOOKUP_SLOT_EMPTY 0xFFFF
+
+#ifdef MAX_ENDPOINT_COUNT
+#define ENDPOINT_INDEX_SIZE lookupTableSize(MAX_ENDPOINT_COUNT)
+#else
+#define ENDPOINT_INDEX_SIZE 1
+#endif
+
+// Set on an endpoint slot when the id appears again later in emAfEndpoints.
+// It may outlive the later endpoint, which only costs a walk.
+#define ENDPOINT_INDEX_DUPLICATE 0x8000
+
+// Index into emAfEndpoints of the first endpoint with a given id, or LOOKUP_SLOT_EMPTY.
+// Dynamic endpoint slots not in use (id 0) are left out.
+static uint16_t endpointIndexTable[ENDPOINT_INDEX_SIZE];
+static bool endpointIndexValid = false;
+
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+#define ATTRIBUTE_INDEX_SIZE lookupTableSize(EMBER_AF_ATTRIBUTE_INDEX_SIZE)
+
+typedef struct
+{
+    uint16_t endpointIndex; // LOOKUP_SLOT_EMPTY for an empty slot
+    uint16_t attributeIndex;
+    uint16_t storageOffset; // within attributeData, for attributes stored there
+    uint8_t clusterIndex;
+} AttributeIndexEntry;
+
+static AttributeIndexEntry attributeIndexTable[ATTRIBUTE_INDEX_SIZE];
+static bool attributeIndexValid = false;
+
+// Attributes on enabled endpoints, whether or not the table holds them
+static uint32_t attributeIndexCount = 0;
+#endif
+
+static uint32_t hashEndpointId(EndpointId endpoint)
+{
+    uint32_t hash = endpoint * 0x9E3779B1u;
+    return hash ^ (hash >> 16);
+}
+
+static uint32_t hashAttributeKey(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint16_t manufacturerCode)
+{
+    uint32_t hash = hashEndpointId(endpoint);
+    hash          = (hash ^ clusterId) * 0x01000193u;
+    hash          = (hash ^ attributeId) * 0x01000193u;
+    hash          = (hash ^ manufacturerCode) * 0x01000193u;
+    return hash ^ (hash >> 15);
+}
+
+static bool isEndpointSlotInUse(uint16_t index)
+{
+    return index < emberAfFixedEndpointCount() || emAfEndpoints[index].endpoint != 0;
+}
+
+static void insertEndpointIndexEntry(uint16_t index)
+{
+    EndpointId endpoint = emAfEndpoints[index].endpoint;
+    uint32_t slot       = hashEndpointId(endpoint) & (ENDPOINT_INDEX_SIZE - 1);
+
+    while (endpointIndexTable[slot] != LOOKUP_SLOT_EMPTY)
+    {
+        uint16_t other = static_cast<uint16_t>(endpointIndexTable[slot] & ~ENDPOINT_INDEX_DUPLICATE);
+        if (emAfEndpoints[other].endpoint == endpoint)
+        {
+            endpointIndexTable[slot] = static_cast<uint16_t>(((index < other) ? index : other) | ENDPOINT_INDEX_DUPLICATE);
+            return;
+        }
+        slot = (slot + 1) & (ENDPOINT_INDEX_SIZE - 1);
+    }
+
+    endpointIndexTable[slot] = index;
+}
+
+// Call before the id of the endpoint changes.
+static void removeEndpointIndexEntry(uint16_t index)
+{
+    EndpointId endpoint = emAfEndpoints[index].endpoint;
+    uint32_t hole       = hashEndpointId(endpoint) & (ENDPOINT_INDEX_SIZE - 1);
+    uint32_t next;
+    uint16_t i;
+
+    while (endpointIndexTable[hole] != LOOKUP_SLOT_EMPTY &&
+           emAfEndpoints[endpointIndexTable[hole] & ~ENDPOINT_INDEX_DUPLICATE].endpoint != endpoint)
+    {
+        hole = (hole + 1) & (ENDPOINT_INDEX_SIZE - 1);
+    }
+
+    // Not there, or the entry is for an earlier endpoint with the same id.
+    if (endpointIndexTable[hole] == LOOKUP_SLOT_EMPTY || (endpointIndexTable[hole] & ~ENDPOINT_INDEX_DUPLICATE) != index)
+    {
+        return;
+    }
+
+    if (endpointIndexTable[hole] & ENDPOINT_INDEX_DUPLICATE)
+    {
+        // The next endpoint with the id takes over the entry.
+        for (i = static_cast<uint16_t>(index + 1); i < emberAfEndpointCount(); i++)
+        {
+            if (emAfEndpoints[i].endpoint == endpoint && isEndpointSlotInUse(i))
+            {
+                endpointIndexTable[hole] = static_cast<uint16_t>(i | ENDPOINT_INDEX_DUPLICATE);
+                return;
+            }
+        }
+    }
+
+    // Move later entries of the probe sequence back into the hole, unless
+    // their hash comes after it, so that none is cut off by an empty slot.
+    for (next = (hole + 1) & (ENDPOINT_INDEX_SIZE - 1); endpointIndexTable[next] != LOOKUP_SLOT_EMPTY;
+         next = (next + 1) & (ENDPOINT_INDEX_SIZE - 1))
+    {
+        uint32_t home = hashEndpointId(emAfEndpoints[endpointIndexTable[next] & ~ENDPOINT_INDEX_DUPLICATE].endpoint) &
+            (ENDPOINT_INDEX_SIZE - 1);
+        if (((next - home) & (ENDPOINT_INDEX_SIZE - 1)) >= ((next - hole) & (ENDPOINT_INDEX_SIZE - 1)))
+        {
+            endpointIndexTable[hole] = endpointIndexTable[next];
+            hole                     = next;
+        }
+    }
+    endpointIndexTable[hole] = LOOKUP_SLOT_EMPTY;
+}
+
+static void rebuildEndpointIndex(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < ENDPOINT_INDEX_SIZE; i++)
+    {
+        endpointIndexTable[i] = LOOKUP_SLOT_EMPTY;
+    }
+
+    endpointIndexValid = (emberAfEndpointCount() <= ENDPOINT_INDEX_SIZE / 2);
+    if (!endpointIndexValid)
+    {
+        return;
+    }
+
+    for (i = 0; i < emberAfEndpointCount(); i++)
+    {
+        if (isEndpointSlotInUse(i))
+        {
+            insertEndpointIndexEntry(i);
+        }
+    }
+}
+
+// Returns the endpointIndexTable entry for the endpoint, or LOOKUP_SLOT_EMPTY
+static uint16_t lookupEndpointIndex(EndpointId endpoint)
+{
+    uint32_t slot = hashEndpointId(endpoint) & (ENDPOINT_INDEX_SIZE - 1);
+    while (endpointIndexTable[slot] != LOOKUP_SLOT_EMPTY)
+    {
+        if (emAfEndpoints[endpointIndexTable[slot] & ~ENDPOINT_INDEX_DUPLICATE].endpoint == endpoint)
+        {
+            return endpointIndexTable[slot];
+        }
+        slot = (slot + 1) & (ENDPOINT_INDEX_SIZE - 1);
+    }
+    return LOOKUP_SLOT_EMPTY;
+}
+
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+static uint32_t attributeIndexEntryHash(const AttributeIndexEntry * entry)
+{
+    EmberAfCluster * cluster      = &(emAfEndpoints[entry->endpointIndex].endpointType->cluster[entry->clusterIndex]);
+    EmberAfAttributeMetadata * am = &(cluster->attributes[entry->attributeIndex]);
+    return hashAttributeKey(emAfEndpoints[entry->endpointIndex].endpoint, cluster->clusterId, am->attributeId,
+                            emAfGetManufacturerCodeForAttribute(cluster, am));
+}
+
+static bool insertAttributeIndexEntry(uint16_t endpointIndex, uint8_t clusterIndex, uint16_t attributeIndex,
+                                      uint16_t storageOffset)
+{
+    AttributeIndexEntry newEntry = { endpointIndex, attributeIndex, storageOffset, clusterIndex };
+    uint32_t slot                = attributeIndexEntryHash(&newEntry) & (ATTRIBUTE_INDEX_SIZE - 1);
+    uint32_t probes;
+
+    for (probes = 0; probes < ATTRIBUTE_INDEX_SIZE; probes++)
+    {
+        if (attributeIndexTable[slot].endpointIndex == LOOKUP_SLOT_EMPTY)
+        {
+            attributeIndexTable[slot] = newEntry;
+            return true;
+        }
+        slot = (slot + 1) & (ATTRIBUTE_INDEX_SIZE - 1);
+    }
+    return false;
+}
+
+static void removeAttributeIndexEntry(uint16_t endpointIndex, uint8_t clusterIndex, uint16_t attributeIndex)
+{
+    AttributeIndexEntry key = { endpointIndex, attributeIndex, 0, clusterIndex };
+    uint32_t hole           = attributeIndexEntryHash(&key) & (ATTRIBUTE_INDEX_SIZE - 1);
+    uint32_t next;
+
+    while (attributeIndexTable[hole].endpointIndex != endpointIndex || attributeIndexTable[hole].clusterIndex != clusterIndex ||
+           attributeIndexTable[hole].attributeIndex != attributeIndex)
+    {
+        if (attributeIndexTable[hole].endpointIndex == LOOKUP_SLOT_EMPTY)
+        {
+            return;
+        }
+        hole = (hole + 1) & (ATTRIBUTE_INDEX_SIZE - 1);
+    }
+
+    // Move later entries of the probe sequence back into the hole, unless
+    // their hash comes after it, so that none is cut off by an empty slot.
+    for (next = (hole + 1) & (ATTRIBUTE_INDEX_SIZE - 1); attributeIndexTable[next].endpointIndex != LOOKUP_SLOT_EMPTY;
+         next = (next + 1) & (ATTRIBUTE_INDEX_SIZE - 1))
+    {
+        uint32_t home = attributeIndexEntryHash(&attributeIndexTable[next]) & (ATTRIBUTE_INDEX_SIZE - 1);
+        if (((next - home) & (ATTRIBUTE_INDEX_SIZE - 1)) >= ((next - hole) & (ATTRIBUTE_INDEX_SIZE - 1)))
+        {
+            attributeIndexTable[hole] = attributeIndexTable[next];
+            hole                      = next;
+        }
+    }
+    attributeIndexTable[hole].endpointIndex = LOOKUP_SLOT_EMPTY;
+}
+
+static uint32_t endpointAttributeCount(uint16_t endpointIndex)
+{
+    EmberAfEndpointType * endpointType = emAfEndpoints[endpointIndex].endpointType;
+    uint32_t count                     = 0;
+    uint8_t clusterIndex;
+
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        count += endpointType->cluster[clusterIndex].attributeCount;
+    }
+    return count;
+}
+
+// Adds the attributes of an endpoint that was just enabled or added.
+static void indexEndpointAttributes(uint16_t endpointIndex)
+{
+    EmberAfEndpointType * endpointType = emAfEndpoints[endpointIndex].endpointType;
+    uint16_t clusterOffset             = 0;
+    uint16_t i;
+    uint8_t clusterIndex;
+
+    attributeIndexCount += endpointAttributeCount(endpointIndex);
+    if (attributeIndexCount > EMBER_AF_ATTRIBUTE_INDEX_SIZE)
+    {
+        // Too many attributes; leave every lookup to the walk until some go away.
+        attributeIndexValid = false;
+    }
+    if (!attributeIndexValid)
+    {
+        return;
+    }
+
+    // Dynamic endpoints are external and don't factor into storage size
+    for (i = 0; i < endpointIndex && i < emberAfFixedEndpointCount(); i++)
+    {
+        clusterOffset = static_cast<uint16_t>(clusterOffset + emAfEndpoints[i].endpointType->endpointSize);
+    }
+
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+        uint16_t attributeOffset = clusterOffset;
+        uint16_t attrIndex;
+        for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+        {
+            EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+            insertAttributeIndexEntry(endpointIndex, clusterIndex, attrIndex, attributeOffset);
+            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+            {
+                attributeOffset = static_cast<uint16_t>(attributeOffset + emberAfAttributeSize(am));
+            }
+        }
+        clusterOffset = static_cast<uint16_t>(clusterOffset + cluster->clusterSize);
+    }
+}
+
+// Removes the attributes of an endpoint that is being disabled or removed.
+// Call before its id or type changes.
+static void unindexEndpointAttributes(uint16_t endpointIndex)
+{
+    EmberAfEndpointType * endpointType = emAfEndpoints[endpointIndex].endpointType;
+    uint8_t clusterIndex;
+
+    attributeIndexCount -= endpointAttributeCount(endpointIndex);
+    if (!attributeIndexValid)
+    {
+        return;
+    }
+
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        uint16_t attrIndex;
+        for (attrIndex = 0; attrIndex < endpointType->cluster[clusterIndex].attributeCount; attrIndex++)
+        {
+            removeAttributeIndexEntry(endpointIndex, clusterIndex, attrIndex);
+        }
+    }
+}
+
+static void rebuildAttributeIndex(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < ATTRIBUTE_INDEX_SIZE; i++)
+    {
+        attributeIndexTable[i].endpointIndex = LOOKUP_SLOT_EMPTY;
+    }
+    attributeIndexValid = true;
+    attributeIndexCount = 0;
+
+    for (i = 0; i < emberAfEndpointCount(); i++)
+    {
+        if (emberAfEndpointIndexIsEnabled(i))
+        {
+            indexEndpointAttributes(i);
+        }
+    }
+}
+
+// Finds the attribute the walk in findAttributeByWalk would. Among the indexed
+// attributes that match (client and server, or several instances of a
+// cluster on one endpoint), that is the one that comes first in the table.
+static bool findAttributeInIndex(EmberAfAttributeSearchRecord * attRecord, EmberAfCluster ** foundCluster,
+                                 EmberAfAttributeMetadata ** foundAttribute, uint16_t * storageOffset)
+{
+    const AttributeIndexEntry * best = NULL;
+    uint32_t slot =
+        hashAttributeKey(attRecord->endpoint, attRecord->clusterId, attRecord->attributeId, attRecord->manufacturerCode) &
+        (ATTRIBUTE_INDEX_SIZE - 1);
+    uint32_t probes;
+
+    for (probes = 0; probes < ATTRIBUTE_INDEX_SIZE && attributeIndexTable[slot].endpointIndex != LOOKUP_SLOT_EMPTY; probes++)
+    {
+        const AttributeIndexEntry * entry        = &attributeIndexTable[slot];
+        EmberAfDefinedEndpoint * definedEndpoint = &emAfEndpoints[entry->endpointIndex];
+        EmberAfCluster * cluster                 = &(definedEndpoint->endpointType->cluster[entry->clusterIndex]);
+        EmberAfAttributeMetadata * am            = &(cluster->attributes[entry->attributeIndex]);
+
+        if (definedEndpoint->endpoint == attRecord->endpoint && emAfMatchCluster(cluster, attRecord) &&
+            emAfMatchAttribute(cluster, am, attRecord))
+        {
+            if (best == NULL || entry->endpointIndex < best->endpointIndex ||
+                (entry->endpointIndex == best->endpointIndex &&
+                 (entry->clusterIndex < best->clusterIndex ||
+                  (entry->clusterIndex == best->clusterIndex && entry->attributeIndex < best->attributeIndex))))
+            {
+                best = entry;
+            }
+        }
+        slot = (slot + 1) & (ATTRIBUTE_INDEX_SIZE - 1);
+    }
+
+    if (best == NULL)
+    {
+        return false;
+    }
+
+    *foundCluster   = &(emAfEndpoints[best->endpointIndex].endpointType->cluster[best->clusterIndex]);
+    *foundAttribute = &((*foundCluster)->attributes[best->attributeIndex]);
+    *storageOffset  = best->storageOffset;
+    return true;
+}
+#endif // EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+
+bool emAfAttributeLookupIsIndexed(void)
+{
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+    // Once enough attributes went away, the table is filled again.
+    if (!attributeIndexValid && attributeIndexCount <= EMBER_AF_ATTRIBUTE_INDEX_SIZE)
+    {
+        rebuildAttributeIndex();
+    }
+    return attributeIndexValid;
+#else
+    return false;
+#endif
+}
+
+static void rebuildLookupIndex(void)
+{
+    rebuildEndpointIndex();
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+    rebuildAttributeIndex();
+#endif
+}
+
+static void addEndpointToLookupIndex(uint16_t index)
+{
+    if (index >= emberAfEndpointCount())
+    {
+        return;
+    }
+
+    if (endpointIndexValid && isEndpointSlotInUse(index))
+    {
+        insertEndpointIndexEntry(index);
+    }
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+    if (emberAfEndpointIndexIsEnabled(index))
+    {
+        indexEndpointAttributes(index);
+    }
+#endif
+}
+
+static void removeEndpointFromLookupIndex(uint16_t index)
+{
+    if (index >= emberAfEndpointCount())
+    {
+        return;
+    }
+
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+    if (emberAfEndpointIndexIsEnabled(index))
+    {
+        unindexEndpointAttributes(index);
+    }
+#endif
+    if (endpointIndexValid && isEndpointSlotInUse(index))
+    {
+        removeEndpointIndexEntry(index);
+    }
+}
+
 // some data types (like strings) are sent OTA in human readable order
 // (how they are read) instead of little endian as the data types are.
 bool emberAfIsThisDataTypeAStringType(EmberAfAttributeType dataType)
@@ -336,6 +797,11 @@ void emberAfClusterMessageSentCallback(const MessageSendDestination & destinatio
 void emAfClusterAttributeChangedCallback(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId,
                                          uint8_t clientServerMask, uint16_t manufacturerCode)
 {
+    if (clientServerMask == CLUSTER_MASK_SERVER)
+    {
+        app::InteractionModelReportingAttributeChangeCallback(endpoint, clusterId, attributeId);
+    }
+
     EmberAfCluster * cluster = emberAfFindClusterWithMfgCode(endpoint, clusterId, clientServerMask, manufacturerCode);
     if (cluster != NULL)
     {
@@ -593,21 +1059,10 @@ bool emAfMatchAttribute(EmberAfCluster * cluster, EmberAfAttributeMetadata * am,
              (emAfGetManufacturerCodeForAttribute(cluster, am) == attRecord->manufacturerCode)));
 }
 
-// When reading non-string attributes, this function returns an error when destination
-// buffer isn't large enough to accommodate the attribute type.  For strings, the
-// function will copy at most readLength bytes.  This means the resulting string
-// may be truncated.  The length byte(s) in the resulting string will reflect
-// any truncation.  If readLength is zero, we are working with backwards-
-// compatibility wrapper functions and we just cross our fingers and hope for
-// the best.
-//
-// When writing attributes, readLength is ignored.  For non-string attributes,
-// this function assumes the source buffer is the same size as the attribute
-// type.  For strings, the function will copy as many bytes as will fit in the
-// attribute.  This means the resulting string may be truncated.  The length
-// byte(s) in the resulting string will reflect any truncated.
-EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord, EmberAfAttributeMetadata ** metadata,
-                                       uint8_t * buffer, uint16_t readLength, bool write, int32_t index)
+// Finds an attribute by walking every enabled endpoint, cluster and attribute,
+// adding up the storage of the ones that come before it on the way.
+static bool findAttributeByWalk(EmberAfAttributeSearchRecord * attRecord, EmberAfCluster ** foundCluster,
+                                EmberAfAttributeMetadata ** foundAttribute, uint16_t * storageOffset)
 {
     uint8_t i;
     uint16_t attributeOffsetIndex = 0;
@@ -633,55 +1088,10 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
                         EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
                         if (emAfMatchAttribute(cluster, am, attRecord))
                         { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != NULL)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             emAfGetManufacturerCodeForAttribute(cluster, am),
-                                                                             am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == NULL)
-                                    {
-                                        return EMBER_ZCL_STATUS_SUCCESS;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            emAfGetManufacturerCodeForAttribute(cluster, am),
-                                                                            am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-
-                                return (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE
-                                            ? (write) ? emberAfExternalAttributeWriteCallback(
-                                                            attRecord->endpoint, attRecord->clusterId, am,
-                                                            emAfGetManufacturerCodeForAttribute(cluster, am), buffer, index)
-                                                      : emberAfExternalAttributeReadCallback(
-                                                            attRecord->endpoint, attRecord->clusterId, am,
-                                                            emAfGetManufacturerCodeForAttribute(cluster, am), buffer,
-                                                            emberAfAttributeSize(am), index)
-                                            : typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength, index));
-                            }
+                            *foundCluster   = cluster;
+                            *foundAttribute = am;
+                            *storageOffset  = attributeOffsetIndex;
+                            return true;
                         }
                         else
                         { // Not the attribute we are looking for
@@ -708,7 +1118,88 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
             }
         }
     }
-    return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE; // Sorry, attribute was not found.
+    return false;
+}
+
+// When reading non-string attributes, this function returns an error when destination
+// buffer isn't large enough to accommodate the attribute type.  For strings, the
+// function will copy at most readLength bytes.  This means the resulting string
+// may be truncated.  The length byte(s) in the resulting string will reflect
+// any truncation.  If readLength is zero, we are working with backwards-
+// compatibility wrapper functions and we just cross our fingers and hope for
+// the best.
+//
+// When writing attributes, readLength is ignored.  For non-string attributes,
+// this function assumes the source buffer is the same size as the attribute
+// type.  For strings, the function will copy as many bytes as will fit in the
+// attribute.  This means the resulting string may be truncated.  The length
+// byte(s) in the resulting string will reflect any truncated.
+EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord, EmberAfAttributeMetadata ** metadata,
+                                       uint8_t * buffer, uint16_t readLength, bool write, int32_t index)
+{
+    EmberAfCluster * cluster;
+    EmberAfAttributeMetadata * am;
+    uint16_t attributeOffsetIndex;
+    bool found;
+
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+    if (emAfAttributeLookupIsIndexed())
+    {
+        found = findAttributeInIndex(attRecord, &cluster, &am, &attributeOffsetIndex);
+    }
+    else
+#endif
+    {
+        found = findAttributeByWalk(attRecord, &cluster, &am, &attributeOffsetIndex);
+    }
+
+    if (!found)
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE; // Sorry, attribute was not found.
+    }
+
+    // If passed metadata location is not null, populate
+    if (metadata != NULL)
+    {
+        *metadata = am;
+    }
+
+    uint8_t * attributeLocation =
+        (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : attributeData + attributeOffsetIndex);
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
+                                                 emAfGetManufacturerCodeForAttribute(cluster, am), am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+        }
+    }
+    else
+    {
+        if (buffer == NULL)
+        {
+            return EMBER_ZCL_STATUS_SUCCESS;
+        }
+
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
+                                                emAfGetManufacturerCodeForAttribute(cluster, am), am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+        }
+    }
+
+    return (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE
+                ? (write) ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                  emAfGetManufacturerCodeForAttribute(cluster, am), buffer, index)
+                          : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                 emAfGetManufacturerCodeForAttribute(cluster, am), buffer,
+                                                                 emberAfAttributeSize(am), index)
+                : typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength, index));
 }
 
 // Check if a cluster is implemented or not. If yes, the cluster is returned.
@@ -877,6 +1368,12 @@ uint16_t emberAfFindClusterClientEndpointIndex(EndpointId endpoint, ClusterId cl
 }
 
 // Returns the endpoint index within a given cluster
+//
+// This is not in the lookup index: it counts the endpoints before this one
+// that have the cluster, so adding, removing or enabling one endpoint would
+// change it for every endpoint after it. Cluster servers use it to find their
+// per-endpoint state when handling a command or tick, not for every attribute
+// access, and each step of the scan below finds its endpoint through the index.
 static uint16_t findClusterEndpointIndex(EndpointId endpoint, ClusterId clusterId, uint8_t mask, uint16_t manufacturerCode)
 {
     uint16_t i, epi = 0;
@@ -905,6 +1402,30 @@ static uint16_t findClusterEndpointIndex(EndpointId endpoint, ClusterId clusterI
 static uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
     uint16_t epi;
+
+    if (endpointIndexValid)
+    {
+        uint16_t entry = lookupEndpointIndex(endpoint);
+        if (entry != LOOKUP_SLOT_EMPTY)
+        {
+            epi = static_cast<uint16_t>(entry & ~ENDPOINT_INDEX_DUPLICATE);
+            if (!ignoreDisabledEndpoints || emberAfEndpointIndexIsEnabled(epi))
+            {
+                return epi;
+            }
+            if (!(entry & ENDPOINT_INDEX_DUPLICATE))
+            {
+                return 0xFFFF;
+            }
+            // A later endpoint with the same id may be enabled; walk to find it.
+        }
+        else if (endpoint != 0)
+        {
+            return 0xFFFF;
+        }
+        // Unused dynamic endpoint slots have id 0 but are not indexed; walk to find them.
+    }
+
     for (epi = 0; epi < emberAfEndpointCount(); epi++)
     {
         if (emAfEndpoints[epi].endpoint == endpoint &&
@@ -959,6 +1480,17 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
 
     if (currentlyEnabled != enable)
     {
+#if EMBER_AF_ATTRIBUTE_INDEX_SIZE > 0
+        if (enable)
+        {
+            indexEndpointAttributes(index);
+        }
+        else
+        {
+            unindexEndpointAttributes(index);
+        }
+#endif
+
         if (enable)
         {
             initializeEndpoint(&(emAfEndpoints[index]));
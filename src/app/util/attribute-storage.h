@@ -72,6 +72,26 @@
 #endif
 #endif
 
+// Number of attribute instances, over all enabled endpoints, that the
+// attribute lookup index can hold. Dynamic endpoints are budgeted at
+// EMBER_AF_ATTRIBUTE_INDEX_DYNAMIC_ENDPOINT_ATTRIBUTES each. While the data
+// model holds more attributes than this, attributes are found by walking the
+// endpoint table instead. 0 disables the index.
+#ifndef EMBER_AF_ATTRIBUTE_INDEX_DYNAMIC_ENDPOINT_ATTRIBUTES
+#define EMBER_AF_ATTRIBUTE_INDEX_DYNAMIC_ENDPOINT_ATTRIBUTES 16
+#endif
+
+#ifndef EMBER_AF_ATTRIBUTE_INDEX_SIZE
+#if defined(GENERATED_ATTRIBUTE_COUNT) && defined(DYNAMIC_ENDPOINT_COUNT)
+#define EMBER_AF_ATTRIBUTE_INDEX_SIZE                                                                                              \
+    (GENERATED_ATTRIBUTE_COUNT + DYNAMIC_ENDPOINT_COUNT * EMBER_AF_ATTRIBUTE_INDEX_DYNAMIC_ENDPOINT_ATTRIBUTES)
+#elif defined(GENERATED_ATTRIBUTE_COUNT)
+#define EMBER_AF_ATTRIBUTE_INDEX_SIZE GENERATED_ATTRIBUTE_COUNT
+#else
+#define EMBER_AF_ATTRIBUTE_INDEX_SIZE 0
+#endif
+#endif
+
 #include <app/common/gen/attribute-type.h>
 
 #define DECLARE_DYNAMIC_ENDPOINT(endpointName, clusterList)                                                                        \
@@ -128,6 +148,11 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
 bool emAfMatchCluster(EmberAfCluster * cluster, EmberAfAttributeSearchRecord * attRecord);
 bool emAfMatchAttribute(EmberAfCluster * cluster, EmberAfAttributeMetadata * am, EmberAfAttributeSearchRecord * attRecord);
 
+// Whether attributes are currently found through the lookup index, rather
+// than by walking the endpoint table because there are more than
+// EMBER_AF_ATTRIBUTE_INDEX_SIZE of them.
+bool emAfAttributeLookupIsIndexed(void);
+
 EmberAfCluster * emberAfFindClusterInTypeWithMfgCode(EmberAfEndpointType * endpointType, chip::ClusterId clusterId,
                                                      EmberAfClusterMask mask, uint16_t manufacturerCode);
 
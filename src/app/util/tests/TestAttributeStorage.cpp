@@ -0,0 +1,351 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the attribute and
+ *      endpoint lookups of attribute-storage, over the data model in
+ *      gen/endpoint_config.h and dynamic endpoints added at run time.
+ *
+ */
+
+#include <app/common/gen/callback.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr ClusterId kBasicClusterId = 0x0028;
+constexpr ClusterId kOnOffClusterId = 0x0006;
+
+constexpr EndpointId kFirstDynamicEndpoint = 10;
+
+// Dynamic endpoints with an On/off server of three attributes, more than the
+// EMBER_AF_ATTRIBUTE_INDEX_DYNAMIC_ENDPOINT_ATTRIBUTES budgeted for them.
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(onOffAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(0x0000, BOOLEAN, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE(0x4000, BOOLEAN, 1, 0)
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END(4);
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(onOffClusters)
+DECLARE_DYNAMIC_CLUSTER(kOnOffClusterId, onOffAttrs) DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(onOffEndpoint, onOffClusters);
+
+// The endpoint and attribute of the last external attribute read
+EndpointId sExternalEndpoint;
+AttributeId sExternalAttribute;
+
+EmberAfStatus ReadAttribute(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint8_t * buffer, uint16_t size)
+{
+    EmberAfAttributeSearchRecord record = { endpoint, clusterId, CLUSTER_MASK_SERVER, attributeId,
+                                            EMBER_AF_NULL_MANUFACTURER_CODE };
+    return emAfReadOrWriteAttribute(&record, nullptr, buffer, size, false);
+}
+
+EmberAfStatus WriteAttribute(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint8_t * buffer)
+{
+    EmberAfAttributeSearchRecord record = { endpoint, clusterId, CLUSTER_MASK_SERVER, attributeId,
+                                            EMBER_AF_NULL_MANUFACTURER_CODE };
+    return emAfReadOrWriteAttribute(&record, nullptr, buffer, 0, true);
+}
+
+// Writes a distinct value to every fixed attribute, so that reading them back
+// shows each has its own storage.
+void WriteFixedAttributes(nlTestSuite * inSuite)
+{
+    uint8_t basic0        = 0x11;
+    uint16_t basic1       = 0x2233;
+    uint16_t basicVersion = 0x4455;
+    uint8_t onOff         = 1;
+    uint16_t onOffVersion = 0x6677;
+
+    NL_TEST_ASSERT(inSuite, WriteAttribute(0, kBasicClusterId, 0x0000, &basic0) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   WriteAttribute(0, kBasicClusterId, 0x0001, reinterpret_cast<uint8_t *>(&basic1)) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   WriteAttribute(0, kBasicClusterId, 0xFFFD, reinterpret_cast<uint8_t *>(&basicVersion)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, WriteAttribute(1, kOnOffClusterId, 0x0000, &onOff) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   WriteAttribute(1, kOnOffClusterId, 0xFFFD, reinterpret_cast<uint8_t *>(&onOffVersion)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+}
+
+void CheckFixedAttributes(nlTestSuite * inSuite)
+{
+    uint8_t basic0        = 0;
+    uint16_t basic1       = 0;
+    uint16_t basicVersion = 0;
+    uint8_t onOff         = 0;
+    uint16_t onOffVersion = 0;
+
+    NL_TEST_ASSERT(inSuite, ReadAttribute(0, kBasicClusterId, 0x0000, &basic0, sizeof(basic0)) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   ReadAttribute(0, kBasicClusterId, 0x0001, reinterpret_cast<uint8_t *>(&basic1), sizeof(basic1)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   ReadAttribute(0, kBasicClusterId, 0xFFFD, reinterpret_cast<uint8_t *>(&basicVersion), sizeof(basicVersion)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, ReadAttribute(1, kOnOffClusterId, 0x0000, &onOff, sizeof(onOff)) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   ReadAttribute(1, kOnOffClusterId, 0xFFFD, reinterpret_cast<uint8_t *>(&onOffVersion), sizeof(onOffVersion)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+
+    NL_TEST_ASSERT(inSuite, basic0 == 0x11 && basic1 == 0x2233 && basicVersion == 0x4455);
+    NL_TEST_ASSERT(inSuite, onOff == 1 && onOffVersion == 0x6677);
+
+    // Present elsewhere, but not on these endpoints.
+    NL_TEST_ASSERT(inSuite, ReadAttribute(1, kBasicClusterId, 0x0000, &basic0, sizeof(basic0)) ==
+                       EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE);
+    NL_TEST_ASSERT(inSuite, ReadAttribute(0, kOnOffClusterId, 0x0000, &onOff, sizeof(onOff)) ==
+                       EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE);
+}
+
+// Checks that the dynamic endpoint is found, and that reading its attribute
+// reaches the external storage for that endpoint.
+bool IsDynamicEndpointFound(uint16_t index, EndpointId endpoint)
+{
+    uint8_t value = 0;
+
+    sExternalEndpoint  = 0xFFFF;
+    sExternalAttribute = 0;
+    if (ReadAttribute(endpoint, kOnOffClusterId, 0x4000, &value, sizeof(value)) != EMBER_ZCL_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    return sExternalEndpoint == endpoint && sExternalAttribute == 0x4000 &&
+        emberAfIndexFromEndpoint(endpoint) == emberAfFixedEndpointCount() + index &&
+        emberAfGetDynamicIndexFromEndpoint(endpoint) == index;
+}
+
+bool IsEndpointGone(EndpointId endpoint)
+{
+    uint8_t value = 0;
+
+    return ReadAttribute(endpoint, kOnOffClusterId, 0x4000, &value, sizeof(value)) == EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE &&
+        emberAfIndexFromEndpoint(endpoint) == 0xFFFF;
+}
+
+void TestFixedEndpoints(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, emAfAttributeLookupIsIndexed());
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(0) == 0);
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(1) == 1);
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(2) == 0xFFFF);
+
+    WriteFixedAttributes(inSuite);
+    CheckFixedAttributes(inSuite);
+
+    // A disabled endpoint keeps its index, but its attributes are not found.
+    uint8_t onOff = 0;
+    NL_TEST_ASSERT(inSuite, emberAfEndpointEnableDisable(1, false));
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(1) == 0xFFFF);
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpointIncludingDisabledEndpoints(1) == 1);
+    NL_TEST_ASSERT(inSuite, ReadAttribute(1, kOnOffClusterId, 0x0000, &onOff, sizeof(onOff)) ==
+                       EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE);
+
+    NL_TEST_ASSERT(inSuite, emberAfEndpointEnableDisable(1, true));
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(1) == 1);
+    WriteFixedAttributes(inSuite);
+    CheckFixedAttributes(inSuite);
+}
+
+void TestDynamicEndpoints(nlTestSuite * inSuite, void * inContext)
+{
+    WriteFixedAttributes(inSuite);
+
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint));
+    NL_TEST_ASSERT(inSuite, emberAfSetDynamicEndpoint(0, kFirstDynamicEndpoint, &onOffEndpoint, 0, 1) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   emberAfSetDynamicEndpoint(1, kFirstDynamicEndpoint + 1, &onOffEndpoint, 0, 1) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emAfAttributeLookupIsIndexed());
+    NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(0, kFirstDynamicEndpoint));
+    NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(1, kFirstDynamicEndpoint + 1));
+    CheckFixedAttributes(inSuite);
+
+    // Ids are unique among dynamic endpoints.
+    NL_TEST_ASSERT(inSuite,
+                   emberAfSetDynamicEndpoint(2, kFirstDynamicEndpoint, &onOffEndpoint, 0, 1) == EMBER_ZCL_STATUS_DUPLICATE_EXISTS);
+
+    NL_TEST_ASSERT(inSuite, emberAfClearDynamicEndpoint(0) == kFirstDynamicEndpoint);
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint));
+    NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(1, kFirstDynamicEndpoint + 1));
+    CheckFixedAttributes(inSuite);
+
+    // The slot is reused for another endpoint.
+    NL_TEST_ASSERT(inSuite,
+                   emberAfSetDynamicEndpoint(0, kFirstDynamicEndpoint + 2, &onOffEndpoint, 0, 1) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint));
+    NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(0, kFirstDynamicEndpoint + 2));
+    NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(1, kFirstDynamicEndpoint + 1));
+
+    // A disabled dynamic endpoint is found again once enabled.
+    NL_TEST_ASSERT(inSuite, emberAfEndpointEnableDisable(kFirstDynamicEndpoint + 1, false));
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint + 1));
+    NL_TEST_ASSERT(inSuite, emberAfEndpointEnableDisable(kFirstDynamicEndpoint + 1, true));
+    NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(1, kFirstDynamicEndpoint + 1));
+
+    NL_TEST_ASSERT(inSuite, emberAfClearDynamicEndpoint(0) == kFirstDynamicEndpoint + 2);
+    NL_TEST_ASSERT(inSuite, emberAfClearDynamicEndpoint(1) == kFirstDynamicEndpoint + 1);
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint + 1));
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint + 2));
+    CheckFixedAttributes(inSuite);
+}
+
+void TestOverBudget(nlTestSuite * inSuite, void * inContext)
+{
+    uint16_t i;
+
+    WriteFixedAttributes(inSuite);
+
+    // Every dynamic endpoint goes over its budget, so with all of them the
+    // attributes no longer fit and are found by walking the endpoint table.
+    for (i = 0; i < DYNAMIC_ENDPOINT_COUNT; i++)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       emberAfSetDynamicEndpoint(i, static_cast<EndpointId>(kFirstDynamicEndpoint + i), &onOffEndpoint, 0, 1) ==
+                           EMBER_ZCL_STATUS_SUCCESS);
+    }
+    NL_TEST_ASSERT(inSuite, !emAfAttributeLookupIsIndexed());
+
+    for (i = 0; i < DYNAMIC_ENDPOINT_COUNT; i++)
+    {
+        NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(i, static_cast<EndpointId>(kFirstDynamicEndpoint + i)));
+    }
+    CheckFixedAttributes(inSuite);
+
+    NL_TEST_ASSERT(inSuite, emberAfEndpointEnableDisable(kFirstDynamicEndpoint, false));
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint));
+
+    // Once enough endpoints are gone, the attributes are indexed again.
+    for (i = 1; i < DYNAMIC_ENDPOINT_COUNT / 2; i++)
+    {
+        NL_TEST_ASSERT(inSuite, emberAfClearDynamicEndpoint(i) == kFirstDynamicEndpoint + i);
+    }
+    NL_TEST_ASSERT(inSuite, emAfAttributeLookupIsIndexed());
+
+    NL_TEST_ASSERT(inSuite, IsEndpointGone(kFirstDynamicEndpoint));
+    for (i = DYNAMIC_ENDPOINT_COUNT / 2; i < DYNAMIC_ENDPOINT_COUNT; i++)
+    {
+        NL_TEST_ASSERT(inSuite, IsDynamicEndpointFound(i, static_cast<EndpointId>(kFirstDynamicEndpoint + i)));
+    }
+    CheckFixedAttributes(inSuite);
+}
+
+// Each test starts from the fixed endpoints alone.
+int TestInitialize(void * inContext)
+{
+    emberAfEndpointConfigure();
+    return SUCCESS;
+}
+
+} // namespace
+
+EmberAfStatus emberAfExternalAttributeReadCallback(EndpointId endpoint, ClusterId clusterId,
+                                                   EmberAfAttributeMetadata * attributeMetadata, uint16_t manufacturerCode,
+                                                   uint8_t * buffer, uint16_t maxReadLength, int32_t index)
+{
+    sExternalEndpoint  = endpoint;
+    sExternalAttribute = attributeMetadata->attributeId;
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+EmberAfStatus emberAfExternalAttributeWriteCallback(EndpointId endpoint, ClusterId clusterId,
+                                                    EmberAfAttributeMetadata * attributeMetadata, uint16_t manufacturerCode,
+                                                    uint8_t * buffer, int32_t index)
+{
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+// The rest of the data model is not part of these tests.
+bool emberAfAttributeReadAccessCallback(EndpointId endpoint, ClusterId clusterId, uint16_t manufacturerCode,
+                                        AttributeId attributeId)
+{
+    return true;
+}
+
+bool emberAfAttributeWriteAccessCallback(EndpointId endpoint, ClusterId clusterId, uint16_t manufacturerCode,
+                                         AttributeId attributeId)
+{
+    return true;
+}
+
+void emberAfClusterInitCallback(EndpointId endpoint, ClusterId clusterId) {}
+
+void emberAfSetDeviceEnabled(EndpointId endpoint, bool enabled) {}
+
+EmberStatus emberAfDeactivateClusterTick(EndpointId endpoint, ClusterId clusterId, bool isClient)
+{
+    return EMBER_SUCCESS;
+}
+
+void emberAfCopyString(uint8_t * dest, const uint8_t * src, size_t size) {}
+
+void emberAfCopyLongString(uint8_t * dest, const uint8_t * src, size_t size) {}
+
+uint16_t emberAfCopyList(ClusterId clusterId, EmberAfAttributeMetadata * am, bool write, uint8_t * dest, uint8_t * src,
+                         int32_t index)
+{
+    return 0;
+}
+
+namespace chip {
+namespace app {
+void InteractionModelReportingAttributeChangeCallback(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) {}
+} // namespace app
+} // namespace chip
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestFixedEndpoints", TestFixedEndpoints),
+    NL_TEST_DEF("TestDynamicEndpoints", TestDynamicEndpoints),
+    NL_TEST_DEF("TestOverBudget", TestOverBudget),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestAttributeStorage()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "AttributeStorage",
+        &sTests[0],
+        nullptr,
+        nullptr,
+        TestInitialize,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeStorage)
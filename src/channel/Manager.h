@@ -83,8 +83,13 @@ public:
     }
 
 private:
+#if CHIP_CONFIG_POOL_USE_HEAP
+    HeapObjectPool<ChannelContext> mChannelContexts;
+    HeapObjectPool<ChannelContextHandleAssociation> mChannelHandles;
+#else
     BitMapObjectPool<ChannelContext, CHIP_CONFIG_MAX_ACTIVE_CHANNELS> mChannelContexts;
     BitMapObjectPool<ChannelContextHandleAssociation, CHIP_CONFIG_MAX_CHANNEL_HANDLES> mChannelHandles;
+#endif
     ExchangeManager * mExchangeManager;
 };
 
@@ -397,9 +397,7 @@ CHIP_ERROR Device::UpdateAddress(const Transport::PeerAddress & addr)
     }
 
     mDeviceAddress = addr;
-    connectionState->SetPeerAddress(addr);
-
-    return CHIP_NO_ERROR;
+    return mSessionManager->UpdatePeerAddress(mSecureSession, addr);
 }
 
 void Device::Reset()
@@ -533,6 +531,8 @@ CHIP_ERROR Device::WarmupCASESession()
     mLocalMessageCounter = 0;
     mPeerMessageCounter  = 0;
 
+    // Resume the previous session with the device rather than redo the full handshake, if both sides still have it.
+    mCASESession.EnableSessionResumption(mResumptionStorage, mAdminId);
     ReturnErrorOnFailure(mCASESession.EstablishSession(mDeviceAddress, mCredentials, mDeviceId, keyID, exchange, this));
 
     mState = ConnectionState::Connecting;
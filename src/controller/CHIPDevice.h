@@ -39,6 +39,7 @@
 #include <protocols/secure_channel/CASESession.h>
 #include <protocols/secure_channel/PASESession.h>
 #include <protocols/secure_channel/SessionIDAllocator.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
 #include <setup_payload/SetupPayload.h>
 #include <support/Base64.h>
 #include <support/DLLUtil.h>
@@ -83,6 +84,7 @@ struct ControllerDeviceInitParams
     PersistentStorageDelegate * storageDelegate         = nullptr;
     Credentials::OperationalCredentialSet * credentials = nullptr;
     SessionIDAllocator * idAllocator                    = nullptr;
+    SessionResumptionStorage * resumptionStorage        = nullptr;
 #if CONFIG_NETWORK_LAYER_BLE
     Ble::BleLayer * bleLayer = nullptr;
 #endif
@@ -176,15 +178,16 @@ public:
      */
     void Init(ControllerDeviceInitParams params, uint16_t listenPort, Transport::AdminId admin)
     {
-        mTransportMgr    = params.transportMgr;
-        mSessionManager  = params.sessionMgr;
-        mExchangeMgr     = params.exchangeMgr;
-        mInetLayer       = params.inetLayer;
-        mListenPort      = listenPort;
-        mAdminId         = admin;
-        mStorageDelegate = params.storageDelegate;
-        mCredentials     = params.credentials;
-        mIDAllocator     = params.idAllocator;
+        mTransportMgr      = params.transportMgr;
+        mSessionManager    = params.sessionMgr;
+        mExchangeMgr       = params.exchangeMgr;
+        mInetLayer         = params.inetLayer;
+        mListenPort        = listenPort;
+        mAdminId           = admin;
+        mStorageDelegate   = params.storageDelegate;
+        mCredentials       = params.credentials;
+        mIDAllocator       = params.idAllocator;
+        mResumptionStorage = params.resumptionStorage;
 #if CONFIG_NETWORK_LAYER_BLE
         mBleLayer = params.bleLayer;
 #endif
@@ -479,6 +482,8 @@ private:
 
     SessionIDAllocator * mIDAllocator = nullptr;
 
+    SessionResumptionStorage * mResumptionStorage = nullptr;
+
     Callback::CallbackDeque mConnectionSuccess;
     Callback::CallbackDeque mConnectionFailure;
 };
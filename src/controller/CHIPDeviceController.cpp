@@ -161,6 +161,7 @@ CHIP_ERROR DeviceController::Init(NodeId localDeviceId, ControllerInitParams par
             ));
 
     ReturnErrorOnFailure(mAdmins.Init(mStorageDelegate));
+    ReturnErrorOnFailure(mResumptionStorage.Init(mStorageDelegate));
 
     Transport::AdminPairingInfo * const admin = mAdmins.AssignAdminId(mAdminId, localDeviceId);
     VerifyOrReturnError(admin != nullptr, CHIP_ERROR_NO_MEMORY);
@@ -792,13 +793,14 @@ void DeviceController::OnNodeIdResolutionFailed(const chip::PeerId & peer, CHIP_
 ControllerDeviceInitParams DeviceController::GetControllerDeviceInitParams()
 {
     return ControllerDeviceInitParams{
-        .transportMgr    = mTransportMgr,
-        .sessionMgr      = mSessionMgr,
-        .exchangeMgr     = mExchangeMgr,
-        .inetLayer       = mInetLayer,
-        .storageDelegate = mStorageDelegate,
-        .credentials     = &mCredentials,
-        .idAllocator     = &mIDAllocator,
+        .transportMgr      = mTransportMgr,
+        .sessionMgr        = mSessionMgr,
+        .exchangeMgr       = mExchangeMgr,
+        .inetLayer         = mInetLayer,
+        .storageDelegate   = mStorageDelegate,
+        .credentials       = &mCredentials,
+        .idAllocator       = &mIDAllocator,
+        .resumptionStorage = &mResumptionStorage,
     };
 }
 
@@ -343,6 +343,7 @@ protected:
     Credentials::CertificateKeyId mRootKeyId;
 
     SessionIDAllocator mIDAllocator;
+    SessionResumptionStorage mResumptionStorage;
 
 #if CHIP_DEVICE_CONFIG_ENABLE_MDNS
     //////////// ResolverDelegate Implementation ///////////////
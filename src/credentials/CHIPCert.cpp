@@ -225,6 +225,11 @@ CHIP_ERROR ChipCertificateSet::LoadCert(TLVReader & reader, BitFlags<CertDecodeF
         cert.mCertFlags.Set(CertFlags::kIsTrustAnchor);
     }
 
+    return LoadCert(cert);
+}
+
+CHIP_ERROR ChipCertificateSet::LoadCert(const ChipCertificateData & cert)
+{
     // Check if this cert matches any currently loaded certificates
     for (uint32_t i = 0; i < mCertCount; i++)
     {
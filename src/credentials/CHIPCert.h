@@ -438,6 +438,17 @@ public:
      **/
     CHIP_ERROR LoadCert(chip::TLV::TLVReader & reader, BitFlags<CertDecodeFlags> decodeFlags, ByteSpan chipCert = ByteSpan());
 
+    /**
+     * @brief Load already decoded CHIP certificate data into set, e.g. a certificate of another set.
+     *        It is required that the CHIP certificate the data was decoded from stays valid while
+     *        the certificate data in the set is used.
+     *
+     * @param cert  The decoded certificate data.
+     *
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR LoadCert(const ChipCertificateData & cert);
+
     /**
      * @brief Load CHIP certificates into set.
      *        It is required that the CHIP certificates in the chipCerts buffer stays valid while
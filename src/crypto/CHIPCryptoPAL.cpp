@@ -409,5 +409,221 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::KDF(const uint8_t * ikm, const size_t
     return CHIP_NO_ERROR;
 }
 
+void AES_CCM_keyed::IncrementCounter(uint8_t * counter, size_t blocks)
+{
+    // The counter block is a big-endian number.
+    for (size_t i = kBlockLength; i > 0 && blocks > 0; i--)
+    {
+        const size_t sum = counter[i - 1] + (blocks & 0xff);
+        counter[i - 1]   = static_cast<uint8_t>(sum);
+        blocks           = (blocks >> 8) + (sum >> 8);
+    }
+}
+
+CHIP_ERROR AES_CCM_keyed::StartEncrypt(size_t message_length, const uint8_t * aad, size_t aad_length, const uint8_t * iv,
+                                       size_t iv_length, size_t tag_length)
+{
+    return Start(true, message_length, aad, aad_length, iv, iv_length, tag_length);
+}
+
+CHIP_ERROR AES_CCM_keyed::StartDecrypt(size_t message_length, const uint8_t * aad, size_t aad_length, const uint8_t * iv,
+                                       size_t iv_length, size_t tag_length)
+{
+    return Start(false, message_length, aad, aad_length, iv, iv_length, tag_length);
+}
+
+// Follows NIST SP 800-38C: the CBC-MAC covers the B0 block with the flags, nonce and message length, the encoded AAD and the
+// plaintext, each padded to whole blocks, and the counter blocks A0, A1, ... encrypt the tag and the message respectively.
+CHIP_ERROR AES_CCM_keyed::Start(bool encrypt, size_t message_length, const uint8_t * aad, size_t aad_length, const uint8_t * iv,
+                                size_t iv_length, size_t tag_length)
+{
+    static const uint8_t kZeroBlock[kBlockLength] = { 0 };
+    MultiPartState & state                        = mMultiPart;
+
+    ClearSecretData(reinterpret_cast<uint8_t *>(&state), sizeof(state));
+
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(iv != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv_length >= 7 && iv_length <= 13, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag_length >= 4 && tag_length <= kBlockLength && tag_length % 2 == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad_length < 0xFF00, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The message length is encoded in the bytes of the counter that the nonce leaves.
+    const size_t lengthSize = kBlockLength - 1 - iv_length;
+    VerifyOrReturnError(lengthSize >= sizeof(size_t) || (message_length >> (8 * lengthSize)) == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // B0 and the encoded AAD are collected into a few blocks at a time, which go through the CBC-MAC together.
+    uint8_t blocks[4 * kBlockLength];
+    blocks[0] = static_cast<uint8_t>(((aad_length > 0) ? 0x40 : 0) | (((tag_length - 2) / 2) << 3) | (lengthSize - 1));
+    memcpy(&blocks[1], iv, iv_length);
+    for (size_t i = 0; i < lengthSize; i++)
+    {
+        blocks[kBlockLength - 1 - i] = static_cast<uint8_t>((i < sizeof(size_t)) ? (message_length >> (8 * i)) : 0);
+    }
+    size_t blocksLength = kBlockLength;
+
+    if (aad_length > 0)
+    {
+        blocks[blocksLength++] = static_cast<uint8_t>(aad_length >> 8);
+        blocks[blocksLength++] = static_cast<uint8_t>(aad_length);
+
+        size_t offset = 0;
+        while (offset < aad_length)
+        {
+            const size_t length = min(sizeof(blocks) - blocksLength, aad_length - offset);
+            memcpy(&blocks[blocksLength], &aad[offset], length);
+            blocksLength += length;
+            offset += length;
+
+            if (blocksLength == sizeof(blocks) && offset < aad_length)
+            {
+                ReturnErrorOnFailure(CbcMac(state.mMac, blocks, blocksLength));
+                blocksLength = 0;
+            }
+        }
+
+        const size_t padding = (kBlockLength - blocksLength % kBlockLength) % kBlockLength;
+        memset(&blocks[blocksLength], 0, padding);
+        blocksLength += padding;
+    }
+    ReturnErrorOnFailure(CbcMac(state.mMac, blocks, blocksLength));
+
+    state.mCounter[0] = static_cast<uint8_t>(lengthSize - 1);
+    memcpy(&state.mCounter[1], iv, iv_length);
+    ReturnErrorOnFailure(Ctr(state.mCounter, kZeroBlock, kBlockLength, state.mTagMask));
+    IncrementCounter(state.mCounter, 1);
+
+    state.mRemaining  = message_length;
+    state.mTagLength  = tag_length;
+    state.mEncrypt    = encrypt;
+    state.mInProgress = true;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Update(const uint8_t * input, size_t length, uint8_t * output)
+{
+    static const uint8_t kZeroBlock[kBlockLength] = { 0 };
+    MultiPartState & state                        = mMultiPart;
+
+    VerifyOrReturnError(state.mInProgress, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(length <= state.mRemaining, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(length == 0 || (input != nullptr && output != nullptr), CHIP_ERROR_INVALID_ARGUMENT);
+
+    state.mRemaining -= length;
+
+    while (length > 0)
+    {
+        if (state.mBlockLength > 0 || length < kBlockLength)
+        {
+            // Bytes that do not make up a whole block are collected until they do, so that the parts can have any length.
+            if (state.mBlockLength == 0)
+            {
+                ReturnErrorOnFailure(Ctr(state.mCounter, kZeroBlock, kBlockLength, state.mKeyStream));
+                IncrementCounter(state.mCounter, 1);
+            }
+
+            const size_t count = min(kBlockLength - state.mBlockLength, length);
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint8_t in                     = input[i];
+                const uint8_t out                    = static_cast<uint8_t>(in ^ state.mKeyStream[state.mBlockLength + i]);
+                state.mBlock[state.mBlockLength + i] = state.mEncrypt ? in : out;
+                output[i]                            = out;
+            }
+            state.mBlockLength += count;
+            input += count;
+            output += count;
+            length -= count;
+
+            if (state.mBlockLength == kBlockLength)
+            {
+                ReturnErrorOnFailure(CbcMac(state.mMac, state.mBlock, kBlockLength));
+                state.mBlockLength = 0;
+            }
+        }
+        else
+        {
+            const size_t count = length - length % kBlockLength;
+            if (state.mEncrypt)
+            {
+                ReturnErrorOnFailure(CbcMac(state.mMac, input, count));
+                ReturnErrorOnFailure(Ctr(state.mCounter, input, count, output));
+            }
+            else
+            {
+                ReturnErrorOnFailure(Ctr(state.mCounter, input, count, output));
+                ReturnErrorOnFailure(CbcMac(state.mMac, output, count));
+            }
+            IncrementCounter(state.mCounter, count / kBlockLength);
+            input += count;
+            output += count;
+            length -= count;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+// Completes the CBC-MAC with the padded last block, and turns it into the tag in place.
+CHIP_ERROR AES_CCM_keyed::FinishMac()
+{
+    MultiPartState & state = mMultiPart;
+
+    VerifyOrReturnError(state.mRemaining == 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (state.mBlockLength > 0)
+    {
+        memset(&state.mBlock[state.mBlockLength], 0, kBlockLength - state.mBlockLength);
+        ReturnErrorOnFailure(CbcMac(state.mMac, state.mBlock, kBlockLength));
+    }
+
+    for (size_t i = 0; i < kBlockLength; i++)
+    {
+        state.mMac[i] ^= state.mTagMask[i];
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::FinishEncrypt(uint8_t * tag, size_t tag_length)
+{
+    VerifyOrReturnError(mMultiPart.mInProgress && mMultiPart.mEncrypt, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag_length == mMultiPart.mTagLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR err = FinishMac();
+    if (err == CHIP_NO_ERROR)
+    {
+        memcpy(tag, mMultiPart.mMac, tag_length);
+    }
+
+    ClearSecretData(reinterpret_cast<uint8_t *>(&mMultiPart), sizeof(mMultiPart));
+    return err;
+}
+
+CHIP_ERROR AES_CCM_keyed::FinishDecrypt(const uint8_t * tag, size_t tag_length)
+{
+    VerifyOrReturnError(mMultiPart.mInProgress && !mMultiPart.mEncrypt, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag_length == mMultiPart.mTagLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR err = FinishMac();
+    if (err == CHIP_NO_ERROR)
+    {
+        // Compare in constant time, so that the time taken does not tell how much of the tag matched.
+        uint8_t difference = 0;
+        for (size_t i = 0; i < tag_length; i++)
+        {
+            difference = static_cast<uint8_t>(difference | (tag[i] ^ mMultiPart.mMac[i]));
+        }
+        err = (difference == 0) ? CHIP_NO_ERROR : CHIP_ERROR_INTERNAL;
+    }
+
+    ClearSecretData(reinterpret_cast<uint8_t *>(&mMultiPart), sizeof(mMultiPart));
+    return err;
+}
+
 } // namespace Crypto
 } // namespace chip
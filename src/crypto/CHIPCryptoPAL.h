@@ -68,6 +68,7 @@ constexpr size_t kP256_PublicKey_Length  = CHIP_CRYPTO_PUBLIC_KEY_SIZE_BYTES;
 constexpr size_t kMAX_Spake2p_Context_Size     = 1024;
 constexpr size_t kMAX_Hash_SHA256_Context_Size = 296;
 constexpr size_t kMAX_P256Keypair_Context_Size = 512;
+constexpr size_t kMAX_AES_CCM_Context_Size     = 256;
 
 /**
  * Spake2+ parameters for P256
@@ -367,6 +368,139 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const uint8_t * key, size_t key_length, const uint8_t * iv,
                            size_t iv_length, uint8_t * plaintext);
 
+struct alignas(size_t) AES_CCM_keyedOpaqueContext
+{
+    uint8_t mOpaque[kMAX_AES_CCM_Context_Size];
+};
+
+/**
+ * @brief A class that holds an AES-CCM key schedule, so that a series of messages
+ *        protected with the same key only pays for the key setup once.
+ *
+ * Encrypt() and Decrypt() produce the same results as AES_CCM_encrypt() and
+ * AES_CCM_decrypt() called with the key given to Init(). The object owns
+ * backend resources, so it cannot be copied.
+ **/
+class AES_CCM_keyed
+{
+public:
+    AES_CCM_keyed();
+    ~AES_CCM_keyed();
+
+    AES_CCM_keyed(const AES_CCM_keyed &) = delete;
+    AES_CCM_keyed & operator=(const AES_CCM_keyed &) = delete;
+
+    /**
+     * @brief Set up the key schedule, replacing any previous key.
+     * @param key Encryption key
+     * @param key_length Length of encryption key (in bytes)
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR Init(const uint8_t * key, size_t key_length);
+
+    /**
+     * @brief Whether Init() has succeeded since construction or the last Clear().
+     **/
+    bool IsInitialized() const { return mInitialized; }
+
+    /**
+     * @brief Encrypt a message with the key given to Init(). See AES_CCM_encrypt() for the parameters.
+     **/
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * iv, size_t iv_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Decrypt a message with the key given to Init(). See AES_CCM_decrypt() for the parameters.
+     **/
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * iv, size_t iv_length, uint8_t * plaintext);
+
+    /**
+     * @brief Start encrypting a message whose parts, e.g. the buffers of a chain, are passed to Update() in order.
+     *        FinishEncrypt() then produces the tag. The result is the same as that of Encrypt() for the whole message.
+     * @param message_length Total length of the parts
+     * @param aad Additional authentication data
+     * @param aad_length Length of additional authentication data, less than 0xFF00
+     * @param iv Initial vector, 7 to 13 bytes long
+     * @param iv_length Length of initial vector
+     * @param tag_length Length of the tag that FinishEncrypt() produces
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR StartEncrypt(size_t message_length, const uint8_t * aad, size_t aad_length, const uint8_t * iv, size_t iv_length,
+                            size_t tag_length);
+
+    /**
+     * @brief Start decrypting a message whose parts are passed to Update() in order. See StartEncrypt() for the parameters.
+     **/
+    CHIP_ERROR StartDecrypt(size_t message_length, const uint8_t * aad, size_t aad_length, const uint8_t * iv, size_t iv_length,
+                            size_t tag_length);
+
+    /**
+     * @brief Encrypt or decrypt the next part of the message started last.
+     * @param input Part of the message
+     * @param length Length of the part, which may be any number of bytes
+     * @param output Buffer to write the result into. It may be input itself, but must not overlap it otherwise.
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR Update(const uint8_t * input, size_t length, uint8_t * output);
+
+    /**
+     * @brief Finish the message started with StartEncrypt() once all of its parts were passed to Update().
+     * @param tag Buffer to write the tag into
+     * @param tag_length Length of the tag, as given to StartEncrypt()
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR FinishEncrypt(uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Finish the message started with StartDecrypt() once all of its parts were passed to Update(), and authenticate it.
+     *        Update() outputs plaintext before it is authenticated, so the caller must discard it unless this succeeds.
+     * @param tag Tag to check
+     * @param tag_length Length of the tag, as given to StartDecrypt()
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR FinishDecrypt(const uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Release the key schedule and wipe the key material.
+     **/
+    void Clear();
+
+private:
+    static constexpr size_t kBlockLength = 16;
+
+    // The state of a message encrypted or decrypted in parts, which the multi-part methods keep independently of the backend.
+    struct MultiPartState
+    {
+        uint8_t mMac[kBlockLength];       // CBC-MAC of the blocks so far
+        uint8_t mCounter[kBlockLength];   // counter block of the next key stream block
+        uint8_t mTagMask[kBlockLength];   // key stream block that encrypts the tag
+        uint8_t mKeyStream[kBlockLength]; // key stream of the block that mBlock collects
+        uint8_t mBlock[kBlockLength];     // plaintext of the block that is not complete yet
+        size_t mBlockLength;
+        size_t mRemaining;
+        size_t mTagLength;
+        bool mEncrypt;
+        bool mInProgress;
+    };
+
+    CHIP_ERROR Start(bool encrypt, size_t message_length, const uint8_t * aad, size_t aad_length, const uint8_t * iv,
+                     size_t iv_length, size_t tag_length);
+    CHIP_ERROR FinishMac();
+
+    // Advance a counter block by the given number of blocks.
+    static void IncrementCounter(uint8_t * counter, size_t blocks);
+
+    // Backend primitives of the multi-part methods, which only pass whole blocks. CbcMac() continues the CBC-MAC in mac over
+    // input. Ctr() encrypts input with the key stream that starts at counter, which it leaves unchanged.
+    CHIP_ERROR CbcMac(uint8_t * mac, const uint8_t * input, size_t length);
+    CHIP_ERROR Ctr(const uint8_t * counter, const uint8_t * input, size_t length, uint8_t * output);
+
+    AES_CCM_keyedOpaqueContext mContext;
+    MultiPartState mMultiPart = {};
+    bool mInitialized = false;
+};
+
 /**
  * @brief Verify the Certificate Signing Request (CSR). If successfully verified, it outputs the public key from the CSR.
  * @param csr CSR in DER format
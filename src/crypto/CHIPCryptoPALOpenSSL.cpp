@@ -283,6 +283,321 @@ exit:
     return error;
 }
 
+typedef struct AES_CCM_keyed_Context
+{
+    EVP_CIPHER_CTX * mCipherContext;
+    // AES-CBC and AES-CTR contexts for messages encrypted or decrypted in parts, which OpenSSL's CCM mode cannot do.
+    // They are set up on first use. The initial vectors they continue with, i.e. the last MAC and the next counter block,
+    // are remembered so that consecutive calls need not load them again.
+    EVP_CIPHER_CTX * mMacContext;
+    EVP_CIPHER_CTX * mCtrContext;
+    uint8_t mMacChain[16];
+    uint8_t mCtrChain[16];
+    uint8_t mKey[32];
+    size_t mKeyLength;
+    // OpenSSL binds the key schedule to the nonce and tag lengths and to the direction, so remember which ones
+    // it was set up for. A context used for a single direction with fixed lengths only computes it once.
+    size_t mIVLength;
+    size_t mTagLength;
+    int mEncrypt;
+} AES_CCM_keyed_Context;
+
+static inline AES_CCM_keyed_Context * to_inner_aes_ccm_keyed_context(AES_CCM_keyedOpaqueContext * context)
+{
+    return SafePointerCast<AES_CCM_keyed_Context *>(context);
+}
+
+// Prepares the cached cipher context for one message: selects the direction, redoes the key schedule only if the
+// direction or the nonce or tag length changed, and loads the per-message tag (decryption only) and nonce.
+static CHIP_ERROR _prepareKeyedCCM(AES_CCM_keyed_Context * context, int encrypt, const uint8_t * iv, size_t iv_length,
+                                   const uint8_t * tag, size_t tag_length)
+{
+    EVP_CIPHER_CTX * const cipher = context->mCipherContext;
+    int result                    = 1;
+
+    VerifyOrReturnError(CanCastTo<int>(iv_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    result = EVP_CipherInit_ex(cipher, nullptr, nullptr, nullptr, nullptr, encrypt);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    if (encrypt != context->mEncrypt || iv_length != context->mIVLength || tag_length != context->mTagLength)
+    {
+        // Cast is safe because we checked with CanCastTo.
+        result = EVP_CIPHER_CTX_ctrl(cipher, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(iv_length), nullptr);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+        // Cast is safe because the caller checked _isValidTagLength.
+        result = EVP_CIPHER_CTX_ctrl(cipher, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+        context->mEncrypt = -1;
+        result            = EVP_CipherInit_ex(cipher, nullptr, nullptr, Uint8::to_const_uchar(context->mKey), nullptr, encrypt);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+        context->mIVLength  = iv_length;
+        context->mTagLength = tag_length;
+        context->mEncrypt   = encrypt;
+    }
+
+    if (tag != nullptr)
+    {
+        // Removing "const" from |tag| here should hopefully be safe as
+        // we're writing the tag, not reading.
+        result = EVP_CIPHER_CTX_ctrl(cipher, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                     const_cast<void *>(static_cast<const void *>(tag)));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    result = EVP_CipherInit_ex(cipher, nullptr, nullptr, nullptr, Uint8::to_const_uchar(iv), encrypt);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+AES_CCM_keyed::AES_CCM_keyed()
+{
+    memset(&mContext, 0, sizeof(mContext));
+}
+
+AES_CCM_keyed::~AES_CCM_keyed()
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_keyed::Init(const uint8_t * key, size_t key_length)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidKeyLength(key_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Clear();
+
+    AES_CCM_keyed_Context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+
+    context->mCipherContext = EVP_CIPHER_CTX_new();
+    VerifyOrReturnError(context->mCipherContext != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // 16 bytes key for AES-CCM-128
+    const EVP_CIPHER * type = (key_length == 16) ? EVP_aes_128_ccm() : EVP_aes_256_ccm();
+    if (EVP_CipherInit_ex(context->mCipherContext, type, nullptr, nullptr, nullptr, 1) != 1)
+    {
+        Clear();
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    // The key schedule itself is computed on first use, once the direction and the nonce and tag lengths are known.
+    memcpy(context->mKey, key, key_length);
+    context->mKeyLength = key_length;
+    context->mEncrypt   = -1;
+
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                  const uint8_t * iv, size_t iv_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length)
+{
+    AES_CCM_keyed_Context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+    int bytesWritten                      = 0;
+    size_t ciphertext_length              = 0;
+    int result                            = 1;
+
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(plaintext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(plaintext_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(CanCastTo<int>(plaintext_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReturnErrorOnFailure(_prepareKeyedCCM(context, 1, iv, iv_length, nullptr, tag_length));
+
+    EVP_CIPHER_CTX * const cipher = context->mCipherContext;
+
+    // Pass in plain text length
+    result = EVP_EncryptUpdate(cipher, nullptr, &bytesWritten, nullptr, static_cast<int>(plaintext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in AAD
+    if (aad_length > 0 && aad != nullptr)
+    {
+        VerifyOrReturnError(CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_EncryptUpdate(cipher, nullptr, &bytesWritten, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    // Encrypt
+    result = EVP_EncryptUpdate(cipher, Uint8::to_uchar(ciphertext), &bytesWritten, Uint8::to_const_uchar(plaintext),
+                               static_cast<int>(plaintext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(bytesWritten >= 0, CHIP_ERROR_INTERNAL);
+    ciphertext_length = static_cast<unsigned int>(bytesWritten);
+
+    // Finalize encryption
+    result = EVP_EncryptFinal_ex(cipher, ciphertext + ciphertext_length, &bytesWritten);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Get tag
+    result = EVP_CIPHER_CTX_ctrl(cipher, EVP_CTRL_CCM_GET_TAG, static_cast<int>(tag_length), Uint8::to_uchar(tag));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                  const uint8_t * tag, size_t tag_length, const uint8_t * iv, size_t iv_length, uint8_t * plaintext)
+{
+    AES_CCM_keyed_Context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+    int bytesOutput                       = 0;
+    int result                            = 1;
+
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(ciphertext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ciphertext_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(CanCastTo<int>(ciphertext_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReturnErrorOnFailure(_prepareKeyedCCM(context, 0, iv, iv_length, tag, tag_length));
+
+    EVP_CIPHER_CTX * const cipher = context->mCipherContext;
+
+    // Pass in cipher text length
+    result = EVP_DecryptUpdate(cipher, nullptr, &bytesOutput, nullptr, static_cast<int>(ciphertext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // Pass in aad
+    if (aad_length > 0 && aad != nullptr)
+    {
+        VerifyOrReturnError(CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_DecryptUpdate(cipher, nullptr, &bytesOutput, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    // Pass in ciphertext. We wont get anything if validation fails.
+    result = EVP_DecryptUpdate(cipher, Uint8::to_uchar(plaintext), &bytesOutput, Uint8::to_const_uchar(ciphertext),
+                               static_cast<int>(ciphertext_length));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+// Readies a block cipher context of the multi-part methods to continue from the given initial vector, creating the context first
+// if needed. The vector is only loaded if it differs from the one the context continues with, which chain holds.
+static CHIP_ERROR _prepareKeyedBlockCipher(AES_CCM_keyed_Context * context, EVP_CIPHER_CTX ** cipher, uint8_t * chain, bool cbc,
+                                           const uint8_t * iv)
+{
+    if (*cipher == nullptr)
+    {
+        EVP_CIPHER_CTX * const newCipher = EVP_CIPHER_CTX_new();
+        VerifyOrReturnError(newCipher != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        const EVP_CIPHER * type = nullptr;
+        if (context->mKeyLength == 16)
+        {
+            type = cbc ? EVP_aes_128_cbc() : EVP_aes_128_ctr();
+        }
+        else
+        {
+            type = cbc ? EVP_aes_256_cbc() : EVP_aes_256_ctr();
+        }
+
+        if (EVP_EncryptInit_ex(newCipher, type, nullptr, Uint8::to_const_uchar(context->mKey), Uint8::to_const_uchar(iv)) != 1 ||
+            EVP_CIPHER_CTX_set_padding(newCipher, 0) != 1)
+        {
+            EVP_CIPHER_CTX_free(newCipher);
+            return CHIP_ERROR_INTERNAL;
+        }
+        *cipher = newCipher;
+    }
+    else if (memcmp(chain, iv, 16) != 0)
+    {
+        const int result = EVP_EncryptInit_ex(*cipher, nullptr, nullptr, nullptr, Uint8::to_const_uchar(iv));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::CbcMac(uint8_t * mac, const uint8_t * input, size_t length)
+{
+    AES_CCM_keyed_Context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+    uint8_t output[16 * kBlockLength];
+    int bytesWritten = 0;
+
+    ReturnErrorOnFailure(_prepareKeyedBlockCipher(context, &context->mMacContext, context->mMacChain, true, mac));
+
+    // CBC-encrypting the input with the MAC so far as the initial vector leaves the new MAC in the last output block.
+    while (length > 0)
+    {
+        const size_t chunkLength = min(length, sizeof(output));
+        const int result         = EVP_EncryptUpdate(context->mMacContext, Uint8::to_uchar(output), &bytesWritten,
+                                             Uint8::to_const_uchar(input), static_cast<int>(chunkLength));
+        if (result != 1 || bytesWritten != static_cast<int>(chunkLength))
+        {
+            // The context is in an unknown state, so the next call starts over with a new one.
+            EVP_CIPHER_CTX_free(context->mMacContext);
+            context->mMacContext = nullptr;
+            return CHIP_ERROR_INTERNAL;
+        }
+
+        memcpy(mac, &output[chunkLength - kBlockLength], kBlockLength);
+        input += chunkLength;
+        length -= chunkLength;
+    }
+
+    memcpy(context->mMacChain, mac, kBlockLength);
+    ClearSecretData(output, sizeof(output));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Ctr(const uint8_t * counter, const uint8_t * input, size_t length, uint8_t * output)
+{
+    AES_CCM_keyed_Context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+    int bytesWritten                      = 0;
+
+    VerifyOrReturnError(CanCastTo<int>(length), CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(_prepareKeyedBlockCipher(context, &context->mCtrContext, context->mCtrChain, false, counter));
+
+    const int result = EVP_EncryptUpdate(context->mCtrContext, Uint8::to_uchar(output), &bytesWritten,
+                                         Uint8::to_const_uchar(input), static_cast<int>(length));
+
+    if (result != 1 || bytesWritten != static_cast<int>(length))
+    {
+        EVP_CIPHER_CTX_free(context->mCtrContext);
+        context->mCtrContext = nullptr;
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    memcpy(context->mCtrChain, counter, kBlockLength);
+    IncrementCounter(context->mCtrChain, length / kBlockLength);
+
+    return CHIP_NO_ERROR;
+}
+
+void AES_CCM_keyed::Clear()
+{
+    AES_CCM_keyed_Context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+
+    if (context->mCipherContext != nullptr)
+    {
+        EVP_CIPHER_CTX_free(context->mCipherContext);
+    }
+    if (context->mMacContext != nullptr)
+    {
+        EVP_CIPHER_CTX_free(context->mMacContext);
+    }
+    if (context->mCtrContext != nullptr)
+    {
+        EVP_CIPHER_CTX_free(context->mCtrContext);
+    }
+    ClearSecretData(reinterpret_cast<uint8_t *>(&mContext), sizeof(mContext));
+    ClearSecretData(reinterpret_cast<uint8_t *>(&mMultiPart), sizeof(mMultiPart));
+    mInitialized = false;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
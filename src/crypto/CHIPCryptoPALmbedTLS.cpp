@@ -179,6 +179,155 @@ exit:
     return error;
 }
 
+static inline mbedtls_ccm_context * to_inner_aes_ccm_keyed_context(AES_CCM_keyedOpaqueContext * context)
+{
+    return SafePointerCast<mbedtls_ccm_context *>(context);
+}
+
+AES_CCM_keyed::AES_CCM_keyed()
+{
+    mbedtls_ccm_init(to_inner_aes_ccm_keyed_context(&mContext));
+}
+
+AES_CCM_keyed::~AES_CCM_keyed()
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_keyed::Init(const uint8_t * key, size_t key_length)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidKeyLength(key_length), CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    Clear();
+
+    mbedtls_ccm_context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+
+    // Size of key = key_length * number of bits in a byte (8)
+    // Cast is safe because we called _isValidKeyLength above.
+    const int result =
+        mbedtls_ccm_setkey(context, MBEDTLS_CIPHER_ID_AES, Uint8::to_const_uchar(key), static_cast<unsigned int>(key_length * 8));
+    _log_mbedTLS_error(result);
+    if (result != 0)
+    {
+        Clear();
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                  const uint8_t * iv, size_t iv_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(plaintext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(plaintext_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrReturnError(aad != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    const int result = mbedtls_ccm_encrypt_and_tag(to_inner_aes_ccm_keyed_context(&mContext), plaintext_length,
+                                                   Uint8::to_const_uchar(iv), iv_length, Uint8::to_const_uchar(aad), aad_length,
+                                                   Uint8::to_const_uchar(plaintext), Uint8::to_uchar(ciphertext),
+                                                   Uint8::to_uchar(tag), tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                  const uint8_t * tag, size_t tag_length, const uint8_t * iv, size_t iv_length, uint8_t * plaintext)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(ciphertext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ciphertext_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrReturnError(aad != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    const int result = mbedtls_ccm_auth_decrypt(to_inner_aes_ccm_keyed_context(&mContext), ciphertext_length,
+                                                Uint8::to_const_uchar(iv), iv_length, Uint8::to_const_uchar(aad), aad_length,
+                                                Uint8::to_const_uchar(ciphertext), Uint8::to_uchar(plaintext),
+                                                Uint8::to_const_uchar(tag), tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+// The multi-part methods use the AES-ECB cipher that the CCM context holds, block by block, as mbedTLS's own CCM does.
+CHIP_ERROR AES_CCM_keyed::CbcMac(uint8_t * mac, const uint8_t * input, size_t length)
+{
+    mbedtls_cipher_context_t * const cipher = &to_inner_aes_ccm_keyed_context(&mContext)->cipher_ctx;
+
+    for (size_t offset = 0; offset < length; offset += kBlockLength)
+    {
+        for (size_t i = 0; i < kBlockLength; i++)
+        {
+            mac[i] ^= input[offset + i];
+        }
+
+        size_t outputLength = 0;
+        const int result    =
+            mbedtls_cipher_update(cipher, Uint8::to_const_uchar(mac), kBlockLength, Uint8::to_uchar(mac), &outputLength);
+        _log_mbedTLS_error(result);
+        VerifyOrReturnError(result == 0 && outputLength == kBlockLength, CHIP_ERROR_INTERNAL);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_keyed::Ctr(const uint8_t * counter, const uint8_t * input, size_t length, uint8_t * output)
+{
+    mbedtls_cipher_context_t * const cipher = &to_inner_aes_ccm_keyed_context(&mContext)->cipher_ctx;
+    uint8_t block[kBlockLength];
+    uint8_t keyStream[kBlockLength];
+
+    memcpy(block, counter, kBlockLength);
+    for (size_t offset = 0; offset < length; offset += kBlockLength)
+    {
+        size_t outputLength = 0;
+        const int result    = mbedtls_cipher_update(cipher, Uint8::to_const_uchar(block), kBlockLength, Uint8::to_uchar(keyStream),
+                                                 &outputLength);
+        _log_mbedTLS_error(result);
+        VerifyOrReturnError(result == 0 && outputLength == kBlockLength, CHIP_ERROR_INTERNAL);
+
+        for (size_t i = 0; i < kBlockLength; i++)
+        {
+            output[offset + i] = static_cast<uint8_t>(input[offset + i] ^ keyStream[i]);
+        }
+
+        IncrementCounter(block, 1);
+    }
+
+    ClearSecretData(keyStream, sizeof(keyStream));
+    return CHIP_NO_ERROR;
+}
+
+void AES_CCM_keyed::Clear()
+{
+    mbedtls_ccm_context * const context = to_inner_aes_ccm_keyed_context(&mContext);
+
+    // mbedtls_ccm_free() releases the key schedule and zeroizes the context.
+    mbedtls_ccm_free(context);
+    mbedtls_ccm_init(context);
+    ClearSecretData(reinterpret_cast<uint8_t *>(&mMultiPart), sizeof(mMultiPart));
+    mInitialized = false;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
@@ -43,6 +43,7 @@
 #include <support/CodeUtils.h>
 #include <support/ScopedBuffer.h>
 #include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
 
 #include <stdarg.h>
 #include <stdint.h>
@@ -601,6 +602,270 @@ static void TestAES_CCM_128DecryptInvalidIVLen(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+// Runs one test vector through the multi-part methods of a keyed context, passing the message in parts of the given length,
+// and decrypts in place.
+template <typename Vector>
+static void CheckAES_CCM_KeyedMultiPart(nlTestSuite * inSuite, AES_CCM_keyed & context, const Vector * vector, size_t partLength,
+                                        uint8_t * out)
+{
+    uint8_t out_tag[16];
+
+    NL_TEST_ASSERT(inSuite,
+                   context.StartEncrypt(vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                                        vector->tag_len) == CHIP_NO_ERROR);
+    for (size_t offset = 0; offset < vector->pt_len; offset += partLength)
+    {
+        const size_t length = chip::min(partLength, vector->pt_len - offset);
+        NL_TEST_ASSERT(inSuite, context.Update(&vector->pt[offset], length, &out[offset]) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, context.FinishEncrypt(out_tag, vector->tag_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(out, vector->ct, vector->ct_len) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(out_tag, vector->tag, vector->tag_len) == 0);
+
+    NL_TEST_ASSERT(inSuite,
+                   context.StartDecrypt(vector->ct_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                                        vector->tag_len) == CHIP_NO_ERROR);
+    for (size_t offset = 0; offset < vector->ct_len; offset += partLength)
+    {
+        const size_t length = chip::min(partLength, vector->ct_len - offset);
+        NL_TEST_ASSERT(inSuite, context.Update(&out[offset], length, &out[offset]) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, context.FinishDecrypt(vector->tag, vector->tag_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(out, vector->pt, vector->pt_len) == 0);
+}
+
+// Runs one test vector through a keyed context: encrypt, decrypt and encrypt again, so that the context is
+// reused across directions, then with a shorter nonce so that the nonce length changes under the same key.
+// Finally the message is passed in parts of several lengths, which need not be whole blocks.
+template <typename Vector>
+static void CheckAES_CCM_KeyedTestVector(nlTestSuite * inSuite, const Vector * vector)
+{
+    chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> expected_ct;
+    uint8_t out_tag[16];
+    uint8_t expected_tag[16];
+    out_ct.Alloc(vector->ct_len);
+    out_pt.Alloc(vector->pt_len);
+    expected_ct.Alloc(vector->ct_len);
+    NL_TEST_ASSERT(inSuite, out_ct && out_pt && expected_ct);
+    NL_TEST_ASSERT(inSuite, vector->tag_len <= sizeof(out_tag));
+
+    AES_CCM_keyed context;
+    NL_TEST_ASSERT(inSuite, context.Init(vector->key, vector->key_len) == CHIP_NO_ERROR);
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        CHIP_ERROR err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                                         out_ct.Get(), out_tag, vector->tag_len);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(out_ct.Get(), vector->ct, vector->ct_len) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(out_tag, vector->tag, vector->tag_len) == 0);
+
+        err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len, vector->iv,
+                              vector->iv_len, out_pt.Get());
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(out_pt.Get(), vector->pt, vector->pt_len) == 0);
+    }
+
+    if (vector->iv_len > 7)
+    {
+        const size_t iv_len = vector->iv_len - 1;
+        CHIP_ERROR err = AES_CCM_encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->key, vector->key_len,
+                                         vector->iv, iv_len, expected_ct.Get(), expected_tag, vector->tag_len);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, iv_len, out_ct.Get(), out_tag,
+                              vector->tag_len);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(out_ct.Get(), expected_ct.Get(), vector->ct_len) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(out_tag, expected_tag, vector->tag_len) == 0);
+    }
+
+    const size_t partLengths[] = { 1, 5, 16, 17, 32, vector->pt_len };
+    for (size_t partLength : partLengths)
+    {
+        CheckAES_CCM_KeyedMultiPart(inSuite, context, vector, partLength, out_ct.Get());
+    }
+}
+
+static void TestAES_CCM_KeyedTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    int numOfTestsRan = 0;
+    for (const ccm_128_test_vector * vector : ccm_128_test_vectors)
+    {
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            CheckAES_CCM_KeyedTestVector(inSuite, vector);
+        }
+    }
+    for (const ccm_test_vector * vector : ccm_test_vectors)
+    {
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            CheckAES_CCM_KeyedTestVector(inSuite, vector);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+static void TestAES_CCM_KeyedInvalidUse(nlTestSuite * inSuite, void * inContext)
+{
+    const ccm_128_test_vector * vector = ccm_128_test_vectors[0];
+    uint8_t out[64];
+    uint8_t tag[16];
+    uint8_t bad_tag[16];
+    NL_TEST_ASSERT(inSuite, vector->ct_len <= sizeof(out) && vector->tag_len <= sizeof(tag));
+
+    AES_CCM_keyed context;
+    NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+    NL_TEST_ASSERT(inSuite,
+                   context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len, out, tag,
+                                   vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, context.Init(nullptr, vector->key_len) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, context.Init(vector->key, 0) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+
+    NL_TEST_ASSERT(inSuite, context.Init(vector->key, vector->key_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.IsInitialized());
+
+    // A message that fails authentication must not disturb the following ones.
+    memcpy(bad_tag, vector->tag, vector->tag_len);
+    bad_tag[0] ^= 0x01;
+    NL_TEST_ASSERT(inSuite,
+                   context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, bad_tag, vector->tag_len, vector->iv,
+                                   vector->iv_len, out) == CHIP_ERROR_INTERNAL);
+    NL_TEST_ASSERT(inSuite,
+                   context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                   vector->iv, vector->iv_len, out) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(out, vector->pt, vector->pt_len) == 0);
+
+    // The same goes for a message decrypted in parts.
+    NL_TEST_ASSERT(inSuite, context.Update(vector->ct, vector->ct_len, out) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite,
+                   context.StartDecrypt(vector->ct_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                                        vector->tag_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.Update(vector->ct, vector->ct_len + 1, out) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, context.Update(vector->ct, vector->ct_len - 1, out) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.FinishDecrypt(vector->tag, vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite,
+                   context.StartDecrypt(vector->ct_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                                        vector->tag_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.Update(vector->ct, vector->ct_len, out) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.FinishDecrypt(bad_tag, vector->tag_len) == CHIP_ERROR_INTERNAL);
+    NL_TEST_ASSERT(inSuite, context.FinishDecrypt(vector->tag, vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite,
+                   context.StartEncrypt(vector->pt_len, vector->aad, vector->aad_len, vector->iv, 6, vector->tag_len) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+
+    context.Clear();
+    NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+    NL_TEST_ASSERT(inSuite,
+                   context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                   vector->iv, vector->iv_len, out) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite,
+                   context.StartDecrypt(vector->ct_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len,
+                                        vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+static CHIP_ERROR EncryptDecryptInTwoParts(AES_CCM_keyed & encryptContext, AES_CCM_keyed & decryptContext,
+                                           const uint8_t * plaintext, size_t length, const uint8_t * aad, size_t aad_length,
+                                           const uint8_t * iv, size_t iv_length, uint8_t * ciphertext, uint8_t * decrypted,
+                                           uint8_t * tag, size_t tag_length)
+{
+    const size_t partLength = length / 2 + 3;
+
+    ReturnErrorOnFailure(encryptContext.StartEncrypt(length, aad, aad_length, iv, iv_length, tag_length));
+    ReturnErrorOnFailure(encryptContext.Update(plaintext, partLength, ciphertext));
+    ReturnErrorOnFailure(encryptContext.Update(&plaintext[partLength], length - partLength, &ciphertext[partLength]));
+    ReturnErrorOnFailure(encryptContext.FinishEncrypt(tag, tag_length));
+
+    ReturnErrorOnFailure(decryptContext.StartDecrypt(length, aad, aad_length, iv, iv_length, tag_length));
+    ReturnErrorOnFailure(decryptContext.Update(ciphertext, partLength, decrypted));
+    ReturnErrorOnFailure(decryptContext.Update(&ciphertext[partLength], length - partLength, &decrypted[partLength]));
+    return decryptContext.FinishDecrypt(tag, tag_length);
+}
+
+// Compares per-message throughput of the one-shot AES_CCM_encrypt()/AES_CCM_decrypt() against a keyed context,
+// using secure session sized messages.
+static void TestAES_CCM_128Throughput(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageLength = 128;
+    constexpr size_t kAADLength     = 24;
+    constexpr size_t kIVLength      = 12;
+    constexpr size_t kTagLength     = 16;
+    constexpr int kIterations       = 20000;
+
+    uint8_t key[16];
+    uint8_t aad[kAADLength];
+    uint8_t iv[kIVLength];
+    uint8_t tag[kTagLength];
+    uint8_t plaintext[kMessageLength];
+    uint8_t ciphertext[kMessageLength];
+    uint8_t decrypted[kMessageLength];
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(key, sizeof(key)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(aad, sizeof(aad)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(iv, sizeof(iv)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(plaintext, sizeof(plaintext)) == CHIP_NO_ERROR);
+
+    uint64_t start = System::Clock::GetMonotonicMicroseconds();
+    for (int i = 0; i < kIterations && err == CHIP_NO_ERROR; i++)
+    {
+        iv[0] = static_cast<uint8_t>(i);
+        err   = AES_CCM_encrypt(plaintext, sizeof(plaintext), aad, sizeof(aad), key, sizeof(key), iv, sizeof(iv), ciphertext, tag,
+                              sizeof(tag));
+        if (err == CHIP_NO_ERROR)
+        {
+            err = AES_CCM_decrypt(ciphertext, sizeof(ciphertext), aad, sizeof(aad), tag, sizeof(tag), key, sizeof(key), iv,
+                                  sizeof(iv), decrypted);
+        }
+    }
+    const uint64_t oneShotMicroseconds = System::Clock::GetMonotonicMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    AES_CCM_keyed encryptContext;
+    AES_CCM_keyed decryptContext;
+    NL_TEST_ASSERT(inSuite, encryptContext.Init(key, sizeof(key)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decryptContext.Init(key, sizeof(key)) == CHIP_NO_ERROR);
+
+    start = System::Clock::GetMonotonicMicroseconds();
+    for (int i = 0; i < kIterations && err == CHIP_NO_ERROR; i++)
+    {
+        iv[0] = static_cast<uint8_t>(i);
+        err   = encryptContext.Encrypt(plaintext, sizeof(plaintext), aad, sizeof(aad), iv, sizeof(iv), ciphertext, tag, sizeof(tag));
+        if (err == CHIP_NO_ERROR)
+        {
+            err = decryptContext.Decrypt(ciphertext, sizeof(ciphertext), aad, sizeof(aad), tag, sizeof(tag), iv, sizeof(iv),
+                                         decrypted);
+        }
+    }
+    const uint64_t keyedMicroseconds = System::Clock::GetMonotonicMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plaintext, decrypted, sizeof(plaintext)) == 0);
+
+    // The same messages in two parts, as if they were held by a chain of two buffers.
+    start = System::Clock::GetMonotonicMicroseconds();
+    for (int i = 0; i < kIterations && err == CHIP_NO_ERROR; i++)
+    {
+        iv[0] = static_cast<uint8_t>(i);
+        err   = EncryptDecryptInTwoParts(encryptContext, decryptContext, plaintext, sizeof(plaintext), aad, sizeof(aad), iv,
+                                       sizeof(iv), ciphertext, decrypted, tag, sizeof(tag));
+    }
+    const uint64_t multiPartMicroseconds = System::Clock::GetMonotonicMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plaintext, decrypted, sizeof(plaintext)) == 0);
+
+    // Each iteration is one message encrypted and decrypted.
+    printf("\n AES-CCM-128 %u byte messages: one-shot %.0f msg/s, keyed %.0f msg/s, keyed in two parts %.0f msg/s\n",
+           static_cast<unsigned>(kMessageLength),
+           kIterations * 1e6 / static_cast<double>(oneShotMicroseconds > 0 ? oneShotMicroseconds : 1),
+           kIterations * 1e6 / static_cast<double>(keyedMicroseconds > 0 ? keyedMicroseconds : 1),
+           kIterations * 1e6 / static_cast<double>(multiPartMicroseconds > 0 ? multiPartMicroseconds : 1));
+}
+
 static void TestHash_SHA256(nlTestSuite * inSuite, void * inContext)
 {
     int numOfTestCases     = ArraySize(hash_sha256_test_vectors);
@@ -1535,6 +1800,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid key", TestAES_CCM_256DecryptInvalidKey),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid IV", TestAES_CCM_256DecryptInvalidIVLen),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid vectors", TestAES_CCM_256DecryptInvalidTestVectors),
+    NL_TEST_DEF("Test keyed AES-CCM test vectors", TestAES_CCM_KeyedTestVectors),
+    NL_TEST_DEF("Test keyed AES-CCM invalid use", TestAES_CCM_KeyedInvalidUse),
+    NL_TEST_DEF("Test AES-CCM-128 throughput", TestAES_CCM_128Throughput),
     NL_TEST_DEF("Test ECDSA signing and validation message using SHA256", TestECDSA_Signing_SHA256_Msg),
     NL_TEST_DEF("Test ECDSA signing and validation SHA256 Hash", TestECDSA_Signing_SHA256_Hash),
     NL_TEST_DEF("Test ECDSA signature validation fail - Different msg", TestECDSA_ValidationFailsDifferentMessage),
@@ -106,6 +106,203 @@ union PeerSockAddr
     sockaddr_in in;
     sockaddr_in6 in6;
 };
+
+namespace {
+
+constexpr size_t kControlDataSize = 256;
+
+/*
+ * Fill in the destination address and, if the packet must leave through a particular interface or with a particular
+ * source address, the IP_PKTINFO/IPV6_PKTINFO control message of a zeroed message header. The caller supplies the
+ * storage, which must outlive the send.
+ */
+CHIP_ERROR PrepareSendMsgHeader(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo & aPktInfo,
+                                PeerSockAddr & aPeerSockAddr, uint8_t * aControlData, size_t aControlDataSize,
+                                struct msghdr & aMsgHeader)
+{
+    // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
+    memset(&aPeerSockAddr, 0, sizeof(aPeerSockAddr));
+    aMsgHeader.msg_name = &aPeerSockAddr;
+    if (aAddrType == kIPAddressType_IPv6)
+    {
+        aPeerSockAddr.in6.sin6_family = AF_INET6;
+        aPeerSockAddr.in6.sin6_port   = htons(aPktInfo.DestPort);
+        aPeerSockAddr.in6.sin6_addr   = aPktInfo.DestAddress.ToIPv6();
+        VerifyOrReturnError(CanCastTo<decltype(aPeerSockAddr.in6.sin6_scope_id)>(aPktInfo.Interface), CHIP_ERROR_INCORRECT_STATE);
+        aPeerSockAddr.in6.sin6_scope_id = static_cast<decltype(aPeerSockAddr.in6.sin6_scope_id)>(aPktInfo.Interface);
+        aMsgHeader.msg_namelen          = sizeof(sockaddr_in6);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        aPeerSockAddr.in.sin_family = AF_INET;
+        aPeerSockAddr.in.sin_port   = htons(aPktInfo.DestPort);
+        aPeerSockAddr.in.sin_addr   = aPktInfo.DestAddress.ToIPv4();
+        aMsgHeader.msg_namelen      = sizeof(sockaddr_in);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    // If the endpoint has been bound to a particular interface,
+    // and the caller didn't supply a specific interface to send
+    // on, use the bound interface. This appears to be necessary
+    // for messages to multicast addresses, which under Linux
+    // don't seem to get sent out the correct interface, despite
+    // the socket being bound.
+    InterfaceId intfId = aPktInfo.Interface;
+    if (intfId == INET_NULL_INTERFACEID)
+        intfId = aBoundIntfId;
+
+    // If the packet should be sent over a specific interface, or with a specific source
+    // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
+    // add add it to the message header.  If the local OS doesn't support IP_PKTINFO/IPV6_PKTINFO
+    // fail with an error.
+    if (intfId != INET_NULL_INTERFACEID || aPktInfo.SrcAddress.Type() != kIPAddressType_Any)
+    {
+#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+        memset(aControlData, 0, aControlDataSize);
+        aMsgHeader.msg_control    = aControlData;
+        aMsgHeader.msg_controllen = aControlDataSize;
+
+        struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&aMsgHeader);
+
+#if INET_CONFIG_ENABLE_IPV4
+
+        if (aAddrType == kIPAddressType_IPv4)
+        {
+#if defined(IP_PKTINFO)
+            controlHdr->cmsg_level = IPPROTO_IP;
+            controlHdr->cmsg_type  = IP_PKTINFO;
+            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in_pktinfo));
+
+            struct in_pktinfo * pktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<decltype(pktInfo->ipi_ifindex)>(intfId))
+            {
+                return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
+            }
+
+            pktInfo->ipi_ifindex  = static_cast<decltype(pktInfo->ipi_ifindex)>(intfId);
+            pktInfo->ipi_spec_dst = aPktInfo.SrcAddress.ToIPv4();
+
+            aMsgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+#else  // !defined(IP_PKTINFO)
+            return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
+#endif // !defined(IP_PKTINFO)
+        }
+
+#endif // INET_CONFIG_ENABLE_IPV4
+
+        if (aAddrType == kIPAddressType_IPv6)
+        {
+#if defined(IPV6_PKTINFO)
+            controlHdr->cmsg_level = IPPROTO_IPV6;
+            controlHdr->cmsg_type  = IPV6_PKTINFO;
+            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in6_pktinfo));
+
+            struct in6_pktinfo * pktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<decltype(pktInfo->ipi6_ifindex)>(intfId))
+            {
+                return CHIP_ERROR_UNEXPECTED_EVENT;
+            }
+            pktInfo->ipi6_ifindex = static_cast<decltype(pktInfo->ipi6_ifindex)>(intfId);
+            pktInfo->ipi6_addr    = aPktInfo.SrcAddress.ToIPv6();
+
+            aMsgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+#else  // !defined(IPV6_PKTINFO)
+            return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
+#endif // !defined(IPV6_PKTINFO)
+        }
+
+#else  // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
+        return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
+#endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * Point the scatter/gather array of a message header at the buffers of a message, one element per buffer of the chain, so
+ * that a chained message is sent without being copied. The caller supplies INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH elements.
+ */
+CHIP_ERROR PrepareSendMsgIOVs(const chip::System::PacketBufferHandle & aBuffer, struct iovec * aIOVs, struct msghdr & aMsgHeader)
+{
+    size_t count = 0;
+    for (chip::System::PacketBufferHandle buf = aBuffer.Retain(); !buf.IsNull(); buf.Advance())
+    {
+        VerifyOrReturnError(count < INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH, CHIP_ERROR_MESSAGE_TOO_LONG);
+        aIOVs[count].iov_base = buf->Start();
+        aIOVs[count].iov_len  = buf->DataLength();
+        count++;
+    }
+
+    aMsgHeader.msg_iov    = aIOVs;
+    aMsgHeader.msg_iovlen = static_cast<decltype(aMsgHeader.msg_iovlen)>(count);
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * Extract the source address and port of a received datagram, and the interface and destination address reported by
+ * IP_PKTINFO/IPV6_PKTINFO, from the message header filled in by recvmsg() or recvmmsg().
+ */
+CHIP_ERROR GetPacketInfoFromMsgHeader(struct msghdr & aMsgHeader, IPPacketInfo & aPacketInfo)
+{
+    const PeerSockAddr & lPeerSockAddr = *static_cast<const PeerSockAddr *>(aMsgHeader.msg_name);
+
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
+        aPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
+        aPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&aMsgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&aMsgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            aPacketInfo.Interface   = static_cast<InterfaceId>(inPktInfo->ipi_ifindex);
+            aPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            struct in6_pktinfo * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            aPacketInfo.Interface   = static_cast<InterfaceId>(in6PktInfo->ipi6_ifindex);
+            aPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // anonymous namespace
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
@@ -588,6 +785,11 @@ void IPEndPointBasis::Init(InetLayer * aInetLayer)
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     mBoundIntfId = INET_NULL_INTERFACEID;
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+    mNumDeferredMsgs   = 0;
+    mFlushScheduled    = false;
+    mDeferredSendError = CHIP_NO_ERROR;
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
@@ -795,126 +997,196 @@ CHIP_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     // Ensure the destination address type is compatible with the endpoint address type.
     VerifyOrReturnError(mAddrType == aPktInfo->DestAddress.Type(), CHIP_ERROR_INVALID_ARGUMENT);
 
-    // For now the entire message must fit within a single buffer.
-    VerifyOrReturnError(!aBuffer->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
+    struct iovec msgIOVs[INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH];
+    struct msghdr msgHeader;
+    memset(&msgHeader, 0, sizeof(msgHeader));
+    ReturnErrorOnFailure(PrepareSendMsgIOVs(aBuffer, msgIOVs, msgHeader));
+
+    PeerSockAddr peerSockAddr;
+    uint8_t controlData[kControlDataSize];
+    ReturnErrorOnFailure(
+        PrepareSendMsgHeader(mAddrType, mBoundIntfId, *aPktInfo, peerSockAddr, controlData, sizeof(controlData), msgHeader));
 
-    struct iovec msgIOV;
-    msgIOV.iov_base = aBuffer->Start();
-    msgIOV.iov_len  = aBuffer->DataLength();
+    // Send IP packet.
+    const ssize_t lenSent = sendmsg(mSocket.GetFD(), &msgHeader, 0);
+    if (lenSent == -1)
+        return chip::System::MapErrorPOSIX(errno);
+    if (lenSent != aBuffer->TotalLength())
+        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+    return CHIP_NO_ERROR;
+}
 
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+/**
+ *  Queue a message to be sent by FlushDeferredMsgs(), which runs once the current event has been handled or when the
+ *  queue fills, so that the messages sent while handling one event cost a single sendmmsg() call.
+ *
+ *  The message is validated as SendMsg() would, so only errors from the send itself are deferred. The first of those is
+ *  returned by the next call, which then does not queue its message, so that the sender learns of it as it would of a
+ *  failed SendMsg().
+ */
+CHIP_ERROR IPEndPointBasis::DeferMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBufferHandle && aBuffer)
+{
+    if (mDeferredSendError != CHIP_NO_ERROR)
+    {
+        const CHIP_ERROR err = mDeferredSendError;
+        mDeferredSendError   = CHIP_NO_ERROR;
+        return err;
+    }
+
+    VerifyOrReturnError(mAddrType == aPktInfo->DestAddress.Type(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    struct iovec msgIOVs[INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH];
     struct msghdr msgHeader;
     memset(&msgHeader, 0, sizeof(msgHeader));
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
-
-    // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
+    ReturnErrorOnFailure(PrepareSendMsgIOVs(aBuffer, msgIOVs, msgHeader));
     PeerSockAddr peerSockAddr;
-    memset(&peerSockAddr, 0, sizeof(peerSockAddr));
-    msgHeader.msg_name = &peerSockAddr;
-    if (mAddrType == kIPAddressType_IPv6)
+    uint8_t controlData[kControlDataSize];
+    ReturnErrorOnFailure(
+        PrepareSendMsgHeader(mAddrType, mBoundIntfId, *aPktInfo, peerSockAddr, controlData, sizeof(controlData), msgHeader));
+
+    if (!mFlushScheduled)
     {
-        peerSockAddr.in6.sin6_family = AF_INET6;
-        peerSockAddr.in6.sin6_port   = htons(aPktInfo->DestPort);
-        peerSockAddr.in6.sin6_addr   = aPktInfo->DestAddress.ToIPv6();
-        VerifyOrReturnError(CanCastTo<decltype(peerSockAddr.in6.sin6_scope_id)>(aPktInfo->Interface), CHIP_ERROR_INCORRECT_STATE);
-        peerSockAddr.in6.sin6_scope_id = static_cast<decltype(peerSockAddr.in6.sin6_scope_id)>(aPktInfo->Interface);
-        msgHeader.msg_namelen          = sizeof(sockaddr_in6);
+        if (Layer().SystemLayer()->ScheduleWork(HandleFlushDeferredMsgs, this) != CHIP_NO_ERROR)
+        {
+            // Without a flush to rely on, fall back to sending in order right away.
+            FlushDeferredMsgs();
+            return SendMsg(aPktInfo, std::move(aBuffer), 0);
+        }
+        mFlushScheduled = true;
     }
-#if INET_CONFIG_ENABLE_IPV4
-    else
+    else if (mNumDeferredMsgs == INET_CONFIG_UDP_IO_BATCH_SIZE)
     {
-        peerSockAddr.in.sin_family = AF_INET;
-        peerSockAddr.in.sin_port   = htons(aPktInfo->DestPort);
-        peerSockAddr.in.sin_addr   = aPktInfo->DestAddress.ToIPv4();
-        msgHeader.msg_namelen      = sizeof(sockaddr_in);
+        FlushDeferredMsgs();
     }
-#endif // INET_CONFIG_ENABLE_IPV4
 
-    // If the endpoint has been bound to a particular interface,
-    // and the caller didn't supply a specific interface to send
-    // on, use the bound interface. This appears to be necessary
-    // for messages to multicast addresses, which under Linux
-    // don't seem to get sent out the correct interface, despite
-    // the socket being bound.
-    InterfaceId intfId = aPktInfo->Interface;
-    if (intfId == INET_NULL_INTERFACEID)
-        intfId = mBoundIntfId;
+    DeferredMsg & deferred = mDeferredMsgs[mNumDeferredMsgs++];
+    deferred.mDestAddress  = aPktInfo->DestAddress;
+    deferred.mSrcAddress   = aPktInfo->SrcAddress;
+    deferred.mInterface    = aPktInfo->Interface;
+    deferred.mDestPort     = aPktInfo->DestPort;
+    deferred.mBuffer       = std::move(aBuffer);
 
-    // If the packet should be sent over a specific interface, or with a specific source
-    // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
-    // add add it to the message header.  If the local OS doesn't support IP_PKTINFO/IPV6_PKTINFO
-    // fail with an error.
-    if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
+    return CHIP_NO_ERROR;
+}
+
+void IPEndPointBasis::FlushDeferredMsgs()
+{
+    struct mmsghdr msgHeaders[INET_CONFIG_UDP_IO_BATCH_SIZE];
+    struct iovec msgIOVs[INET_CONFIG_UDP_IO_BATCH_SIZE][INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH];
+    PeerSockAddr peerSockAddrs[INET_CONFIG_UDP_IO_BATCH_SIZE];
+    uint8_t controlData[INET_CONFIG_UDP_IO_BATCH_SIZE][kControlDataSize];
+    unsigned int count = 0;
+
+    for (size_t i = 0; i < mNumDeferredMsgs && mSocket.HasFD(); i++)
     {
-#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        uint8_t controlData[256];
-        memset(controlData, 0, sizeof(controlData));
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        DeferredMsg & deferred = mDeferredMsgs[i];
 
-        struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader);
+        IPPacketInfo pktInfo;
+        pktInfo.Clear();
+        pktInfo.DestAddress = deferred.mDestAddress;
+        pktInfo.SrcAddress  = deferred.mSrcAddress;
+        pktInfo.Interface   = deferred.mInterface;
+        pktInfo.DestPort    = deferred.mDestPort;
 
-#if INET_CONFIG_ENABLE_IPV4
+        memset(&msgHeaders[count], 0, sizeof(msgHeaders[count]));
 
-        if (mAddrType == kIPAddressType_IPv4)
+        // Already validated by DeferMsg().
+        if (PrepareSendMsgIOVs(deferred.mBuffer, msgIOVs[count], msgHeaders[count].msg_hdr) == CHIP_NO_ERROR &&
+            PrepareSendMsgHeader(mAddrType, mBoundIntfId, pktInfo, peerSockAddrs[count], controlData[count], kControlDataSize,
+                                 msgHeaders[count].msg_hdr) == CHIP_NO_ERROR)
         {
-#if defined(IP_PKTINFO)
-            controlHdr->cmsg_level = IPPROTO_IP;
-            controlHdr->cmsg_type  = IP_PKTINFO;
-            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in_pktinfo));
-
-            struct in_pktinfo * pktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-            if (!CanCastTo<decltype(pktInfo->ipi_ifindex)>(intfId))
-            {
-                return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
-            }
+            count++;
+        }
+    }
 
-            pktInfo->ipi_ifindex  = static_cast<decltype(pktInfo->ipi_ifindex)>(intfId);
-            pktInfo->ipi_spec_dst = aPktInfo->SrcAddress.ToIPv4();
+    // Messages that sendmmsg() reported as failed, so that they are not also reported as truncated.
+    bool failed[INET_CONFIG_UDP_IO_BATCH_SIZE] = {};
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
-#else  // !defined(IP_PKTINFO)
-            return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
-#endif // !defined(IP_PKTINFO)
+    unsigned int sent = 0;
+    while (sent < count)
+    {
+        const int res = sendmmsg(mSocket.GetFD(), &msgHeaders[sent], count - sent, 0);
+        if (res > 0)
+        {
+            sent += static_cast<unsigned int>(res);
+            continue;
+        }
+        if (errno == EINTR)
+        {
+            continue;
         }
 
-#endif // INET_CONFIG_ENABLE_IPV4
+        // sendmmsg() fails only for the first message of those passed; drop it, as SendMsg() would have, and go on.
+        const CHIP_ERROR err = chip::System::MapErrorPOSIX(errno);
+        ChipLogError(Inet, "Deferred UDP send failed: %s", ErrorStr(err));
+        RecordDeferredSendError(err);
+        failed[sent++] = true;
+    }
 
-        if (mAddrType == kIPAddressType_IPv6)
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (failed[i])
         {
-#if defined(IPV6_PKTINFO)
-            controlHdr->cmsg_level = IPPROTO_IPV6;
-            controlHdr->cmsg_type  = IPV6_PKTINFO;
-            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in6_pktinfo));
-
-            struct in6_pktinfo * pktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-            if (!CanCastTo<decltype(pktInfo->ipi6_ifindex)>(intfId))
-            {
-                return CHIP_ERROR_UNEXPECTED_EVENT;
-            }
-            pktInfo->ipi6_ifindex = static_cast<decltype(pktInfo->ipi6_ifindex)>(intfId);
-            pktInfo->ipi6_addr    = aPktInfo->SrcAddress.ToIPv6();
+            continue;
+        }
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
-#else  // !defined(IPV6_PKTINFO)
-            return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
-#endif // !defined(IPV6_PKTINFO)
+        size_t length = 0;
+        for (size_t j = 0; j < msgHeaders[i].msg_hdr.msg_iovlen; j++)
+        {
+            length += msgIOVs[i][j].iov_len;
         }
+        if (msgHeaders[i].msg_len != length)
+        {
+            ChipLogError(Inet, "Deferred UDP send truncated: %u of %u bytes", msgHeaders[i].msg_len,
+                         static_cast<unsigned int>(length));
+            RecordDeferredSendError(CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG);
+        }
+    }
 
-#else  // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
-        return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
-#endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
+    for (size_t i = 0; i < mNumDeferredMsgs; i++)
+    {
+        mDeferredMsgs[i].mBuffer = nullptr;
     }
+    mNumDeferredMsgs = 0;
+}
 
-    // Send IP packet.
-    const ssize_t lenSent = sendmsg(mSocket.GetFD(), &msgHeader, 0);
-    if (lenSent == -1)
-        return chip::System::MapErrorPOSIX(errno);
-    if (lenSent != aBuffer->DataLength())
-        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
-    return CHIP_NO_ERROR;
+void IPEndPointBasis::RecordDeferredSendError(CHIP_ERROR aError)
+{
+    if (mDeferredSendError == CHIP_NO_ERROR)
+    {
+        mDeferredSendError = aError;
+    }
 }
 
+void IPEndPointBasis::HandleFlushDeferredMsgs(chip::System::Layer * aLayer, void * aAppState, CHIP_ERROR aError)
+{
+    IPEndPointBasis * const lEndPoint = static_cast<IPEndPointBasis *>(aAppState);
+
+    lEndPoint->mFlushScheduled = false;
+    lEndPoint->FlushDeferredMsgs();
+}
+
+/**
+ *  Send any deferred messages and free the buffers held for batched receive. Must be called before the socket is closed.
+ */
+void IPEndPointBasis::ReleaseBatchedIO()
+{
+    if (mFlushScheduled)
+    {
+        Layer().SystemLayer()->CancelTimer(HandleFlushDeferredMsgs, this);
+        mFlushScheduled = false;
+    }
+
+    FlushDeferredMsgs();
+
+    for (System::PacketBufferHandle & lBuffer : mRecvBuffers)
+    {
+        lBuffer = nullptr;
+    }
+}
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+
 CHIP_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int aProtocol)
 {
     if (!mSocket.HasFD())
@@ -1028,6 +1300,9 @@ CHIP_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int
 
 void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 {
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+    HandlePendingIOBatched(aPort);
+#else  // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -1041,7 +1316,7 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
     {
         struct iovec msgIOV;
         PeerSockAddr lPeerSockAddr;
-        uint8_t controlData[256];
+        uint8_t controlData[kControlDataSize];
         struct msghdr msgHeader;
 
         msgIOV.iov_base = lBuffer->Start();
@@ -1071,62 +1346,7 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = static_cast<InterfaceId>(inPktInfo->ipi_ifindex);
-                    lPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = static_cast<InterfaceId>(in6PktInfo->ipi6_ifindex);
-                    lPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = GetPacketInfoFromMsgHeader(msgHeader, lPacketInfo);
         }
     }
     else
@@ -1146,7 +1366,92 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
             OnReceiveError(this, lStatus, nullptr);
         }
     }
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+}
+
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+void IPEndPointBasis::HandlePendingIOBatched(uint16_t aPort)
+{
+    struct mmsghdr msgHeaders[INET_CONFIG_UDP_IO_BATCH_SIZE];
+    struct iovec msgIOVs[INET_CONFIG_UDP_IO_BATCH_SIZE];
+    PeerSockAddr peerSockAddrs[INET_CONFIG_UDP_IO_BATCH_SIZE];
+    uint8_t controlData[INET_CONFIG_UDP_IO_BATCH_SIZE][kControlDataSize];
+    unsigned int count = 0;
+
+    // Receive into whichever buffers were left over from the last wakeup, topping them up to a full batch.
+    for (; count < INET_CONFIG_UDP_IO_BATCH_SIZE; count++)
+    {
+        System::PacketBufferHandle & lBuffer = mRecvBuffers[count];
+        if (lBuffer.IsNull())
+        {
+            lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (lBuffer.IsNull())
+            {
+                break;
+            }
+        }
+
+        msgIOVs[count].iov_base = lBuffer->Start();
+        msgIOVs[count].iov_len  = lBuffer->AvailableDataLength();
+
+        memset(&peerSockAddrs[count], 0, sizeof(peerSockAddrs[count]));
+        memset(&msgHeaders[count], 0, sizeof(msgHeaders[count]));
+
+        msgHeaders[count].msg_hdr.msg_name       = &peerSockAddrs[count];
+        msgHeaders[count].msg_hdr.msg_namelen    = sizeof(peerSockAddrs[count]);
+        msgHeaders[count].msg_hdr.msg_iov        = &msgIOVs[count];
+        msgHeaders[count].msg_hdr.msg_iovlen     = 1;
+        msgHeaders[count].msg_hdr.msg_control    = controlData[count];
+        msgHeaders[count].msg_hdr.msg_controllen = kControlDataSize;
+    }
+
+    const int received = (count > 0) ? recvmmsg(mSocket.GetFD(), msgHeaders, count, MSG_DONTWAIT, nullptr) : 0;
+    if (received <= 0)
+    {
+        const CHIP_ERROR lStatus = (count > 0) ? chip::System::MapErrorPOSIX(errno) : CHIP_ERROR_NO_MEMORY;
+        if (OnReceiveError != nullptr && lStatus != chip::System::MapErrorPOSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+        return;
+    }
+
+    // A handler may close or free the endpoint; hold a reference so the rest of the batch can be dropped safely.
+    Retain();
+
+    for (int i = 0; i < received && mState == kState_Listening && OnMessageReceived != nullptr; i++)
+    {
+        CHIP_ERROR lStatus                 = CHIP_NO_ERROR;
+        System::PacketBufferHandle lBuffer = std::move(mRecvBuffers[i]);
+        IPPacketInfo lPacketInfo;
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort = aPort;
+
+        if (msgHeaders[i].msg_len > lBuffer->AvailableDataLength())
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength(static_cast<uint16_t>(msgHeaders[i].msg_len));
+            lStatus = GetPacketInfoFromMsgHeader(msgHeaders[i].msg_hdr, lPacketInfo);
+        }
+
+        if (lStatus == CHIP_NO_ERROR)
+        {
+            lBuffer.RightSize();
+            OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        }
+        else if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+    }
+
+    Release();
 }
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
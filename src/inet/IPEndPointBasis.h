@@ -139,6 +139,43 @@ protected:
     CHIP_ERROR SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBufferHandle && aBuffer, uint16_t aSendFlags);
     CHIP_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     void HandlePendingIO(uint16_t aPort);
+
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+#if !(HAVE_RECVMMSG && HAVE_SENDMMSG)
+#error "INET_CONFIG_UDP_IO_BATCH_SIZE > 1 requires recvmmsg() and sendmmsg()"
+#endif // !(HAVE_RECVMMSG && HAVE_SENDMMSG)
+
+    CHIP_ERROR DeferMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBufferHandle && aBuffer);
+    void FlushDeferredMsgs();
+    void ReleaseBatchedIO();
+
+private:
+    /**
+     * A datagram queued by DeferMsg(). IPPacketInfo is not a complete type here, so its fields are held individually.
+     */
+    struct DeferredMsg
+    {
+        IPAddress mDestAddress;
+        IPAddress mSrcAddress;
+        InterfaceId mInterface;
+        uint16_t mDestPort;
+        chip::System::PacketBufferHandle mBuffer;
+    };
+
+    static void HandleFlushDeferredMsgs(chip::System::Layer * aLayer, void * aAppState, CHIP_ERROR aError);
+    void RecordDeferredSendError(CHIP_ERROR aError);
+    void HandlePendingIOBatched(uint16_t aPort);
+
+    DeferredMsg mDeferredMsgs[INET_CONFIG_UDP_IO_BATCH_SIZE];
+    size_t mNumDeferredMsgs;
+    bool mFlushScheduled;
+    CHIP_ERROR mDeferredSendError; // First failure of a deferred send, returned by the next DeferMsg()
+
+    // Receive buffers are allocated ahead of recvmmsg() and the unused ones are kept for the next wakeup.
+    chip::System::PacketBufferHandle mRecvBuffers[INET_CONFIG_UDP_IO_BATCH_SIZE];
+
+protected:
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -479,4 +479,43 @@
 #ifndef INET_CONFIG_IP_MULTICAST_HOP_LIMIT
 #define INET_CONFIG_IP_MULTICAST_HOP_LIMIT                 (64)
 #endif // INET_CONFIG_IP_MULTICAST_HOP_LIMIT
+
+/**
+ *  @def INET_CONFIG_UDP_IO_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams that a sockets-based UDP
+ *    endpoint moves with a single system call.
+ *
+ *  @details
+ *    When greater than 1, a readable endpoint drains up to this many
+ *    datagrams with one recvmmsg() call, and sends made with
+ *    UDPEndPoint::kSendFlag_Deferred are queued and written with one
+ *    sendmmsg() call once the current event has been handled.  This
+ *    requires the platform to define HAVE_RECVMMSG and HAVE_SENDMMSG.
+ *
+ *    A value of 1 disables batching: each datagram is received with
+ *    recvmsg() and sent with sendmsg().  Linux enables batching by
+ *    default.
+ */
+#ifndef INET_CONFIG_UDP_IO_BATCH_SIZE
+#define INET_CONFIG_UDP_IO_BATCH_SIZE                      1
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH
+ *
+ *  @brief
+ *    The maximum number of buffers in a chained PacketBuffer that a
+ *    sockets-based UDP endpoint sends as one datagram.
+ *
+ *  @details
+ *    Each buffer of the chain is passed to sendmsg() or sendmmsg() as
+ *    one element of the scatter/gather array, so that the message is
+ *    not copied into a single buffer first.  Sending a longer chain
+ *    fails with #CHIP_ERROR_MESSAGE_TOO_LONG.
+ */
+#ifndef INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH
+#define INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH              4
+#endif // INET_CONFIG_UDP_SEND_MAX_CHAIN_LENGTH
 // clang-format on
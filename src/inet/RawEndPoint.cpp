@@ -466,6 +466,10 @@ void RawEndPoint::Close()
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+        ReleaseBatchedIO();
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+
         if (mSocket.HasFD())
         {
             mSocket.Close();
@@ -392,6 +392,10 @@ void UDPEndPoint::Close()
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+        ReleaseBatchedIO();
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+
         if (mSocket.HasFD())
         {
             mSocket.Close();
@@ -648,6 +652,13 @@ CHIP_ERROR UDPEndPoint::SendMsg(const IPPacketInfo * pktInfo, System::PacketBuff
     res = GetSocket(destAddr.Type());
     SuccessOrExit(res);
 
+#if INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+    if (sendFlags & kSendFlag_Deferred)
+    {
+        ExitNow(res = IPEndPointBasis::DeferMsg(pktInfo, std::move(msg)));
+    }
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+
     res = IPEndPointBasis::SendMsg(pktInfo, std::move(msg), sendFlags);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -56,6 +56,20 @@ class DLL_EXPORT UDPEndPoint : public IPEndPointBasis
     friend class InetLayer;
 
 public:
+    /**
+     * Flags accepted by SendTo() and SendMsg().
+     */
+    enum
+    {
+        /**
+         * Queue the message and send it, together with any others queued during the current event, once that event has been
+         * handled. Only honored by sockets-based endpoints with INET_CONFIG_UDP_IO_BATCH_SIZE greater than 1; elsewhere the
+         * message is sent immediately. The send itself fails after the call has returned, so its error is returned by the
+         * next deferred send on the endpoint, which then does not queue its own message.
+         */
+        kSendFlag_Deferred = 0x0001,
+    };
+
     CHIP_ERROR Bind(IPAddressType addrType, const IPAddress & addr, uint16_t port, InterfaceId intfId = INET_NULL_INTERFACEID);
     CHIP_ERROR BindInterface(IPAddressType addrType, InterfaceId intfId);
     InterfaceId GetBoundInterface();
@@ -165,6 +165,30 @@ CHIP_ERROR CHIPCircularTLVBuffer::EvictHead()
     return CHIP_NO_ERROR;
 }
 
+/**
+ * @brief
+ *   Discards the data written past a previous tail of the buffer
+ *
+ * A TLVWriter commits data to the buffer as it goes, evicting elements
+ * from the head when it runs out of space.  This function drops a
+ * partially written element, e.g. when the writer failed, while keeping
+ * the current head: elements evicted in the meantime stay evicted.
+ *
+ * @param[in] inTail  The tail of the buffer before the element was
+ *                    started, as returned by QueueTail()
+ */
+void CHIPCircularTLVBuffer::DiscardTail(uint8_t * inTail)
+{
+    if (inTail >= mQueueHead)
+    {
+        mQueueLength = static_cast<uint32_t>(inTail - mQueueHead);
+    }
+    else
+    {
+        mQueueLength = mQueueSize - static_cast<uint32_t>(mQueueHead - inTail);
+    }
+}
+
 /**
  * @brief
  *  Implements TLVBackingStore::OnInit(TLVWriter) for circular buffers.
@@ -69,6 +69,7 @@ public:
     inline uint8_t * GetQueue() const { return mQueue; }
 
     CHIP_ERROR EvictHead();
+    void DiscardTail(uint8_t * inTail);
 
     // chip::TLV::TLVBackingStore overrides:
     CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
@@ -172,6 +173,20 @@ public:
      *
      */
     void Init(CHIPCircularTLVBuffer & buf) { TLVWriter::Init(buf, UINT32_MAX); }
+
+    /**
+     * @brief
+     *   Initializes a TLVWriter object to write from a single CHIPCircularTLVBuffer,
+     *   failing with #CHIP_ERROR_BUFFER_TOO_SMALL past maxLen bytes
+     *
+     * @param[in]    buf     A pointer to a fully initialized CHIPCircularTLVBuffer
+     * @param[in]    maxLen  The maximum number of bytes to write
+     *
+     * @retval #CHIP_NO_ERROR  On success.
+     * @retval other           If no space could be made for the first byte.
+     *
+     */
+    CHIP_ERROR Init(CHIPCircularTLVBuffer & buf, uint32_t maxLen) { return TLVWriter::Init(buf, maxLen); }
 };
 
 } // namespace TLV
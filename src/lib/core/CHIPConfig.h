@@ -1204,6 +1204,36 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def CHIP_CONFIG_POOL_USE_HEAP
+ *
+ *  @brief
+ *    Allocate exchange and channel contexts from the heap, through a
+ *    HeapObjectPool, instead of from a BitMapObjectPool of a fixed size.
+ *
+ *  @details
+ *    With this enabled, the maximum numbers of these objects, e.g.
+ *    #CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, are only limited by the heap,
+ *    which suits platforms that have one to spare, such as POSIX ones.
+ *
+ */
+#ifndef CHIP_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_POOL_USE_HEAP 0
+#endif // CHIP_CONFIG_POOL_USE_HEAP
+
+/**
+ *  @def CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES
+ *
+ *  @brief
+ *    Maximum number of CASE session establishments a responder runs at
+ *    the same time. Further SigmaR1 messages are answered with a busy
+ *    status report until one of the handshakes completes or times out.
+ *
+ */
+#ifndef CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES
+#define CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES 4
+#endif // CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES
+
 /**
  *  @def CHIP_CONFIG_MAX_ACTIVE_CHANNELS
  *
@@ -2278,6 +2308,18 @@
 #define CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE 16
 #endif // CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_PEER_CONNECTION_INDEX
+ *
+ * @brief Enable hash indexes over the peer connection pool, so that
+ * looking up a session by key id, node id or address does not scan
+ * the whole pool. Recommended when CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE
+ * is large, at the cost of a few bytes of RAM per pool entry.
+ */
+#ifndef CHIP_CONFIG_PEER_CONNECTION_INDEX
+#define CHIP_CONFIG_PEER_CONNECTION_INDEX 0
+#endif // CHIP_CONFIG_PEER_CONNECTION_INDEX
+
 /**
  * @def CHIP_PEER_CONNECTION_TIMEOUT_MS
  *
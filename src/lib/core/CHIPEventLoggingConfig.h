@@ -89,3 +89,17 @@
 #ifndef CHIP_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 #define CHIP_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 0
 #endif
+
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES
+ *
+ * @brief
+ *   The number of entries in the sparse index each event buffer keeps
+ *   of where events of a given number start, so that fetching events
+ *   does not need to read the buffer from its oldest event.  Entries
+ *   are spread at least 1/CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES of
+ *   the buffer apart.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_ENTRIES 8
+#endif
@@ -1819,6 +1819,45 @@ public:
      * @return the total remaining number of bytes.
      */
     uint32_t GetRemainingFreeLength() const { return mRemainingLen; }
+
+    /**
+     * Sets aside space in the current buffer that subsequent writes cannot use, so that a caller can
+     * fill the buffer with elements that are allowed to run out of room and still be sure to fit the
+     * fields that must follow them.
+     *
+     * @param[in] aBufferSize   The number of bytes to set aside.
+     *
+     * @retval #CHIP_NO_ERROR               If the space was set aside.
+     * @retval #CHIP_ERROR_NO_MEMORY        If fewer than @p aBufferSize bytes remain.
+     */
+    CHIP_ERROR ReserveBuffer(uint32_t aBufferSize)
+    {
+        if (mRemainingLen < aBufferSize || mMaxLen - mLenWritten < aBufferSize)
+            return CHIP_ERROR_NO_MEMORY;
+        mReservedSize += aBufferSize;
+        mRemainingLen -= aBufferSize;
+        mMaxLen -= aBufferSize;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Returns space set aside by ReserveBuffer() to subsequent writes.
+     *
+     * @param[in] aBufferSize   The number of bytes to release.
+     *
+     * @retval #CHIP_NO_ERROR               If the space was released.
+     * @retval #CHIP_ERROR_INCORRECT_STATE  If fewer than @p aBufferSize bytes are set aside.
+     */
+    CHIP_ERROR UnreserveBuffer(uint32_t aBufferSize)
+    {
+        if (mReservedSize < aBufferSize)
+            return CHIP_ERROR_INCORRECT_STATE;
+        mReservedSize -= aBufferSize;
+        mRemainingLen += aBufferSize;
+        mMaxLen += aBufferSize;
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * The profile id of tags that should be encoded in implicit form.
      *
@@ -1849,6 +1888,7 @@ protected:
     uint32_t mRemainingLen;
     uint32_t mLenWritten;
     uint32_t mMaxLen;
+    uint32_t mReservedSize;
     TLVType mContainerType;
 
 private:
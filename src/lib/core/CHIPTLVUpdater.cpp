@@ -105,6 +105,7 @@ CHIP_ERROR TLVUpdater::Init(TLVReader & aReader, uint32_t freeLen)
     mUpdaterWriter.mRemainingLen  = freeLen;
     mUpdaterWriter.mLenWritten    = readDataLen;
     mUpdaterWriter.mMaxLen        = readDataLen + freeLen;
+    mUpdaterWriter.mReservedSize  = 0;
     mUpdaterWriter.mContainerType = aReader.mContainerType;
     mUpdaterWriter.SetContainerOpen(false);
     mUpdaterWriter.SetCloseContainerReserved(false);
@@ -2154,6 +2154,66 @@ void CheckCircularTLVBufferEvictStraddlingEvent(nlTestSuite * inSuite, void * in
     TestEnd<TLVReader>(inSuite, reader);
 }
 
+void CheckCircularTLVBufferDiscardTail(nlTestSuite * inSuite, void * inContext)
+{
+    // Write 11 byte elements into a 33 byte buffer that starts midway,
+    // and discard the ones written after a checkpoint, with and
+    // without evicting anything on the way.
+
+    uint8_t backingStore[33];
+    CircularTLVWriter writer;
+    CircularTLVReader reader;
+    TestTLVContext * context = static_cast<TestTLVContext *>(inContext);
+    CHIPCircularTLVBuffer buffer(backingStore, 33, &(backingStore[16]));
+    uint8_t * tail;
+    writer.Init(buffer);
+    writer.ImplicitProfileId = TestProfile_2;
+
+    context->mEvictionCount = 0;
+    context->mEvictedBytes  = 0;
+
+    buffer.mProcessEvictedElement = CountEvictedMembers;
+    buffer.mAppData               = inContext;
+
+    WriteEncoding3(inSuite, writer);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 11);
+
+    // Fill the buffer, wrapping around, then drop what came after the first element.
+    tail = buffer.QueueTail();
+    WriteEncoding3(inSuite, writer);
+    WriteEncoding3(inSuite, writer);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 33);
+
+    buffer.DiscardTail(tail);
+    NL_TEST_ASSERT(inSuite, context->mEvictionCount == 0);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 11);
+
+    reader.Init(buffer);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext<TLVReader>(inSuite, reader);
+
+    ReadEncoding3(inSuite, reader);
+
+    TestEnd<TLVReader>(inSuite, reader);
+
+    // Elements evicted while writing past the checkpoint stay evicted.
+    tail = buffer.QueueTail();
+    writer.Init(buffer);
+    writer.ImplicitProfileId = TestProfile_2;
+    WriteEncoding3(inSuite, writer);
+    WriteEncoding3(inSuite, writer);
+    WriteEncoding3(inSuite, writer);
+    NL_TEST_ASSERT(inSuite, context->mEvictionCount == 1);
+
+    buffer.DiscardTail(tail);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 0);
+    NL_TEST_ASSERT(inSuite, buffer.QueueTail() == tail);
+
+    reader.Init(buffer);
+    TestEnd<TLVReader>(inSuite, reader);
+}
+
 void CheckCircularTLVBufferEdge(nlTestSuite * inSuite, void * inContext)
 {
     TestTLVContext * context = static_cast<TestTLVContext *>(inContext);
@@ -3523,6 +3583,38 @@ static void CheckCloseContainerReserve(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ * Test TLV buffer reservations
+ */
+static void CheckBufferReserve(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[8];
+    TLVWriter writer;
+    TLVWriter checkpoint;
+    TLVType container;
+
+    writer.Init(buf, sizeof(buf));
+
+    NL_TEST_ASSERT(inSuite, writer.ReserveBuffer(sizeof(buf) + 1) == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, writer.ReserveBuffer(3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetRemainingFreeLength() == sizeof(buf) - 3);
+
+    // The reserved bytes are not available to elements, and the container can still be closed.
+    NL_TEST_ASSERT(inSuite, writer.StartContainer(AnonymousTag, kTLVType_Array, container) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Put(AnonymousTag, static_cast<uint8_t>(1)) == CHIP_NO_ERROR);
+    checkpoint = writer;
+    NL_TEST_ASSERT(inSuite, writer.Put(AnonymousTag, static_cast<uint8_t>(2)) != CHIP_NO_ERROR);
+    writer = checkpoint;
+    NL_TEST_ASSERT(inSuite, writer.EndContainer(container) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, writer.UnreserveBuffer(4) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, writer.UnreserveBuffer(3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Put(AnonymousTag, static_cast<uint8_t>(3)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.PutBoolean(AnonymousTag, true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == 7);
+}
+
 static CHIP_ERROR ReadFuzzedEncoding1(nlTestSuite * inSuite, TLVReader & reader)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -3764,10 +3856,12 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("CHIP Circular TLV buffer, straddle",  CheckCircularTLVBufferEvictStraddlingEvent),
     NL_TEST_DEF("CHIP Circular TLV buffer, edge",      CheckCircularTLVBufferEdge),
+    NL_TEST_DEF("CHIP Circular TLV buffer, discard tail", CheckCircularTLVBufferDiscardTail),
     NL_TEST_DEF("CHIP TLV Printf",                     CheckCHIPTLVPutStringF),
     NL_TEST_DEF("CHIP TLV Printf, Circular TLV buf",   CheckCHIPTLVPutStringFCircular),
     NL_TEST_DEF("CHIP TLV Skip non-contiguous",        CheckCHIPTLVSkipCircular),
     NL_TEST_DEF("CHIP TLV Check reserve",              CheckCloseContainerReserve),
+    NL_TEST_DEF("CHIP TLV Buffer reserve",             CheckBufferReserve),
     NL_TEST_DEF("CHIP TLV Reader Fuzz Test",           TLVReaderFuzzTest),
 
     NL_TEST_SENTINEL()
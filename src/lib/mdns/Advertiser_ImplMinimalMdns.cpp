@@ -98,8 +98,7 @@ void LogQuery(const QueryData & data) {}
 #endif
 
 class AdvertiserMinMdns : public ServiceAdvertiser,
-                          public MdnsPacketDelegate, // receive query packets
-                          public ParserDelegate      // parses queries
+                          public MdnsPacketDelegate // receive query packets
 {
 public:
     AdvertiserMinMdns() : mResponseSender(&GlobalMinimalMdnsServer::Server())
@@ -121,11 +120,6 @@ public:
     // MdnsPacketDelegate
     void OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info) override;
 
-    // ParserDelegate
-    void OnHeader(ConstHeaderRef & header) override { mMessageId = header.GetMessageId(); }
-    void OnResource(ResourceType type, const ResourceData & data) override {}
-    void OnQuery(const QueryData & data) override;
-
 private:
     /// Advertise available records configured within the server
     ///
@@ -150,10 +144,6 @@ private:
     uint32_t mCommissionInstanceName1;
     uint32_t mCommissionInstanceName2;
 
-    // current request handling
-    const chip::Inet::IPPacketInfo * mCurrentSource = nullptr;
-    uint32_t mMessageId                             = 0;
-
     const char * mEmptyTextEntries[1] = {
         "=",
     };
@@ -165,25 +155,17 @@ void AdvertiserMinMdns::OnMdnsPacketData(const BytesRange & data, const chip::In
     ChipLogDetail(Discovery, "MinMdns received a query.");
 #endif
 
-    mCurrentSource = info;
-    if (!ParsePacket(data, this))
+    QueryPacket queryPacket;
+    if (!queryPacket.Parse(data))
     {
         ChipLogError(Discovery, "Failed to parse mDNS query");
-    }
-    mCurrentSource = nullptr;
-}
-
-void AdvertiserMinMdns::OnQuery(const QueryData & data)
-{
-    if (mCurrentSource == nullptr)
-    {
-        ChipLogError(Discovery, "INTERNAL CONSISTENCY ERROR: missing query source");
         return;
     }
 
-    LogQuery(data);
+    queryPacket.ForEachQuery([](const QueryData & query) { LogQuery(query); });
 
-    CHIP_ERROR err = mResponseSender.Respond(mMessageId, data, mCurrentSource);
+    // All queries of the packet are answered at once, without the answers the querier already knows.
+    CHIP_ERROR err = mResponseSender.Respond(queryPacket, info);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Discovery, "Failed to reply to query: %s", ErrorStr(err));
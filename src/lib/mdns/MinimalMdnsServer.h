@@ -84,6 +84,10 @@ public:
     void SetQueryDelegate(MdnsPacketDelegate * delegate) { mQueryDelegate = delegate; }
     void SetResponseDelegate(MdnsPacketDelegate * delegate) { mResponseDelegate = delegate; }
 
+    /// Queries are also passed to an observer, which does not answer them but
+    /// may notice questions that other hosts already asked.
+    void SetQueryObserver(MdnsPacketDelegate * delegate) { mQueryObserver = delegate; }
+
     // ServerDelegate implementation
     void OnQuery(const mdns::Minimal::BytesRange & data, const chip::Inet::IPPacketInfo * info) override
     {
@@ -91,6 +95,10 @@ public:
         {
             mQueryDelegate->OnMdnsPacketData(data, info);
         }
+        if (mQueryObserver != nullptr)
+        {
+            mQueryObserver->OnMdnsPacketData(data, info);
+        }
     }
 
     void OnResponse(const mdns::Minimal::BytesRange & data, const chip::Inet::IPPacketInfo * info) override
@@ -105,6 +113,7 @@ private:
     ServerType mServer;
     MdnsPacketDelegate * mQueryDelegate    = nullptr;
     MdnsPacketDelegate * mResponseDelegate = nullptr;
+    MdnsPacketDelegate * mQueryObserver    = nullptr;
 };
 
 } // namespace Mdns
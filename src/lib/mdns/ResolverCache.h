@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace chip {
+namespace Mdns {
+
+/// Holds up to kEntryCount resolution results for as long as the TTL of the
+/// records they were built from.
+///
+/// Entries are looked up with a caller-provided predicate, so the same cache
+/// works for operational data (keyed by PeerId) and for discovered nodes
+/// (keyed by instance name). When the cache is full, inserting a new entry
+/// evicts the one closest to expiring.
+///
+/// Time is passed in explicitly, in monotonic milliseconds.
+template <typename T, size_t kEntryCount>
+class ResolverCache
+{
+public:
+    /// Percentage of the TTL after which an entry still in use should be
+    /// refreshed, as RFC 6762 section 5.2 suggests.
+    static constexpr uint64_t kRefreshPercent = 80;
+
+    static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+    struct Entry
+    {
+        T data;
+        uint64_t expiryMs   = 0;
+        uint64_t refreshMs  = 0;
+        uint32_t ttlSeconds = 0;     ///< TTL the entry was inserted with
+        bool inUse          = false; ///< Looked up since the entry was last inserted, so worth refreshing
+        bool refreshSent    = false; ///< A refresh query went out for the current records
+        bool answerPending  = false; ///< A cached answer is waiting to be delivered
+
+        bool IsLive(uint64_t nowMs) const { return nowMs < expiryMs; }
+
+        /// Whether at least half of the TTL is left, so that the records can
+        /// be listed as known answers (RFC 6762 section 7.1).
+        bool IsFresh(uint64_t nowMs) const
+        {
+            return IsLive(nowMs) && ((expiryMs - nowMs) * 2 >= static_cast<uint64_t>(ttlSeconds) * 1000);
+        }
+
+        /// Remaining TTL, in seconds.
+        uint32_t RemainingTtlSeconds(uint64_t nowMs) const
+        {
+            return IsLive(nowMs) ? static_cast<uint32_t>((expiryMs - nowMs) / 1000) : 0;
+        }
+    };
+
+    /// Adds data, or replaces the live entry that matches it. A TTL of 0 (an
+    /// mDNS "goodbye") removes the entry instead.
+    template <typename Matcher>
+    void Insert(const T & data, Matcher && matches, uint32_t ttlSeconds, uint64_t nowMs)
+    {
+        if (ttlSeconds == 0)
+        {
+            Remove(matches);
+            return;
+        }
+
+        Entry * slot = Find(matches, nowMs);
+        if (slot == nullptr)
+        {
+            slot = &mEntries[0];
+            for (Entry & entry : mEntries)
+            {
+                if (entry.expiryMs < slot->expiryMs)
+                {
+                    slot = &entry;
+                }
+            }
+        }
+
+        const uint64_t ttlMs = static_cast<uint64_t>(ttlSeconds) * 1000;
+
+        slot->data          = data;
+        slot->expiryMs      = nowMs + ttlMs;
+        slot->refreshMs     = nowMs + ttlMs * kRefreshPercent / 100;
+        slot->ttlSeconds    = ttlSeconds;
+        slot->inUse         = false;
+        slot->refreshSent   = false;
+        slot->answerPending = false;
+    }
+
+    /// Returns the live entry that matches, or nullptr.
+    template <typename Matcher>
+    Entry * Find(Matcher && matches, uint64_t nowMs)
+    {
+        for (Entry & entry : mEntries)
+        {
+            if (entry.IsLive(nowMs) && matches(entry.data))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename Matcher>
+    void Remove(Matcher && matches)
+    {
+        for (Entry & entry : mEntries)
+        {
+            if (entry.expiryMs != 0 && matches(entry.data))
+            {
+                entry = Entry();
+            }
+        }
+    }
+
+    /// Calls fn on every live entry.
+    template <typename Function>
+    void ForEach(uint64_t nowMs, Function && fn)
+    {
+        for (Entry & entry : mEntries)
+        {
+            if (entry.IsLive(nowMs))
+            {
+                fn(entry);
+            }
+        }
+    }
+
+    /// The earliest refresh time of the live entries that are in use and have
+    /// not been refreshed yet, or kNever.
+    uint64_t NextRefreshMs(uint64_t nowMs) const
+    {
+        uint64_t next = kNever;
+        for (const Entry & entry : mEntries)
+        {
+            if (entry.IsLive(nowMs) && entry.inUse && !entry.refreshSent && entry.refreshMs < next)
+            {
+                next = entry.refreshMs;
+            }
+        }
+        return next;
+    }
+
+    void Clear()
+    {
+        for (Entry & entry : mEntries)
+        {
+            entry = Entry();
+        }
+    }
+
+private:
+    Entry mEntries[kEntryCount];
+};
+
+} // namespace Mdns
+} // namespace chip
@@ -17,18 +17,25 @@
 
 #include "Resolver.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "MinimalMdnsServer.h"
+#include "ResolverCache.h"
 #include "ServiceNaming.h"
 
 #include <mdns/TxtFields.h>
 #include <mdns/minimal/Parser.h>
+#include <mdns/minimal/PendingQueries.h>
 #include <mdns/minimal/QueryBuilder.h>
+#include <mdns/minimal/QueryPacket.h>
 #include <mdns/minimal/RecordData.h>
 #include <mdns/minimal/core/FlatAllocatedQName.h>
+#include <mdns/minimal/records/Ptr.h>
 
+#include <support/RandUtils.h>
 #include <support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
 
 // MDNS servers will receive all broadcast packets over the network.
 // Disable 'invalid packet' messages because the are expected and common
@@ -68,15 +75,50 @@ void TxtRecordDelegateImpl::OnRecord(const mdns::Minimal::BytesRange & name, con
 constexpr size_t kMdnsMaxPacketSize = 1024;
 constexpr uint16_t kMdnsPort        = 5353;
 
+constexpr size_t kOperationalCacheSize = 16;
+constexpr size_t kDiscoveredCacheSize  = 8;
+
+// Browse queries are sent after a random delay, as RFC 6762 section 5.2 suggests for
+// queries that many hosts may send at the same time.
+constexpr uint32_t kBrowseMinDelayMs = 20;
+constexpr uint32_t kBrowseMaxDelayMs = 120;
+
+// Browses for different services or filters that may wait for their send delay at the same time.
+constexpr size_t kMaxPendingBrowses = 4;
+
+using PendingBrowses = mdns::Minimal::PendingQueries<kMaxPendingBrowses>;
+
+/// A commissionable node or commissioner, as remembered by the resolver.
+struct DiscoveredCacheData
+{
+    DiscoveryType mType;
+    DiscoveredNodeData mData;
+};
+
+using OperationalCache = ResolverCache<ResolvedNodeData, kOperationalCacheSize>;
+using DiscoveredCache  = ResolverCache<DiscoveredCacheData, kDiscoveredCacheSize>;
+
+auto MatchPeerId(const PeerId & peerId)
+{
+    return [&peerId](const ResolvedNodeData & data) { return data.mPeerId == peerId; };
+}
+
+auto MatchInstance(DiscoveryType type, const char * instanceName)
+{
+    return [type, instanceName](const DiscoveredCacheData & data) {
+        return data.mType == type && strcmp(data.mData.instanceName, instanceName) == 0;
+    };
+}
+
 using namespace mdns::Minimal;
 
 class PacketDataReporter : public ParserDelegate
 {
 public:
     PacketDataReporter(ResolverDelegate * delegate, chip::Inet::InterfaceId interfaceId, DiscoveryType discoveryType,
-                       const BytesRange & packet) :
+                       const BytesRange & packet, OperationalCache & operationalCache, DiscoveredCache & discoveredCache) :
         mDelegate(delegate),
-        mDiscoveryType(discoveryType), mPacketRange(packet)
+        mDiscoveryType(discoveryType), mPacketRange(packet), mOperationalCache(operationalCache), mDiscoveredCache(discoveredCache)
     {
         mNodeData.mInterfaceId = interfaceId;
     }
@@ -96,11 +138,26 @@ private:
     ResolvedNodeData mNodeData;
     DiscoveredNodeData mDiscoveredNodeData;
     BytesRange mPacketRange;
+    OperationalCache & mOperationalCache;
+    DiscoveredCache & mDiscoveredCache;
 
     bool mValid       = false;
     bool mHasNodePort = false;
     bool mHasIP       = false;
 
+    // Results are cached for the shortest TTL of the records they were built from.
+    uint32_t mOperationalTtl = std::numeric_limits<uint32_t>::max();
+    uint32_t mDiscoveredTtl  = std::numeric_limits<uint32_t>::max();
+
+    bool IsDiscovery() const
+    {
+        return mDiscoveryType == DiscoveryType::kCommissionableNode || mDiscoveryType == DiscoveryType::kCommissionerNode;
+    }
+    static void UpdateTtl(uint32_t & ttl, const ResourceData & data)
+    {
+        ttl = static_cast<uint32_t>(std::min<uint64_t>(ttl, data.GetTtlSeconds()));
+    }
+
     void OnCommissionableNodeSrvRecord(SerializedQNameIterator name, const SrvRecord & srv);
     void OnOperationalSrvRecord(SerializedQNameIterator name, const SrvRecord & srv);
 
@@ -196,6 +253,27 @@ bool HasQNamePart(SerializedQNameIterator qname, QNamePart part)
     return false;
 }
 
+/// Whether a cached node is known to satisfy a browse filter. Filters on values that TXT records do not carry are not
+/// answered from the cache.
+bool MatchesFilter(const DiscoveredNodeData & node, const DiscoveryFilter & filter)
+{
+    switch (filter.type)
+    {
+    case DiscoveryFilterType::kNone:
+        return true;
+    case DiscoveryFilterType::kInstanceName:
+        return strcmp(node.instanceName, filter.instanceName) == 0;
+    case DiscoveryFilterType::kLong:
+        return node.longDiscriminator == filter.code;
+    case DiscoveryFilterType::kVendor:
+        return node.vendorId == filter.code;
+    case DiscoveryFilterType::kDeviceType:
+        return node.deviceType == filter.code;
+    default:
+        return false;
+    }
+}
+
 void PacketDataReporter::OnResource(ResourceType type, const ResourceData & data)
 {
     if (!mValid)
@@ -217,28 +295,23 @@ void PacketDataReporter::OnResource(ResourceType type, const ResourceData & data
             ChipLogError(Discovery, "Packet data reporter failed to parse SRV record");
             mHasNodePort = false;
         }
-        else if (mDiscoveryType == DiscoveryType::kOperational)
+        else if (HasQNamePart(data.GetName(), kOperationalServiceName))
         {
-            // Ensure this is our record.
-            if (HasQNamePart(data.GetName(), kOperationalServiceName))
-            {
-                OnOperationalSrvRecord(data.GetName(), srv);
-            }
-            else
-            {
-                mValid = false;
-            }
+            // Operational records are used whatever was last asked for, so that unsolicited
+            // announcements keep the cache current.
+            OnOperationalSrvRecord(data.GetName(), srv);
+            UpdateTtl(mOperationalTtl, data);
         }
-        else if (mDiscoveryType == DiscoveryType::kCommissionableNode || mDiscoveryType == DiscoveryType::kCommissionerNode)
+        else if (IsDiscovery() &&
+                 (HasQNamePart(data.GetName(), kCommissionableServiceName) ||
+                  HasQNamePart(data.GetName(), kCommissionerServiceName)))
         {
-            if (HasQNamePart(data.GetName(), kCommissionableServiceName) || HasQNamePart(data.GetName(), kCommissionerServiceName))
-            {
-                OnCommissionableNodeSrvRecord(data.GetName(), srv);
-            }
-            else
-            {
-                mValid = false;
-            }
+            OnCommissionableNodeSrvRecord(data.GetName(), srv);
+            UpdateTtl(mDiscoveredTtl, data);
+        }
+        else
+        {
+            mValid = false;
         }
         break;
     }
@@ -251,14 +324,16 @@ void PacketDataReporter::OnResource(ResourceType type, const ResourceData & data
             {
                 strncpy(mDiscoveredNodeData.instanceName, qname.Value(), sizeof(DiscoveredNodeData::instanceName));
             }
+            UpdateTtl(mDiscoveredTtl, data);
         }
         break;
     }
     case QType::TXT:
-        if (mDiscoveryType == DiscoveryType::kCommissionableNode || mDiscoveryType == DiscoveryType::kCommissionerNode)
+        if (IsDiscovery())
         {
             TxtRecordDelegateImpl textRecordDelegate(&mDiscoveredNodeData);
             ParseTxtRecord(data.GetData(), &textRecordDelegate);
+            UpdateTtl(mDiscoveredTtl, data);
         }
         break;
     case QType::A: {
@@ -270,13 +345,12 @@ void PacketDataReporter::OnResource(ResourceType type, const ResourceData & data
         }
         else
         {
-            if (mDiscoveryType == DiscoveryType::kOperational)
-            {
-                OnOperationalIPAddress(addr);
-            }
-            else if (mDiscoveryType == DiscoveryType::kCommissionableNode || mDiscoveryType == DiscoveryType::kCommissionerNode)
+            OnOperationalIPAddress(addr);
+            UpdateTtl(mOperationalTtl, data);
+            if (IsDiscovery())
             {
                 OnDiscoveredNodeIPAddress(addr);
+                UpdateTtl(mDiscoveredTtl, data);
             }
         }
         break;
@@ -290,13 +364,12 @@ void PacketDataReporter::OnResource(ResourceType type, const ResourceData & data
         }
         else
         {
-            if (mDiscoveryType == DiscoveryType::kOperational)
-            {
-                OnOperationalIPAddress(addr);
-            }
-            else if (mDiscoveryType == DiscoveryType::kCommissionableNode || mDiscoveryType == DiscoveryType::kCommissionerNode)
+            OnOperationalIPAddress(addr);
+            UpdateTtl(mOperationalTtl, data);
+            if (IsDiscovery())
             {
                 OnDiscoveredNodeIPAddress(addr);
+                UpdateTtl(mDiscoveredTtl, data);
             }
         }
         break;
@@ -308,22 +381,37 @@ void PacketDataReporter::OnResource(ResourceType type, const ResourceData & data
 
 void PacketDataReporter::OnComplete()
 {
-    if ((mDiscoveryType == DiscoveryType::kCommissionableNode || mDiscoveryType == DiscoveryType::kCommissionerNode) &&
-        mDiscoveredNodeData.IsValid())
+    const uint64_t nowMs = System::Clock::GetMonotonicMilliseconds();
+
+    // A TTL of 0 announces that the records are going away: drop them from the cache, and do not report them.
+    if (IsDiscovery() && mDiscoveredNodeData.IsValid())
     {
-        mDelegate->OnNodeDiscoveryComplete(mDiscoveredNodeData);
+        const DiscoveredCacheData cacheData = { mDiscoveryType, mDiscoveredNodeData };
+        mDiscoveredCache.Insert(cacheData, MatchInstance(mDiscoveryType, mDiscoveredNodeData.instanceName), mDiscoveredTtl, nowMs);
+        if (mDiscoveredTtl > 0)
+        {
+            mDelegate->OnNodeDiscoveryComplete(mDiscoveredNodeData);
+        }
     }
-    else if (mDiscoveryType == DiscoveryType::kOperational && mHasIP && mHasNodePort)
+    else if (mHasIP && mHasNodePort)
     {
-        mNodeData.LogNodeIdResolved();
-        mDelegate->OnNodeIdResolved(mNodeData);
+        mOperationalCache.Insert(mNodeData, MatchPeerId(mNodeData.mPeerId), mOperationalTtl, nowMs);
+        if (mDiscoveryType == DiscoveryType::kOperational && mOperationalTtl > 0)
+        {
+            mNodeData.LogNodeIdResolved();
+            mDelegate->OnNodeIdResolved(mNodeData);
+        }
     }
 }
 
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() { GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this); }
+    MinMdnsResolver()
+    {
+        GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
+        GlobalMinimalMdnsServer::Instance().SetQueryObserver(this);
+    }
 
     //// MdnsPacketDelegate implementation
     void OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info) override;
@@ -338,9 +426,31 @@ public:
 private:
     ResolverDelegate * mDelegate = nullptr;
     DiscoveryType mDiscoveryType = DiscoveryType::kUnknown;
-
-    CHIP_ERROR SendQuery(mdns::Minimal::FullQName qname, mdns::Minimal::QType type);
+    System::Layer * mSystemLayer = nullptr;
+
+    // Results are answered from the caches while their records are live. Operational entries that are looked up are
+    // refreshed with a new query before they expire.
+    OperationalCache mOperationalCache;
+    DiscoveredCache mDiscoveredCache;
+    bool mCachedAnswersScheduled = false;
+
+    // Browse queries waiting for their send delay.
+    PendingBrowses mPendingBrowses;
+
+    void OnQueryObserved(const BytesRange & data);
+    CHIP_ERROR SendBrowseQuery(mdns::Minimal::FullQName qname, DiscoveryType type, const DiscoveryFilter & filter);
+    void AddKnownAnswers(QueryBuilder & builder, mdns::Minimal::FullQName qname, DiscoveryType type,
+                         const DiscoveryFilter & filter);
+    void SendDueBrowses(uint64_t nowMs);
+    void ArmBrowseTimer();
+    CHIP_ERROR SendOperationalQuery(const PeerId & peerId);
     CHIP_ERROR BrowseNodes(DiscoveryType type, DiscoveryFilter subtype);
+    void AnswerFromCache(DiscoveryType type, const DiscoveryFilter & filter);
+    CHIP_ERROR ScheduleCachedAnswers();
+    void ArmRefreshTimer();
+    static void HandleCachedAnswers(System::Layer * layer, void * appState, CHIP_ERROR error);
+    static void HandleRefreshTimer(System::Layer * layer, void * appState, CHIP_ERROR error);
+    static void HandleBrowseTimer(System::Layer * layer, void * appState, CHIP_ERROR error);
     template <typename... Args>
     mdns::Minimal::FullQName CheckAndAllocateQName(Args &&... parts)
     {
@@ -357,12 +467,19 @@ private:
 
 void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info)
 {
+    // Queries of other hosts are observed, not answered.
+    if ((data.Size() >= static_cast<ptrdiff_t>(HeaderRef::kSizeBytes)) && ConstHeaderRef(data.Start()).GetFlags().IsQuery())
+    {
+        OnQueryObserved(data);
+        return;
+    }
+
     if (mDelegate == nullptr)
     {
         return;
     }
 
-    PacketDataReporter reporter(mDelegate, info->Interface, mDiscoveryType, data);
+    PacketDataReporter reporter(mDelegate, info->Interface, mDiscoveryType, data, mOperationalCache, mDiscoveredCache);
 
     if (!ParsePacket(data, &reporter))
     {
@@ -371,11 +488,14 @@ void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet
     else
     {
         reporter.OnComplete();
+        ArmRefreshTimer();
     }
 }
 
 CHIP_ERROR MinMdnsResolver::StartResolver(chip::Inet::InetLayer * inetLayer, uint16_t port)
 {
+    mSystemLayer = inetLayer->SystemLayer();
+
     /// Note: we do not double-check the port as we assume the APP will always use
     /// the same inetLayer and port for mDNS.
     if (GlobalMinimalMdnsServer::Server().IsListening())
@@ -392,7 +512,22 @@ CHIP_ERROR MinMdnsResolver::SetResolverDelegate(ResolverDelegate * delegate)
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR MinMdnsResolver::SendQuery(mdns::Minimal::FullQName qname, mdns::Minimal::QType type)
+void MinMdnsResolver::OnQueryObserved(const BytesRange & data)
+{
+    VerifyOrReturn(mPendingBrowses.Count() > 0);
+
+    QueryPacket observed;
+    VerifyOrReturn(observed.Parse(data));
+
+    // RFC 6762 section 7.3: duplicate question suppression
+    if (mPendingBrowses.SuppressDuplicatedBy(observed) > 0)
+    {
+        ChipLogDetail(Discovery, "Browse query already asked by another host, not sending it");
+        ArmBrowseTimer();
+    }
+}
+
+CHIP_ERROR MinMdnsResolver::SendBrowseQuery(mdns::Minimal::FullQName qname, DiscoveryType type, const DiscoveryFilter & filter)
 {
     System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
     ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
@@ -401,15 +536,105 @@ CHIP_ERROR MinMdnsResolver::SendQuery(mdns::Minimal::FullQName qname, mdns::Mini
     builder.Header().SetMessageId(0);
 
     mdns::Minimal::Query query(qname);
-    query.SetType(type).SetClass(mdns::Minimal::QClass::IN);
+    query.SetType(mdns::Minimal::QType::ANY).SetClass(mdns::Minimal::QClass::IN);
     // TODO(cecille): Not sure why unicast response isn't working - fix.
     query.SetAnswerViaUnicast(false);
 
     builder.AddQuery(query);
+    AddKnownAnswers(builder, qname, type, filter);
 
     ReturnErrorCodeIf(!builder.Ok(), CHIP_ERROR_INTERNAL);
 
-    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+    System::PacketBufferHandle packet = builder.ReleasePacket();
+
+    // A newer browse for the same name replaces the one still waiting. Browses that cannot wait are sent right away.
+    if (mSystemLayer != nullptr)
+    {
+        const uint32_t delayMs = kBrowseMinDelayMs + GetRandU32() % (kBrowseMaxDelayMs - kBrowseMinDelayMs + 1);
+        if (mPendingBrowses.Add(std::move(packet), System::Clock::GetMonotonicMilliseconds() + delayMs))
+        {
+            ArmBrowseTimer();
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(std::move(packet), kMdnsPort);
+}
+
+/**
+ * List the instances found by an earlier browse for the same service as known answers, so that
+ * responders only send back the ones that are new (RFC 6762 section 7.1).
+ */
+void MinMdnsResolver::AddKnownAnswers(QueryBuilder & builder, mdns::Minimal::FullQName qname, DiscoveryType type,
+                                      const DiscoveryFilter & filter)
+{
+    const char * serviceName = nullptr;
+    switch (type)
+    {
+    case DiscoveryType::kCommissionableNode:
+        serviceName = kCommissionableServiceName;
+        break;
+    case DiscoveryType::kCommissionerNode:
+        serviceName = kCommissionerServiceName;
+        break;
+    default:
+        return;
+    }
+
+    // Browsing for an instance name asks for the instance records rather than a PTR record.
+    VerifyOrReturn(filter.type != DiscoveryFilterType::kInstanceName);
+
+    const uint64_t nowMs = System::Clock::GetMonotonicMilliseconds();
+    mDiscoveredCache.ForEach(nowMs, [&](DiscoveredCache::Entry & entry) {
+        if (entry.data.mType != type || !MatchesFilter(entry.data.mData, filter) || !entry.IsFresh(nowMs))
+        {
+            return;
+        }
+
+        const QNamePart instanceQName[] = { entry.data.mData.instanceName, serviceName, kCommissionProtocol, kLocalDomain };
+        PtrResourceRecord record(qname, FullQName(instanceQName));
+        record.SetTtl(entry.RemainingTtlSeconds(nowMs));
+        builder.AddAnswer(record);
+    });
+}
+
+void MinMdnsResolver::SendDueBrowses(uint64_t nowMs)
+{
+    mPendingBrowses.TakeDue(nowMs, [](System::PacketBufferHandle && packet) {
+        CHIP_ERROR err = GlobalMinimalMdnsServer::Server().BroadcastSend(std::move(packet), kMdnsPort);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Discovery, "Failed to send browse query: %s", ErrorStr(err));
+        }
+    });
+}
+
+void MinMdnsResolver::ArmBrowseTimer()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    const uint64_t nextMs = mPendingBrowses.NextDueMs();
+    if (nextMs == PendingBrowses::kNever)
+    {
+        mSystemLayer->CancelTimer(HandleBrowseTimer, this);
+        return;
+    }
+
+    const uint64_t nowMs   = System::Clock::GetMonotonicMilliseconds();
+    const uint32_t delayMs = static_cast<uint32_t>((nextMs > nowMs) ? (nextMs - nowMs) : 0);
+    if (mSystemLayer->StartTimer(delayMs, HandleBrowseTimer, this) != CHIP_NO_ERROR)
+    {
+        // Without a timer, the browses cannot wait.
+        SendDueBrowses(PendingBrowses::kNever);
+    }
+}
+
+void MinMdnsResolver::HandleBrowseTimer(System::Layer * layer, void * appState, CHIP_ERROR error)
+{
+    MinMdnsResolver * const self = static_cast<MinMdnsResolver *>(appState);
+
+    self->SendDueBrowses(System::Clock::GetMonotonicMilliseconds());
+    self->ArmBrowseTimer();
 }
 
 CHIP_ERROR MinMdnsResolver::FindCommissionableNodes(DiscoveryFilter filter)
@@ -472,12 +697,138 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
         return CHIP_ERROR_NO_MEMORY;
     }
 
-    return SendQuery(qname, mdns::Minimal::QType::ANY);
+    // The query still goes out, as nodes that are not cached may match too.
+    AnswerFromCache(type, filter);
+
+    return SendBrowseQuery(qname, type, filter);
+}
+
+void MinMdnsResolver::AnswerFromCache(DiscoveryType type, const DiscoveryFilter & filter)
+{
+    bool found = false;
+    mDiscoveredCache.ForEach(System::Clock::GetMonotonicMilliseconds(), [&](DiscoveredCache::Entry & entry) {
+        if (entry.data.mType == type && MatchesFilter(entry.data.mData, filter))
+        {
+            entry.answerPending = true;
+            found               = true;
+        }
+    });
+
+    if (found && ScheduleCachedAnswers() != CHIP_NO_ERROR)
+    {
+        mDiscoveredCache.ForEach(System::Clock::GetMonotonicMilliseconds(),
+                                 [](DiscoveredCache::Entry & entry) { entry.answerPending = false; });
+    }
 }
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId, Inet::IPAddressType type)
 {
-    mDiscoveryType                    = DiscoveryType::kOperational;
+    mDiscoveryType = DiscoveryType::kOperational;
+
+    OperationalCache::Entry * entry = mOperationalCache.Find(MatchPeerId(peerId), System::Clock::GetMonotonicMilliseconds());
+    if (entry != nullptr && (type == Inet::kIPAddressType_Any || entry->data.mAddress.Type() == type) &&
+        ScheduleCachedAnswers() == CHIP_NO_ERROR)
+    {
+        entry->inUse         = true;
+        entry->answerPending = true;
+        ArmRefreshTimer();
+        return CHIP_NO_ERROR;
+    }
+
+    return SendOperationalQuery(peerId);
+}
+
+/**
+ * Deliver cached results asynchronously, as results from the network would be, so that delegates are never called
+ * back from within ResolveNodeId() or a browse.
+ */
+CHIP_ERROR MinMdnsResolver::ScheduleCachedAnswers()
+{
+    VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!mCachedAnswersScheduled, CHIP_NO_ERROR);
+
+    ReturnErrorOnFailure(mSystemLayer->ScheduleWork(HandleCachedAnswers, this));
+    mCachedAnswersScheduled = true;
+    return CHIP_NO_ERROR;
+}
+
+void MinMdnsResolver::HandleCachedAnswers(System::Layer * layer, void * appState, CHIP_ERROR error)
+{
+    MinMdnsResolver * const self = static_cast<MinMdnsResolver *>(appState);
+    const uint64_t nowMs         = System::Clock::GetMonotonicMilliseconds();
+
+    self->mCachedAnswersScheduled = false;
+
+    // Entries are copied out first, as the delegate may start a new resolution that changes the cache.
+    self->mOperationalCache.ForEach(nowMs, [self](OperationalCache::Entry & entry) {
+        if (!entry.answerPending)
+        {
+            return;
+        }
+        entry.answerPending       = false;
+        ResolvedNodeData nodeData = entry.data;
+        if (self->mDelegate != nullptr)
+        {
+            nodeData.LogNodeIdResolved();
+            self->mDelegate->OnNodeIdResolved(nodeData);
+        }
+    });
+
+    self->mDiscoveredCache.ForEach(nowMs, [self](DiscoveredCache::Entry & entry) {
+        if (!entry.answerPending)
+        {
+            return;
+        }
+        entry.answerPending               = false;
+        const DiscoveredNodeData nodeData = entry.data.mData;
+        if (self->mDelegate != nullptr)
+        {
+            self->mDelegate->OnNodeDiscoveryComplete(nodeData);
+        }
+    });
+}
+
+void MinMdnsResolver::ArmRefreshTimer()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    const uint64_t nowMs  = System::Clock::GetMonotonicMilliseconds();
+    const uint64_t nextMs = mOperationalCache.NextRefreshMs(nowMs);
+    if (nextMs == OperationalCache::kNever)
+    {
+        mSystemLayer->CancelTimer(HandleRefreshTimer, this);
+        return;
+    }
+
+    const uint64_t delayMs = (nextMs > nowMs) ? nextMs - nowMs : 0;
+    mSystemLayer->StartTimer(static_cast<uint32_t>(std::min<uint64_t>(delayMs, UINT32_MAX)), HandleRefreshTimer, this);
+}
+
+void MinMdnsResolver::HandleRefreshTimer(System::Layer * layer, void * appState, CHIP_ERROR error)
+{
+    MinMdnsResolver * const self = static_cast<MinMdnsResolver *>(appState);
+    const uint64_t nowMs         = System::Clock::GetMonotonicMilliseconds();
+
+    self->mOperationalCache.ForEach(nowMs, [self, nowMs](OperationalCache::Entry & entry) {
+        if (!entry.inUse || entry.refreshSent || entry.refreshMs > nowMs)
+        {
+            return;
+        }
+        // The answer replaces the entry; if none comes, the entry expires with its records.
+        entry.refreshSent = true;
+        CHIP_ERROR err    = self->SendOperationalQuery(entry.data.mPeerId);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Discovery, "Failed to refresh cached node 0x" ChipLogFormatX64 ": %s",
+                         ChipLogValueX64(entry.data.mPeerId.GetNodeId()), ErrorStr(err));
+        }
+    });
+
+    self->ArmRefreshTimer();
+}
+
+CHIP_ERROR MinMdnsResolver::SendOperationalQuery(const PeerId & peerId)
+{
     System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
     ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
 
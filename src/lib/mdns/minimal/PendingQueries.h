@@ -0,0 +1,178 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <system/SystemPacketBuffer.h>
+
+#include "QueryPacket.h"
+
+namespace mdns {
+namespace Minimal {
+
+/// Queries waiting for their send delay (RFC 6762 section 5.2), each with
+/// its own due time.
+///
+/// Queries are keyed by their first question: a query for a name that is
+/// already waiting replaces the waiting one, which keeps its due time. A query
+/// is dropped if another host asks the same questions before it is due
+/// (RFC 6762 section 7.3), as the answers reach this host too.
+///
+/// Time is passed in explicitly, in monotonic milliseconds.
+template <size_t kEntryCount>
+class PendingQueries
+{
+public:
+    static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+    /// Queues [packet], a query, to be sent at [dueMs].
+    ///
+    /// Returns false, leaving [packet] to the caller, if it is not a query or
+    /// if all entries are in use.
+    bool Add(chip::System::PacketBufferHandle && packet, uint64_t dueMs)
+    {
+        QueryPacket query;
+        if (!Parse(packet, query))
+        {
+            return false;
+        }
+
+        Entry * freeEntry = nullptr;
+        for (Entry & entry : mEntries)
+        {
+            if (entry.packet.IsNull())
+            {
+                freeEntry = (freeEntry == nullptr) ? &entry : freeEntry;
+                continue;
+            }
+
+            QueryPacket waiting;
+            if (Parse(entry.packet, waiting) && IsSameKey(query, waiting))
+            {
+                entry.packet = std::move(packet);
+                return true;
+            }
+        }
+
+        if (freeEntry == nullptr)
+        {
+            return false;
+        }
+
+        freeEntry->packet = std::move(packet);
+        freeEntry->dueMs  = dueMs;
+        return true;
+    }
+
+    /// Drops the waiting queries that [observed], a query of another host,
+    /// makes unnecessary. Returns the number of queries dropped.
+    size_t SuppressDuplicatedBy(const QueryPacket & observed)
+    {
+        size_t dropped = 0;
+        for (Entry & entry : mEntries)
+        {
+            QueryPacket waiting;
+            if (!entry.packet.IsNull() && Parse(entry.packet, waiting) && waiting.IsDuplicatedBy(observed))
+            {
+                entry.packet = nullptr;
+                dropped++;
+            }
+        }
+        return dropped;
+    }
+
+    /// Removes the queries due at [nowMs] and calls
+    /// fn(chip::System::PacketBufferHandle &&) for each of them.
+    template <typename Function>
+    void TakeDue(uint64_t nowMs, Function && fn)
+    {
+        for (Entry & entry : mEntries)
+        {
+            if (!entry.packet.IsNull() && entry.dueMs <= nowMs)
+            {
+                chip::System::PacketBufferHandle packet = std::move(entry.packet);
+                fn(std::move(packet));
+            }
+        }
+    }
+
+    /// Due time of the earliest waiting query, or kNever if none is waiting.
+    uint64_t NextDueMs() const
+    {
+        uint64_t nextMs = kNever;
+        for (const Entry & entry : mEntries)
+        {
+            if (!entry.packet.IsNull() && entry.dueMs < nextMs)
+            {
+                nextMs = entry.dueMs;
+            }
+        }
+        return nextMs;
+    }
+
+    size_t Count() const
+    {
+        size_t count = 0;
+        for (const Entry & entry : mEntries)
+        {
+            count += entry.packet.IsNull() ? 0 : 1;
+        }
+        return count;
+    }
+
+private:
+    struct Entry
+    {
+        chip::System::PacketBufferHandle packet;
+        uint64_t dueMs = 0;
+    };
+
+    static bool Parse(const chip::System::PacketBufferHandle & packet, QueryPacket & query)
+    {
+        return !packet.IsNull() && query.Parse(BytesRange(packet->Start(), packet->Start() + packet->DataLength())) &&
+            (query.GetQueryCount() > 0);
+    }
+
+    static QueryData FirstQuery(const QueryPacket & query)
+    {
+        QueryData first;
+        bool found = false;
+        query.ForEachQuery([&](const QueryData & data) {
+            first = found ? first : data;
+            found = true;
+        });
+        return first;
+    }
+
+    static bool IsSameKey(const QueryPacket & query, const QueryPacket & other)
+    {
+        const QueryData first      = FirstQuery(query);
+        const QueryData otherFirst = FirstQuery(other);
+        return (first.GetType() == otherFirst.GetType()) && (first.GetClass() == otherFirst.GetClass()) &&
+            (first.GetName() == otherFirst.GetName());
+    }
+
+    Entry mEntries[kEntryCount];
+};
+
+} // namespace Minimal
+} // namespace mdns
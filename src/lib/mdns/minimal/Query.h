@@ -21,6 +21,7 @@
 
 #include <mdns/minimal/core/Constants.h>
 #include <mdns/minimal/core/QName.h>
+#include <mdns/minimal/core/RecordWriter.h>
 
 namespace mdns {
 namespace Minimal {
@@ -57,6 +58,16 @@ public:
     /// @param hdr will be updated with a query count
     /// @param out where to write the query data
     bool Append(HeaderRef & hdr, chip::Encoding::BigEndian::BufferWriter & out) const
+    {
+        RecordWriter writer(out);
+        return Append(hdr, writer);
+    }
+
+    /// Append the query through a writer that may compress its name
+    ///
+    /// @param hdr will be updated with a query count
+    /// @param writer where to write the query data
+    bool Append(HeaderRef & hdr, RecordWriter & writer) const
     {
         // Questions can only be appended before any other data is added
         if ((hdr.GetAdditionalCount() != 0) || (hdr.GetAnswerCount() != 0) || (hdr.GetAuthorityCount() != 0))
@@ -64,7 +75,9 @@ public:
             return false;
         }
 
-        mQName.Output(out);
+        chip::Encoding::BigEndian::BufferWriter & out = writer.Writer();
+
+        writer.WriteQName(mQName);
 
         out.Put16(static_cast<uint16_t>(mType));
         out.Put16(static_cast<uint16_t>(static_cast<uint16_t>(mClass) | (mAnswerViaUnicast ? kQClassUnicastAnswerFlag : 0)));
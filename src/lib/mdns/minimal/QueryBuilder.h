@@ -21,10 +21,15 @@
 
 #include <mdns/minimal/Query.h>
 #include <mdns/minimal/core/DnsHeader.h>
+#include <mdns/minimal/core/RecordWriter.h>
+#include <mdns/minimal/records/ResourceRecord.h>
 
 namespace mdns {
 namespace Minimal {
 
+/// Writes a MDNS query into a given packet buffer.
+///
+/// Names are compressed against the names already in the packet.
 class QueryBuilder
 {
 public:
@@ -35,6 +40,7 @@ public:
     {
         mPacket = std::move(packet);
         mHeader = HeaderRef(mPacket->Start());
+        mNameTable.Clear();
 
         if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
         {
@@ -68,8 +74,33 @@ public:
         }
 
         chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
+        RecordWriter writer(out, mPacket->Start(), mNameTable);
 
-        if (!query.Append(mHeader, out))
+        if (!query.Append(mHeader, writer))
+        {
+            mQueryBuildOk = false;
+        }
+        else
+        {
+            mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + out.Needed()));
+        }
+        return *this;
+    }
+
+    /// Adds a record that the querier already knows, so that responders do
+    /// not send it again (RFC 6762 section 7.1). Known answers follow all
+    /// the queries.
+    QueryBuilder & AddAnswer(const ResourceRecord & record)
+    {
+        if (!mQueryBuildOk)
+        {
+            return *this;
+        }
+
+        chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
+        RecordWriter writer(out, mPacket->Start(), mNameTable);
+
+        if (!record.Append(mHeader, ResourceType::kAnswer, writer))
         {
             mQueryBuildOk = false;
         }
@@ -85,6 +116,7 @@ public:
 private:
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
+    QNameCompressionTable mNameTable; // names of the queries and answers in mPacket
     bool mQueryBuildOk = true;
 };
 
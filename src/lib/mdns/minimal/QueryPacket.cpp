@@ -0,0 +1,212 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "QueryPacket.h"
+
+#include "RecordData.h"
+
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+// Records are compared after writing them out, and any record that is sent
+// fits in a single reply packet.
+constexpr size_t kMaxRecordSizeBytes = 512;
+
+uint16_t ClassWithoutFlushBit(QClass klass)
+{
+    return static_cast<uint16_t>(static_cast<uint16_t>(klass) & ~kQClassResponseFlushBit);
+}
+
+bool IsSameData(QType type, const BytesRange & data, const BytesRange & packet, const BytesRange & otherData,
+                const BytesRange & otherPacket)
+{
+    switch (type)
+    {
+    case QType::PTR: {
+        SerializedQNameIterator name;
+        SerializedQNameIterator otherName;
+        return ParsePtrRecord(data, packet, &name) && ParsePtrRecord(otherData, otherPacket, &otherName) && (name == otherName);
+    }
+    case QType::SRV: {
+        SrvRecord srv;
+        SrvRecord otherSrv;
+        return srv.Parse(data, packet) && otherSrv.Parse(otherData, otherPacket) &&
+            (srv.GetPriority() == otherSrv.GetPriority()) && (srv.GetWeight() == otherSrv.GetWeight()) &&
+            (srv.GetPort() == otherSrv.GetPort()) && (srv.GetName() == otherSrv.GetName());
+    }
+    default:
+        return (data.Size() == otherData.Size()) &&
+            (memcmp(data.Start(), otherData.Start(), static_cast<size_t>(data.Size())) == 0);
+    }
+}
+
+} // namespace
+
+bool IsSameRecord(const ResourceData & answer, const BytesRange & packet, const ResourceData & otherAnswer,
+                  const BytesRange & otherPacket)
+{
+    if ((answer.GetType() != otherAnswer.GetType()) ||
+        (ClassWithoutFlushBit(answer.GetClass()) != ClassWithoutFlushBit(otherAnswer.GetClass())))
+    {
+        return false;
+    }
+
+    if (answer.GetName() != otherAnswer.GetName())
+    {
+        return false;
+    }
+
+    return IsSameData(answer.GetType(), answer.GetData(), packet, otherAnswer.GetData(), otherPacket);
+}
+
+bool IsSameRecord(const ResourceRecord & record, const ResourceData & answer, const BytesRange & packet)
+{
+    if ((answer.GetType() != record.GetType()) ||
+        (ClassWithoutFlushBit(answer.GetClass()) != ClassWithoutFlushBit(record.GetClass())))
+    {
+        return false;
+    }
+
+    if (answer.GetName() != record.GetName())
+    {
+        return false;
+    }
+
+    // Write the record out without compression, to compare its data as received data.
+    uint8_t headerBuffer[HeaderRef::kSizeBytes];
+    HeaderRef header(headerBuffer);
+    header.Clear();
+
+    uint8_t recordBuffer[kMaxRecordSizeBytes];
+    chip::Encoding::BigEndian::BufferWriter out(recordBuffer, sizeof(recordBuffer));
+    if (!record.Append(header, ResourceType::kAnswer, out))
+    {
+        return false;
+    }
+
+    const BytesRange recordRange(recordBuffer, recordBuffer + out.Needed());
+    const uint8_t * start = recordBuffer;
+    ResourceData written;
+    if (!written.Parse(recordRange, &start))
+    {
+        return false;
+    }
+
+    return IsSameData(record.GetType(), written.GetData(), recordRange, answer.GetData(), packet);
+}
+
+bool QueryPacket::Parse(const BytesRange & packetData)
+{
+    *this = QueryPacket();
+
+    if (packetData.Size() < static_cast<ptrdiff_t>(HeaderRef::kSizeBytes))
+    {
+        return false;
+    }
+
+    // header is used as const, so cast is safe
+    ConstHeaderRef header(packetData.Start());
+
+    if (!header.GetFlags().IsValidMdns() || !header.GetFlags().IsQuery())
+    {
+        return false;
+    }
+
+    const uint8_t * queries = packetData.Start() + HeaderRef::kSizeBytes;
+    const uint8_t * data    = queries;
+
+    QueryData query;
+    for (uint16_t i = 0; i < header.GetQueryCount(); i++)
+    {
+        if (!query.Parse(packetData, &data))
+        {
+            return false;
+        }
+    }
+
+    const uint8_t * knownAnswers = data;
+
+    ResourceData answer;
+    for (uint16_t i = 0; i < header.GetAnswerCount(); i++)
+    {
+        if (!answer.Parse(packetData, &data))
+        {
+            return false;
+        }
+    }
+
+    mPacket           = packetData;
+    mQueries          = queries;
+    mKnownAnswers     = knownAnswers;
+    mMessageId        = header.GetMessageId();
+    mQueryCount       = header.GetQueryCount();
+    mKnownAnswerCount = header.GetAnswerCount();
+    mTruncated        = header.GetFlags().IsTruncated();
+
+    return true;
+}
+
+bool QueryPacket::RequestedUnicastAnswer() const
+{
+    bool unicast = (mQueryCount > 0);
+    ForEachQuery([&unicast](const QueryData & query) { unicast = unicast && query.RequestedUnicastAnswer(); });
+    return unicast;
+}
+
+bool QueryPacket::IsKnownAnswer(const ResourceRecord & record) const
+{
+    bool known = false;
+    ForEachKnownAnswer([&](const ResourceData & answer) {
+        // A known answer with less than half of the TTL left is to be refreshed.
+        known = known || ((answer.GetTtlSeconds() * 2 >= record.GetTtl()) && IsSameRecord(record, answer, mPacket));
+    });
+    return known;
+}
+
+bool QueryPacket::IsDuplicatedBy(const QueryPacket & other) const
+{
+    bool duplicated = (mQueryCount > 0);
+
+    // Answers to questions that asked for unicast replies are not seen by other hosts.
+    ForEachQuery([&](const QueryData & query) {
+        bool asked = false;
+        other.ForEachQuery([&](const QueryData & otherQuery) {
+            asked = asked ||
+                ((otherQuery.GetType() == query.GetType()) && (otherQuery.GetClass() == query.GetClass()) &&
+                 !otherQuery.RequestedUnicastAnswer() && (otherQuery.GetName() == query.GetName()));
+        });
+        duplicated = duplicated && asked;
+    });
+
+    // Responders leave out the known answers of the other packet, which this one has to list too.
+    other.ForEachKnownAnswer([&](const ResourceData & otherAnswer) {
+        bool known = false;
+        ForEachKnownAnswer([&](const ResourceData & answer) {
+            known = known || IsSameRecord(answer, mPacket, otherAnswer, other.mPacket);
+        });
+        duplicated = duplicated && known;
+    });
+
+    return duplicated;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "Parser.h"
+
+#include <mdns/minimal/records/ResourceRecord.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// A received mDNS query: its questions and the records that the querier
+/// listed as already known (RFC 6762 section 7.1).
+///
+/// Questions and known answers are parsed from the packet data whenever they
+/// are used, so the data has to outlive this object.
+class QueryPacket
+{
+public:
+    QueryPacket() {}
+
+    /// Checks that [packetData] holds a well formed query.
+    ///
+    /// returns true on parse success, false on failure.
+    bool Parse(const BytesRange & packetData);
+
+    uint16_t GetMessageId() const { return mMessageId; }
+    uint16_t GetQueryCount() const { return mQueryCount; }
+    uint16_t GetKnownAnswerCount() const { return mKnownAnswerCount; }
+
+    /// The querier sends more known answers in the packets that follow (RFC 6762 section 7.2).
+    bool IsTruncated() const { return mTruncated; }
+
+    /// Whether all questions asked for unicast replies.
+    bool RequestedUnicastAnswer() const;
+
+    /// Calls fn(const QueryData &) for every question of the packet.
+    template <typename Function>
+    void ForEachQuery(Function && fn) const
+    {
+        const uint8_t * data = mQueries;
+        QueryData query;
+        for (uint16_t i = 0; i < mQueryCount; i++)
+        {
+            if (!query.Parse(mPacket, &data))
+            {
+                return; // cannot happen for a packet that Parse accepted
+            }
+            fn(query);
+        }
+    }
+
+    /// Calls fn(const ResourceData &) for every known answer of the packet.
+    template <typename Function>
+    void ForEachKnownAnswer(Function && fn) const
+    {
+        const uint8_t * data = mKnownAnswers;
+        ResourceData answer;
+        for (uint16_t i = 0; i < mKnownAnswerCount; i++)
+        {
+            if (!answer.Parse(mPacket, &data))
+            {
+                return; // cannot happen for a packet that Parse accepted
+            }
+            fn(answer);
+        }
+    }
+
+    /// Whether the querier already knows [record]: it listed the record as a
+    /// known answer with at least half of the record's TTL remaining. Such
+    /// records are not to be sent back.
+    bool IsKnownAnswer(const ResourceRecord & record) const;
+
+    /// Whether [other], a query that another host sent, makes this query
+    /// unnecessary (RFC 6762 section 7.3): it asks all of the questions of
+    /// this query for multicast replies, and all of its known answers are
+    /// known answers of this query too.
+    bool IsDuplicatedBy(const QueryPacket & other) const;
+
+    /// The range of the packet, in which names of the questions and known
+    /// answers may point.
+    const BytesRange & GetPacketRange() const { return mPacket; }
+
+private:
+    BytesRange mPacket;
+    const uint8_t * mQueries      = nullptr; // first question
+    const uint8_t * mKnownAnswers = nullptr; // first known answer
+    uint16_t mMessageId           = 0;
+    uint16_t mQueryCount          = 0;
+    uint16_t mKnownAnswerCount    = 0;
+    bool mTruncated               = false;
+};
+
+/// Whether [answer], a record received within [packet], is the same as
+/// [record], apart from its TTL. Names are compared rather than their
+/// encoding, which may be compressed.
+bool IsSameRecord(const ResourceRecord & record, const ResourceData & answer, const BytesRange & packet);
+
+/// Whether two received records are the same, apart from their TTL.
+bool IsSameRecord(const ResourceData & answer, const BytesRange & packet, const ResourceData & otherAnswer,
+                  const BytesRange & otherPacket);
+
+} // namespace Minimal
+} // namespace mdns
@@ -20,12 +20,16 @@
 #include <system/SystemPacketBuffer.h>
 
 #include <mdns/minimal/core/DnsHeader.h>
+#include <mdns/minimal/core/RecordWriter.h>
 #include <mdns/minimal/records/ResourceRecord.h>
 
 namespace mdns {
 namespace Minimal {
 
 /// Writes a MDNS reply into a given packet buffer.
+///
+/// Names of the records are compressed against the names of the records
+/// already in the packet.
 class ResponseBuilder
 {
 public:
@@ -36,6 +40,7 @@ public:
     {
         mPacket = std::move(packet);
         mHeader = HeaderRef(mPacket->Start());
+        mNameTable.Clear();
 
         if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
         {
@@ -78,9 +83,13 @@ public:
         }
 
         chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
+        RecordWriter writer(out, mPacket->Start(), mNameTable);
+        const size_t nameCount = mNameTable.Count();
 
-        if (!record.Append(mHeader, type, out))
+        if (!record.Append(mHeader, type, writer))
         {
+            // Names of the record that did not fit cannot be pointed to.
+            mNameTable.Truncate(nameCount);
             mBuildOk = false;
         }
         else
@@ -116,6 +125,7 @@ public:
 private:
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
+    QNameCompressionTable mNameTable; // names of the records in mPacket
     bool mBuildOk = false;
 };
 
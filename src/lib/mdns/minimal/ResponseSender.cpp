@@ -49,7 +49,8 @@ namespace Internal {
 
 bool ResponseSendingState::SendUnicast() const
 {
-    return mQuery->RequestedUnicastAnswer() || (mSource->SrcPort != kMdnsStandardPort);
+    const bool requestedUnicast = (mQuery != nullptr) ? mQuery->RequestedUnicastAnswer() : mQueryPacket->RequestedUnicastAnswer();
+    return requestedUnicast || (mSource->SrcPort != kMdnsStandardPort);
 }
 
 bool ResponseSendingState::IncludeQuery() const
@@ -75,7 +76,42 @@ CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder
 CHIP_ERROR ResponseSender::Respond(uint32_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource)
 {
     mSendState.Reset(messageId, query, querySource);
+    ResetAdditionals();
 
+    ReturnErrorOnFailure(AddAnswers(query));
+    ReturnErrorOnFailure(AddAdditionals(query));
+
+    return FlushReply();
+}
+
+CHIP_ERROR ResponseSender::Respond(const QueryPacket & queryPacket, const chip::Inet::IPPacketInfo * querySource)
+{
+    // Queries with the truncated bit set are answered right away, so only the known answers in
+    // this packet are left out, not those in the packets that follow it (RFC 6762 section 7.2).
+    mSendState.Reset(queryPacket, querySource);
+    ResetAdditionals();
+
+    // Answers of all queries come before any additional records.
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    queryPacket.ForEachQuery([this, &err](const QueryData & query) {
+        if (err == CHIP_NO_ERROR)
+        {
+            err = AddAnswers(query);
+        }
+    });
+    queryPacket.ForEachQuery([this, &err](const QueryData & query) {
+        if (err == CHIP_NO_ERROR)
+        {
+            err = AddAdditionals(query);
+        }
+    });
+    ReturnErrorOnFailure(err);
+
+    return FlushReply();
+}
+
+void ResponseSender::ResetAdditionals()
+{
     // Responder has a stateful 'additional replies required' that is used within the response
     // loop. 'no additionals required' is set at the start and additionals are marked as the query
     // reply is built.
@@ -86,73 +122,90 @@ CHIP_ERROR ResponseSender::Respond(uint32_t messageId, const QueryData & query,
             mResponder[i]->ResetAdditionals();
         }
     }
+}
 
-    // send all 'Answer' replies
-    {
-        const uint64_t kTimeNowMs = chip::System::Clock::GetMonotonicMilliseconds();
+CHIP_ERROR ResponseSender::AddAnswers(const QueryData & query)
+{
+    mSendState.SetResourceType(ResourceType::kAnswer);
 
-        QueryReplyFilter queryReplyFilter(query);
-        QueryResponderRecordFilter responseFilter;
+    const uint64_t kTimeNowMs = chip::System::Clock::GetMonotonicMilliseconds();
 
-        responseFilter.SetReplyFilter(&queryReplyFilter);
+    QueryReplyFilter queryReplyFilter(query);
+    QueryResponderRecordFilter responseFilter;
 
-        if (!mSendState.SendUnicast())
+    responseFilter
+        .SetReplyFilter(&queryReplyFilter) //
+        .SetIncludeNotReportedOnly(true);
+
+    if (!mSendState.SendUnicast())
+    {
+        // According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
+        //
+        // TODO: the 'last sent' value does NOT track the interface we used to send, so this may cause
+        //       broadcasts on one interface to throttle broadcasts on another interface.
+        constexpr uint64_t kOneSecondMs = 1000;
+        responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNowMs - kOneSecondMs);
+    }
+    for (size_t i = 0; i < kMaxQueryResponders; ++i)
+    {
+        if (mResponder[i] == nullptr)
         {
-            // According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
-            //
-            // TODO: the 'last sent' value does NOT track the interface we used to send, so this may cause
-            //       broadcasts on one interface to throttle broadcasts on another interface.
-            constexpr uint64_t kOneSecondMs = 1000;
-            responseFilter.SetIncludeOnlyMulticastBeforeMS(kTimeNowMs - kOneSecondMs);
+            continue;
         }
-        for (size_t i = 0; i < kMaxQueryResponders; ++i)
+        for (auto it = mResponder[i]->begin(&responseFilter); it != mResponder[i]->end(); it++)
         {
-            if (mResponder[i] == nullptr)
+            const size_t recordCount = mSendState.GetRecordCount();
+
+            it->responder->AddAllResponses(mSendState.GetSource(), this);
+            ReturnErrorOnFailure(mSendState.GetError());
+
+            if (mSendState.GetRecordCount() == recordCount)
             {
-                continue;
+                continue; // the querier knows all of it, so it most likely knows the additional data too
             }
-            for (auto it = mResponder[i]->begin(&responseFilter); it != mResponder[i]->end(); it++)
-            {
-                it->responder->AddAllResponses(querySource, this);
-                ReturnErrorOnFailure(mSendState.GetError());
 
-                mResponder[i]->MarkAdditionalRepliesFor(it);
+            mResponder[i]->MarkReported(it);
+            mResponder[i]->MarkAdditionalRepliesFor(it);
 
-                if (!mSendState.SendUnicast())
-                {
-                    it->lastMulticastTime = kTimeNowMs;
-                }
+            if (!mSendState.SendUnicast())
+            {
+                it->lastMulticastTime = kTimeNowMs;
             }
         }
     }
 
-    // send all 'Additional' replies
-    {
-        mSendState.SetResourceType(ResourceType::kAdditional);
+    return CHIP_NO_ERROR;
+}
 
-        QueryReplyFilter queryReplyFilter(query);
+CHIP_ERROR ResponseSender::AddAdditionals(const QueryData & query)
+{
+    mSendState.SetResourceType(ResourceType::kAdditional);
 
-        queryReplyFilter.SetIgnoreNameMatch(true).SetSendingAdditionalItems(true);
+    QueryReplyFilter queryReplyFilter(query);
 
-        QueryResponderRecordFilter responseFilter;
-        responseFilter
-            .SetReplyFilter(&queryReplyFilter) //
-            .SetIncludeAdditionalRepliesOnly(true);
-        for (size_t i = 0; i < kMaxQueryResponders; ++i)
+    queryReplyFilter.SetIgnoreNameMatch(true).SetSendingAdditionalItems(true);
+
+    QueryResponderRecordFilter responseFilter;
+    responseFilter
+        .SetReplyFilter(&queryReplyFilter)     //
+        .SetIncludeAdditionalRepliesOnly(true) //
+        .SetIncludeNotReportedOnly(true);
+    for (size_t i = 0; i < kMaxQueryResponders; ++i)
+    {
+        if (mResponder[i] == nullptr)
         {
-            if (mResponder[i] == nullptr)
-            {
-                continue;
-            }
-            for (auto it = mResponder[i]->begin(&responseFilter); it != mResponder[i]->end(); it++)
-            {
-                it->responder->AddAllResponses(querySource, this);
-                ReturnErrorOnFailure(mSendState.GetError());
-            }
+            continue;
+        }
+        for (auto it = mResponder[i]->begin(&responseFilter); it != mResponder[i]->end(); it++)
+        {
+            it->responder->AddAllResponses(mSendState.GetSource(), this);
+            ReturnErrorOnFailure(mSendState.GetError());
+
+            mResponder[i]->MarkReported(it);
         }
     }
 
-    return FlushReply();
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR ResponseSender::FlushReply()
@@ -189,7 +242,14 @@ CHIP_ERROR ResponseSender::PrepareNewReplyPacket()
 
     if (mSendState.IncludeQuery())
     {
-        mResponseBuilder.AddQuery(*mSendState.GetQuery());
+        if (mSendState.GetQuery() != nullptr)
+        {
+            mResponseBuilder.AddQuery(*mSendState.GetQuery());
+        }
+        else
+        {
+            mSendState.GetQueryPacket()->ForEachQuery([this](const QueryData & query) { mResponseBuilder.AddQuery(query); });
+        }
     }
 
     return CHIP_NO_ERROR;
@@ -199,6 +259,11 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
 {
     RETURN_IF_ERROR(mSendState.GetError());
 
+    if (mSendState.IsKnownAnswer(record))
+    {
+        return; // RFC 6762 section 7.1: known answers are not sent again
+    }
+
     if (!mResponseBuilder.HasPacketBuffer())
     {
         mSendState.SetError(PrepareNewReplyPacket());
@@ -229,8 +294,11 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
             // Very much unexpected: single record addtion should fit (our records should not be that big).
             ChipLogError(Discovery, "Failed to add single record to mDNS response.");
             mSendState.SetError(CHIP_ERROR_INTERNAL);
+            return;
         }
     }
+
+    mSendState.IncrementRecordCount();
 }
 
 } // namespace Minimal
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "Parser.h"
+#include "QueryPacket.h"
 #include "ResponseBuilder.h"
 #include "Server.h"
 
@@ -41,9 +42,22 @@ public:
     {
         mMessageId    = messageId;
         mQuery        = &query;
+        mQueryPacket  = nullptr;
         mSource       = packet;
         mSendError    = CHIP_NO_ERROR;
         mResourceType = ResourceType::kAnswer;
+        mRecordCount  = 0;
+    }
+
+    void Reset(const QueryPacket & queryPacket, const chip::Inet::IPPacketInfo * packet)
+    {
+        mMessageId    = queryPacket.GetMessageId();
+        mQuery        = nullptr;
+        mQueryPacket  = &queryPacket;
+        mSource       = packet;
+        mSendError    = CHIP_NO_ERROR;
+        mResourceType = ResourceType::kAnswer;
+        mRecordCount  = 0;
     }
 
     void SetResourceType(ResourceType resourceType) { mResourceType = resourceType; }
@@ -58,8 +72,22 @@ public:
 
     uint32_t GetMessageId() const { return mMessageId; }
 
+    /// The single query being replied to, if not replying to a whole query packet
     const QueryData * GetQuery() const { return mQuery; }
 
+    /// The query packet being replied to, if any
+    const QueryPacket * GetQueryPacket() const { return mQueryPacket; }
+
+    /// Check if the querier already knows the given record
+    bool IsKnownAnswer(const ResourceRecord & record) const
+    {
+        return (mQueryPacket != nullptr) && mQueryPacket->IsKnownAnswer(record);
+    }
+
+    /// Number of records added to the reply so far, over all of its packets
+    size_t GetRecordCount() const { return mRecordCount; }
+    void IncrementRecordCount() { mRecordCount++; }
+
     /// Check if the reply should be sent as a unicast reply
     bool SendUnicast() const;
 
@@ -74,10 +102,12 @@ public:
 
 private:
     const QueryData * mQuery                 = nullptr;               // query being replied to
+    const QueryPacket * mQueryPacket         = nullptr;               // query packet being replied to
     const chip::Inet::IPPacketInfo * mSource = nullptr;               // Where to send the reply (if unicast)
     uint32_t mMessageId                      = 0;                     // message id for the reply
     ResourceType mResourceType               = ResourceType::kAnswer; // what is being sent right now
     CHIP_ERROR mSendError                    = CHIP_NO_ERROR;
+    size_t mRecordCount                      = 0; // records added to the reply
 };
 
 } // namespace Internal
@@ -86,6 +116,9 @@ private:
 ///
 /// Handles processing the query via a QueryResponderBase and then sending back the reply
 /// using appropriate paths (unicast or multicast) via the given Server.
+///
+/// All questions of a query packet are answered by a single reply, which leaves out the
+/// records that the querier listed as known answers (RFC 6762 section 7.1).
 class ResponseSender : public ResponderDelegate
 {
 public:
@@ -98,10 +131,19 @@ public:
     /// Send back the response to a particular query
     CHIP_ERROR Respond(uint32_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource);
 
+    /// Send back a single response to all the queries of a packet
+    ///
+    /// Only the known answers in this packet are left out of the reply: the reply is not
+    /// delayed for the further known answers that follow a truncated query (RFC 6762 section 7.2).
+    CHIP_ERROR Respond(const QueryPacket & queryPacket, const chip::Inet::IPPacketInfo * querySource);
+
     // Implementation of ResponderDelegate
     void AddResponse(const ResourceRecord & record) override;
 
 private:
+    void ResetAdditionals();
+    CHIP_ERROR AddAnswers(const QueryData & query);
+    CHIP_ERROR AddAdditionals(const QueryData & query);
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
 
@@ -152,6 +152,31 @@ bool SerializedQNameIterator::operator==(const FullQName & other) const
     return ((idx == other.nameCount) && !self.Next());
 }
 
+bool SerializedQNameIterator::operator==(const SerializedQNameIterator & other) const
+{
+    SerializedQNameIterator self = *this; // allow iteration
+    SerializedQNameIterator them = other;
+
+    while (true)
+    {
+        const bool selfHasNext = self.Next();
+        const bool themHasNext = them.Next();
+
+        if (selfHasNext != themHasNext)
+        {
+            return false;
+        }
+        if (!selfHasNext)
+        {
+            return self.IsValid() && them.IsValid();
+        }
+        if (strcasecmp(self.Value(), them.Value()) != 0)
+        {
+            return false;
+        }
+    }
+}
+
 bool FullQName::operator==(const FullQName & other) const
 {
     if (nameCount != other.nameCount)
@@ -108,6 +108,11 @@ public:
     bool operator==(const FullQName & other) const;
     bool operator!=(const FullQName & other) const { return !(*this == other); }
 
+    /// Compares the names two iterators point to, e.g. names within different
+    /// packets. Names with invalid data are never equal.
+    bool operator==(const SerializedQNameIterator & other) const;
+    bool operator!=(const SerializedQNameIterator & other) const { return !(*this == other); }
+
     void Put(chip::Encoding::BigEndian::BufferWriter & out) const
     {
         SerializedQNameIterator copy = *this;
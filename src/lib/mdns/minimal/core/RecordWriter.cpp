@@ -0,0 +1,87 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RecordWriter.h"
+
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+constexpr uint16_t kPointerMarker = 0xC000;
+
+} // namespace
+
+void QNameCompressionTable::Add(size_t offset)
+{
+    if ((mCount < kMaxNames) && (offset <= kMaxOffset))
+    {
+        mOffsets[mCount++] = static_cast<uint16_t>(offset);
+    }
+}
+
+bool QNameCompressionTable::Find(const uint8_t * message, size_t messageLength, const FullQName & name, uint16_t & offset) const
+{
+    const BytesRange validData(message, message + messageLength);
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        if ((mOffsets[i] < messageLength) && (SerializedQNameIterator(validData, message + mOffsets[i]) == name))
+        {
+            offset = mOffsets[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+RecordWriter & RecordWriter::WriteQName(const FullQName & name)
+{
+    for (size_t i = 0; i < name.nameCount; i++)
+    {
+        // Names can only be looked up in what was actually written.
+        if ((mTable != nullptr) && mOutput.Fit())
+        {
+            const size_t position = static_cast<size_t>(mOutput.Buffer() - mMessage) + mOutput.Needed();
+
+            FullQName suffix;
+            suffix.names     = name.names + i;
+            suffix.nameCount = name.nameCount - i;
+
+            uint16_t offset;
+            if (mTable->Find(mMessage, position, suffix, offset))
+            {
+                mOutput.Put16(static_cast<uint16_t>(kPointerMarker | offset));
+                return *this;
+            }
+
+            mTable->Add(position);
+        }
+
+        mOutput.Put8(static_cast<uint8_t>(strlen(name.names[i])));
+        mOutput.Put(name.names[i]);
+    }
+    mOutput.Put8(0); // end of qnames
+
+    return *this;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <support/BufferWriter.h>
+
+#include <mdns/minimal/core/QName.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Offsets, from the start of a DNS message, of the names written to it, so
+/// that later names can point to them instead of repeating them (RFC 1035,
+/// section 4.1.4).
+///
+/// Writing a name records all of its suffixes that were written out in full,
+/// e.g. "foo.bar.local" records "foo.bar.local", "bar.local" and "local".
+class QNameCompressionTable
+{
+public:
+    static constexpr size_t kMaxNames    = 32;
+    static constexpr uint16_t kMaxOffset = 0x3FFF; // pointers have 14 bits of offset
+
+    void Clear() { mCount = 0; }
+
+    /// Number of names recorded, e.g. to later forget the names of a record
+    /// that did not fit with Truncate().
+    size_t Count() const { return mCount; }
+    void Truncate(size_t count)
+    {
+        if (count < mCount)
+        {
+            mCount = count;
+        }
+    }
+
+    /// Record a name at the given offset. Names out of reach of a pointer, or
+    /// that do not fit in the table, are not recorded.
+    void Add(size_t offset);
+
+    /// Find a recorded name that is equal to name, within the first
+    /// messageLength bytes of message.
+    bool Find(const uint8_t * message, size_t messageLength, const FullQName & name, uint16_t & offset) const;
+
+private:
+    uint16_t mOffsets[kMaxNames];
+    size_t mCount = 0;
+};
+
+/// Writes the parts of a resource record, compressing the names it writes if
+/// given a compression table.
+class RecordWriter
+{
+public:
+    /// Write to output without compressing names.
+    RecordWriter(chip::Encoding::BigEndian::BufferWriter & output) : mOutput(output) {}
+
+    /// Write to output, which continues the DNS message that starts at message.
+    /// Names are compressed against those in table, and the ones written out
+    /// are added to it.
+    RecordWriter(chip::Encoding::BigEndian::BufferWriter & output, const uint8_t * message, QNameCompressionTable & table) :
+        mOutput(output), mMessage(message), mTable(&table)
+    {}
+
+    chip::Encoding::BigEndian::BufferWriter & Writer() { return mOutput; }
+
+    RecordWriter & WriteQName(const FullQName & name);
+
+private:
+    chip::Encoding::BigEndian::BufferWriter & mOutput;
+    const uint8_t * mMessage       = nullptr;
+    QNameCompressionTable * mTable = nullptr;
+};
+
+} // namespace Minimal
+} // namespace mdns
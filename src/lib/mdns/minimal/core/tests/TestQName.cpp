@@ -198,6 +198,33 @@ void CaseInsensitiveSerializedCompare(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void SerializedCompare(nlTestSuite * inSuite, void * inContext)
+{
+    static const uint8_t kManyItems[] = "\04this\02is\01a\04test\00";
+    static const uint8_t kPtrItems[]  = "\04tHIs\02iS\01a\04test\00\04this\xc0\x05";
+    const BytesRange manyItemsRange(kManyItems, kManyItems + sizeof(kManyItems));
+    const BytesRange ptrItemsRange(kPtrItems, kPtrItems + sizeof(kPtrItems));
+
+    // "this.is.a.test", in full and through a pointer to "is.a.test"
+    NL_TEST_ASSERT(inSuite,
+                   SerializedQNameIterator(manyItemsRange, kManyItems) == SerializedQNameIterator(ptrItemsRange, kPtrItems + 16));
+    NL_TEST_ASSERT(inSuite,
+                   SerializedQNameIterator(ptrItemsRange, kPtrItems) == SerializedQNameIterator(ptrItemsRange, kPtrItems + 16));
+
+    // "is.a.test" and "this.is.a.test"
+    NL_TEST_ASSERT(inSuite,
+                   SerializedQNameIterator(manyItemsRange, kManyItems + 5) !=
+                       SerializedQNameIterator(ptrItemsRange, kPtrItems + 16));
+    NL_TEST_ASSERT(inSuite,
+                   SerializedQNameIterator(manyItemsRange, kManyItems) != SerializedQNameIterator(manyItemsRange, kManyItems + 5));
+
+    // invalid data
+    static const uint8_t kBadItems[] = "\04this\02is\01a\14test\00";
+    const BytesRange badItemsRange(kBadItems, kBadItems + sizeof(kBadItems));
+    NL_TEST_ASSERT(inSuite,
+                   SerializedQNameIterator(badItemsRange, kBadItems) != SerializedQNameIterator(badItemsRange, kBadItems));
+}
+
 void CaseInsensitiveFullQNameCompare(nlTestSuite * inSuite, void * inContext)
 {
     {
@@ -247,6 +274,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Comparison", Comparison),
     NL_TEST_DEF("CaseInsensitiveSerializedCompare", CaseInsensitiveSerializedCompare),
     NL_TEST_DEF("CaseInsensitiveFullQNameCompare", CaseInsensitiveFullQNameCompare),
+    NL_TEST_DEF("SerializedCompare", SerializedCompare),
 
     NL_TEST_SENTINEL()
 };
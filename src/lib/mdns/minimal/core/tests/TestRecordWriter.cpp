@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <mdns/minimal/core/RecordWriter.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace mdns::Minimal;
+using namespace chip::Encoding::BigEndian;
+
+void UncompressedTest(nlTestSuite * inSuite, void * inContext)
+{
+    const QNamePart kName[] = { "some", "test", "local" };
+    uint8_t buffer[64];
+
+    BufferWriter output(buffer, sizeof(buffer));
+    RecordWriter writer(output);
+
+    writer.WriteQName(kName).WriteQName(kName);
+
+    static const uint8_t kExpected[] = "\04some\04test\05local\00"
+                                       "\04some\04test\05local\00";
+    NL_TEST_ASSERT(inSuite, output.Fit());
+    NL_TEST_ASSERT(inSuite, output.Needed() == sizeof(kExpected) - 1);
+    NL_TEST_ASSERT(inSuite, memcmp(buffer, kExpected, sizeof(kExpected) - 1) == 0);
+}
+
+void CompressedTest(nlTestSuite * inSuite, void * inContext)
+{
+    const QNamePart kService[]  = { "_chip", "_tcp", "local" };
+    const QNamePart kInstance[] = { "ABCD", "_chip", "_tcp", "local" };
+    const QNamePart kHost[]     = { "host", "local" };
+    const QNamePart kOther[]    = { "other", "domain" };
+
+    uint8_t message[128];
+    QNameCompressionTable table;
+
+    // Names are looked up from the start of the message, which here has a 2-byte prefix.
+    message[0] = 0xAB;
+    message[1] = 0xCD;
+    BufferWriter output(message + 2, sizeof(message) - 2);
+    RecordWriter writer(output, message, table);
+
+    writer.WriteQName(kService);    // written in full, at offset 2
+    writer.WriteQName(kInstance);   // "ABCD" then a pointer to "_chip._tcp.local"
+    writer.WriteQName(kHost);       // "host" then a pointer to "local"
+    writer.WriteQName(kInstance);   // a pointer to the whole instance name
+    writer.WriteQName(kOther);      // nothing in common
+    writer.WriteQName(FullQName()); // the root name
+
+    static const uint8_t kExpected[] = "\05_chip\04_tcp\05local\00"
+                                       "\04ABCD\xC0\x02"
+                                       "\04host\xC0\x0D"
+                                       "\xC0\x14"
+                                       "\05other\06domain\00"
+                                       "\00";
+    NL_TEST_ASSERT(inSuite, output.Fit());
+    NL_TEST_ASSERT(inSuite, output.Needed() == sizeof(kExpected) - 1);
+    NL_TEST_ASSERT(inSuite, memcmp(message + 2, kExpected, sizeof(kExpected) - 1) == 0);
+
+    // The compressed names read back as the originals.
+    const BytesRange validData(message, message + 2 + output.Needed());
+    NL_TEST_ASSERT(inSuite, SerializedQNameIterator(validData, message + 20) == FullQName(kInstance));
+    NL_TEST_ASSERT(inSuite, SerializedQNameIterator(validData, message + 27) == FullQName(kHost));
+    NL_TEST_ASSERT(inSuite, SerializedQNameIterator(validData, message + 34) == FullQName(kInstance));
+}
+
+void CaseInsensitiveTest(nlTestSuite * inSuite, void * inContext)
+{
+    const QNamePart kName[]      = { "test", "local" };
+    const QNamePart kOtherCase[] = { "TEST", "Local" };
+
+    uint8_t message[64];
+    QNameCompressionTable table;
+    BufferWriter output(message, sizeof(message));
+    RecordWriter writer(output, message, table);
+
+    writer.WriteQName(kName).WriteQName(kOtherCase);
+
+    static const uint8_t kExpected[] = "\04test\05local\00"
+                                       "\xC0\x00";
+    NL_TEST_ASSERT(inSuite, output.Needed() == sizeof(kExpected) - 1);
+    NL_TEST_ASSERT(inSuite, memcmp(message, kExpected, sizeof(kExpected) - 1) == 0);
+}
+
+void TruncatedTest(nlTestSuite * inSuite, void * inContext)
+{
+    const QNamePart kName[] = { "test", "local" };
+
+    uint8_t message[64];
+    QNameCompressionTable table;
+
+    {
+        // A record that does not fit is dropped together with the names it recorded.
+        BufferWriter output(message, 8);
+        RecordWriter writer(output, message, table);
+        writer.WriteQName(kName);
+        NL_TEST_ASSERT(inSuite, !output.Fit());
+    }
+
+    table.Truncate(0);
+    NL_TEST_ASSERT(inSuite, table.Count() == 0);
+
+    BufferWriter output(message, sizeof(message));
+    RecordWriter writer(output, message, table);
+    writer.WriteQName(kName);
+    NL_TEST_ASSERT(inSuite, table.Count() == 2);
+    NL_TEST_ASSERT(inSuite, output.Needed() == 12);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("UncompressedTest", UncompressedTest),
+    NL_TEST_DEF("CompressedTest", CompressedTest),
+    NL_TEST_DEF("CaseInsensitiveTest", CaseInsensitiveTest),
+    NL_TEST_DEF("TruncatedTest", TruncatedTest),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestRecordWriter(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "RecordWriter",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRecordWriter)
@@ -20,8 +20,10 @@
 namespace mdns {
 namespace Minimal {
 
-bool IPResourceRecord::WriteData(chip::Encoding::BigEndian::BufferWriter & out) const
+bool IPResourceRecord::WriteData(RecordWriter & writer) const
 {
+    chip::Encoding::BigEndian::BufferWriter & out = writer.Writer();
+
     // IP address is already stored in network byte order, hence raw bytes put
     if (mIPAddress.IsIPv6())
     {
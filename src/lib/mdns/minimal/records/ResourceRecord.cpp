@@ -21,6 +21,12 @@ namespace mdns {
 namespace Minimal {
 
 bool ResourceRecord::Append(HeaderRef & hdr, ResourceType asType, chip::Encoding::BigEndian::BufferWriter & out) const
+{
+    RecordWriter writer(out);
+    return Append(hdr, asType, writer);
+}
+
+bool ResourceRecord::Append(HeaderRef & hdr, ResourceType asType, RecordWriter & writer) const
 {
     // order is important based on resource type. First come answers, then authorityAnswers
     // and then additional:
@@ -33,7 +39,9 @@ bool ResourceRecord::Append(HeaderRef & hdr, ResourceType asType, chip::Encoding
         return false;
     }
 
-    mQName.Output(out);
+    chip::Encoding::BigEndian::BufferWriter & out = writer.Writer();
+
+    writer.WriteQName(mQName);
 
     out                                           //
         .Put16(static_cast<uint16_t>(GetType()))  //
@@ -44,7 +52,7 @@ bool ResourceRecord::Append(HeaderRef & hdr, ResourceType asType, chip::Encoding
     chip::Encoding::BigEndian::BufferWriter sizeOutput(out); // copy to re-output size
     out.Put16(0);                                            // dummy, will be replaced later
 
-    if (!WriteData(out))
+    if (!WriteData(writer))
     {
         return false;
     }
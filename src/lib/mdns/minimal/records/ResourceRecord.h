@@ -21,6 +21,7 @@
 
 #include <mdns/minimal/core/Constants.h>
 #include <mdns/minimal/core/QName.h>
+#include <mdns/minimal/core/RecordWriter.h>
 
 #include <support/BufferWriter.h>
 
@@ -55,13 +56,18 @@ public:
     }
     bool GetCacheFlush() const { return mCacheFlush; }
 
-    /// Append the given record to the underlying output.
+    /// Append the given record to the underlying output, without compressing names.
     /// Updates header item count on success, does NOT update header on failure.
     bool Append(HeaderRef & hdr, ResourceType asType, chip::Encoding::BigEndian::BufferWriter & out) const;
 
+    /// Append the given record through a writer that may compress the names
+    /// of the record, i.e. its owner name and names within its data.
+    /// Updates header item count on success, does NOT update header on failure.
+    bool Append(HeaderRef & hdr, ResourceType asType, RecordWriter & out) const;
+
 protected:
     /// Output the data portion of the resource record.
-    virtual bool WriteData(chip::Encoding::BigEndian::BufferWriter & out) const = 0;
+    virtual bool WriteData(RecordWriter & out) const = 0;
 
     ResourceRecord(QType type, FullQName name) : mType(type), mQName(name) {}
 
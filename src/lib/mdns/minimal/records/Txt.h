@@ -50,8 +50,9 @@ public:
     }
 
 protected:
-    bool WriteData(chip::Encoding::BigEndian::BufferWriter & out) const override
+    bool WriteData(RecordWriter & writer) const override
     {
+        chip::Encoding::BigEndian::BufferWriter & out = writer.Writer();
         for (size_t i = 0; i < mEntryCount; i++)
         {
             size_t len = strlen(mEntries[i]);
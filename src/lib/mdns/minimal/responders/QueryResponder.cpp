@@ -76,6 +76,7 @@ void QueryResponderBase::ResetAdditionals()
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
         mResponderInfos[i].reportNowAsAdditional = false;
+        mResponderInfos[i].reportedNow           = false;
     }
 }
 
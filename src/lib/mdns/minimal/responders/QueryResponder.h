@@ -40,6 +40,7 @@ namespace Internal {
 struct QueryResponderInfo : public QueryResponderRecord
 {
     bool reportNowAsAdditional; // report as additional data required
+    bool reportedNow;           // already reported in the current reply
 
     bool alsoReportAdditionalQName = false; // report more data when this record is listed
     FullQName additionalQName;              // if alsoReportAdditionalQName is set, send this extra data
@@ -49,6 +50,7 @@ struct QueryResponderInfo : public QueryResponderRecord
         responder                 = nullptr;
         reportService             = false;
         reportNowAsAdditional     = false;
+        reportedNow               = false;
         alsoReportAdditionalQName = false;
     }
 };
@@ -112,6 +114,13 @@ public:
         return *this;
     }
 
+    /// Set if to include only items not yet reported in the current reply or everything.
+    QueryResponderRecordFilter & SetIncludeNotReportedOnly(bool includeNotReportedOnly)
+    {
+        mIncludeNotReportedOnly = includeNotReportedOnly;
+        return *this;
+    }
+
     /// Filter out anything rejected by the given reply filter.
     /// If replyFilter is nullptr, no such filtering is applied.
     QueryResponderRecordFilter & SetReplyFilter(ReplyFilter * replyFilter)
@@ -140,6 +149,11 @@ public:
             return false;
         }
 
+        if (mIncludeNotReportedOnly && record->reportedNow)
+        {
+            return false;
+        }
+
         if ((mIncludeOnlyMulticastBeforeMS > 0) && (record->lastMulticastTime >= mIncludeOnlyMulticastBeforeMS))
         {
             return false;
@@ -155,6 +169,7 @@ public:
 
 private:
     bool mIncludeAdditionalRepliesOnly     = false;
+    bool mIncludeNotReportedOnly           = false;
     ReplyFilter * mReplyFilter             = nullptr;
     uint64_t mIncludeOnlyMulticastBeforeMS = 0;
 };
@@ -259,9 +274,13 @@ public:
     }
     QueryResponderIterator end() { return QueryResponderIterator(); }
 
-    /// Clear any items marked as 'additional'.
+    /// Clear any items marked as 'additional' or as reported, to start a new reply.
     void ResetAdditionals();
 
+    /// Marks the given item as reported in the current reply, so that a reply
+    /// to several queries lists it only once.
+    void MarkReported(QueryResponderIterator it) { it.GetInternal()->reportedNow = true; }
+
     /// Marks queries matching this qname as 'to be additionally reported'
     /// @return the number of items marked new as 'additional data'.
     size_t MarkAdditional(const FullQName & qname);
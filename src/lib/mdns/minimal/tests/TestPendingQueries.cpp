@@ -0,0 +1,178 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <mdns/minimal/PendingQueries.h>
+
+#include <mdns/minimal/QueryBuilder.h>
+#include <mdns/minimal/core/FlatAllocatedQName.h>
+#include <mdns/minimal/records/Ptr.h>
+
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kPacketSizeBytes = 512;
+
+using TestQueries = PendingQueries<2>;
+
+struct TestNames
+{
+    uint8_t commissionableStorage[64];
+    uint8_t commissionerStorage[64];
+    uint8_t thirdStorage[64];
+    uint8_t instanceStorage[64];
+    FullQName commissionable = FlatAllocatedQName::Build(commissionableStorage, "_chipc", "_udp", "local");
+    FullQName commissioner   = FlatAllocatedQName::Build(commissionerStorage, "_chipd", "_udp", "local");
+    FullQName third          = FlatAllocatedQName::Build(thirdStorage, "_third", "_udp", "local");
+    FullQName instance       = FlatAllocatedQName::Build(instanceStorage, "instance", "_chipc", "_udp", "local");
+};
+
+System::PacketBufferHandle BuildQuery(const FullQName & name, const ResourceRecord * knownAnswer = nullptr)
+{
+    QueryBuilder builder(System::PacketBufferHandle::New(kPacketSizeBytes));
+    builder.AddQuery(Query(name).SetType(QType::ANY).SetAnswerViaUnicast(false));
+    if (knownAnswer != nullptr)
+    {
+        builder.AddAnswer(*knownAnswer);
+    }
+    return builder.Ok() ? builder.ReleasePacket() : System::PacketBufferHandle();
+}
+
+bool ParseQuery(const System::PacketBufferHandle & packet, QueryPacket & query)
+{
+    return query.Parse(BytesRange(packet->Start(), packet->Start() + packet->DataLength()));
+}
+
+void BackToBackQueries(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    TestQueries queries;
+
+    // A second browse within the delay of the first one must not drop it.
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissionable), 100));
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissioner), 50));
+    NL_TEST_ASSERT(inSuite, queries.Count() == 2);
+    NL_TEST_ASSERT(inSuite, queries.NextDueMs() == 50);
+
+    int sent = 0;
+    queries.TakeDue(49, [&](System::PacketBufferHandle && packet) { sent++; });
+    NL_TEST_ASSERT(inSuite, sent == 0);
+
+    queries.TakeDue(50, [&](System::PacketBufferHandle && packet) {
+        QueryPacket query;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, query));
+        query.ForEachQuery([&](const QueryData & data) { NL_TEST_ASSERT(inSuite, data.GetName() == names.commissioner); });
+        sent++;
+    });
+    NL_TEST_ASSERT(inSuite, sent == 1);
+    NL_TEST_ASSERT(inSuite, queries.NextDueMs() == 100);
+
+    queries.TakeDue(100, [&](System::PacketBufferHandle && packet) {
+        QueryPacket query;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, query));
+        query.ForEachQuery([&](const QueryData & data) { NL_TEST_ASSERT(inSuite, data.GetName() == names.commissionable); });
+        sent++;
+    });
+    NL_TEST_ASSERT(inSuite, sent == 2);
+    NL_TEST_ASSERT(inSuite, queries.Count() == 0);
+    NL_TEST_ASSERT(inSuite, queries.NextDueMs() == TestQueries::kNever);
+}
+
+void SameNameReplaces(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    TestQueries queries;
+    PtrResourceRecord knownAnswer(names.commissionable, names.instance);
+
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissionable), 100));
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissionable, &knownAnswer), 200));
+    NL_TEST_ASSERT(inSuite, queries.Count() == 1);
+    NL_TEST_ASSERT(inSuite, queries.NextDueMs() == 100);
+
+    int sent = 0;
+    queries.TakeDue(100, [&](System::PacketBufferHandle && packet) {
+        QueryPacket query;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, query));
+        NL_TEST_ASSERT(inSuite, query.GetKnownAnswerCount() == 1);
+        sent++;
+    });
+    NL_TEST_ASSERT(inSuite, sent == 1);
+}
+
+void FullQueue(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    TestQueries queries;
+
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissionable), 100));
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissioner), 100));
+
+    System::PacketBufferHandle packet = BuildQuery(names.third);
+    NL_TEST_ASSERT(inSuite, !queries.Add(std::move(packet), 100));
+    NL_TEST_ASSERT(inSuite, !packet.IsNull());
+    NL_TEST_ASSERT(inSuite, queries.Count() == 2);
+}
+
+void DuplicateSuppression(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    TestQueries queries;
+
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissionable), 100));
+    NL_TEST_ASSERT(inSuite, queries.Add(BuildQuery(names.commissioner), 100));
+
+    System::PacketBufferHandle observedPacket = BuildQuery(names.commissioner);
+    QueryPacket observed;
+    NL_TEST_ASSERT(inSuite, ParseQuery(observedPacket, observed));
+    NL_TEST_ASSERT(inSuite, queries.SuppressDuplicatedBy(observed) == 1);
+    NL_TEST_ASSERT(inSuite, queries.Count() == 1);
+
+    int sent = 0;
+    queries.TakeDue(100, [&](System::PacketBufferHandle && packet) {
+        QueryPacket query;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, query));
+        query.ForEachQuery([&](const QueryData & data) { NL_TEST_ASSERT(inSuite, data.GetName() == names.commissionable); });
+        sent++;
+    });
+    NL_TEST_ASSERT(inSuite, sent == 1);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("BackToBackQueries", BackToBackQueries),       //
+    NL_TEST_DEF("SameNameReplaces", SameNameReplaces),         //
+    NL_TEST_DEF("FullQueue", FullQueue),                       //
+    NL_TEST_DEF("DuplicateSuppression", DuplicateSuppression), //
+    NL_TEST_SENTINEL()                                         //
+};
+
+} // namespace
+
+int TestPendingQueries(void)
+{
+    chip::Platform::MemoryInit();
+    nlTestSuite theSuite = { "PendingQueries", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPendingQueries)
@@ -0,0 +1,265 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <mdns/minimal/QueryPacket.h>
+
+#include <mdns/minimal/QueryBuilder.h>
+#include <mdns/minimal/core/FlatAllocatedQName.h>
+#include <mdns/minimal/records/Ptr.h>
+#include <mdns/minimal/records/Srv.h>
+#include <mdns/minimal/records/Txt.h>
+
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kPacketSizeBytes = 512;
+
+struct TestNames
+{
+    uint8_t serviceStorage[64];
+    uint8_t instanceStorage[64];
+    uint8_t otherInstanceStorage[64];
+    uint8_t hostStorage[64];
+    FullQName service       = FlatAllocatedQName::Build(serviceStorage, "_test", "_udp", "local");
+    FullQName instance      = FlatAllocatedQName::Build(instanceStorage, "instance", "_test", "_udp", "local");
+    FullQName otherInstance = FlatAllocatedQName::Build(otherInstanceStorage, "other", "_test", "_udp", "local");
+    FullQName host          = FlatAllocatedQName::Build(hostStorage, "host", "local");
+};
+
+/// Builds a query packet and parses it back.
+class TestQuery
+{
+public:
+    TestQuery() : mBuilder(System::PacketBufferHandle::New(kPacketSizeBytes)) {}
+
+    TestQuery & AddQuery(const FullQName & name, QType type, bool unicast = false)
+    {
+        mBuilder.AddQuery(Query(name).SetType(type).SetAnswerViaUnicast(unicast));
+        return *this;
+    }
+
+    TestQuery & AddAnswer(const ResourceRecord & record)
+    {
+        mBuilder.AddAnswer(record);
+        return *this;
+    }
+
+    bool Parse(QueryPacket & packet)
+    {
+        if (!mBuilder.Ok())
+        {
+            return false;
+        }
+        mPacket = mBuilder.ReleasePacket();
+        return packet.Parse(BytesRange(mPacket->Start(), mPacket->Start() + mPacket->DataLength()));
+    }
+
+private:
+    QueryBuilder mBuilder;
+    System::PacketBufferHandle mPacket;
+};
+
+void ParseCounts(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    TestQuery query;
+    QueryPacket packet;
+
+    query.AddQuery(names.service, QType::PTR).AddQuery(names.instance, QType::SRV, true);
+    query.AddAnswer(PtrResourceRecord(names.service, names.instance));
+    NL_TEST_ASSERT(inSuite, query.Parse(packet));
+
+    NL_TEST_ASSERT(inSuite, packet.GetQueryCount() == 2);
+    NL_TEST_ASSERT(inSuite, packet.GetKnownAnswerCount() == 1);
+    NL_TEST_ASSERT(inSuite, !packet.IsTruncated());
+    NL_TEST_ASSERT(inSuite, !packet.RequestedUnicastAnswer());
+
+    int queries = 0;
+    packet.ForEachQuery([&](const QueryData & data) {
+        NL_TEST_ASSERT(inSuite, data.GetType() == ((queries == 0) ? QType::PTR : QType::SRV));
+        NL_TEST_ASSERT(inSuite, data.RequestedUnicastAnswer() == (queries != 0));
+        queries++;
+    });
+    NL_TEST_ASSERT(inSuite, queries == 2);
+
+    int answers = 0;
+    packet.ForEachKnownAnswer([&](const ResourceData & data) {
+        NL_TEST_ASSERT(inSuite, data.GetType() == QType::PTR);
+        answers++;
+    });
+    NL_TEST_ASSERT(inSuite, answers == 1);
+
+    TestQuery unicastQuery;
+    unicastQuery.AddQuery(names.instance, QType::SRV, true);
+    NL_TEST_ASSERT(inSuite, unicastQuery.Parse(packet));
+    NL_TEST_ASSERT(inSuite, packet.RequestedUnicastAnswer());
+}
+
+void ParseInvalid(nlTestSuite * inSuite, void * inContext)
+{
+    QueryPacket packet;
+
+    // too short for a header
+    const uint8_t shortData[] = { 0, 0, 0, 0 };
+    NL_TEST_ASSERT(inSuite, !packet.Parse(BytesRange(shortData, shortData + sizeof(shortData))));
+
+    // a response rather than a query
+    const uint8_t response[] = {
+        0x00, 0x00, 0x84, 0x00, // id, flags: response, authoritative
+        0x00, 0x00, 0x00, 0x00, // queries, answers
+        0x00, 0x00, 0x00, 0x00, // authorities, additionals
+    };
+    NL_TEST_ASSERT(inSuite, !packet.Parse(BytesRange(response, response + sizeof(response))));
+
+    // claims a question that is not there
+    const uint8_t missingQuery[] = {
+        0x00, 0x00, 0x00, 0x00, // id, flags: query
+        0x00, 0x01, 0x00, 0x00, // queries, answers
+        0x00, 0x00, 0x00, 0x00, // authorities, additionals
+    };
+    NL_TEST_ASSERT(inSuite, !packet.Parse(BytesRange(missingQuery, missingQuery + sizeof(missingQuery))));
+    NL_TEST_ASSERT(inSuite, packet.GetQueryCount() == 0);
+}
+
+void KnownAnswers(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    TestQuery query;
+    QueryPacket packet;
+
+    const char * txtEntries[]      = { "a=b", "c=d" };
+    const char * otherTxtEntries[] = { "a=b" };
+
+    PtrResourceRecord ptr(names.service, names.instance);
+    SrvResourceRecord srv(names.instance, names.host, 1234);
+    TxtResourceRecord txt(names.instance, txtEntries);
+
+    query.AddQuery(names.service, QType::PTR);
+    query.AddAnswer(ptr).AddAnswer(srv).AddAnswer(txt);
+    NL_TEST_ASSERT(inSuite, query.Parse(packet));
+    NL_TEST_ASSERT(inSuite, packet.GetKnownAnswerCount() == 3);
+
+    NL_TEST_ASSERT(inSuite, packet.IsKnownAnswer(ptr));
+    NL_TEST_ASSERT(inSuite, packet.IsKnownAnswer(srv));
+    NL_TEST_ASSERT(inSuite, packet.IsKnownAnswer(txt));
+
+    // Our records carry the cache flush bit, which known answers do not.
+    SrvResourceRecord flushSrv(names.instance, names.host, 1234);
+    flushSrv.SetCacheFlush(true);
+    NL_TEST_ASSERT(inSuite, packet.IsKnownAnswer(flushSrv));
+
+    NL_TEST_ASSERT(inSuite, !packet.IsKnownAnswer(PtrResourceRecord(names.service, names.otherInstance)));
+    NL_TEST_ASSERT(inSuite, !packet.IsKnownAnswer(SrvResourceRecord(names.instance, names.host, 1235)));
+    NL_TEST_ASSERT(inSuite, !packet.IsKnownAnswer(SrvResourceRecord(names.otherInstance, names.host, 1234)));
+    NL_TEST_ASSERT(inSuite, !packet.IsKnownAnswer(TxtResourceRecord(names.instance, otherTxtEntries)));
+
+    // Known answers are only valid for records whose TTL they cover at least half of.
+    SrvResourceRecord longSrv(names.instance, names.host, 1234);
+    longSrv.SetTtl(ResourceRecord::kDefaultTtl * 2);
+    NL_TEST_ASSERT(inSuite, packet.IsKnownAnswer(longSrv));
+    longSrv.SetTtl(ResourceRecord::kDefaultTtl * 2 + 1);
+    NL_TEST_ASSERT(inSuite, !packet.IsKnownAnswer(longSrv));
+}
+
+void DuplicateQuestions(nlTestSuite * inSuite, void * inContext)
+{
+    TestNames names;
+    PtrResourceRecord ptr(names.service, names.instance);
+    PtrResourceRecord otherPtr(names.service, names.otherInstance);
+
+    TestQuery ourQuery;
+    QueryPacket ourPacket;
+    ourQuery.AddQuery(names.service, QType::PTR).AddAnswer(ptr);
+    NL_TEST_ASSERT(inSuite, ourQuery.Parse(ourPacket));
+
+    {
+        TestQuery query;
+        QueryPacket packet;
+        query.AddQuery(names.service, QType::PTR);
+        NL_TEST_ASSERT(inSuite, query.Parse(packet));
+        NL_TEST_ASSERT(inSuite, ourPacket.IsDuplicatedBy(packet));
+    }
+
+    {
+        // more questions, and known answers that we also have
+        TestQuery query;
+        QueryPacket packet;
+        query.AddQuery(names.instance, QType::SRV).AddQuery(names.service, QType::PTR).AddAnswer(ptr);
+        NL_TEST_ASSERT(inSuite, query.Parse(packet));
+        NL_TEST_ASSERT(inSuite, ourPacket.IsDuplicatedBy(packet));
+    }
+
+    {
+        // responders would leave out a record that we do not have
+        TestQuery query;
+        QueryPacket packet;
+        query.AddQuery(names.service, QType::PTR).AddAnswer(otherPtr);
+        NL_TEST_ASSERT(inSuite, query.Parse(packet));
+        NL_TEST_ASSERT(inSuite, !ourPacket.IsDuplicatedBy(packet));
+    }
+
+    {
+        // the answers go to the other querier only
+        TestQuery query;
+        QueryPacket packet;
+        query.AddQuery(names.service, QType::PTR, true);
+        NL_TEST_ASSERT(inSuite, query.Parse(packet));
+        NL_TEST_ASSERT(inSuite, !ourPacket.IsDuplicatedBy(packet));
+    }
+
+    {
+        TestQuery query;
+        QueryPacket packet;
+        query.AddQuery(names.service, QType::ANY);
+        NL_TEST_ASSERT(inSuite, query.Parse(packet));
+        NL_TEST_ASSERT(inSuite, !ourPacket.IsDuplicatedBy(packet));
+    }
+
+    {
+        TestQuery query;
+        QueryPacket packet;
+        query.AddQuery(names.instance, QType::PTR);
+        NL_TEST_ASSERT(inSuite, query.Parse(packet));
+        NL_TEST_ASSERT(inSuite, !ourPacket.IsDuplicatedBy(packet));
+    }
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("ParseCounts", ParseCounts),               //
+    NL_TEST_DEF("ParseInvalid", ParseInvalid),             //
+    NL_TEST_DEF("KnownAnswers", KnownAnswers),             //
+    NL_TEST_DEF("DuplicateQuestions", DuplicateQuestions), //
+    NL_TEST_SENTINEL()                                     //
+};
+
+} // namespace
+
+int TestQueryPacket(void)
+{
+    chip::Platform::MemoryInit();
+    nlTestSuite theSuite = { "QueryPacket", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestQueryPacket)
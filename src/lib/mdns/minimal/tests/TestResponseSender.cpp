@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include <mdns/minimal/QueryBuilder.h>
 #include <mdns/minimal/RecordData.h>
 #include <mdns/minimal/core/FlatAllocatedQName.h>
 #include <mdns/minimal/responders/Ptr.h>
@@ -64,9 +65,9 @@ public:
             {
                 if (data.GetType() == QType::PTR)
                 {
-                    // Check that the internal values are the same
+                    // Check that the internal values are the same. The target may point to names elsewhere in the packet.
                     SerializedQNameIterator dataTarget;
-                    ParsePtrRecord(data.GetData(), data.GetData(), &dataTarget);
+                    ParsePtrRecord(data.GetData(), mPacketRange, &dataTarget);
                     const PtrResourceRecord * expectedPtr = static_cast<const PtrResourceRecord *>(expectedRecord[i]);
                     if (dataTarget == expectedPtr->GetPtr())
                     {
@@ -93,12 +94,33 @@ public:
                chip::Inet::InterfaceId interface) override
     {
         ResetFoundRecords();
-        ParsePacket(BytesRange(data->Start(), data->Start() + data->TotalLength()), this);
+        mPacketRange = BytesRange(data->Start(), data->Start() + data->TotalLength());
+        ParsePacket(mPacketRange, this);
         TestGotAllExpectedPackets();
         sendCalled = true;
+        sentPackets++;
+        sentBytes += data->TotalLength();
         return CHIP_NO_ERROR;
     }
 
+    CHIP_ERROR BroadcastSend(chip::System::PacketBufferHandle && data, uint16_t port, chip::Inet::InterfaceId interface) override
+    {
+        return DirectSend(std::move(data), chip::Inet::IPAddress::Any, port, interface);
+    }
+
+    /// Forget the expected records and what was sent so far.
+    void Reset()
+    {
+        for (size_t i = 0; i < kMaxExpectedRecords; ++i)
+        {
+            expectedRecord[i] = nullptr;
+        }
+        headerFound = false;
+        sendCalled  = false;
+        sentPackets = 0;
+        sentBytes   = 0;
+    }
+
     void AddExpectedRecord(ResourceRecord * record)
     {
         for (size_t i = 0; i < kMaxExpectedRecords; ++i)
@@ -113,14 +135,19 @@ public:
     }
     bool GetSendCalled() { return sendCalled; }
     bool GetHeaderFound() { return headerFound; }
+    size_t GetSentPackets() { return sentPackets; }
+    size_t GetSentBytes() { return sentBytes; }
 
 private:
     nlTestSuite * mInSuite;
+    BytesRange mPacketRange;
     static constexpr size_t kMaxExpectedRecords          = 10;
     ResourceRecord * expectedRecord[kMaxExpectedRecords] = {};
     bool foundRecord[kMaxExpectedRecords];
-    bool headerFound = false;
-    bool sendCalled  = false;
+    bool headerFound   = false;
+    bool sendCalled    = false;
+    size_t sentPackets = 0;
+    size_t sentBytes   = 0;
     void ResetFoundRecords()
     {
         for (size_t i = 0; i < kMaxExpectedRecords; ++i)
@@ -450,6 +477,165 @@ void PtrSrvTxtMultipleRespondersToServiceListing(nlTestSuite * inSuite, void * i
     NL_TEST_ASSERT(inSuite, common1.server.GetHeaderFound());
 }
 
+constexpr uint16_t kMdnsPort           = 5353;
+constexpr size_t kQueryPacketSizeBytes = 512;
+
+bool ParseQuery(const System::PacketBufferHandle & packet, QueryPacket & queryPacket)
+{
+    return queryPacket.Parse(BytesRange(packet->Start(), packet->Start() + packet->DataLength()));
+}
+
+void KnownAnswerSuppression(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    // Multicast queries, as other controllers browsing for the service send them.
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    size_t fullReplyBytes = 0;
+    {
+        QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSizeBytes));
+        builder.AddQuery(Query(common.service).SetType(QType::ANY).SetAnswerViaUnicast(false));
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        QueryPacket queryPacket;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, queryPacket));
+
+        common.server.AddExpectedRecord(&common.ptrRecord);
+        common.server.AddExpectedRecord(&common.srvRecord);
+        common.server.AddExpectedRecord(&common.txtRecord);
+        NL_TEST_ASSERT(inSuite, responseSender.Respond(queryPacket, &common.packetInfo) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, common.server.GetSentPackets() == 1);
+        fullReplyBytes = common.server.GetSentBytes();
+        NL_TEST_ASSERT(inSuite, fullReplyBytes > 0);
+    }
+
+    // The querier knows the PTR record, and so does not need its additional records either.
+    {
+        common.server.Reset();
+        common.queryResponder.ClearBroadcastThrottle();
+
+        QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSizeBytes));
+        builder.AddQuery(Query(common.service).SetType(QType::ANY).SetAnswerViaUnicast(false));
+        builder.AddAnswer(PtrResourceRecord(common.service, common.instance).SetTtl(ResourceRecord::kDefaultTtl / 2));
+        NL_TEST_ASSERT(inSuite, builder.Ok());
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        QueryPacket queryPacket;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, queryPacket));
+
+        NL_TEST_ASSERT(inSuite, responseSender.Respond(queryPacket, &common.packetInfo) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, common.server.GetSentPackets() == 0);
+        NL_TEST_ASSERT(inSuite, common.server.GetSentBytes() == 0);
+    }
+
+    // A known answer with less than half of its TTL left is refreshed.
+    {
+        common.server.Reset();
+        common.queryResponder.ClearBroadcastThrottle();
+
+        QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSizeBytes));
+        builder.AddQuery(Query(common.service).SetType(QType::ANY).SetAnswerViaUnicast(false));
+        builder.AddAnswer(PtrResourceRecord(common.service, common.instance).SetTtl(ResourceRecord::kDefaultTtl / 2 - 1));
+        NL_TEST_ASSERT(inSuite, builder.Ok());
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        QueryPacket queryPacket;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, queryPacket));
+
+        common.server.AddExpectedRecord(&common.ptrRecord);
+        common.server.AddExpectedRecord(&common.srvRecord);
+        common.server.AddExpectedRecord(&common.txtRecord);
+        NL_TEST_ASSERT(inSuite, responseSender.Respond(queryPacket, &common.packetInfo) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, common.server.GetSentPackets() == 1);
+        NL_TEST_ASSERT(inSuite, common.server.GetSentBytes() == fullReplyBytes);
+    }
+}
+
+void KnownAnswerSuppressionOfSomeInstances(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+
+    uint8_t otherInstanceStorage[64];
+    const FullQName otherInstance = FlatAllocatedQName::Build(otherInstanceStorage, "other", "instance");
+    PtrResourceRecord otherPtrRecord(common.service, otherInstance);
+    PtrResponder otherPtrResponder(common.service, otherInstance);
+
+    common.queryResponder.AddResponder(&common.ptrResponder);
+    common.queryResponder.AddResponder(&otherPtrResponder);
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSizeBytes));
+    builder.AddQuery(Query(common.service).SetType(QType::PTR).SetAnswerViaUnicast(false));
+    builder.AddAnswer(common.ptrRecord);
+    NL_TEST_ASSERT(inSuite, builder.Ok());
+    System::PacketBufferHandle packet = builder.ReleasePacket();
+    QueryPacket queryPacket;
+    NL_TEST_ASSERT(inSuite, ParseQuery(packet, queryPacket));
+
+    // Only the instance that the querier did not list is sent.
+    common.server.AddExpectedRecord(&otherPtrRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(queryPacket, &common.packetInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSentPackets() == 1);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+}
+
+void ResponseAggregation(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+    common.packetInfo.SrcPort = kMdnsPort;
+
+    // One reply per query packet.
+    size_t separateReplyBytes = 0;
+    for (QType type : { QType::SRV, QType::TXT })
+    {
+        common.server.Reset();
+        common.queryResponder.ClearBroadcastThrottle();
+
+        QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSizeBytes));
+        builder.AddQuery(Query(common.instance).SetType(type).SetAnswerViaUnicast(false));
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        QueryPacket queryPacket;
+        NL_TEST_ASSERT(inSuite, ParseQuery(packet, queryPacket));
+
+        common.server.AddExpectedRecord((type == QType::SRV) ? static_cast<ResourceRecord *>(&common.srvRecord)
+                                                             : static_cast<ResourceRecord *>(&common.txtRecord));
+        NL_TEST_ASSERT(inSuite, responseSender.Respond(queryPacket, &common.packetInfo) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, common.server.GetSentPackets() == 1);
+        separateReplyBytes += common.server.GetSentBytes();
+    }
+
+    // Both questions in one packet, and the same question asked twice, get a single reply that lists each record once.
+    common.server.Reset();
+    common.queryResponder.ClearBroadcastThrottle();
+
+    QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSizeBytes));
+    builder.AddQuery(Query(common.instance).SetType(QType::SRV).SetAnswerViaUnicast(false));
+    builder.AddQuery(Query(common.instance).SetType(QType::TXT).SetAnswerViaUnicast(false));
+    builder.AddQuery(Query(common.instance).SetType(QType::SRV).SetAnswerViaUnicast(false));
+    System::PacketBufferHandle packet = builder.ReleasePacket();
+    QueryPacket queryPacket;
+    NL_TEST_ASSERT(inSuite, ParseQuery(packet, queryPacket));
+
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(queryPacket, &common.packetInfo) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetSentPackets() == 1);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+
+    // One header less, and the TXT record points to the name of the SRV record.
+    NL_TEST_ASSERT(inSuite, common.server.GetSentBytes() < separateReplyBytes - HeaderRef::kSizeBytes);
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("SrvAnyResponseToInstance", SrvAnyResponseToInstance),                                       //
     NL_TEST_DEF("SrvTxtAnyResponseToInstance", SrvTxtAnyResponseToInstance),                                 //
@@ -461,6 +647,9 @@ const nlTest sTests[] = {
     NL_TEST_DEF("AddManyQueryResponders", AddManyQueryResponders),                                           //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToInstance", PtrSrvTxtMultipleRespondersToInstance),             //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToServiceListing", PtrSrvTxtMultipleRespondersToServiceListing), //
+    NL_TEST_DEF("KnownAnswerSuppression", KnownAnswerSuppression),                                           //
+    NL_TEST_DEF("KnownAnswerSuppressionOfSomeInstances", KnownAnswerSuppressionOfSomeInstances),             //
+    NL_TEST_DEF("ResponseAggregation", ResponseAggregation),                                                 //
 
     NL_TEST_SENTINEL() //
 };
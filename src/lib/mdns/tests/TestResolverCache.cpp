@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <mdns/ResolverCache.h>
+
+#include <mdns/Resolver.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Mdns;
+
+namespace {
+
+using TestCache = ResolverCache<ResolvedNodeData, 2>;
+
+ResolvedNodeData MakeNode(NodeId nodeId, uint16_t port)
+{
+    ResolvedNodeData data;
+    data.mPeerId      = PeerId().SetFabricId(1).SetNodeId(nodeId);
+    data.mInterfaceId = INET_NULL_INTERFACEID;
+    data.mAddress     = Inet::IPAddress::Any;
+    data.mPort        = port;
+    return data;
+}
+
+auto MatchNode(NodeId nodeId)
+{
+    return [nodeId](const ResolvedNodeData & data) { return data.mPeerId.GetNodeId() == nodeId; };
+}
+
+void TestInsertAndExpire(nlTestSuite * inSuite, void * inContext)
+{
+    TestCache cache;
+
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(1), 0) == nullptr);
+
+    cache.Insert(MakeNode(1, 5540), MatchNode(1), 120, 1000);
+    TestCache::Entry * entry = cache.Find(MatchNode(1), 1000);
+    NL_TEST_ASSERT(inSuite, entry != nullptr);
+    NL_TEST_ASSERT(inSuite, entry->data.mPort == 5540);
+    NL_TEST_ASSERT(inSuite, entry->refreshMs == 1000 + 96000);
+
+    // Live until the TTL has passed.
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(1), 1000 + 119999) != nullptr);
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(1), 1000 + 120000) == nullptr);
+
+    // Newer records replace older ones.
+    cache.Insert(MakeNode(1, 5541), MatchNode(1), 120, 2000);
+    entry = cache.Find(MatchNode(1), 2000);
+    NL_TEST_ASSERT(inSuite, entry != nullptr && entry->data.mPort == 5541);
+
+    // A goodbye removes the entry.
+    cache.Insert(MakeNode(1, 5541), MatchNode(1), 0, 3000);
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(1), 3000) == nullptr);
+}
+
+void TestEviction(nlTestSuite * inSuite, void * inContext)
+{
+    TestCache cache;
+
+    cache.Insert(MakeNode(1, 1), MatchNode(1), 60, 0);
+    cache.Insert(MakeNode(2, 2), MatchNode(2), 30, 0);
+
+    // The entry closest to expiring gives way.
+    cache.Insert(MakeNode(3, 3), MatchNode(3), 60, 0);
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(1), 0) != nullptr);
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(2), 0) == nullptr);
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(3), 0) != nullptr);
+
+    // Expired entries are reused first.
+    cache.Insert(MakeNode(4, 4), MatchNode(4), 10, 60000);
+    NL_TEST_ASSERT(inSuite, cache.Find(MatchNode(4), 60000) != nullptr);
+
+    int live = 0;
+    cache.ForEach(60000, [&live](TestCache::Entry &) { live++; });
+    NL_TEST_ASSERT(inSuite, live == 1);
+}
+
+void TestRefresh(nlTestSuite * inSuite, void * inContext)
+{
+    TestCache cache;
+
+    cache.Insert(MakeNode(1, 1), MatchNode(1), 100, 0);
+    cache.Insert(MakeNode(2, 2), MatchNode(2), 50, 0);
+
+    // Only entries that are in use are refreshed.
+    NL_TEST_ASSERT(inSuite, cache.NextRefreshMs(0) == TestCache::kNever);
+
+    cache.Find(MatchNode(1), 0)->inUse = true;
+    NL_TEST_ASSERT(inSuite, cache.NextRefreshMs(0) == 80000);
+
+    cache.Find(MatchNode(2), 0)->inUse = true;
+    NL_TEST_ASSERT(inSuite, cache.NextRefreshMs(0) == 40000);
+
+    cache.Find(MatchNode(2), 40000)->refreshSent = true;
+    NL_TEST_ASSERT(inSuite, cache.NextRefreshMs(40000) == 80000);
+
+    // Fresh records start over, and need to be looked up again to be refreshed.
+    cache.Insert(MakeNode(1, 1), MatchNode(1), 100, 50000);
+    NL_TEST_ASSERT(inSuite, cache.NextRefreshMs(50000) == TestCache::kNever);
+}
+
+void TestKnownAnswerTtl(nlTestSuite * inSuite, void * inContext)
+{
+    TestCache cache;
+
+    cache.Insert(MakeNode(1, 1), MatchNode(1), 120, 1000);
+    TestCache::Entry * entry = cache.Find(MatchNode(1), 1000);
+    NL_TEST_ASSERT(inSuite, entry != nullptr);
+    NL_TEST_ASSERT(inSuite, entry->ttlSeconds == 120);
+    NL_TEST_ASSERT(inSuite, entry->RemainingTtlSeconds(1000) == 120);
+    NL_TEST_ASSERT(inSuite, entry->RemainingTtlSeconds(1000 + 30500) == 89);
+
+    // Records are listed as known answers until half of their TTL has passed.
+    NL_TEST_ASSERT(inSuite, entry->IsFresh(1000 + 60000));
+    NL_TEST_ASSERT(inSuite, !entry->IsFresh(1000 + 60001));
+    NL_TEST_ASSERT(inSuite, !entry->IsFresh(1000 + 120000));
+    NL_TEST_ASSERT(inSuite, entry->RemainingTtlSeconds(1000 + 120000) == 0);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("InsertAndExpire", TestInsertAndExpire), //
+    NL_TEST_DEF("Eviction", TestEviction),               //
+    NL_TEST_DEF("Refresh", TestRefresh),                 //
+    NL_TEST_DEF("KnownAnswerTtl", TestKnownAnswerTtl),   //
+    NL_TEST_SENTINEL()                                   //
+};
+
+} // namespace
+
+int TestResolverCache(void)
+{
+    nlTestSuite theSuite = { "ResolverCache", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestResolverCache);
@@ -19,14 +19,36 @@
 
 #include <support/Pool.h>
 
+#include <support/CHIPMem.h>
+
 #include <nlassert.h>
 
 namespace chip {
 
+namespace {
+
+template <typename T>
+size_t CountTrailingZeros(T value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    static_assert(sizeof(T) == sizeof(unsigned long), "CountTrailingZeros expects unsigned long");
+    return static_cast<size_t>(__builtin_ctzl(value));
+#else
+    size_t count = 0;
+    for (; (value & 1) == 0; value >>= 1)
+    {
+        count++;
+    }
+    return count;
+#endif
+}
+
+} // namespace
+
 StaticAllocatorBitmap::StaticAllocatorBitmap(void * storage, std::atomic<tBitChunkType> * usage, size_t capacity,
                                              size_t elementSize) :
     StaticAllocatorBase(capacity),
-    mElements(storage), mElementSize(elementSize), mUsage(usage)
+    mElements(storage), mElementSize(elementSize), mUsage(usage), mFreeWordHint(0)
 {
     for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
     {
@@ -34,25 +56,36 @@ StaticAllocatorBitmap::StaticAllocatorBitmap(void * storage, std::atomic<tBitChu
     }
 }
 
+StaticAllocatorBitmap::tBitChunkType StaticAllocatorBitmap::UsableBits(size_t word) const
+{
+    const size_t remaining = Capacity() - word * kBitChunkSize;
+    return (remaining >= kBitChunkSize) ? ~static_cast<tBitChunkType>(0) : (kBit1 << remaining) - 1;
+}
+
 void * StaticAllocatorBitmap::Allocate()
 {
-    for (size_t word = 0; word * kBitChunkSize < Capacity(); ++word)
+    const size_t words = WordCount();
+    size_t word        = mFreeWordHint.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < words; ++i, ++word)
     {
-        auto & usage = mUsage[word];
-        auto value   = usage.load(std::memory_order_relaxed);
-        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < Capacity(); ++offset)
+        if (word >= words)
         {
-            if ((value & (kBit1 << offset)) == 0)
+            word = 0;
+        }
+
+        auto & usage             = mUsage[word];
+        auto value               = usage.load(std::memory_order_relaxed);
+        const tBitChunkType mask = UsableBits(word);
+        while ((~value & mask) != 0)
+        {
+            const size_t offset = CountTrailingZeros(~value & mask);
+            // On a race the exchange fails and updates value with the new usage.
+            if (usage.compare_exchange_weak(value, value | (kBit1 << offset)))
             {
-                if (usage.compare_exchange_strong(value, value | (kBit1 << offset)))
-                {
-                    mAllocated++;
-                    return At(word * kBitChunkSize + offset);
-                }
-                else
-                {
-                    value = usage.load(std::memory_order_relaxed); // if there is a race, update new usage
-                }
+                mAllocated++;
+                mFreeWordHint.store(word, std::memory_order_relaxed);
+                return At(word * kBitChunkSize + offset);
             }
         }
     }
@@ -71,6 +104,11 @@ void StaticAllocatorBitmap::Deallocate(void * element)
     auto value = mUsage[word].fetch_and(~(kBit1 << offset));
     nlASSERT((value & (kBit1 << offset)) != 0); // assert fail when free an unused slot
     mAllocated--;
+
+    if (word < mFreeWordHint.load(std::memory_order_relaxed))
+    {
+        mFreeWordHint.store(word, std::memory_order_relaxed);
+    }
 }
 
 size_t StaticAllocatorBitmap::IndexOf(void * element)
@@ -89,16 +127,99 @@ bool StaticAllocatorBitmap::ForEachActiveObjectInner(void * context, Lambda lamb
     {
         auto & usage = mUsage[word];
         auto value   = usage.load(std::memory_order_relaxed);
-        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < Capacity(); ++offset)
+        while (value != 0)
+        {
+            const size_t offset = CountTrailingZeros(value);
+            value &= value - 1;
+            if (!lambda(context, At(word * kBitChunkSize + offset)))
+                return false;
+        }
+    }
+    return true;
+}
+
+HeapObjectPoolBase::~HeapObjectPoolBase()
+{
+    // Objects still active are not destroyed, as with BitMapObjectPool, but their memory is freed.
+    while (mList.mNext != &mList)
+    {
+        Unlink(mList.mNext);
+    }
+}
+
+void * HeapObjectPoolBase::Allocate(size_t objectOffset, size_t objectSize)
+{
+    uint8_t * memory = static_cast<uint8_t *>(Platform::MemoryAlloc(objectOffset + objectSize));
+    if (memory == nullptr)
+    {
+        return nullptr;
+    }
+
+    Node * node        = reinterpret_cast<Node *>(memory);
+    node->mObject      = memory + objectOffset;
+    node->mPrev        = mList.mPrev;
+    node->mNext        = &mList;
+    mList.mPrev        = node;
+    node->mPrev->mNext = node;
+    mAllocated++;
+    return node->mObject;
+}
+
+void HeapObjectPoolBase::Deallocate(void * object, size_t objectOffset)
+{
+    Node * node = reinterpret_cast<Node *>(static_cast<uint8_t *>(object) - objectOffset);
+    nlASSERT(node->mObject == object); // assert fail when free an unused object
+    mAllocated--;
+
+    if (mIterationDepth == 0)
+    {
+        Unlink(node);
+    }
+    else
+    {
+        // Freeing the node could pull it from under an iteration; leave it in the list until all iterations end.
+        node->mObject      = nullptr;
+        mHaveReleasedNodes = true;
+    }
+}
+
+void HeapObjectPoolBase::Unlink(Node * node)
+{
+    node->mPrev->mNext = node->mNext;
+    node->mNext->mPrev = node->mPrev;
+    Platform::MemoryFree(node);
+}
+
+bool HeapObjectPoolBase::ForEachActiveObjectInner(void * context, Lambda lambda)
+{
+    bool result = true;
+
+    mIterationDepth++;
+    for (Node * node = mList.mNext; node != &mList; node = node->mNext)
+    {
+        if (node->mObject != nullptr && !lambda(context, node->mObject))
         {
-            if ((value & (kBit1 << offset)) != 0)
+            result = false;
+            break;
+        }
+    }
+    mIterationDepth--;
+
+    if (mIterationDepth == 0 && mHaveReleasedNodes)
+    {
+        mHaveReleasedNodes = false;
+        for (Node * node = mList.mNext; node != &mList;)
+        {
+            Node * next = node->mNext;
+            if (node->mObject == nullptr)
             {
-                if (!lambda(context, At(word * kBitChunkSize + offset)))
-                    return false;
+                Unlink(node);
             }
+            node = next;
         }
     }
-    return true;
+
+    return result;
 }
 
 } // namespace chip
@@ -18,7 +18,8 @@
 
 /**
  * @file
- *   Defines a memory pool class BitMapObjectPool.
+ *   Defines the memory pool classes BitMapObjectPool, of a fixed number of objects, and HeapObjectPool, whose objects are
+ *   allocated from the heap.
  */
 
 #pragma once
@@ -26,9 +27,12 @@
 #include <array>
 #include <assert.h>
 #include <atomic>
+#include <cstddef>
 #include <limits>
 #include <new>
 #include <stddef.h>
+#include <stdint.h>
+#include <utility>
 
 namespace chip {
 
@@ -60,6 +64,11 @@ protected:
 
 public:
     StaticAllocatorBitmap(void * storage, std::atomic<tBitChunkType> * usage, size_t capacity, size_t elementSize);
+
+    /**
+     * Find a free element one word of the bitmap at a time, starting at the word that most recently had one, and within
+     * a word by counting trailing zeros.
+     */
     void * Allocate();
     void Deallocate(void * element);
 
@@ -71,9 +80,15 @@ protected:
     bool ForEachActiveObjectInner(void * context, Lambda lambda);
 
 private:
+    size_t WordCount() const { return (Capacity() + kBitChunkSize - 1) / kBitChunkSize; }
+    tBitChunkType UsableBits(size_t word) const;
+
     void * mElements;
     const size_t mElementSize;
     std::atomic<tBitChunkType> * mUsage;
+
+    // A word that likely has a free element. It is only a hint: Allocate() goes on to check all other words.
+    std::atomic<size_t> mFreeWordHint;
 };
 
 /**
@@ -147,4 +162,107 @@ private:
     alignas(alignof(T)) uint8_t mMemory[N * sizeof(T)];
 };
 
+class HeapObjectPoolBase
+{
+public:
+    size_t Allocated() const { return mAllocated; }
+    bool Exhausted() const { return false; }
+
+protected:
+    /**
+     * Links the objects of a HeapObjectPool. Each object is allocated together with its node, kObjectOffset bytes after
+     * the start of the node, so that releasing an object finds its node without a search.
+     */
+    struct Node
+    {
+        Node * mPrev;
+        Node * mNext;
+        void * mObject; // nullptr once released while the pool is iterated
+    };
+
+    HeapObjectPoolBase() { mList.mPrev = mList.mNext = &mList; }
+    ~HeapObjectPoolBase();
+
+    void * Allocate(size_t objectOffset, size_t objectSize);
+    void Deallocate(void * object, size_t objectOffset);
+
+    using Lambda = bool (*)(void *, void *);
+    bool ForEachActiveObjectInner(void * context, Lambda lambda);
+
+private:
+    void Unlink(Node * node);
+
+    Node mList               = {}; // sentinel of the circular list of all nodes
+    size_t mAllocated        = 0;
+    unsigned mIterationDepth = 0;
+    bool mHaveReleasedNodes  = false;
+};
+
+/**
+ *  @brief
+ *   A class template used for allocating Objects from the heap, with the same interface as BitMapObjectPool but without a
+ *   fixed capacity. The active objects are linked in a list, so that iterating them costs time in proportion to their
+ *   number rather than to the capacity of the pool.
+ *
+ *   Objects may be created and released while the pool is iterated; the memory of released objects is freed once the
+ *   outermost iteration ends. Unlike BitMapObjectPool, the pool is not safe to use from several threads without a lock.
+ *
+ *  @tparam     T   a subclass of element to be allocated.
+ */
+template <class T>
+class HeapObjectPool : public HeapObjectPoolBase
+{
+public:
+    template <typename... Args>
+    T * CreateObject(Args &&... args)
+    {
+        void * element = Allocate(kObjectOffset, sizeof(T));
+        if (element != nullptr)
+            return new (element) T(std::forward<Args>(args)...);
+        else
+            return nullptr;
+    }
+
+    void ReleaseObject(T * element)
+    {
+        if (element == nullptr)
+            return;
+
+        element->~T();
+        Deallocate(element, kObjectOffset);
+    }
+
+    /**
+     * @brief
+     *   Run a functor for each active object in the pool
+     *
+     *  @param     function The functor of type `bool (*)(T*)`, return false to break the iteration
+     *  @return    bool     Returns false if broke during iteration
+     */
+    template <typename Function>
+    bool ForEachActiveObject(Function && function)
+    {
+        LambdaProxy<Function> proxy(std::forward<Function>(function));
+        return ForEachActiveObjectInner(&proxy, &LambdaProxy<Function>::Call);
+    }
+
+private:
+    template <typename Function>
+    class LambdaProxy
+    {
+    public:
+        LambdaProxy(Function && function) : mFunction(std::move(function)) {}
+        static bool Call(void * context, void * target)
+        {
+            return static_cast<LambdaProxy *>(context)->mFunction(static_cast<T *>(target));
+        }
+
+    private:
+        Function mFunction;
+    };
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "HeapObjectPool cannot align T");
+    static constexpr size_t kObjectOffset = (sizeof(Node) + alignof(T) - 1) / alignof(T) * alignof(T);
+};
+
 } // namespace chip
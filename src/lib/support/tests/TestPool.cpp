@@ -25,6 +25,7 @@
 
 #include <set>
 
+#include <support/CHIPMem.h>
 #include <support/Pool.h>
 #include <support/UnitTestRegistration.h>
 
@@ -32,8 +33,8 @@
 
 namespace chip {
 
-template <class T, size_t N>
-size_t GetNumObjectsInUse(BitMapObjectPool<T, N> & pool)
+template <class Pool>
+size_t GetNumObjectsInUse(Pool & pool)
 {
     size_t count = 0;
     pool.ForEachActiveObject([&count](void *) {
@@ -129,13 +130,136 @@ void TestCreateReleaseStruct(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void TestAllocateAcrossWords(nlTestSuite * inSuite, void * inContext)
+{
+    // More than two words of the bitmap, the last of them partly used.
+    constexpr const size_t size = 150;
+    BitMapObjectPool<uint32_t, size> pool;
+    uint32_t * obj[size];
+    for (size_t i = 0; i < size; ++i)
+    {
+        obj[i] = pool.CreateObject(static_cast<uint32_t>(i));
+        NL_TEST_ASSERT(inSuite, obj[i] != nullptr);
+    }
+    NL_TEST_ASSERT(inSuite, pool.CreateObject() == nullptr);
+
+    // Free elements are found whichever word they are in, ahead of or behind the one last allocated from.
+    for (size_t i : { size - 1, size_t(3), size_t(70) })
+    {
+        pool.ReleaseObject(obj[i]);
+        NL_TEST_ASSERT(inSuite, pool.CreateObject(static_cast<uint32_t>(i)) == obj[i]);
+        NL_TEST_ASSERT(inSuite, pool.CreateObject() == nullptr);
+    }
+
+    pool.ReleaseObject(obj[140]);
+    pool.ReleaseObject(obj[10]);
+    NL_TEST_ASSERT(inSuite, pool.CreateObject(static_cast<uint32_t>(10)) == obj[10]);
+    NL_TEST_ASSERT(inSuite, pool.CreateObject(static_cast<uint32_t>(140)) == obj[140]);
+
+    size_t index = 0;
+    bool inOrder = true;
+    pool.ForEachActiveObject([&](uint32_t * element) {
+        inOrder = inOrder && (element == obj[index]) && (*element == index);
+        ++index;
+        return true;
+    });
+    NL_TEST_ASSERT(inSuite, inOrder);
+    NL_TEST_ASSERT(inSuite, index == size);
+}
+
+void TestHeapCreateReleaseObject(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr const size_t size = 100;
+    HeapObjectPool<uint32_t> pool;
+    pool.ReleaseObject(nullptr);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == 0);
+
+    uint32_t * obj[size];
+    for (size_t i = 0; i < size; ++i)
+    {
+        obj[i] = pool.CreateObject(static_cast<uint32_t>(i));
+        NL_TEST_ASSERT(inSuite, obj[i] != nullptr);
+        NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == i + 1);
+        NL_TEST_ASSERT(inSuite, pool.Allocated() == i + 1);
+    }
+    NL_TEST_ASSERT(inSuite, !pool.Exhausted());
+
+    pool.ReleaseObject(obj[55]);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == size - 1);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == size - 1);
+
+    // Objects are visited in the order they were created.
+    uint32_t expected = 0;
+    bool inOrder      = true;
+    pool.ForEachActiveObject([&](uint32_t * element) {
+        expected += (expected == 55) ? 1 : 0;
+        inOrder = inOrder && (*element == expected);
+        ++expected;
+        return true;
+    });
+    NL_TEST_ASSERT(inSuite, inOrder);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (i != 55)
+        {
+            pool.ReleaseObject(obj[i]);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == 0);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+}
+
+void TestHeapReleaseWhileIterating(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr const size_t size = 10;
+    HeapObjectPool<uint32_t> pool;
+    uint32_t * obj[size];
+    for (size_t i = 0; i < size; ++i)
+    {
+        obj[i] = pool.CreateObject(static_cast<uint32_t>(i));
+    }
+
+    // Release the visited object and the one after it, and create one, from within the iteration.
+    size_t visited     = 0;
+    uint32_t * created = nullptr;
+    pool.ForEachActiveObject([&](uint32_t * element) {
+        ++visited;
+        if (*element == 2)
+        {
+            pool.ReleaseObject(obj[2]);
+            pool.ReleaseObject(obj[3]);
+            created = pool.CreateObject(static_cast<uint32_t>(size));
+        }
+        return true;
+    });
+    NL_TEST_ASSERT(inSuite, created != nullptr);
+    NL_TEST_ASSERT(inSuite, visited == size);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == size - 1);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == size - 1);
+
+    // Stopping an iteration early reports it.
+    NL_TEST_ASSERT(inSuite, !pool.ForEachActiveObject([](uint32_t * element) { return *element != 5; }));
+
+    pool.ReleaseObject(created);
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (i != 2 && i != 3)
+        {
+            pool.ReleaseObject(obj[i]);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == 0);
+}
+
 int Setup(void * inContext)
 {
-    return SUCCESS;
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
 }
 
 int Teardown(void * inContext)
 {
+    chip::Platform::MemoryShutdown();
     return SUCCESS;
 }
 
@@ -145,8 +269,13 @@ int Teardown(void * inContext)
 /**
  *   Test Suite. It lists all the test functions.
  */
-static const nlTest sTests[] = { NL_TEST_DEF_FN(TestReleaseNull), NL_TEST_DEF_FN(TestCreateReleaseObject),
-                                 NL_TEST_DEF_FN(TestCreateReleaseStruct), NL_TEST_SENTINEL() };
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestReleaseNull),
+                                 NL_TEST_DEF_FN(TestCreateReleaseObject),
+                                 NL_TEST_DEF_FN(TestCreateReleaseStruct),
+                                 NL_TEST_DEF_FN(TestAllocateAcrossWords),
+                                 NL_TEST_DEF_FN(TestHeapCreateReleaseObject),
+                                 NL_TEST_DEF_FN(TestHeapReleaseWhileIterating),
+                                 NL_TEST_SENTINEL() };
 
 int TestPool()
 {
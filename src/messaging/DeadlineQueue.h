@@ -0,0 +1,179 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an intrusive queue of objects ordered by an
+ *      absolute deadline, used by the reliable message protocol to
+ *      schedule acknowledgments and retransmissions.
+ */
+
+#pragma once
+
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace Messaging {
+
+/**
+ *  @class DeadlineQueueItem
+ *
+ *  @brief
+ *    The links an object needs to be kept in a DeadlineQueue. An item is in
+ *    at most one queue at a time, and keeps its last deadline once removed.
+ */
+class DeadlineQueueItem
+{
+public:
+    DeadlineQueueItem() = default;
+
+    DeadlineQueueItem(const DeadlineQueueItem &) = delete;
+    DeadlineQueueItem & operator=(const DeadlineQueueItem &) = delete;
+
+    System::Clock::MonotonicMilliseconds GetDeadline() const { return mDeadline; }
+    bool IsQueued() const { return mQueued; }
+
+private:
+    template <class T>
+    friend class DeadlineQueue;
+
+    System::Clock::MonotonicMilliseconds mDeadline = 0;
+    DeadlineQueueItem * mpPrev                     = nullptr;
+    DeadlineQueueItem * mpNext                     = nullptr;
+    bool mQueued                                   = false;
+};
+
+/**
+ *  @class DeadlineQueue
+ *
+ *  @brief
+ *    A doubly-linked list of T, which must derive from DeadlineQueueItem,
+ *    sorted by deadline so that the earliest one is always at the front.
+ *
+ *    Items are nearly always scheduled a fixed timeout from now, which puts
+ *    them at or near the back, so insertion searches from the tail. Items
+ *    with equal deadlines keep their insertion order. Removal is O(1).
+ */
+template <class T>
+class DeadlineQueue
+{
+public:
+    bool IsEmpty() const { return mpHead == nullptr; }
+
+    /**
+     * The item with the earliest deadline, or nullptr if the queue is empty.
+     */
+    T * Front() const { return static_cast<T *>(mpHead); }
+
+    /**
+     * Schedule an item at the given deadline, moving it if it is already queued.
+     */
+    void Insert(T & aItem, System::Clock::MonotonicMilliseconds aDeadline)
+    {
+        DeadlineQueueItem & item = aItem;
+
+        Remove(aItem);
+        item.mDeadline = aDeadline;
+
+        DeadlineQueueItem * prev = mpTail;
+        while (prev != nullptr && prev->mDeadline > aDeadline)
+        {
+            prev = prev->mpPrev;
+        }
+
+        item.mpPrev  = prev;
+        item.mpNext  = (prev != nullptr) ? prev->mpNext : mpHead;
+        item.mQueued = true;
+
+        if (item.mpNext != nullptr)
+        {
+            item.mpNext->mpPrev = &item;
+        }
+        else
+        {
+            mpTail = &item;
+        }
+
+        if (prev != nullptr)
+        {
+            prev->mpNext = &item;
+        }
+        else
+        {
+            mpHead = &item;
+        }
+    }
+
+    /**
+     * Take an item out of the queue. Does nothing if the item is not queued.
+     */
+    void Remove(T & aItem)
+    {
+        DeadlineQueueItem & item = aItem;
+
+        if (!item.mQueued)
+        {
+            return;
+        }
+
+        if (item.mpPrev != nullptr)
+        {
+            item.mpPrev->mpNext = item.mpNext;
+        }
+        else
+        {
+            mpHead = item.mpNext;
+        }
+
+        if (item.mpNext != nullptr)
+        {
+            item.mpNext->mpPrev = item.mpPrev;
+        }
+        else
+        {
+            mpTail = item.mpPrev;
+        }
+
+        item.mpPrev  = nullptr;
+        item.mpNext  = nullptr;
+        item.mQueued = false;
+    }
+
+    /**
+     * The item with the earliest deadline, if that deadline is not after aNow.
+     */
+    T * FrontIfExpired(System::Clock::MonotonicMilliseconds aNow) const
+    {
+        return (mpHead != nullptr && mpHead->mDeadline <= aNow) ? Front() : nullptr;
+    }
+
+    void Clear()
+    {
+        while (mpHead != nullptr)
+        {
+            Remove(*Front());
+        }
+    }
+
+private:
+    DeadlineQueueItem * mpHead = nullptr;
+    DeadlineQueueItem * mpTail = nullptr;
+};
+
+} // namespace Messaging
+} // namespace chip
@@ -185,6 +185,8 @@ private:
     SecureSessionHandle mSecureSession; // The connection state
     uint16_t mExchangeId;               // Assigned exchange ID.
 
+    ExchangeContext * mpNextInIndex = nullptr; // The next exchange in the same bucket of the ExchangeManager index.
+
     /**
      *  Determine whether a response is currently expected for a message that was sent over
      *  this exchange.  While this is true, attempts to send other messages that expect a response
@@ -30,6 +30,7 @@
 #endif
 
 #include <cstring>
+#include <functional>
 #include <inttypes.h>
 #include <stddef.h>
 
@@ -50,6 +51,21 @@ using namespace chip::System;
 namespace chip {
 namespace Messaging {
 
+namespace {
+
+size_t MixHash(uint64_t value)
+{
+    // 64-bit finalizer from MurmurHash3.
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return static_cast<size_t>(value);
+}
+
+} // namespace
+
 /**
  *  Constructor for the ExchangeManager class.
  *  It sets the state to kState_NotInitialized.
@@ -59,9 +75,14 @@ namespace Messaging {
  *    prior to use.
  *
  */
-ExchangeManager::ExchangeManager() : mDelegate(nullptr), mReliableMessageMgr(mContextPool)
+ExchangeManager::ExchangeManager() : mDelegate(nullptr)
 {
     mState = State::kState_NotInitialized;
+
+    for (auto & head : mExchangeIndex)
+    {
+        head = nullptr;
+    }
 }
 
 CHIP_ERROR ExchangeManager::Init(SecureSessionMgr * sessionMgr)
@@ -83,6 +104,11 @@ CHIP_ERROR ExchangeManager::Init(SecureSessionMgr * sessionMgr)
         handler.Reset();
     }
 
+    for (auto & head : mUMHandlerIndex)
+    {
+        head = nullptr;
+    }
+
     sessionMgr->SetDelegate(this);
 
     mReliableMessageMgr.Init(sessionMgr->SystemLayer(), sessionMgr);
@@ -116,7 +142,77 @@ CHIP_ERROR ExchangeManager::Shutdown()
 
 ExchangeContext * ExchangeManager::NewContext(SecureSessionHandle session, ExchangeDelegate * delegate)
 {
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, true, delegate);
+    return CreateContext(mNextExchangeId++, session, true, delegate);
+}
+
+void ExchangeManager::ReleaseContext(ExchangeContext * ec)
+{
+    UnindexContext(ec);
+    mContextPool.ReleaseObject(ec);
+}
+
+ExchangeContext * ExchangeManager::CreateContext(uint16_t exchangeId, SecureSessionHandle session, bool initiator,
+                                                 ExchangeDelegate * delegate)
+{
+    ExchangeContext * ec = mContextPool.CreateObject(this, exchangeId, session, initiator, delegate);
+    if (ec != nullptr)
+    {
+        IndexContext(ec);
+    }
+    return ec;
+}
+
+ExchangeContext * ExchangeManager::FindContext(SecureSessionHandle session, const PacketHeader & packetHeader,
+                                               const PayloadHeader & payloadHeader)
+{
+    // The message is for an exchange that we initiated if it was not sent by an initiator.
+    size_t bucket = ExchangeBucket(session, payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator());
+
+    for (ExchangeContext * ec = mExchangeIndex[bucket]; ec != nullptr; ec = ec->mpNextInIndex)
+    {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            return ec;
+        }
+    }
+    return nullptr;
+}
+
+size_t ExchangeManager::ExchangeBucket(SecureSessionHandle session, uint16_t exchangeId, bool initiator)
+{
+    uint64_t key = session.GetPeerNodeId();
+    key ^= (static_cast<uint64_t>(session.GetAdminId()) << 48) | (static_cast<uint64_t>(session.GetPeerKeyId()) << 32) |
+        (static_cast<uint64_t>(exchangeId) << 1) | (initiator ? 1 : 0);
+    return MixHash(key) % kExchangeBucketCount;
+}
+
+void ExchangeManager::IndexContext(ExchangeContext * ec)
+{
+    // Keep the chain in address order, the order in which a BitMapObjectPool is walked, so that the first
+    // exchange that matches a message is the same one a walk of the pool would find.
+    ExchangeContext ** link = &mExchangeIndex[ExchangeBucket(ec->mSecureSession, ec->mExchangeId, ec->IsInitiator())];
+    while (*link != nullptr && std::less<ExchangeContext *>()(*link, ec))
+    {
+        link = &(*link)->mpNextInIndex;
+    }
+
+    ec->mpNextInIndex = *link;
+    *link             = ec;
+}
+
+void ExchangeManager::UnindexContext(ExchangeContext * ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[ExchangeBucket(ec->mSecureSession, ec->mExchangeId, ec->IsInitiator())];
+    while (*link != nullptr && *link != ec)
+    {
+        link = &(*link)->mpNextInIndex;
+    }
+
+    if (*link != nullptr)
+    {
+        *link             = ec->mpNextInIndex;
+        ec->mpNextInIndex = nullptr;
+    }
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId, ExchangeDelegate * delegate)
@@ -152,19 +248,20 @@ void ExchangeManager::OnReceiveError(CHIP_ERROR error, const Transport::PeerAddr
 
 CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, ExchangeDelegate * delegate)
 {
-    UnsolicitedMessageHandler * selected = nullptr;
+    UnsolicitedMessageHandler * selected = FindUMH(protocolId, msgType);
+
+    if (selected != nullptr)
+    {
+        selected->Delegate = delegate;
+        return CHIP_NO_ERROR;
+    }
 
     for (auto & umh : UMHandlerPool)
     {
         if (!umh.IsInUse())
         {
-            if (selected == nullptr)
-                selected = &umh;
-        }
-        else if (umh.Matches(protocolId, msgType))
-        {
-            umh.Delegate = delegate;
-            return CHIP_NO_ERROR;
+            selected = &umh;
+            break;
         }
     }
 
@@ -175,6 +272,10 @@ CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgTyp
     selected->ProtocolId  = protocolId;
     selected->MessageType = msgType;
 
+    UnsolicitedMessageHandler *& head = mUMHandlerIndex[UMHandlerBucket(protocolId, msgType)];
+    selected->Next                    = head;
+    head                              = selected;
+
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
     return CHIP_NO_ERROR;
@@ -182,17 +283,42 @@ CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgTyp
 
 CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgType)
 {
-    for (auto & umh : UMHandlerPool)
+    UnsolicitedMessageHandler ** link = &mUMHandlerIndex[UMHandlerBucket(protocolId, msgType)];
+    while (*link != nullptr && !(*link)->Matches(protocolId, msgType))
     {
-        if (umh.IsInUse() && umh.Matches(protocolId, msgType))
+        link = &(*link)->Next;
+    }
+
+    if (*link == nullptr)
+    {
+        return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+    }
+
+    UnsolicitedMessageHandler * umh = *link;
+    *link                           = umh->Next;
+    umh->Next                       = nullptr;
+    umh->Reset();
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+
+    return CHIP_NO_ERROR;
+}
+
+ExchangeManager::UnsolicitedMessageHandler * ExchangeManager::FindUMH(Protocols::Id protocolId, int16_t msgType)
+{
+    for (UnsolicitedMessageHandler * umh = mUMHandlerIndex[UMHandlerBucket(protocolId, msgType)]; umh != nullptr; umh = umh->Next)
+    {
+        if (umh->Matches(protocolId, msgType))
         {
-            umh.Reset();
-            SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
-            return CHIP_NO_ERROR;
+            return umh;
         }
     }
+    return nullptr;
+}
 
-    return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+size_t ExchangeManager::UMHandlerBucket(Protocols::Id protocolId, int16_t msgType)
+{
+    uint64_t key = (static_cast<uint64_t>(protocolId.ToFullyQualifiedSpecForm()) << 16) | static_cast<uint16_t>(msgType);
+    return MixHash(key) % kUMHandlerBucketCount;
 }
 
 void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
@@ -213,9 +339,9 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     }
 
     // Search for an existing exchange that the message applies to. If a match is found...
-    bool found = false;
-    mContextPool.ForEachActiveObject([&](auto * ec) {
-        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+    {
+        ExchangeContext * ec = FindContext(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
             // Found a matching exchange. Set flag for correct subsequent MRP
             // retransmission timeout selection.
@@ -226,15 +352,8 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
 
             // Matched ExchangeContext; send to message handler.
             ec->HandleMessage(packetHeader, payloadHeader, source, msgFlags, std::move(msgBuf));
-            found = true;
-            return false;
+            ExitNow(err = CHIP_NO_ERROR);
         }
-        return true;
-    });
-
-    if (found)
-    {
-        ExitNow(err = CHIP_NO_ERROR);
     }
 
     // If it's not a duplicate message, search for an unsolicited message handler if it is marked as being sent by an initiator.
@@ -244,21 +363,11 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
         // handle the message type over handlers that handle all messages for a profile.
-        matchingUMH = nullptr;
+        matchingUMH = FindUMH(payloadHeader.GetProtocolID(), payloadHeader.GetMessageType());
 
-        for (auto & umh : UMHandlerPool)
+        if (matchingUMH == nullptr)
         {
-            if (umh.IsInUse() && payloadHeader.HasProtocol(umh.ProtocolId))
-            {
-                if (umh.MessageType == payloadHeader.GetMessageType())
-                {
-                    matchingUMH = &umh;
-                    break;
-                }
-
-                if (umh.MessageType == kAnyMessageType)
-                    matchingUMH = &umh;
-            }
+            matchingUMH = FindUMH(payloadHeader.GetProtocolID(), kAnyMessageType);
         }
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message does not need to send
@@ -277,8 +386,7 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
         // If rcvd msg is not from initiator then this exchange is created as Initiator.
         // Note that if matchingUMH is not null then rcvd msg if from initiator.
         // TODO: Figure out which channel to use for the received message
-        ExchangeContext * ec =
-            mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), delegate);
+        ExchangeContext * ec = CreateContext(payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), delegate);
 
         VerifyOrExit(ec != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
@@ -312,7 +420,13 @@ void ExchangeManager::OnConnectionExpired(SecureSessionHandle session)
     mContextPool.ForEachActiveObject([&](auto * ec) {
         if (ec->mSecureSession == session)
         {
+            // The exchange is indexed by its session, which is about to be reset. Hold a reference while it is
+            // out of the index, since its delegate may close it when notified, and let the last release free it.
+            ec->Retain();
+            UnindexContext(ec);
             ec->OnConnectionExpired();
+            IndexContext(ec);
+            ec->Release();
             // Continue to iterate because there can be multiple exchanges
             // associated with the connection.
         }
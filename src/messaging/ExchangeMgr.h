@@ -102,7 +102,7 @@ public:
      */
     ExchangeContext * NewContext(SecureSessionHandle session, ExchangeDelegate * delegate);
 
-    void ReleaseContext(ExchangeContext * ec) { mContextPool.ReleaseObject(ec); }
+    void ReleaseContext(ExchangeContext * ec);
 
     /**
      *  Register an unsolicited message handler for a given protocol identifier. This handler would be
@@ -220,8 +220,14 @@ private:
         // so need a type that can store both that and all valid message type
         // values.
         int16_t MessageType;
+        // The next handler in the same bucket of the handler index.
+        UnsolicitedMessageHandler * Next = nullptr;
     };
 
+    // One bucket per pool entry keeps the chains short at a pointer of memory each.
+    static constexpr size_t kExchangeBucketCount  = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS;
+    static constexpr size_t kUMHandlerBucketCount = CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS;
+
     uint16_t mNextExchangeId;
     uint16_t mNextKeyId;
     State mState;
@@ -234,10 +240,30 @@ private:
 
     Transport::AdminId mAdminId = 0;
 
+#if CHIP_CONFIG_POOL_USE_HEAP
+    HeapObjectPool<ExchangeContext> mContextPool;
+#else
     BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
+#endif
 
     UnsolicitedMessageHandler UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
 
+    // Hash indexes, so that dispatching a message does not walk the pools. Exchanges are keyed on
+    // (session, exchange id, initiator), with each chain kept in pool order, and unsolicited message
+    // handlers on (protocol, message type).
+    ExchangeContext * mExchangeIndex[kExchangeBucketCount];
+    UnsolicitedMessageHandler * mUMHandlerIndex[kUMHandlerBucketCount];
+
+    ExchangeContext * CreateContext(uint16_t exchangeId, SecureSessionHandle session, bool initiator, ExchangeDelegate * delegate);
+    ExchangeContext * FindContext(SecureSessionHandle session, const PacketHeader & packetHeader,
+                                  const PayloadHeader & payloadHeader);
+    static size_t ExchangeBucket(SecureSessionHandle session, uint16_t exchangeId, bool initiator);
+    void IndexContext(ExchangeContext * ec);
+    void UnindexContext(ExchangeContext * ec);
+
+    UnsolicitedMessageHandler * FindUMH(Protocols::Id protocolId, int16_t msgType);
+    static size_t UMHandlerBucket(Protocols::Id protocolId, int16_t msgType);
+
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, ExchangeDelegate * delegate);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
 
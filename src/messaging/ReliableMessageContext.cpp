@@ -39,7 +39,7 @@ namespace chip {
 namespace Messaging {
 
 ReliableMessageContext::ReliableMessageContext() :
-    mConfig(gDefaultReliableMessageProtocolConfig), mNextAckTimeTick(0), mPendingPeerAckId(0)
+    mConfig(gDefaultReliableMessageProtocolConfig), mpRetransEntry(nullptr), mPendingPeerAckId(0)
 {}
 
 void ReliableMessageContext::RetainContext()
@@ -80,6 +80,11 @@ void ReliableMessageContext::SetMsgRcvdFromPeer(bool inMsgRcvdFromPeer)
 void ReliableMessageContext::SetAckPending(bool inAckPending)
 {
     mFlags.Set(Flags::kFlagAckPending, inAckPending);
+
+    if (!inAckPending && IsQueued())
+    {
+        GetReliableMessageMgr()->CancelAck(this);
+    }
 }
 
 void ReliableMessageContext::SetDropAckDebug(bool inDropAckDebug)
@@ -132,14 +137,14 @@ CHIP_ERROR ReliableMessageContext::FlushAcks()
     return err;
 }
 
-uint64_t ReliableMessageContext::GetInitialRetransmitTimeoutTick()
+uint32_t ReliableMessageContext::GetInitialRetransmitTimeout() const
 {
-    return mConfig.mInitialRetransTimeoutTick;
+    return mConfig.mInitialRetransTimeout;
 }
 
-uint64_t ReliableMessageContext::GetActiveRetransmitTimeoutTick()
+uint32_t ReliableMessageContext::GetActiveRetransmitTimeout() const
 {
-    return mConfig.mActiveRetransTimeoutTick;
+    return mConfig.mActiveRetransTimeout;
 }
 
 /**
@@ -187,9 +192,6 @@ CHIP_ERROR ReliableMessageContext::HandleNeedsAck(uint32_t MessageId, BitFlags<M
     if (ShouldDropAckDebug())
         return err;
 
-    // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
-    GetReliableMessageMgr()->ExpireTicks();
-
     // If the message IS a duplicate there will never be a response to it, so we
     // should not wait for one and just immediately send a standalone ack.
     if (MsgFlags.Has(MessageFlagValues::kDuplicateMessage))
@@ -234,9 +236,6 @@ CHIP_ERROR ReliableMessageContext::HandleNeedsAck(uint32_t MessageId, BitFlags<M
 
         // Replace the Pending ack id.
         SetPendingPeerAckId(MessageId);
-        mNextAckTimeTick =
-            static_cast<uint16_t>(CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT_TICK +
-                                  GetReliableMessageMgr()->GetTickCounterFromTimeDelta(System::Clock::GetMonotonicMilliseconds()));
     }
 
 exit:
@@ -279,6 +278,9 @@ void ReliableMessageContext::SetPendingPeerAckId(uint32_t aPeerAckId)
 {
     mPendingPeerAckId = aPeerAckId;
     SetAckPending(true);
+
+    // Send a standalone ack if nothing piggybacks it before the ack timeout.
+    GetReliableMessageMgr()->ScheduleAck(this);
 }
 
 } // namespace Messaging
@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <messaging/DeadlineQueue.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 
 #include <core/CHIPError.h>
@@ -43,8 +44,9 @@ class ExchangeContext;
 enum class MessageFlagValues : uint32_t;
 class ReliableMessageContext;
 class ReliableMessageMgr;
+struct RetransTableEntry;
 
-class ReliableMessageContext
+class ReliableMessageContext : private DeadlineQueueItem
 {
 public:
     ReliableMessageContext();
@@ -72,17 +74,17 @@ public:
      *  Get the initial retransmission interval. It would be the time to wait before
      *  retransmission after first failure.
      *
-     *  @return the initial retransmission interval.
+     *  @return the initial retransmission interval in milliseconds.
      */
-    uint64_t GetInitialRetransmitTimeoutTick();
+    uint32_t GetInitialRetransmitTimeout() const;
 
     /**
      *  Get the active retransmit interval. It would be the time to wait before
      *  retransmission after subsequent failures.
      *
-     *  @return the active retransmission interval.
+     *  @return the active retransmission interval in milliseconds.
      */
-    uint64_t GetActiveRetransmitTimeoutTick();
+    uint32_t GetActiveRetransmitTimeout() const;
 
     /**
      *  Send a SecureChannel::StandaloneAck message.
@@ -223,6 +225,7 @@ private:
 
     /**
      *  Set if an acknowledgment needs to be sent back to the peer on this exchange.
+     *  Clearing it cancels any standalone acknowledgment scheduled for the exchange.
      *
      *  @param[in]  inAckPending A Boolean indicating whether (true) or not
      *                          (false) an acknowledgment should be sent back
@@ -238,9 +241,10 @@ private:
     friend class ReliableMessageMgr;
     friend class ExchangeContext;
     friend class ExchangeMessageDispatch;
+    friend class DeadlineQueue<ReliableMessageContext>;
 
     ReliableMessageProtocolConfig mConfig;
-    uint16_t mNextAckTimeTick; // Next time for triggering Solo Ack
+    RetransTableEntry * mpRetransEntry; // The message of this exchange awaiting an acknowledgment, if any
     uint32_t mPendingPeerAckId;
 };
 
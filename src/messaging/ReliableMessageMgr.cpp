@@ -21,6 +21,7 @@
  *
  */
 
+#include <algorithm>
 #include <inttypes.h>
 
 #include <messaging/ReliableMessageMgr.h>
@@ -32,17 +33,15 @@
 #include <support/BitFlags.h>
 #include <support/CHIPFaultInjection.h>
 #include <support/CodeUtils.h>
+#include <support/RandUtils.h>
 #include <support/logging/CHIPLogging.h>
 
 namespace chip {
 namespace Messaging {
 
-ReliableMessageMgr::RetransTableEntry::RetransTableEntry() : rc(nullptr), nextRetransTimeTick(0), sendCount(0) {}
+RetransTableEntry::RetransTableEntry() : rc(nullptr), sendCount(0), firstSentTime(0) {}
 
-ReliableMessageMgr::ReliableMessageMgr(BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
-    mContextPool(contextPool), mSystemLayer(nullptr), mSessionMgr(nullptr), mCurrentTimerExpiry(0),
-    mTimerIntervalShift(CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT)
-{}
+ReliableMessageMgr::ReliableMessageMgr() : mSystemLayer(nullptr), mSessionMgr(nullptr), mCurrentTimerExpiry(0) {}
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
 
@@ -51,7 +50,6 @@ void ReliableMessageMgr::Init(chip::System::Layer * systemLayer, SecureSessionMg
     mSystemLayer = systemLayer;
     mSessionMgr  = sessionMgr;
 
-    mTimeStampBase      = System::Clock::GetMonotonicMilliseconds();
     mCurrentTimerExpiry = 0;
 }
 
@@ -67,16 +65,8 @@ void ReliableMessageMgr::Shutdown()
     {
         ClearRetransTable(rEntry);
     }
-}
 
-uint64_t ReliableMessageMgr::GetTickCounterFromTimePeriod(uint64_t period)
-{
-    return (period >> mTimerIntervalShift);
-}
-
-uint64_t ReliableMessageMgr::GetTickCounterFromTimeDelta(uint64_t newTime)
-{
-    return GetTickCounterFromTimePeriod(newTime - mTimeStampBase);
+    mAckQueue.Clear();
 }
 
 #if defined(RMP_TICKLESS_DEBUG)
@@ -88,8 +78,8 @@ void ReliableMessageMgr::TicklessDebugDumpRetransTable(const char * log)
     {
         if (entry.rc)
         {
-            ChipLogDetail(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " NextRetransTimeCtr:%04" PRIX16, entry.rc,
-                          entry.msgId, entry.nextRetransTimeTick);
+            ChipLogDetail(ExchangeManager, "EC:%p MsgId:%08" PRIX32 " NextRetransTime:%" PRIu64, entry.rc,
+                          entry.retainedBuf.GetMsgId(), entry.GetDeadline());
         }
     }
 }
@@ -102,71 +92,78 @@ void ReliableMessageMgr::TicklessDebugDumpRetransTable(const char * log)
 
 void ReliableMessageMgr::ExecuteActions()
 {
+    const System::Clock::MonotonicMilliseconds now = System::Clock::GetMonotonicMilliseconds();
+
 #if defined(RMP_TICKLESS_DEBUG)
-    ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions");
+    ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions at %" PRIu64, now);
 #endif
 
-    ExecuteForAllContext([](ReliableMessageContext * rc) {
-        if (rc->IsAckPending())
-        {
-            if (0 == rc->mNextAckTimeTick)
-            {
+    ReliableMessageContext * rc;
+    while ((rc = mAckQueue.FrontIfExpired(now)) != nullptr)
+    {
 #if defined(RMP_TICKLESS_DEBUG)
-                ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK");
+        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK");
 #endif
-                // Send the Ack in a SecureChannel::StandaloneAck message
-                rc->SendStandaloneAckMessage();
-            }
+        mAckQueue.Remove(*rc);
+
+        // Hold the exchange, as sending may result in it being closed.
+        rc->RetainContext();
+
+        // Send the Ack in a SecureChannel::StandaloneAck message
+        rc->SendStandaloneAckMessage();
+
+        // If the ack could not go out, try again after another ack timeout.
+        if (rc->IsAckPending())
+        {
+            mAckQueue.Insert(*rc, now + kRmpAckTimeoutMs);
         }
-    });
+
+        rc->ReleaseContext();
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries before processing");
 
     // Retransmit / cancel anything in the retrans table whose retrans timeout
     // has expired
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry;
+    while ((entry = mRetransQueue.FrontIfExpired(now)) != nullptr)
     {
-        ReliableMessageContext * rc = entry.rc;
-        CHIP_ERROR err              = CHIP_NO_ERROR;
-
-        if (!rc || entry.nextRetransTimeTick != 0)
-            continue;
+        rc = entry->rc;
 
-        if (entry.retainedBuf.IsNull())
+        if (entry->retainedBuf.IsNull())
         {
             // We generally try to prevent entries with a null buffer being in a table, but it could happen
             // if the message dispatch (which is supposed to fill in the buffer) fails to do so _and_ returns
             // success (so its caller doesn't clear out the bogus table entry).
             //
             // If that were to happen, we would crash in the code below.  Guard against it, just in case.
-            ClearRetransTable(entry);
+            ClearRetransTable(*entry);
             continue;
         }
 
-        uint8_t sendCount = entry.sendCount;
-        uint32_t msgId    = entry.retainedBuf.GetMsgId();
+        uint8_t sendCount = entry->sendCount;
+        uint32_t msgId    = entry->retainedBuf.GetMsgId();
 
         if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
         {
-            err = CHIP_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
-
             ChipLogError(ExchangeManager, "Failed to Send CHIP MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %d", msgId,
                          sendCount, CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
 
             // Remove from Table
-            ClearRetransTable(entry);
+            ClearRetransTable(*entry);
+            continue;
         }
 
-        // Resend from Table (if the operation fails, the entry is cleared)
-        if (err == CHIP_NO_ERROR)
-            err = SendFromRetransTable(&entry);
+        // Schedule the next retransmission before sending, since the ack may arrive, and clear
+        // the entry, before the send returns. The deadline is kept strictly after now so that
+        // the entry is not picked up again by this loop.
+        mRetransQueue.Insert(*entry, now + std::max<uint32_t>(GetRetransmitTimeout(rc, static_cast<uint8_t>(sendCount + 1)), 1));
 
-        if (err == CHIP_NO_ERROR)
+        // Resend from Table (if the operation fails, the entry is cleared)
+        if (SendFromRetransTable(entry) == CHIP_NO_ERROR)
         {
-            // If the retransmission was successful, update the passive timer
-            entry.nextRetransTimeTick = static_cast<uint16_t>(rc->GetActiveRetransmitTimeoutTick());
 #if !defined(NDEBUG)
-            ChipLogDetail(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d", msgId, entry.sendCount);
+            ChipLogDetail(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d", msgId, sendCount + 1);
 #endif
         }
     }
@@ -174,66 +171,6 @@ void ReliableMessageMgr::ExecuteActions()
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
 
-static void TickProceed(uint16_t & time, uint64_t ticks)
-{
-    if (time >= ticks)
-    {
-        time = static_cast<uint16_t>(time - ticks);
-    }
-    else
-    {
-        time = 0;
-    }
-}
-
-void ReliableMessageMgr::ExpireTicks()
-{
-    uint64_t now = System::Clock::GetMonotonicMilliseconds();
-
-    // Number of full ticks elapsed since last timer processing.  We always round down
-    // to the previous tick.  If we are between tick boundaries, the extra time since the
-    // last virtual tick is not accounted for here (it will be accounted for when resetting
-    // the ReliableMessageProtocol timer)
-    uint64_t deltaTicks = GetTickCounterFromTimeDelta(now);
-
-#if defined(RMP_TICKLESS_DEBUG)
-    ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExpireTicks at %" PRIu64 ", %" PRIu64 ", %u", now, mTimeStampBase,
-                  deltaTicks);
-#endif
-
-    ExecuteForAllContext([deltaTicks](ReliableMessageContext * rc) {
-        if (rc->IsAckPending())
-        {
-            // Decrement counter of Ack timestamp by the elapsed timer ticks
-            TickProceed(rc->mNextAckTimeTick, deltaTicks);
-#if defined(RMP_TICKLESS_DEBUG)
-            ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExpireTicks set mNextAckTimeTick to %u", rc->mNextAckTimeTick);
-#endif
-        }
-    });
-
-    for (RetransTableEntry & entry : mRetransTable)
-    {
-        ReliableMessageContext * rc = entry.rc;
-        if (rc)
-        {
-            // Decrement Retransmit timeout by elapsed timeticks
-            TickProceed(entry.nextRetransTimeTick, deltaTicks);
-#if defined(RMP_TICKLESS_DEBUG)
-            ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExpireTicks set nextRetransTimeTick to %u",
-                          entry.nextRetransTimeTick);
-#endif
-        } // rc entry is allocated
-    }
-
-    // Re-Adjust the base time stamp to the most recent tick boundary
-    mTimeStampBase += (deltaTicks << mTimerIntervalShift);
-
-#if defined(RMP_TICKLESS_DEBUG)
-    ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExpireTicks mTimeStampBase to %" PRIu64, mTimeStampBase);
-#endif
-}
-
 void ReliableMessageMgr::Timeout(System::Layer * aSystemLayer, void * aAppState, CHIP_ERROR aError)
 {
     ReliableMessageMgr * manager = reinterpret_cast<ReliableMessageMgr *>(aAppState);
@@ -244,10 +181,7 @@ void ReliableMessageMgr::Timeout(System::Layer * aSystemLayer, void * aAppState,
     ChipLogDetail(ExchangeManager, "ReliableMessageMgr::Timeout\n");
 #endif
 
-    // Make sure all tick counts are sync'd to the current time
-    manager->ExpireTicks();
-
-    // Execute any actions that are due this tick
+    // Execute any actions that are due
     manager->ExecuteActions();
 
     // Calculate next physical wakeup
@@ -266,19 +200,19 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
         // Check the exchContext pointer for finding an empty slot in Table
         if (!entry.rc)
         {
-            // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
-            ExpireTicks();
-
-            entry.rc          = rc;
-            entry.sendCount   = 0;
-            entry.retainedBuf = EncryptedPacketBufferHandle();
+            // Stamped before the message is sent, since its ack may arrive before the send returns.
+            entry.rc            = rc;
+            entry.sendCount     = 0;
+            entry.firstSentTime = System::Clock::GetMonotonicMilliseconds();
+            entry.retainedBuf   = EncryptedPacketBufferHandle();
 
             *rEntry = &entry;
 
             // Increment the reference count
             rc->RetainContext();
             rc->SetOccupied(true);
-            added = true;
+            rc->mpRetransEntry = &entry;
+            added              = true;
 
             break;
         }
@@ -298,8 +232,7 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
     VerifyOrReturn(entry != nullptr && entry->rc != nullptr,
                    ChipLogError(ExchangeManager, "StartRetransmission was called for invalid entry"));
 
-    entry->nextRetransTimeTick = static_cast<uint16_t>(entry->rc->GetInitialRetransmitTimeoutTick() +
-                                                       GetTickCounterFromTimeDelta(System::Clock::GetMonotonicMilliseconds()));
+    mRetransQueue.Insert(*entry, System::Clock::GetMonotonicMilliseconds() + GetRetransmitTimeout(entry->rc, entry->sendCount));
 
     // Check if the timer needs to be started and start it.
     StartTimer();
@@ -307,47 +240,100 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 
 void ReliableMessageMgr::PauseRetransmision(ReliableMessageContext * rc, uint32_t PauseTimeMillis)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = rc->mpRetransEntry;
+
+    if (entry != nullptr && entry->IsQueued())
     {
-        if (entry.rc == rc)
-        {
-            entry.nextRetransTimeTick = static_cast<uint16_t>(entry.nextRetransTimeTick + (PauseTimeMillis >> mTimerIntervalShift));
-            break;
-        }
+        mRetransQueue.Insert(*entry, entry->GetDeadline() + PauseTimeMillis);
     }
 }
 
 void ReliableMessageMgr::ResumeRetransmision(ReliableMessageContext * rc)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = rc->mpRetransEntry;
+
+    if (entry != nullptr)
     {
-        if (entry.rc == rc)
-        {
-            entry.nextRetransTimeTick = 0;
-            break;
-        }
+        mRetransQueue.Insert(*entry, System::Clock::GetMonotonicMilliseconds());
+        StartTimer();
     }
 }
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMsgId)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = rc->mpRetransEntry;
+
+    if (entry != nullptr && entry->retainedBuf.GetMsgId() == ackMsgId)
     {
-        if ((entry.rc == rc) && entry.retainedBuf.GetMsgId() == ackMsgId)
+        // Only the ack of a message sent once tells how long the round trip took (Karn's algorithm).
+        Transport::PeerConnectionState * state = GetPeerConnectionState(rc);
+        if (entry->sendCount == 0 && entry->firstSentTime != 0 && state != nullptr)
         {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(entry);
+            const System::Clock::MonotonicMilliseconds rtt = System::Clock::GetMonotonicMilliseconds() - entry->firstSentTime;
+            state->GetRoundTripTimeEstimator().AddSample(static_cast<uint32_t>(std::min<uint64_t>(rtt, UINT32_MAX)));
+        }
+
+        // Clear the entry from the retransmision table.
+        ClearRetransTable(*entry);
 
 #if !defined(NDEBUG)
-            ChipLogDetail(ExchangeManager, "Rxd Ack; Removing MsgId:%08" PRIX32 " from Retrans Table", ackMsgId);
+        ChipLogDetail(ExchangeManager, "Rxd Ack; Removing MsgId:%08" PRIX32 " from Retrans Table", ackMsgId);
 #endif
-            return true;
-        }
+        return true;
     }
 
     return false;
 }
 
+uint32_t ReliableMessageMgr::GetRetransmitTimeout(ReliableMessageContext * rc, uint8_t sendCount)
+{
+    uint32_t configured = (sendCount == 0) ? rc->GetInitialRetransmitTimeout() : rc->GetActiveRetransmitTimeout();
+    uint32_t timeout;
+    uint8_t backoff;
+
+    Transport::PeerConnectionState * state = GetPeerConnectionState(rc);
+    if (state != nullptr && state->GetRoundTripTimeEstimator().HasSample())
+    {
+        // The peer has been heard from, so wait as long as it takes to answer rather than as
+        // long as it may sleep, backing off from the first retransmission on.
+        const uint32_t minimum = std::min<uint32_t>(configured, CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL);
+        timeout                = std::max(state->GetRoundTripTimeEstimator().GetRetransmitTimeoutMs(), minimum);
+        backoff                = sendCount;
+    }
+    else
+    {
+        // The initial interval covers the first retransmission, and the active one backs off after it.
+        timeout = configured;
+        backoff = (sendCount == 0) ? 0 : static_cast<uint8_t>(sendCount - 1);
+    }
+
+    const uint32_t maximum = std::max<uint32_t>(timeout, CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL);
+    for (; backoff > 0 && timeout < maximum; backoff--)
+    {
+        timeout = (timeout > maximum / 2) ? maximum : timeout * 2;
+    }
+
+    const uint32_t jitter = static_cast<uint32_t>(uint64_t(timeout) * CHIP_CONFIG_MRP_BACKOFF_JITTER_PERCENT / 100);
+    if (jitter > 0)
+    {
+        timeout += GetRandU32() % (jitter + 1);
+    }
+
+    return timeout;
+}
+
+Transport::PeerConnectionState * ReliableMessageMgr::GetPeerConnectionState(ReliableMessageContext * rc)
+{
+    ExchangeContext * ec = rc->GetExchangeContext();
+
+    if (mSessionMgr == nullptr || ec == nullptr)
+    {
+        return nullptr;
+    }
+
+    return mSessionMgr->GetPeerConnectionState(ec->GetSecureSession());
+}
+
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 {
     CHIP_ERROR err              = CHIP_NO_ERROR;
@@ -365,12 +351,13 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
     const ExchangeMessageDispatch * dispatcher = rc->GetExchangeContext()->GetMessageDispatch();
     VerifyOrExit(dispatcher != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
+    // Update the counters first, as the ack may arrive before the send returns, and needs to
+    // be seen as the ack of a retransmitted message.
+    entry->sendCount++;
+
     err = dispatcher->SendPreparedMessage(rc->GetExchangeContext()->GetSecureSession(), entry->retainedBuf);
     SuccessOrExit(err);
 
-    // Update the counters
-    entry->sendCount++;
-
 exit:
     if (err != CHIP_NO_ERROR)
     {
@@ -385,13 +372,10 @@ exit:
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    if (rc->mpRetransEntry != nullptr)
     {
-        if (entry.rc == rc)
-        {
-            // Clear the retransmit table entry.
-            ClearRetransTable(entry);
-        }
+        // Clear the retransmit table entry.
+        ClearRetransTable(*rc->mpRetransEntry);
     }
 }
 
@@ -401,82 +385,73 @@ void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & rEntry)
     {
         VerifyOrDie(rEntry.rc->IsOccupied() == true);
 
-        // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
-        ExpireTicks();
+        bool wasFront = (mRetransQueue.Front() == &rEntry);
+        mRetransQueue.Remove(rEntry);
 
-        rEntry.rc->ReleaseContext();
-        rEntry.rc->SetOccupied(false);
-        rEntry.rc = nullptr;
+        ReliableMessageContext * rc = rEntry.rc;
 
         // Clear all other fields
-        rEntry = RetransTableEntry();
+        rEntry.rc          = nullptr;
+        rEntry.retainedBuf = EncryptedPacketBufferHandle();
+        rEntry.sendCount     = 0;
+        rEntry.firstSentTime = 0;
 
-        // Schedule next physical wakeup, unless shutting down
-        if (mSystemLayer)
+        rc->mpRetransEntry = nullptr;
+        rc->SetOccupied(false);
+        rc->ReleaseContext();
+
+        // Schedule next physical wakeup, unless shutting down or the earliest deadline has not moved
+        if (mSystemLayer && wasFront)
             StartTimer();
     }
 }
 
 void ReliableMessageMgr::FailRetransTableEntries(ReliableMessageContext * rc, CHIP_ERROR err)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    if (rc->mpRetransEntry != nullptr)
     {
-        if (entry.rc == rc)
-        {
-            // Remove the entry from the retransmission table.
-            ClearRetransTable(entry);
-        }
+        // Remove the entry from the retransmission table.
+        ClearRetransTable(*rc->mpRetransEntry);
     }
 }
 
-void ReliableMessageMgr::StartTimer()
+void ReliableMessageMgr::ScheduleAck(ReliableMessageContext * rc)
 {
-    CHIP_ERROR res            = CHIP_NO_ERROR;
-    uint64_t nextWakeTimeTick = UINT64_MAX;
-    bool foundWake            = false;
+    if (!rc->IsQueued())
+    {
+        mAckQueue.Insert(*rc, System::Clock::GetMonotonicMilliseconds() + kRmpAckTimeoutMs);
+    }
+}
 
-    // When do we need to next wake up to send an ACK?
+void ReliableMessageMgr::CancelAck(ReliableMessageContext * rc)
+{
+    mAckQueue.Remove(*rc);
+}
 
-    ExecuteForAllContext([&nextWakeTimeTick, &foundWake](ReliableMessageContext * rc) {
-        if (rc->IsAckPending() && rc->mNextAckTimeTick < nextWakeTimeTick)
-        {
-            nextWakeTimeTick = rc->mNextAckTimeTick;
-            foundWake        = true;
-#if defined(RMP_TICKLESS_DEBUG)
-            ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer next ACK time %u", nextWakeTimeTick);
-#endif
-        }
-    });
+void ReliableMessageMgr::StartTimer()
+{
+    CHIP_ERROR res                                   = CHIP_NO_ERROR;
+    System::Clock::MonotonicMilliseconds timerExpiry = UINT64_MAX;
 
-    for (RetransTableEntry & entry : mRetransTable)
+    // When do we need to next wake up to send an ACK or a retransmission?
+    if (!mAckQueue.IsEmpty())
     {
-        ReliableMessageContext * rc = entry.rc;
-        if (rc)
-        {
-            // When do we need to next wake up for ReliableMessageProtocol retransmit?
-            if (entry.nextRetransTimeTick < nextWakeTimeTick)
-            {
-                nextWakeTimeTick = entry.nextRetransTimeTick;
-                foundWake        = true;
-#if defined(RMP_TICKLESS_DEBUG)
-                ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer RetransTime %u", nextWakeTimeTick);
-#endif
-            }
-        }
+        timerExpiry = mAckQueue.Front()->GetDeadline();
     }
 
-    if (foundWake)
+    if (!mRetransQueue.IsEmpty())
     {
-        // Set timer for next tick boundary - subtract the elapsed time from the current tick
-        System::Clock::MonotonicMilliseconds timerExpiry = (nextWakeTimeTick << mTimerIntervalShift) + mTimeStampBase;
+        timerExpiry = std::min(timerExpiry, mRetransQueue.Front()->GetDeadline());
+    }
 
+    if (timerExpiry != UINT64_MAX)
+    {
 #if defined(RMP_TICKLESS_DEBUG)
-        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer wake at %" PRIu64 " ms (%" PRIu64 " %" PRIu64 ")",
-                      timerExpiry, nextWakeTimeTick, mTimeStampBase);
+        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer wake at %" PRIu64 " ms", timerExpiry);
 #endif
         if (timerExpiry != mCurrentTimerExpiry)
         {
-            // If the tick boundary has expired in the past (delayed processing of event due to other system activity),
+            // If the deadline has passed (delayed processing of event due to other system activity),
             // expire the timer immediately
             uint64_t now           = System::Clock::GetMonotonicMilliseconds();
             uint64_t timerArmValue = (timerExpiry > now) ? timerExpiry - now : 0;
@@ -512,6 +487,7 @@ void ReliableMessageMgr::StartTimer()
 void ReliableMessageMgr::StopTimer()
 {
     mSystemLayer->CancelTimer(Timeout, this);
+    mCurrentTimerExpiry = 0;
 }
 
 #if CHIP_CONFIG_TEST
@@ -26,12 +26,12 @@
 #include <array>
 #include <stdint.h>
 
+#include <messaging/DeadlineQueue.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 
 #include <core/CHIPError.h>
 #include <support/BitFlags.h>
-#include <support/Pool.h>
 #include <system/SystemLayer.h>
 #include <system/SystemPacketBuffer.h>
 #include <system/SystemTimer.h>
@@ -43,58 +43,45 @@ namespace Messaging {
 enum class SendMessageFlags : uint16_t;
 class ReliableMessageContext;
 
-class ReliableMessageMgr
+/**
+ *  @class RetransTableEntry
+ *
+ *  @brief
+ *    This class is part of the CHIP Reliable Messaging Protocol and is used
+ *    to keep track of CHIP messages that have been sent and are expecting an
+ *    acknowledgment back. If the acknowledgment is not received within a
+ *    specific timeout, the message would be retransmitted from this table.
+ *
+ *    While its retransmission is scheduled, the entry is queued by the
+ *    absolute time of that retransmission.
+ *
+ */
+struct RetransTableEntry : public DeadlineQueueItem
 {
-public:
-    /**
-     *  @class RetransTableEntry
-     *
-     *  @brief
-     *    This class is part of the CHIP Reliable Messaging Protocol and is used
-     *    to keep track of CHIP messages that have been sent and are expecting an
-     *    acknowledgment back. If the acknowledgment is not received within a
-     *    specific timeout, the message would be retransmitted from this table.
-     *
-     */
-    struct RetransTableEntry
-    {
-        RetransTableEntry();
+    RetransTableEntry();
+
+    ReliableMessageContext * rc;             /**< The context for the stored CHIP message. */
+    EncryptedPacketBufferHandle retainedBuf; /**< The packet buffer holding the CHIP message. */
+    uint8_t sendCount;                       /**< A counter representing the number of times the message has been sent. */
 
-        ReliableMessageContext * rc;             /**< The context for the stored CHIP message. */
-        EncryptedPacketBufferHandle retainedBuf; /**< The packet buffer holding the CHIP message. */
-        uint16_t nextRetransTimeTick;            /**< A counter representing the next retransmission time for the message. */
-        uint8_t sendCount;                       /**< A counter representing the number of times the message has been sent. */
-    };
+    /** When the message was first sent, to measure the round trip time to the peer, or 0 if unknown. */
+    System::Clock::MonotonicMilliseconds firstSentTime;
+};
 
+class ReliableMessageMgr
+{
 public:
-    ReliableMessageMgr(BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
+    using RetransTableEntry = Messaging::RetransTableEntry;
+
+    ReliableMessageMgr();
     ~ReliableMessageMgr();
 
     void Init(chip::System::Layer * systemLayer, SecureSessionMgr * sessionMgr);
     void Shutdown();
 
     /**
-     * Return a tick counter value given a time period.
-     *
-     * @param[in]  period        Timestamp value of in milliseconds.
-     *
-     * @return Tick count for the time period.
-     */
-    uint64_t GetTickCounterFromTimePeriod(uint64_t period);
-
-    /**
-     * Return a tick counter value between the given time and the stored time.
-     *
-     * @param[in]  newTime        Timestamp value of in milliseconds.
-     *
-     * @return Tick count of the difference between the given time and the stored time.
-     */
-    uint64_t GetTickCounterFromTimeDelta(uint64_t newTime);
-
-    /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
-     * action needs to be triggered by ReliableMessageProtocol time facilities,
-     * execute that action.
+     * Send the standalone acks and retransmissions whose deadline has passed,
+     * taking them from the front of their queues.
      */
     void ExecuteActions();
 
@@ -147,8 +134,8 @@ public:
     void ResumeRetransmision(ReliableMessageContext * rc);
 
     /**
-     *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
-     *  the specified ExchangeContext and the message ID from the retransmision table.
+     *  Clear the entry of the specified ExchangeContext from the retransmision table, if it holds
+     *  the message ID.
      *
      *  @param[in]    rc        A pointer to the ExchangeContext object.
      *
@@ -158,6 +145,22 @@ public:
      */
     bool CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t msgId);
 
+    /**
+     *  The time to wait for an acknowledgment before retransmitting a message of the
+     *  specified ExchangeContext.
+     *
+     *  Once the round trip time to the peer has been measured, the wait is derived from
+     *  it, otherwise from the retransmit intervals configured for the exchange. It doubles
+     *  with each retransmission, and random jitter is added on top.
+     *
+     *  @param[in]    rc          A pointer to the ExchangeContext object.
+     *
+     *  @param[in]    sendCount   The number of times the message has been retransmitted.
+     *
+     *  @return  The timeout in milliseconds.
+     */
+    uint32_t GetRetransmitTimeout(ReliableMessageContext * rc, uint8_t sendCount);
+
     /**
      *  Send the specified entry from the retransmission table.
      *
@@ -194,59 +197,55 @@ public:
     void FailRetransTableEntries(ReliableMessageContext * rc, CHIP_ERROR err);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
-     * Determine how many ReliableMessageProtocol ticks we need to sleep before we
-     * need to physically wake the CPU to perform an action.  Set a timer to go off
-     * when we next need to wake the system.
+     *  Schedule a standalone acknowledgment for the specified ExchangeContext one
+     *  ack timeout from now, unless one is already scheduled.
+     *
+     *  @param[in]    rc    A pointer to the ExchangeContext object.
      *
      */
-    void StartTimer();
+    void ScheduleAck(ReliableMessageContext * rc);
 
     /**
-     * Stop the timer for retransmistion on current node.
+     *  Cancel the standalone acknowledgment scheduled for the specified ExchangeContext.
+     *
+     *  @param[in]    rc    A pointer to the ExchangeContext object.
      *
      */
-    void StopTimer();
+    void CancelAck(ReliableMessageContext * rc);
+
+    /**
+     * Set a timer to go off at the earliest deadline of the pending acks and
+     * retransmissions, or stop it if there are none.
+     *
+     */
+    void StartTimer();
 
     /**
-     * Calculate number of virtual ReliableMessageProtocol ticks that have expired
-     * since we last called this function. Iterate through active exchange contexts
-     * and retrans table entries, subtracting expired virtual ticks to synchronize
-     * wakeup times with the current system time. Do not perform any actions beyond
-     * updating tick counts, actions will be performed by the physical
-     * ReliableMessageProtocol timer tick expiry.
+     * Stop the timer for retransmistion on current node.
      *
      */
-    void ExpireTicks();
+    void StopTimer();
 
 #if CHIP_CONFIG_TEST
     // Functions for testing
     int TestGetCountRetransTable();
-    void TestSetIntervalShift(uint16_t value) { mTimerIntervalShift = value; }
 #endif // CHIP_CONFIG_TEST
 
 private:
-    BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
     SecureSessionMgr * mSessionMgr;
-    uint64_t mTimeStampBase; // ReliableMessageProtocol timer base value to add offsets to evaluate timeouts
     System::Clock::MonotonicMilliseconds mCurrentTimerExpiry; // Tracks when the ReliableMessageProtocol timer will next expire
-    uint16_t mTimerIntervalShift;                             // ReliableMessageProtocol Timer tick period shift
-
-    /* Placeholder function to run a function for all exchanges */
-    template <typename Function>
-    void ExecuteForAllContext(Function function)
-    {
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            function(ec->GetReliableMessageContext());
-            return true;
-        });
-    }
 
     void TicklessDebugDumpRetransTable(const char * log);
 
+    Transport::PeerConnectionState * GetPeerConnectionState(ReliableMessageContext * rc);
+
     // ReliableMessageProtocol Global tables for timer context
     RetransTableEntry mRetransTable[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+
+    // Exchanges with an ack pending and table entries with a retransmission scheduled, by deadline
+    DeadlineQueue<ReliableMessageContext> mAckQueue;
+    DeadlineQueue<RetransTableEntry> mRetransQueue;
 };
 
 } // namespace Messaging
@@ -34,8 +34,9 @@ namespace Messaging {
  *  @def CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT
  *
  *  @brief
- *    The default ReliableMessageProtocol timer tick interval shift in
- *    milliseconds. 6 bit equals 64 milliseconds
+ *    The ReliableMessageProtocol tick interval shift in milliseconds, the
+ *    unit of CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT_TICK. 6 bit equals 64
+ *    milliseconds. Retransmissions are scheduled in milliseconds.
  *
  */
 #ifndef CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT
@@ -71,11 +72,50 @@ namespace Messaging {
 #define CHIP_CONFIG_MRP_DEFAULT_INITIAL_RETRY_INTERVAL (5000)
 #endif // CHIP_CONFIG_MRP_DEFAULT_INITIAL_RETRY_INTERVAL
 
+/**
+ *  @def CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL
+ *
+ *  @brief
+ *    Lower bound, in milliseconds, of a retransmit interval derived from the
+ *    measured round trip time to the peer. Exchanges configured with shorter
+ *    retransmit intervals are bounded by those instead.
+ *
+ */
+#ifndef CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL
+#define CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL (100)
+#endif // CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL
+
+/**
+ *  @def CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL
+ *
+ *  @brief
+ *    Upper bound, in milliseconds, of a retransmit interval after exponential
+ *    backoff. Configured retransmit intervals longer than this are used as is.
+ *
+ */
+#ifndef CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL
+#define CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL (60000)
+#endif // CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL
+
+/**
+ *  @def CHIP_CONFIG_MRP_BACKOFF_JITTER_PERCENT
+ *
+ *  @brief
+ *    Random jitter, as a percentage of the retransmit interval, added to
+ *    each retransmit interval so that peers that lost messages at the same
+ *    time do not retransmit in lockstep.
+ *
+ */
+#ifndef CHIP_CONFIG_MRP_BACKOFF_JITTER_PERCENT
+#define CHIP_CONFIG_MRP_BACKOFF_JITTER_PERCENT (25)
+#endif // CHIP_CONFIG_MRP_BACKOFF_JITTER_PERCENT
+
 /**
  *  @def CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT_TICK
  *
  *  @brief
- *    The default acknowledgment timeout in milliseconds.
+ *    The default acknowledgment timeout in ticks of
+ *    (1 << CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT) milliseconds.
  *
  */
 #ifndef CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT_TICK
@@ -116,14 +156,17 @@ namespace Messaging {
  */
 struct ReliableMessageProtocolConfig
 {
-    uint32_t mInitialRetransTimeoutTick; /**< Configurable timeout in msec for retransmission of the first sent message. */
-    uint32_t mActiveRetransTimeoutTick;  /**< Configurable timeout in msec for retransmission of all subsequent messages. */
+    uint32_t mInitialRetransTimeout; /**< Configurable timeout in msec for retransmission of the first sent message. */
+    uint32_t mActiveRetransTimeout;  /**< Configurable timeout in msec for retransmission of all subsequent messages. */
 };
 
-const ReliableMessageProtocolConfig gDefaultReliableMessageProtocolConfig = {
-    CHIP_CONFIG_MRP_DEFAULT_INITIAL_RETRY_INTERVAL >> CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT,
-    CHIP_CONFIG_MRP_DEFAULT_ACTIVE_RETRY_INTERVAL >> CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT
-};
+const ReliableMessageProtocolConfig gDefaultReliableMessageProtocolConfig = { CHIP_CONFIG_MRP_DEFAULT_INITIAL_RETRY_INTERVAL,
+                                                                              CHIP_CONFIG_MRP_DEFAULT_ACTIVE_RETRY_INTERVAL };
+
+/**
+ *  The acknowledgment timeout in milliseconds.
+ */
+constexpr uint32_t kRmpAckTimeoutMs = CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT_TICK << CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT;
 
 // clang-format on
 
@@ -0,0 +1,216 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks of the ExchangeManager message
+ *      dispatch. They are built with chip_build_benchmarks and are not
+ *      part of the unit tests.
+ */
+
+#include <core/CHIPCore.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/Protocols.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+using namespace chip::Messaging;
+
+using TestContext = chip::Test::MessagingContext;
+
+constexpr uint8_t kMsgType_TEST1 = 1;
+constexpr uint64_t kIterations   = 100000;
+
+TestContext sContext;
+
+TransportMgr<Test::LoopbackTransport> gTransportMgr;
+
+class KeepOpenDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        // Keep the exchange open for the next message.
+        ec->WillSendMessage();
+        ReceivedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    uint64_t ReceivedCount = 0;
+};
+
+uint64_t PerSecond(uint64_t aCount, uint64_t aElapsedUs)
+{
+    return aCount * 1000000 / ((aElapsedUs > 0) ? aElapsedUs : 1);
+}
+
+void BenchmarkDispatch(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Leave room for the exchange that an unsolicited message may need.
+    constexpr size_t kExchangeCount = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS - 1;
+
+    using DuplicateMessage = SecureSessionMgrDelegate::DuplicateMessage;
+
+    KeepOpenDelegate delegate;
+    ExchangeContext * exchanges[kExchangeCount];
+    SecureSessionMgrDelegate & dispatcher = ctx.GetExchangeManager();
+    const SecureSessionHandle session     = ctx.GetSessionLocalToPeer();
+
+    for (ExchangeContext *& ec : exchanges)
+    {
+        ec = ctx.NewExchangeToPeer(&delegate);
+        NL_TEST_ASSERT(inSuite, ec != nullptr);
+        VerifyOrReturn(ec != nullptr);
+    }
+
+    // Fill the unsolicited message handler table too, none of them for the messages sent below.
+    uint8_t handlerCount = 0;
+    while (ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, handlerCount, &delegate) ==
+           CHIP_NO_ERROR)
+    {
+        handlerCount++;
+    }
+    NL_TEST_ASSERT(inSuite, handlerCount > 0);
+
+    PacketHeader packetHeader;
+    packetHeader.SetSourceNodeId(ctx.GetDestinationNodeId());
+
+    // Responses on the exchange that was opened last.
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(exchanges[kExchangeCount - 1]->GetExchangeId())
+        .SetMessageType(Protocols::BDX::Id, kMsgType_TEST1)
+        .SetInitiator(false);
+
+    uint64_t start = System::Clock::GetMonotonicMicroseconds();
+    for (uint64_t i = 0; i < kIterations; i++)
+    {
+        dispatcher.OnMessageReceived(packetHeader, payloadHeader, session, PeerAddress::Uninitialized(), DuplicateMessage::No,
+                                     System::PacketBufferHandle());
+    }
+    uint64_t exchangeElapsed = System::Clock::GetMonotonicMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, delegate.ReceivedCount == kIterations);
+
+    // Unsolicited messages that no handler takes, and that need no ack, so no exchange is created for them.
+    payloadHeader.SetExchangeID(static_cast<uint16_t>(exchanges[kExchangeCount - 1]->GetExchangeId() + 1))
+        .SetMessageType(Protocols::BDX::Id, kMsgType_TEST1)
+        .SetInitiator(true);
+
+    start = System::Clock::GetMonotonicMicroseconds();
+    for (uint64_t i = 0; i < kIterations; i++)
+    {
+        dispatcher.OnMessageReceived(packetHeader, payloadHeader, session, PeerAddress::Uninitialized(), DuplicateMessage::No,
+                                     System::PacketBufferHandle());
+    }
+    uint64_t unsolicitedElapsed = System::Clock::GetMonotonicMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, delegate.ReceivedCount == kIterations);
+
+    printf("ExchangeManager with %zu exchanges and %u handlers: %" PRIu64 " exchange messages/s, %" PRIu64
+           " unsolicited messages/s\n",
+           kExchangeCount, handlerCount, PerSecond(kIterations, exchangeElapsed), PerSecond(kIterations, unsolicitedElapsed));
+
+    for (uint8_t msgType = 0; msgType < handlerCount; msgType++)
+    {
+        CHIP_ERROR err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, msgType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    for (ExchangeContext * ec : exchanges)
+    {
+        ec->Close();
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Benchmark ExchangeMgr dispatch", BenchmarkDispatch),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext);
+int Finalize(void * aContext);
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Benchmark-CHIP-ExchangeManager",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+int Initialize(void * aContext)
+{
+    CHIP_ERROR err = chip::Platform::MemoryInit();
+    if (err != CHIP_NO_ERROR)
+        return FAILURE;
+
+    err = gTransportMgr.Init("LOOPBACK");
+    if (err != CHIP_NO_ERROR)
+        return FAILURE;
+
+    auto * ctx = reinterpret_cast<TestContext *>(aContext);
+    err        = ctx->Init(&sSuite, &gTransportMgr);
+    if (err != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+int Finalize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    chip::Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+int BenchmarkExchangeMgr()
+{
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkExchangeMgr)
@@ -0,0 +1,194 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks of the ReliableMessageProtocol
+ *      implementation. They are built with chip_build_benchmarks and are
+ *      not part of the unit tests.
+ */
+
+#include <core/CHIPCore.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/ReliableMessageContext.h>
+#include <messaging/ReliableMessageMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/Protocols.h>
+#include <protocols/echo/Echo.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Messaging;
+using namespace chip::Protocols;
+
+using TestContext = chip::Test::MessagingContext;
+
+TestContext sContext;
+
+const char PAYLOAD[] = "Hello!";
+
+TransportMgrBase gTransportMgr;
+Test::LoopbackTransport gLoopback;
+
+// Each message in the retransmission table holds a packet buffer, so leave room for the buffers that the
+// acks themselves need.
+constexpr size_t kExchanges    = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE / 2;
+constexpr uint64_t kIterations = 100000;
+
+class MockAppDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
+uint64_t PerSecond(uint64_t aCount, uint64_t aElapsedUs)
+{
+    return aCount * 1000000 / ((aElapsedUs > 0) ? aElapsedUs : 1);
+}
+
+void BenchmarkRetransTable(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    MockAppDelegate mockSender;
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    ExchangeContext * exchanges[kExchanges];
+
+    // Fill the table with messages that are dropped and not due for retransmission before the end of the benchmark.
+    gLoopback.mNumMessagesToDrop = kExchanges;
+    for (size_t i = 0; i < kExchanges; i++)
+    {
+        exchanges[i] = ctx.NewExchangeToPeer(&mockSender);
+        NL_TEST_ASSERT(inSuite, exchanges[i] != nullptr);
+        VerifyOrReturn(exchanges[i] != nullptr);
+        exchanges[i]->GetReliableMessageContext()->SetConfig({ 60000, 60000 });
+
+        System::PacketBufferHandle buffer = MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, exchanges[i]->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer)) == CHIP_NO_ERROR);
+    }
+
+    // With many messages in flight and nothing due, measure what each timer fire, and each ack lookup, costs on its own.
+    uint64_t start = System::Clock::GetMonotonicMicroseconds();
+    for (uint64_t i = 0; i < kIterations; i++)
+    {
+        ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    }
+    uint64_t timerElapsed = System::Clock::GetMonotonicMicroseconds() - start;
+
+    bool acked = false;
+    start      = System::Clock::GetMonotonicMicroseconds();
+    for (uint64_t i = 0; i < kIterations; i++)
+    {
+        acked |= rm->CheckAndRemRetransTable(exchanges[i % kExchanges]->GetReliableMessageContext(), UINT32_MAX);
+    }
+    uint64_t ackElapsed = System::Clock::GetMonotonicMicroseconds() - start;
+
+    NL_TEST_ASSERT(inSuite, !acked);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kExchanges);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kExchanges));
+
+    printf("ReliableMessageMgr with %zu messages in flight: %" PRIu64 " timer fires/s, %" PRIu64 " ack lookups/s\n", kExchanges,
+           PerSecond(kIterations, timerElapsed), PerSecond(kIterations, ackElapsed));
+
+    for (ExchangeContext * exchange : exchanges)
+    {
+        rm->ClearRetransTable(exchange->GetReliableMessageContext());
+        exchange->Close();
+    }
+    gLoopback.Reset();
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Benchmark ReliableMessageMgr retransmission table", BenchmarkRetransTable),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext);
+int Finalize(void * aContext);
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Benchmark-CHIP-ReliableMessageProtocol",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+int Initialize(void * aContext)
+{
+    CHIP_ERROR err = chip::Platform::MemoryInit();
+    if (err != CHIP_NO_ERROR)
+        return FAILURE;
+
+    gTransportMgr.Init(&gLoopback);
+
+    auto * ctx = reinterpret_cast<TestContext *>(aContext);
+    err        = ctx->Init(&sSuite, &gTransportMgr);
+    if (err != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    gTransportMgr.SetSecureSessionMgr(&ctx->GetSecureSessionManager());
+    return SUCCESS;
+}
+
+int Finalize(void * aContext)
+{
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    chip::Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+int BenchmarkReliableMessageProtocol()
+{
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkReliableMessageProtocol)
@@ -93,6 +93,39 @@ public:
     bool IsOnResponseTimeoutCalled = false;
 };
 
+class KeepOpenDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        // Keep the exchange open for the next message.
+        ec->WillSendMessage();
+        LastExchange = ec;
+        ReceivedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    ExchangeContext * LastExchange = nullptr;
+    uint64_t ReceivedCount         = 0;
+};
+
+// Hand the exchange manager a message on the given exchange, as if it had come from the peer of the session.
+void Deliver(TestContext & ctx, SecureSessionHandle session, uint16_t exchangeId, bool initiator)
+{
+    PacketHeader packetHeader;
+    packetHeader.SetSourceNodeId(session.GetPeerNodeId());
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(exchangeId).SetMessageType(Protocols::BDX::Id, kMsgType_TEST1).SetInitiator(initiator);
+
+    static_cast<SecureSessionMgrDelegate &>(ctx.GetExchangeManager())
+        .OnMessageReceived(packetHeader, payloadHeader, session, PeerAddress::Uninitialized(),
+                           SecureSessionMgrDelegate::DuplicateMessage::No, System::PacketBufferHandle());
+}
+
 void CheckNewContextTest(nlTestSuite * inSuite, void * inContext)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
@@ -217,6 +250,106 @@ void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+void CheckIndexAfterClose(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    KeepOpenDelegate closedDelegate;
+    KeepOpenDelegate openDelegate;
+    ExchangeContext * closed = ctx.NewExchangeToPeer(&closedDelegate);
+    ExchangeContext * open   = ctx.NewExchangeToPeer(&openDelegate);
+    NL_TEST_ASSERT(inSuite, closed != nullptr && open != nullptr);
+    VerifyOrReturn(closed != nullptr && open != nullptr);
+
+    const uint16_t closedId = closed->GetExchangeId();
+    closed->Close();
+
+    // Messages for a closed exchange find nothing, and those for the others still find them.
+    Deliver(ctx, ctx.GetSessionLocalToPeer(), closedId, false);
+    NL_TEST_ASSERT(inSuite, closedDelegate.ReceivedCount == 0);
+    Deliver(ctx, ctx.GetSessionLocalToPeer(), open->GetExchangeId(), false);
+    NL_TEST_ASSERT(inSuite, openDelegate.ReceivedCount == 1);
+
+    open->Close();
+}
+
+void CheckIndexAfterSessionExpiration(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    WaitForTimeoutDelegate closingDelegate;
+    KeepOpenDelegate expiredDelegate;
+    KeepOpenDelegate newDelegate;
+    const SecureSessionHandle session = ctx.GetSessionLocalToPeer();
+
+    // One exchange that its delegate closes when the session expires, and one that stays open without a session.
+    ExchangeContext * closing = ctx.NewExchangeToPeer(&closingDelegate);
+    ExchangeContext * expired = ctx.NewExchangeToPeer(&expiredDelegate);
+    NL_TEST_ASSERT(inSuite, closing != nullptr && expired != nullptr);
+    VerifyOrReturn(closing != nullptr && expired != nullptr);
+    closing->SendMessage(
+        Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+        SendFlags(Messaging::SendMessageFlags::kExpectResponse).Set(Messaging::SendMessageFlags::kNoAutoRequestAck));
+
+    ctx.GetExchangeManager().OnConnectionExpired(session);
+    NL_TEST_ASSERT(inSuite, closingDelegate.IsOnResponseTimeoutCalled);
+
+    // The exchange left without a session no longer gets the messages of the session, which new exchanges on it do.
+    ExchangeContext * fresh = ctx.NewExchangeToPeer(&newDelegate);
+    NL_TEST_ASSERT(inSuite, fresh != nullptr);
+    VerifyOrReturn(fresh != nullptr);
+    Deliver(ctx, session, expired->GetExchangeId(), false);
+    NL_TEST_ASSERT(inSuite, expiredDelegate.ReceivedCount == 0);
+    Deliver(ctx, session, fresh->GetExchangeId(), false);
+    NL_TEST_ASSERT(inSuite, newDelegate.ReceivedCount == 1);
+
+    expired->Close();
+    fresh->Close();
+}
+
+void CheckIndexDuplicateExchangeIds(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    KeepOpenDelegate initiatorDelegate;
+    KeepOpenDelegate responderDelegate;
+    const SecureSessionHandle session = ctx.GetSessionLocalToPeer();
+
+    ExchangeContext * initiator = ctx.NewExchangeToPeer(&initiatorDelegate);
+    NL_TEST_ASSERT(inSuite, initiator != nullptr);
+    VerifyOrReturn(initiator != nullptr);
+    const uint16_t exchangeId = initiator->GetExchangeId();
+
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1,
+                                                                                       &responderDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The peer opens an exchange with the same id, which is told apart from ours by who initiated it.
+    Deliver(ctx, session, exchangeId, true);
+    NL_TEST_ASSERT(inSuite, responderDelegate.ReceivedCount == 1 && initiatorDelegate.ReceivedCount == 0);
+    ExchangeContext * responder = responderDelegate.LastExchange;
+    NL_TEST_ASSERT(inSuite, responder != nullptr && responder != initiator && responder->GetExchangeId() == exchangeId);
+    VerifyOrReturn(responder != nullptr);
+
+    Deliver(ctx, session, exchangeId, true);
+    NL_TEST_ASSERT(inSuite, responderDelegate.ReceivedCount == 2 && responderDelegate.LastExchange == responder);
+    Deliver(ctx, session, exchangeId, false);
+    NL_TEST_ASSERT(inSuite, initiatorDelegate.ReceivedCount == 1 && initiatorDelegate.LastExchange == initiator);
+
+    // The same id on another session is another exchange.
+    Deliver(ctx, ctx.GetSessionPeerToLocal(), exchangeId, false);
+    NL_TEST_ASSERT(inSuite, initiatorDelegate.ReceivedCount == 1 && responderDelegate.ReceivedCount == 2);
+
+    // Closing one of them leaves the other one indexed.
+    responder->Close();
+    Deliver(ctx, session, exchangeId, false);
+    NL_TEST_ASSERT(inSuite, initiatorDelegate.ReceivedCount == 2);
+
+    initiator->Close();
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
 // Test Suite
 
 /**
@@ -230,6 +363,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
     NL_TEST_DEF("Test OnConnectionExpired basics",            CheckSessionExpirationBasics),
     NL_TEST_DEF("Test OnConnectionExpired timeout handling",  CheckSessionExpirationTimeout),
+    NL_TEST_DEF("Test ExchangeMgr index after close",         CheckIndexAfterClose),
+    NL_TEST_DEF("Test ExchangeMgr index after expiration",    CheckIndexAfterSessionExpiration),
+    NL_TEST_DEF("Test ExchangeMgr duplicate exchange ids",    CheckIndexDuplicateExchangeIds),
 
     NL_TEST_SENTINEL()
 };
@@ -278,7 +278,7 @@ void CheckResendApplicationMessage(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 1);
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -344,7 +344,7 @@ void CheckCloseExchangeAndResendApplicationMessage(nlTestSuite * inSuite, void *
     NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 1);
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -409,7 +409,7 @@ void CheckFailedMessageRetainOnSend(nlTestSuite * inSuite, void * inContext)
     // Ensure the message was dropped
     NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 1);
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -470,7 +470,7 @@ void CheckResendApplicationMessageWithPeerExchange(nlTestSuite * inSuite, void *
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
     NL_TEST_ASSERT(inSuite, !mockReceiver.IsOnMessageReceivedCalled);
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -547,7 +547,7 @@ void CheckDuplicateMessageClosedExchange(nlTestSuite * inSuite, void * inContext
     err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -620,7 +620,7 @@ void CheckResendSessionEstablishmentMessageWithPeerExchange(nlTestSuite * inSuit
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
     NL_TEST_ASSERT(inSuite, !mockReceiver.IsOnMessageReceivedCalled);
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -709,7 +709,7 @@ void CheckDuplicateMessage(nlTestSuite * inSuite, void * inContext)
     mockReceiver.mDropAckResponse = false;
     mockReceiver.mRetainExchange  = false;
 
-    // 1 tick is 64 ms, sleep 65 ms to trigger first re-transmit
+    // The retransmit timeout is 1 ms, sleep 65 ms to trigger first re-transmit
     test_os_sleep_ms(65);
     ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
 
@@ -1139,6 +1139,203 @@ void CheckMessageAfterClosed(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
 }
 
+// Each message in the retransmission table holds a packet buffer, so leave room for the buffers that the
+// retransmissions and acks themselves need.
+constexpr size_t kRetransTestExchanges = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE / 2;
+
+// Open kRetransTestExchanges exchanges, and send a message on each, so that each of them has an entry waiting
+// for an ack. The messages and all their retransmissions are dropped.
+void FillRetransTable(nlTestSuite * inSuite, TestContext & ctx, ExchangeDelegate * delegate, ExchangeContext ** exchanges,
+                      uint32_t shortTimeoutExchanges)
+{
+    gLoopback.mSentMessageCount    = 0;
+    gLoopback.mNumMessagesToDrop   = kRetransTestExchanges * (CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS + 1);
+    gLoopback.mDroppedMessageCount = 0;
+
+    for (size_t i = 0; i < kRetransTestExchanges; i++)
+    {
+        exchanges[i] = ctx.NewExchangeToPeer(delegate);
+        NL_TEST_ASSERT(inSuite, exchanges[i] != nullptr);
+
+        // The first shortTimeoutExchanges even exchanges are due soon, the others well after the end of the test.
+        const uint32_t timeout = (i % 2 == 0 && i / 2 < shortTimeoutExchanges) ? 20 : 60000;
+        exchanges[i]->GetReliableMessageContext()->SetConfig({ timeout, timeout });
+
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        NL_TEST_ASSERT(inSuite, exchanges[i]->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer)) == CHIP_NO_ERROR);
+    }
+}
+
+void CloseRetransTestExchanges(ReliableMessageMgr * rm, ExchangeContext ** exchanges)
+{
+    for (size_t i = 0; i < kRetransTestExchanges; i++)
+    {
+        if (exchanges[i] != nullptr)
+        {
+            rm->ClearRetransTable(exchanges[i]->GetReliableMessageContext());
+            exchanges[i]->Close();
+        }
+    }
+    gLoopback.Reset();
+}
+
+void CheckRetransDeadlines(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    MockAppDelegate mockSender;
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    ExchangeContext * exchanges[kRetransTestExchanges];
+    const uint32_t dueExchanges = (kRetransTestExchanges + 1) / 2;
+
+    FillRetransTable(inSuite, ctx, &mockSender, exchanges, dueExchanges);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kRetransTestExchanges));
+
+    // Only the messages with a short timeout are due for a retransmission.
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges + dueExchanges);
+
+    // Each of them is retransmitted once per timeout.
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges + dueExchanges);
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges + 2 * dueExchanges);
+
+    // Pausing pushes a retransmission back, and resuming makes it due right away.
+    rm->PauseRetransmision(exchanges[0]->GetReliableMessageContext(), 60000);
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges + 3 * dueExchanges - 1);
+    rm->ResumeRetransmision(exchanges[0]->GetReliableMessageContext());
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges + 3 * dueExchanges);
+
+    // The third retransmission waits twice as long as the others, and past it the messages are given up on.
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kRetransTestExchanges));
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == kRetransTestExchanges + 3 * dueExchanges);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(kRetransTestExchanges - dueExchanges));
+
+    CloseRetransTestExchanges(rm, exchanges);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+}
+
+void CheckRetransmitTimeout(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    MockAppDelegate mockSender;
+    ReliableMessageMgr * rm     = ctx.GetExchangeManager().GetReliableMessageMgr();
+    ExchangeContext * exchange  = ctx.NewExchangeToPeer(&mockSender);
+    ReliableMessageContext * rc = exchange->GetReliableMessageContext();
+    RoundTripTimeEstimator & estimator =
+        ctx.GetSecureSessionManager().GetPeerConnectionState(ctx.GetSessionLocalToPeer())->GetRoundTripTimeEstimator();
+
+    auto timeoutWithin = [&](uint8_t sendCount, uint32_t low, uint32_t high) {
+        const uint32_t timeout = rm->GetRetransmitTimeout(rc, sendCount);
+        return timeout >= low && timeout <= high;
+    };
+
+    // Before the round trip time is known, the configured intervals apply, the active one backing off
+    // after the first retransmission, up to the limit. Jitter adds up to a quarter.
+    rc->SetConfig({ 2000, 400 });
+    NL_TEST_ASSERT(inSuite, timeoutWithin(0, 2000, 2500));
+    NL_TEST_ASSERT(inSuite, timeoutWithin(1, 400, 500));
+    NL_TEST_ASSERT(inSuite, timeoutWithin(2, 800, 1000));
+    NL_TEST_ASSERT(inSuite, timeoutWithin(3, 1600, 2000));
+
+    rc->SetConfig({ 40000, 40000 });
+    NL_TEST_ASSERT(inSuite, timeoutWithin(2, CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL, CHIP_CONFIG_MRP_MAX_RETRY_INTERVAL * 5 / 4));
+
+    // Once it is known, it replaces the configured intervals, both shorter and longer ones, and backs off
+    // from the first retransmission on.
+    estimator.AddSample(400);
+    rc->SetConfig({ 2000, 400 });
+    NL_TEST_ASSERT(inSuite, timeoutWithin(0, 1200, 1500));
+    NL_TEST_ASSERT(inSuite, timeoutWithin(1, 2400, 3000));
+
+    estimator.Reset();
+    estimator.AddSample(4000);
+    NL_TEST_ASSERT(inSuite, timeoutWithin(0, 12000, 15000));
+
+    // Short round trips are held to the minimum, unless the exchange is configured for less.
+    estimator.Reset();
+    estimator.AddSample(1);
+    NL_TEST_ASSERT(inSuite, timeoutWithin(0, CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL, CHIP_CONFIG_MRP_MIN_RETRY_INTERVAL * 5 / 4));
+    rc->SetConfig({ 1, 1 });
+    NL_TEST_ASSERT(inSuite, timeoutWithin(0, 3, 3));
+
+    exchange->Close();
+}
+
+void CheckRoundTripTimeSamples(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    MockAppDelegate mockSender;
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    RoundTripTimeEstimator & estimator =
+        ctx.GetSecureSessionManager().GetPeerConnectionState(ctx.GetSessionLocalToPeer())->GetRoundTripTimeEstimator();
+
+    ExchangeContext * exchange = ctx.NewExchangeToPeer(&mockSender);
+    exchange->GetReliableMessageContext()->SetConfig({ 1, 1 });
+
+    // The ack of a retransmitted message may be for any of its copies, so it is not measured.
+    gLoopback.mSentMessageCount    = 0;
+    gLoopback.mNumMessagesToDrop   = 1;
+    gLoopback.mDroppedMessageCount = 0;
+
+    chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer)) == CHIP_NO_ERROR);
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+    exchange->Close();
+
+    // The ack of a message sent once is, even when it arrives before the send returns, as it does over loopback.
+    exchange = ctx.NewExchangeToPeer(&mockSender);
+    buffer   = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    const System::Clock::MonotonicMilliseconds start = System::Clock::GetMonotonicMilliseconds();
+    NL_TEST_ASSERT(inSuite, exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer)) == CHIP_NO_ERROR);
+    const System::Clock::MonotonicMilliseconds elapsed = System::Clock::GetMonotonicMilliseconds() - start;
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, estimator.GetSampleCount() == 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRttMs() <= elapsed);
+    exchange->Close();
+
+    // A message without a send time gives no sample.
+    PacketHeader packetHeader;
+    packetHeader.SetMessageId(1);
+    buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, packetHeader.EncodeBeforeData(buffer) == CHIP_NO_ERROR);
+
+    exchange = ctx.NewExchangeToPeer(&mockSender);
+    ReliableMessageMgr::RetransTableEntry * entry;
+    NL_TEST_ASSERT(inSuite, rm->AddToRetransTable(exchange->GetReliableMessageContext(), &entry) == CHIP_NO_ERROR);
+    entry->retainedBuf   = EncryptedPacketBufferHandle::MarkEncrypted(std::move(buffer));
+    entry->firstSentTime = 0;
+    NL_TEST_ASSERT(inSuite, rm->CheckAndRemRetransTable(exchange->GetReliableMessageContext(), 1));
+    NL_TEST_ASSERT(inSuite, estimator.GetSampleCount() == 1);
+    exchange->Close();
+
+    gLoopback.Reset();
+}
+
 // Test Suite
 
 /**
@@ -1161,6 +1358,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test sending an unsolicited ack-soliciting 'standalone ack' message", CheckSendUnsolicitedStandaloneAckMessage),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckSendStandaloneAckMessage", CheckSendStandaloneAckMessage),
     NL_TEST_DEF("Test command, response, default response, with receiver closing exchange after sending response", CheckMessageAfterClosed),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckRetransDeadlines", CheckRetransDeadlines),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckRetransmitTimeout", CheckRetransmitTimeout),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckRoundTripTimeSamples", CheckRoundTripTimeSamples),
 
     NL_TEST_SENTINEL()
 };
@@ -1168,6 +1368,7 @@ const nlTest sTests[] =
 
 int Initialize(void * aContext);
 int Finalize(void * aContext);
+int InitializeTest(void * aContext);
 
 // clang-format off
 nlTestSuite sSuite =
@@ -1175,7 +1376,9 @@ nlTestSuite sSuite =
     "Test-CHIP-ReliableMessageProtocol",
     &sTests[0],
     Initialize,
-    Finalize
+    Finalize,
+    InitializeTest,
+    nullptr
 };
 // clang-format on
 
@@ -1201,6 +1404,25 @@ int Initialize(void * aContext)
     return SUCCESS;
 }
 
+/**
+ *  Start each test without a round trip time estimate, so that retransmissions follow the
+ *  intervals the test configures.
+ */
+int InitializeTest(void * aContext)
+{
+    auto * ctx = reinterpret_cast<TestContext *>(aContext);
+
+    for (SecureSessionHandle session : { ctx->GetSessionLocalToPeer(), ctx->GetSessionPeerToLocal() })
+    {
+        PeerConnectionState * state = ctx->GetSecureSessionManager().GetPeerConnectionState(session);
+        if (state != nullptr)
+        {
+            state->GetRoundTripTimeEstimator().Reset();
+        }
+    }
+    return SUCCESS;
+}
+
 /**
  *  Finalize the test suite.
  */
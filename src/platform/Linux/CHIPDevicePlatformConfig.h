@@ -70,6 +70,52 @@
 #define CHIP_DEVICE_LAYER_BLE_CONN_CFG_TAG 1
 #endif // CHIP_DEVICE_LAYER_BLE_CONN_CFG_TAG
 
+/**
+ * @def CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS
+ *
+ * How long, in milliseconds, the KeyValueStoreManager holds back rewriting its file after a Put() or
+ * Delete(), so that the changes made within that window are committed together. Each change is still
+ * appended to a synced journal before the call returns, and is recovered from it after a crash.
+ * KeyValueStoreManagerImpl::Flush() commits early.
+ *
+ * 0 commits the whole file on every change.
+ */
+#ifndef CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS 0
+#endif // CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+ *
+ * Back the KeyValueStoreManager with the log-structured ChipLinuxLogStore, which keeps values
+ * in binary form, rather than with the INI file. An INI file found at the KVS path is imported on the first
+ * start. Set by the chip_linux_kvs_backend build argument.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE
+ *
+ * The number of bytes of superseded records the log-structured KVS tolerates before it compacts,
+ * regardless of how small the live data is.
+ */
+#ifndef CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE
+#define CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES
+ *
+ * Whether the log-structured KVS syncs each record to disk before Put() or Delete() returns.
+ * When 0, records reach the disk when KeyValueStoreManagerImpl::Flush() is called or the
+ * system writes them back.
+ */
+#ifndef CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES
+#define CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES 1
+#endif // CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
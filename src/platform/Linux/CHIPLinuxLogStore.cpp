@@ -0,0 +1,485 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements the log-structured key-value store for Linux.
+ *
+ *         The file starts with an 8-byte magic, followed by records of the form
+ *
+ *             CRC-32 (4) | type (1) | key length (2) | value length (4) | key | value
+ *
+ *         with integers in little-endian order, and the CRC covering everything in the record after it.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <core/CHIPEncoding.h>
+#include <platform/Linux/CHIPLinuxLogStore.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kMagic[8] = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kCrcSize   = 4;
+
+// CRC-32 (IEEE 802.3), a nibble at a time to keep the table small.
+uint32_t Crc32(const uint8_t * data, size_t len)
+{
+    static constexpr uint32_t kTable[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = kTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = kTable[(crc ^ (static_cast<uint32_t>(data[i]) >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t len)
+{
+    while (len > 0)
+    {
+        const ssize_t written = write(fd, data, len);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(written > 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        data += written;
+        len -= static_cast<size_t>(written);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// A rename is only durable once the directory holding the file is synced.
+CHIP_ERROR SyncDirectoryOf(const std::string & path)
+{
+    const size_t slash    = path.find_last_of('/');
+    const std::string dir = (slash == std::string::npos) ? "." : path.substr(0, (slash == 0) ? 1 : slash);
+
+    const int fd = open(dir.c_str(), O_RDONLY | O_CLOEXEC);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+    const int res = fsync(fd);
+    close(fd);
+    VerifyOrReturnError(res == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+ChipLinuxLogStore::ChipLinuxLogStore()
+{
+    mFd       = -1;
+    mLogSize  = 0;
+    mLiveSize = 0;
+}
+
+ChipLinuxLogStore::~ChipLinuxLogStore()
+{
+    if (mFd >= 0)
+    {
+        close(mFd);
+    }
+}
+
+CHIP_ERROR ChipLinuxLogStore::Init(const char * path)
+{
+    VerifyOrReturnError(path != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+    mEntries.clear();
+    mPath.assign(path);
+
+    CHIP_ERROR err = Load();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "failed to load KVS log (%s): %s", mPath.c_str(), ErrorStr(err));
+        if (mFd >= 0)
+        {
+            close(mFd);
+            mFd = -1;
+        }
+        mEntries.clear();
+    }
+    return err;
+}
+
+/**
+ * Build the index from the file, dropping whatever follows the last intact record, or import the file if it is
+ * not a log.
+ */
+CHIP_ERROR ChipLinuxLogStore::Load()
+{
+    mFd = open(mPath.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (mFd < 0)
+    {
+        ChipLogError(DeviceLayer, "failed to open KVS log (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+
+    struct stat st;
+    VerifyOrReturnError(fstat(mFd, &st) == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+
+    mLiveSize = sizeof(kMagic);
+    mLogSize  = sizeof(kMagic);
+
+    if (fileSize < sizeof(kMagic))
+    {
+        // A new file, or one whose creation was interrupted.
+        VerifyOrReturnError(ftruncate(mFd, 0) == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        ReturnErrorOnFailure(WriteAll(mFd, kMagic, sizeof(kMagic)));
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        return CHIP_NO_ERROR;
+    }
+
+    void * const map = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+    VerifyOrReturnError(map != MAP_FAILED, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    const uint8_t * const data = static_cast<const uint8_t *>(map);
+
+    if (memcmp(data, kMagic, sizeof(kMagic)) != 0)
+    {
+        // Not a log, so the file is taken to be the INI file of the store this one replaces.
+        munmap(map, fileSize);
+        return ImportIniFile();
+    }
+
+    size_t pos     = sizeof(kMagic);
+    size_t skipped = 0;
+    while (fileSize - pos >= kRecordHeaderSize)
+    {
+        const uint8_t * p         = data + pos;
+        const uint32_t crc        = Encoding::LittleEndian::Get32(p);
+        const uint8_t type        = p[kCrcSize];
+        const uint16_t keyLen     = Encoding::LittleEndian::Get16(p + kCrcSize + 1);
+        const uint32_t valueLen   = Encoding::LittleEndian::Get32(p + kCrcSize + 3);
+        const size_t recordSize   = RecordSize(keyLen, valueLen);
+        const uint8_t * const key = p + kRecordHeaderSize;
+
+        if (recordSize > fileSize - pos || Crc32(p + kCrcSize, recordSize - kCrcSize) != crc || keyLen == 0)
+        {
+            break;
+        }
+
+        pos += recordSize;
+
+        // An intact record of a type this version does not know takes no part in the index, and later records
+        // still apply.
+        if (type != static_cast<uint8_t>(RecordType::kPut) && type != static_cast<uint8_t>(RecordType::kDelete))
+        {
+            skipped++;
+            continue;
+        }
+
+        std::string keyStr(reinterpret_cast<const char *>(key), keyLen);
+        auto existing = mEntries.find(keyStr);
+        if (existing != mEntries.end())
+        {
+            mLiveSize -= RecordSize(keyLen, existing->second.size());
+        }
+
+        if (type == static_cast<uint8_t>(RecordType::kPut))
+        {
+            mEntries[keyStr].assign(key + keyLen, key + keyLen + valueLen);
+            mLiveSize += recordSize;
+        }
+        else if (existing != mEntries.end())
+        {
+            mEntries.erase(existing);
+        }
+    }
+
+    munmap(map, fileSize);
+    mLogSize = pos;
+
+    if (skipped > 0)
+    {
+        ChipLogProgress(DeviceLayer, "skipped %u KVS log records of unknown type", static_cast<unsigned>(skipped));
+    }
+
+    if (pos != fileSize)
+    {
+        ChipLogProgress(DeviceLayer, "discarding %u bytes after the last intact record of the KVS log",
+                        static_cast<unsigned>(fileSize - pos));
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(pos)) == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    }
+
+    CompactIfNeeded();
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * Move the entries of the INI file at mPath, written by ChipLinuxStorage, into a new log that replaces it. The INI
+ * file is only replaced once all of its entries have been read, so a failed import leaves it for the next Init().
+ */
+CHIP_ERROR ChipLinuxLogStore::ImportIniFile()
+{
+    ChipLinuxStorage ini;
+    std::vector<std::string> keys;
+
+    // Init() also applies any journal that the INI store left behind.
+    ReturnErrorOnFailure(ini.Init(mPath.c_str()));
+    ReturnErrorOnFailure(ini.GetKeys(keys));
+
+    for (const std::string & key : keys)
+    {
+        size_t valueLen = 0;
+        CHIP_ERROR err  = ini.ReadValueBin(key.c_str(), nullptr, 0, valueLen);
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_BUFFER_TOO_SMALL, err);
+
+        std::vector<uint8_t> & value = mEntries[key];
+        value.resize(valueLen);
+        ReturnErrorOnFailure(ini.ReadValueBin(key.c_str(), value.data(), value.size(), valueLen));
+        value.resize(valueLen);
+    }
+
+    ChipLogProgress(DeviceLayer, "importing %u entries of the INI KVS file (%s)", static_cast<unsigned>(mEntries.size()),
+                    mPath.c_str());
+
+    return CompactLocked();
+}
+
+CHIP_ERROR ChipLinuxLogStore::Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || value_size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_WELL_UNINITIALIZED);
+
+    auto entry = mEntries.find(key);
+    VerifyOrReturnError(entry != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const std::vector<uint8_t> & stored = entry->second;
+    VerifyOrReturnError(offset <= stored.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t copySize = std::min(value_size, stored.size() - offset);
+    if (copySize > 0)
+    {
+        memcpy(value, stored.data() + offset, copySize);
+    }
+    if (read_bytes_size != nullptr)
+    {
+        *read_bytes_size = copySize;
+    }
+
+    return (copySize < stored.size() - offset) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStore::Put(const char * key, const void * value, size_t value_size)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || value_size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const std::string keyStr(key);
+    VerifyOrReturnError(!keyStr.empty() && keyStr.size() <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value_size <= UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint8_t * const bytes = static_cast<const uint8_t *>(value);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_WELL_UNINITIALIZED);
+
+    ReturnErrorOnFailure(Append(RecordType::kPut, keyStr, bytes, value_size));
+
+    auto entry = mEntries.find(keyStr);
+    if (entry == mEntries.end())
+    {
+        entry = mEntries.emplace(keyStr, std::vector<uint8_t>()).first;
+    }
+    else
+    {
+        mLiveSize -= RecordSize(keyStr.size(), entry->second.size());
+    }
+    mLiveSize += RecordSize(keyStr.size(), value_size);
+    entry->second.assign(bytes, bytes + value_size);
+
+    CompactIfNeeded();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStore::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_WELL_UNINITIALIZED);
+
+    auto entry = mEntries.find(key);
+    VerifyOrReturnError(entry != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    ReturnErrorOnFailure(Append(RecordType::kDelete, entry->first, nullptr, 0));
+
+    mLiveSize -= RecordSize(entry->first.size(), entry->second.size());
+    mEntries.erase(entry);
+
+    CompactIfNeeded();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStore::Sync()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_WELL_UNINITIALIZED);
+    VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStore::Compact()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_WELL_UNINITIALIZED);
+
+    return CompactLocked();
+}
+
+void ChipLinuxLogStore::EncodeRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value,
+                                     size_t valueLen)
+{
+    const size_t start = out.size();
+    out.resize(start + RecordSize(key.size(), valueLen));
+
+    uint8_t * p = out.data() + start;
+    p[kCrcSize] = static_cast<uint8_t>(type);
+    Encoding::LittleEndian::Put16(p + kCrcSize + 1, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(p + kCrcSize + 3, static_cast<uint32_t>(valueLen));
+    memcpy(p + kRecordHeaderSize, key.data(), key.size());
+    if (valueLen > 0)
+    {
+        memcpy(p + kRecordHeaderSize + key.size(), value, valueLen);
+    }
+    Encoding::LittleEndian::Put32(p, Crc32(p + kCrcSize, out.size() - start - kCrcSize));
+}
+
+CHIP_ERROR ChipLinuxLogStore::Append(RecordType type, const std::string & key, const uint8_t * value, size_t valueLen)
+{
+    std::vector<uint8_t> record;
+    EncodeRecord(record, type, key, value, valueLen);
+
+    CHIP_ERROR err = WriteAll(mFd, record.data(), record.size());
+#if CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES
+    if (err == CHIP_NO_ERROR && fdatasync(mFd) != 0)
+    {
+        err = CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+#endif // CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "failed to append to KVS log (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+        // Drop any partial record, so that later appends are not hidden behind it on the next load.
+        IgnoreUnusedVariable(ftruncate(mFd, static_cast<off_t>(mLogSize)));
+        return err;
+    }
+
+    mLogSize += record.size();
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxLogStore::CompactIfNeeded()
+{
+    const size_t garbage = mLogSize - mLiveSize;
+    if (garbage < std::max(mLiveSize, static_cast<size_t>(CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE)))
+    {
+        return;
+    }
+
+    // The log itself is intact, so a failed compaction is retried after the next change.
+    CHIP_ERROR err = CompactLocked();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "KVS log compaction failed: %s", ErrorStr(err));
+    }
+}
+
+/**
+ * Write the live entries to a new file and rename it over the log. The new file is opened before the rename, so the
+ * store never ends up without a file to append to.
+ */
+CHIP_ERROR ChipLinuxLogStore::CompactLocked()
+{
+    std::vector<uint8_t> image(kMagic, kMagic + sizeof(kMagic));
+    image.reserve(mLiveSize);
+    for (const auto & entry : mEntries)
+    {
+        EncodeRecord(image, RecordType::kPut, entry.first, entry.second.data(), entry.second.size());
+    }
+
+    const std::string tmpPath = mPath + ".tmp";
+    const int fd              = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+    CHIP_ERROR err = WriteAll(fd, image.data(), image.size());
+    if (err == CHIP_NO_ERROR && (fsync(fd) != 0 || rename(tmpPath.c_str(), mPath.c_str()) != 0))
+    {
+        err = CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    close(mFd);
+    mFd       = fd;
+    mLogSize  = image.size();
+    mLiveSize = image.size();
+
+    return SyncDirectoryOf(mPath);
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a log-structured key-value store with binary values for Linux.
+ *
+ *         Every Put() and Delete() appends one checksummed record to a single file, so a write costs one
+ *         append regardless of the size of the store. The file is read once, through mmap, by Init(), which
+ *         builds the in-memory index that serves all reads. Once superseded records make up more than half of
+ *         the file, and at least CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE bytes, the live entries are
+ *         rewritten to a new file that replaces the old one.
+ *
+ *         A record that was only partly written when the process stopped fails its checksum and is dropped,
+ *         together with anything after it, by the next Init(). Intact records of an unknown type are skipped.
+ *
+ *         Init() imports a file left at the path by ChipLinuxStorage, the INI store this one replaces, into a
+ *         new log, so that a device keeps its data when it switches stores.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxLogStore
+{
+public:
+    ChipLinuxLogStore();
+    ~ChipLinuxLogStore();
+
+    CHIP_ERROR Init(const char * path);
+
+    CHIP_ERROR Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
+    CHIP_ERROR Put(const char * key, const void * value, size_t value_size);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Ensure that all appended records have reached the disk. Only needed when
+     * CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES is 0.
+     */
+    CHIP_ERROR Sync();
+
+    /**
+     * Rewrite the file with only the live entries, regardless of how much of it is garbage.
+     */
+    CHIP_ERROR Compact();
+
+    /** Size in bytes of the log file. */
+    size_t GetLogSize() const { return mLogSize; }
+
+private:
+    enum class RecordType : uint8_t
+    {
+        kPut    = 1,
+        kDelete = 2,
+    };
+
+    static constexpr size_t kRecordHeaderSize = 11; ///< CRC-32, type, key length (16 bits) and value length (32 bits).
+
+    static size_t RecordSize(size_t keyLen, size_t valueLen) { return kRecordHeaderSize + keyLen + valueLen; }
+    static void EncodeRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value,
+                             size_t valueLen);
+
+    CHIP_ERROR Load();
+    CHIP_ERROR ImportIniFile();
+    CHIP_ERROR Append(RecordType type, const std::string & key, const uint8_t * value, size_t valueLen);
+    CHIP_ERROR CompactLocked();
+    void CompactIfNeeded();
+
+    std::mutex mLock;
+    std::unordered_map<std::string, std::vector<uint8_t>> mEntries;
+    std::string mPath;
+    int mFd;          ///< The log file, opened for appending; -1 until Init() succeeds.
+    size_t mLogSize;  ///< Size of the log file.
+    size_t mLiveSize; ///< Size the log file would have if it held only the records of mEntries.
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
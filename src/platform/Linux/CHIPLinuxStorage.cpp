@@ -24,9 +24,12 @@
  */
 
 #include <errno.h>
+#include <fcntl.h>
 #include <fstream>
 #include <inttypes.h>
+#include <iterator>
 #include <libgen.h>
+#include <string.h>
 #include <string>
 #include <unistd.h>
 
@@ -44,17 +47,25 @@ namespace Internal {
 
 ChipLinuxStorage::ChipLinuxStorage()
 {
-    mDirty = false;
+    mDirty     = false;
+    mJournalFd = -1;
 }
 
-ChipLinuxStorage::~ChipLinuxStorage() {}
+ChipLinuxStorage::~ChipLinuxStorage()
+{
+    if (mJournalFd >= 0)
+    {
+        close(mJournalFd);
+    }
+}
 
 CHIP_ERROR ChipLinuxStorage::Init(const char * configFile)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
     mConfigPath.assign(configFile);
-    retval = ChipLinuxStorageIni::Init();
+    mJournalPath = mConfigPath + ".journal";
+    retval       = ChipLinuxStorageIni::Init();
 
     if (retval == CHIP_NO_ERROR)
     {
@@ -76,9 +87,177 @@ CHIP_ERROR ChipLinuxStorage::Init(const char * configFile)
         retval = ChipLinuxStorageIni::AddConfig(mConfigPath);
     }
 
+    if (retval == CHIP_NO_ERROR)
+    {
+        retval = ReplayJournal();
+    }
+
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorage::EnableJournal()
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    VerifyOrReturnError(!mJournalPath.empty(), CHIP_ERROR_INCORRECT_STATE);
+
+    mLock.lock();
+
+    if (mJournalFd < 0)
+    {
+        mJournalFd = open(mJournalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if (mJournalFd < 0)
+        {
+            ChipLogError(DeviceLayer, "failed to open journal (%s), %s (%d)", mJournalPath.c_str(), strerror(errno), errno);
+            retval = CHIP_ERROR_OPEN_FAILED;
+        }
+    }
+
+    mLock.unlock();
+
+    return retval;
+}
+
+/**
+ * Append a record of a write (val != nullptr) or removal (val == nullptr) to the journal, if enabled, and sync it.
+ *
+ * Records are "+key=value\n" and "-key\n". A record that could not be written completely is cut off again, so that
+ * it cannot run into the next one; one left incomplete by a crash lacks its newline and is ignored on replay.
+ */
+CHIP_ERROR ChipLinuxStorage::AppendToJournal(const char * key, const char * val)
+{
+    if (mJournalFd < 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    VerifyOrReturnError(strpbrk(key, "=\n") == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(val == nullptr || strchr(val, '\n') == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::string record(1, (val != nullptr) ? '+' : '-');
+    record.append(key);
+    if (val != nullptr)
+    {
+        record.append(1, '=');
+        record.append(val);
+    }
+    record.append(1, '\n');
+
+    const off_t start = lseek(mJournalFd, 0, SEEK_END);
+    const char * data = record.data();
+    size_t remaining  = record.size();
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    while (remaining > 0 && retval == CHIP_NO_ERROR)
+    {
+        const ssize_t written = write(mJournalFd, data, remaining);
+        if (written > 0)
+        {
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        else if (written < 0 && errno != EINTR)
+        {
+            retval = CHIP_ERROR_WRITE_FAILED;
+        }
+    }
+
+    if (retval == CHIP_NO_ERROR && fdatasync(mJournalFd) != 0)
+    {
+        retval = CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (retval != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "failed to append to journal (%s), %s (%d)", mJournalPath.c_str(), strerror(errno), errno);
+        if (start >= 0)
+        {
+            IgnoreUnusedVariable(ftruncate(mJournalFd, start));
+        }
+    }
+
     return retval;
 }
 
+/**
+ * Apply the records of a journal left behind by an earlier run, then commit them and remove the journal.
+ */
+CHIP_ERROR ChipLinuxStorage::ReplayJournal()
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    std::ifstream ifs;
+    size_t replayed = 0;
+
+    ifs.open(mJournalPath, std::ifstream::in | std::ifstream::binary);
+    if (!ifs.good())
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    const std::string journal((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ifs.close();
+
+    for (size_t start = 0, end; (end = journal.find('\n', start)) != std::string::npos; start = end + 1)
+    {
+        const std::string record = journal.substr(start, end - start);
+        const size_t separator   = record.find('=');
+
+        if (record.size() > 1 && record[0] == '+' && separator != std::string::npos)
+        {
+            ChipLinuxStorageIni::AddEntry(record.substr(1, separator - 1).c_str(), record.substr(separator + 1).c_str());
+            replayed++;
+        }
+        else if (record.size() > 1 && record[0] == '-')
+        {
+            // The key may never have reached the config file, so a failure to remove it is expected.
+            ChipLinuxStorageIni::RemoveEntry(record.c_str() + 1);
+            replayed++;
+        }
+    }
+
+    if (replayed > 0)
+    {
+        ChipLogProgress(DeviceLayer, "replaying %u journal records into (%s)", static_cast<unsigned>(replayed),
+                        mConfigPath.c_str());
+
+        mDirty = true;
+        retval = ChipLinuxStorageIni::CommitConfig(mConfigPath);
+        if (retval == CHIP_NO_ERROR)
+        {
+            retval = SyncConfig();
+        }
+    }
+
+    if (retval == CHIP_NO_ERROR)
+    {
+        unlink(mJournalPath.c_str());
+    }
+
+    return retval;
+}
+
+/**
+ * CommitConfig() replaces the config file by renaming a new one over it, so both the file and the directory entry must
+ * reach the disk before the journal records they supersede are dropped.
+ */
+CHIP_ERROR ChipLinuxStorage::SyncConfig()
+{
+    const size_t slash    = mConfigPath.find_last_of('/');
+    const std::string dir = (slash == std::string::npos) ? "." : mConfigPath.substr(0, (slash == 0) ? 1 : slash);
+
+    for (const std::string & path : { mConfigPath, dir })
+    {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        VerifyOrReturnError(fd >= 0, CHIP_ERROR_WRITE_FAILED);
+
+        const int res = fsync(fd);
+        close(fd);
+        VerifyOrReturnError(res == 0, CHIP_ERROR_WRITE_FAILED);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR ChipLinuxStorage::ReadValue(const char * key, bool & val)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -186,9 +365,14 @@ CHIP_ERROR ChipLinuxStorage::WriteValueStr(const char * key, const char * val)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::AddEntry(key, val);
+    retval = AppendToJournal(key, val);
 
-    mDirty = true;
+    if (retval == CHIP_NO_ERROR)
+    {
+        retval = ChipLinuxStorageIni::AddEntry(key, val);
+
+        mDirty = true;
+    }
 
     mLock.unlock();
 
@@ -232,7 +416,7 @@ CHIP_ERROR ChipLinuxStorage::WriteValueBin(const char * key, const uint8_t * dat
     // Store it
     if (retval == CHIP_NO_ERROR)
     {
-        WriteValueStr(key, encodedData.Get());
+        retval = WriteValueStr(key, encodedData.Get());
     }
 
     return retval;
@@ -244,15 +428,27 @@ CHIP_ERROR ChipLinuxStorage::ClearValue(const char * key)
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::RemoveEntry(key);
-
-    if (retval == CHIP_NO_ERROR)
+    if (!ChipLinuxStorageIni::HasValue(key))
     {
-        mDirty = true;
+        retval = CHIP_ERROR_KEY_NOT_FOUND;
     }
     else
     {
-        retval = CHIP_ERROR_KEY_NOT_FOUND;
+        retval = AppendToJournal(key, nullptr);
+    }
+
+    if (retval == CHIP_NO_ERROR)
+    {
+        retval = ChipLinuxStorageIni::RemoveEntry(key);
+
+        if (retval == CHIP_NO_ERROR)
+        {
+            mDirty = true;
+        }
+        else
+        {
+            retval = CHIP_ERROR_KEY_NOT_FOUND;
+        }
     }
 
     mLock.unlock();
@@ -296,6 +492,19 @@ bool ChipLinuxStorage::HasValue(const char * key)
     return retval;
 }
 
+CHIP_ERROR ChipLinuxStorage::GetKeys(std::vector<std::string> & keys)
+{
+    CHIP_ERROR retval;
+
+    mLock.lock();
+
+    retval = ChipLinuxStorageIni::GetKeys(keys);
+
+    mLock.unlock();
+
+    return retval;
+}
+
 CHIP_ERROR ChipLinuxStorage::Commit()
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -306,6 +515,16 @@ CHIP_ERROR ChipLinuxStorage::Commit()
 
         retval = ChipLinuxStorageIni::CommitConfig(mConfigPath);
 
+        // Everything in the journal is now in the config file.
+        if (retval == CHIP_NO_ERROR && mJournalFd >= 0)
+        {
+            retval = SyncConfig();
+            if (retval == CHIP_NO_ERROR && (ftruncate(mJournalFd, 0) != 0 || fdatasync(mJournalFd) != 0))
+            {
+                retval = CHIP_ERROR_WRITE_FAILED;
+            }
+        }
+
         mLock.unlock();
     }
     else
@@ -83,11 +83,26 @@ public:
     CHIP_ERROR ClearAll();
     CHIP_ERROR Commit();
     bool HasValue(const char * key);
+    CHIP_ERROR GetKeys(std::vector<std::string> & keys);
+
+    /**
+     * Record every subsequent write and removal in an append-only journal next to the config file, synced before
+     * the call returns, so that changes survive a crash without waiting for Commit() to rewrite the whole file.
+     * Commit() empties the journal; Init() replays any journal left behind by an earlier run.
+     */
+    CHIP_ERROR EnableJournal();
+    bool IsJournalEnabled() const { return mJournalFd >= 0; }
 
 private:
+    CHIP_ERROR AppendToJournal(const char * key, const char * val);
+    CHIP_ERROR ReplayJournal();
+    CHIP_ERROR SyncConfig();
+
     std::mutex mLock;
     bool mDirty;
     std::string mConfigPath;
+    std::string mJournalPath;
+    int mJournalFd;
 };
 
 } // namespace Internal
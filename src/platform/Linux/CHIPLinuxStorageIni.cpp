@@ -316,6 +316,21 @@ bool ChipLinuxStorageIni::HasValue(const char * key)
     return it != section.end();
 }
 
+CHIP_ERROR ChipLinuxStorageIni::GetKeys(std::vector<std::string> & keys)
+{
+    std::map<std::string, std::string> section;
+
+    ReturnErrorOnFailure(GetDefaultSection(section));
+
+    keys.clear();
+    for (const auto & entry : section)
+    {
+        keys.push_back(entry.first);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR ChipLinuxStorageIni::AddEntry(const char * key, const char * value)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -38,5 +38,13 @@
 #define INET_CONFIG_NUM_UDP_ENDPOINTS 32
 #endif // INET_CONFIG_NUM_UDP_ENDPOINTS
 
+#ifndef INET_CONFIG_UDP_IO_BATCH_SIZE
+#define INET_CONFIG_UDP_IO_BATCH_SIZE 8
+#endif // INET_CONFIG_UDP_IO_BATCH_SIZE
+
 // On linux platform, we have sys/socket.h, so HAVE_SO_BINDTODEVICE should be set to 1
 #define HAVE_SO_BINDTODEVICE 1
+
+// glibc provides recvmmsg() and sendmmsg(), used when INET_CONFIG_UDP_IO_BATCH_SIZE is greater than 1.
+#define HAVE_RECVMMSG 1
+#define HAVE_SENDMMSG 1
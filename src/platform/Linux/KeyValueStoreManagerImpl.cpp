@@ -26,7 +26,7 @@
 #include <algorithm>
 #include <string.h>
 
-#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/CHIPDeviceLayer.h>
 #include <support/CodeUtils.h>
 #include <support/logging/CHIPLogging.h>
 
@@ -36,6 +36,46 @@ namespace PersistedStorage {
 
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
+void KeyValueStoreManagerImpl::Init(const char * file)
+{
+    mStorage.Init(file);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
+                                          size_t offset_bytes)
+{
+    return mStorage.Get(key, value, value_size, read_bytes_size, offset_bytes);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
+{
+    return mStorage.Put(key, value, value_size);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
+{
+    return mStorage.Delete(key);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::Flush()
+{
+    return mStorage.Sync();
+}
+
+#else // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
+void KeyValueStoreManagerImpl::Init(const char * file)
+{
+    mStorage.Init(file);
+
+    if (mWriteBackIntervalMs > 0 && mStorage.EnableJournal() != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "KVS journal unavailable, committing every change");
+    }
+}
+
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
@@ -78,7 +118,7 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = mStorage.Commit();
+    err = Commit();
     SuccessOrExit(err);
 
 exit:
@@ -97,13 +137,71 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = mStorage.Commit();
+    err = Commit();
     SuccessOrExit(err);
 
 exit:
     return err;
 }
 
+CHIP_ERROR KeyValueStoreManagerImpl::Flush()
+{
+    VerifyOrReturnError(mCommitPending, CHIP_NO_ERROR);
+
+    SystemLayer.CancelTimer(HandleCommitTimer, this);
+    mCommitPending = false;
+
+    return mStorage.Commit();
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::SetWriteBackInterval(uint32_t aIntervalMs)
+{
+    ReturnErrorOnFailure(Flush());
+
+    mWriteBackIntervalMs = aIntervalMs;
+
+    // Without the journal, Commit() keeps committing every change right away.
+    return (aIntervalMs > 0) ? mStorage.EnableJournal() : CHIP_NO_ERROR;
+}
+
+/**
+ * Commit the store file now, or, in write-back mode, once the write-back interval has passed since the first change
+ * not yet committed.
+ */
+CHIP_ERROR KeyValueStoreManagerImpl::Commit()
+{
+    if (mCommitPending)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    // Without a running System Layer, or if the journal could not be opened, fall back to committing right away.
+    if (mWriteBackIntervalMs > 0 && mStorage.IsJournalEnabled() &&
+        SystemLayer.StartTimer(mWriteBackIntervalMs, HandleCommitTimer, this) == CHIP_NO_ERROR)
+    {
+        mCommitPending = true;
+        return CHIP_NO_ERROR;
+    }
+
+    return mStorage.Commit();
+}
+
+void KeyValueStoreManagerImpl::HandleCommitTimer(System::Layer * aLayer, void * aAppState, CHIP_ERROR aError)
+{
+    KeyValueStoreManagerImpl * const self = static_cast<KeyValueStoreManagerImpl *>(aAppState);
+
+    self->mCommitPending = false;
+
+    // The changes remain in the journal if this fails, and the next change schedules another attempt.
+    CHIP_ERROR err = self->mStorage.Commit();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "KVS write-back commit failed: %s", ErrorStr(err));
+    }
+}
+
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -23,7 +23,13 @@
 
 #pragma once
 
+#include <platform/CHIPDeviceConfig.h>
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+#include <platform/Linux/CHIPLinuxLogStore.h>
+#else
 #include <platform/Linux/CHIPLinuxStorage.h>
+#endif
+#include <system/SystemLayer.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -36,14 +42,39 @@ public:
      * @brief
      * Initalize the KVS, must be called before using.
      */
-    void Init(const char * file) { mStorage.Init(file); }
+    void Init(const char * file);
 
     CHIP_ERROR _Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
+    /**
+     * @brief
+     * Commit any changes still held back by CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS, or, with the log store,
+     * not yet synced because of CHIP_DEVICE_CONFIG_KVS_LOG_SYNC_WRITES, to the store file now.
+     */
+    CHIP_ERROR Flush();
+
+#if !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+    /**
+     * @brief
+     * Change the write-back interval, CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS by default. Changes still held back
+     * are committed first; with an interval of 0, every change is committed right away.
+     */
+    CHIP_ERROR SetWriteBackInterval(uint32_t aIntervalMs);
+#endif // !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
 private:
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+    DeviceLayer::Internal::ChipLinuxLogStore mStorage;
+#else
+    CHIP_ERROR Commit();
+    static void HandleCommitTimer(System::Layer * aLayer, void * aAppState, CHIP_ERROR aError);
+
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+    uint32_t mWriteBackIntervalMs = CHIP_DEVICE_CONFIG_KVS_WRITE_BACK_INTERVAL_MS;
+    bool mCommitPending           = false;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
@@ -0,0 +1,311 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the Linux
+ *      log-structured key-value store.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxLogStore.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+char sPath[] = "/tmp/chip-kvs-log-XXXXXX";
+
+off_t FileSize()
+{
+    struct stat st;
+    return (stat(sPath, &st) == 0) ? st.st_size : -1;
+}
+
+void TestLogStore_PutGetDelete(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxLogStore store;
+    NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+
+    const uint8_t value[] = { 0x00, 0x01, 0xff, 0x00, 0x7f };
+    uint8_t buf[sizeof(value)];
+    size_t readSize = 0;
+
+    NL_TEST_ASSERT(inSuite, store.Get("key", buf, sizeof(buf)) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, store.Put("key", value, sizeof(value)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("key", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && memcmp(buf, value, sizeof(value)) == 0);
+
+    // Partial and offset reads.
+    NL_TEST_ASSERT(inSuite, store.Get("key", buf, 2, &readSize) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, readSize == 2 && memcmp(buf, value, 2) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("key", buf, sizeof(buf), &readSize, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 2 && memcmp(buf, value + 3, 2) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("key", buf, sizeof(buf), &readSize, sizeof(value) + 1) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Empty values are distinct from missing ones.
+    NL_TEST_ASSERT(inSuite, store.Put("empty", nullptr, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("empty", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 0);
+
+    NL_TEST_ASSERT(inSuite, store.Delete("key") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Delete("key") == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, store.Get("key", buf, sizeof(buf)) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+void TestLogStore_Reload(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t value = 0;
+    size_t readSize;
+
+    {
+        ChipLinuxLogStore store;
+        NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+        for (uint32_t i = 1; i <= 10; i++)
+        {
+            NL_TEST_ASSERT(inSuite, store.Put("counter", &i, sizeof(i)) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, store.Put("gone", &value, sizeof(value)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, store.Delete("gone") == CHIP_NO_ERROR);
+    }
+
+    ChipLinuxLogStore store;
+    NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("counter", &value, sizeof(value), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && value == 10);
+    NL_TEST_ASSERT(inSuite, store.Get("gone", &value, sizeof(value)) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+void TestLogStore_TornRecord(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t first  = 1;
+    const uint32_t second = 2;
+    off_t intactSize;
+
+    {
+        ChipLinuxLogStore store;
+        NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, store.Put("torn", &first, sizeof(first)) == CHIP_NO_ERROR);
+        intactSize = FileSize();
+        NL_TEST_ASSERT(inSuite, store.Put("torn", &second, sizeof(second)) == CHIP_NO_ERROR);
+    }
+
+    // Cut the last record short, as a crash in the middle of the append would.
+    NL_TEST_ASSERT(inSuite, truncate(sPath, FileSize() - 1) == 0);
+
+    uint32_t value = 0;
+    ChipLinuxLogStore store;
+    NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, FileSize() == intactSize);
+    NL_TEST_ASSERT(inSuite, store.Get("torn", &value, sizeof(value)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value == first);
+
+    // Later appends land after the last intact record and survive a reload.
+    NL_TEST_ASSERT(inSuite, store.Put("torn", &second, sizeof(second)) == CHIP_NO_ERROR);
+    ChipLinuxLogStore reloaded;
+    NL_TEST_ASSERT(inSuite, reloaded.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reloaded.Get("torn", &value, sizeof(value)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value == second);
+}
+
+// Append a record that is intact but of a type unknown to the store, as a later version could write.
+void AppendUnknownRecord()
+{
+    uint8_t record[] = { 0, 0, 0, 0, 0x7f, 3, 0, 1, 0, 0, 0, 'n', 'e', 'w', 0xaa };
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 4; i < sizeof(record); i++)
+    {
+        crc ^= record[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < 4; i++)
+    {
+        record[i] = static_cast<uint8_t>(crc >> (8 * i));
+    }
+
+    FILE * file = fopen(sPath, "ab");
+    VerifyOrReturn(file != nullptr);
+    fwrite(record, 1, sizeof(record), file);
+    fclose(file);
+}
+
+void TestLogStore_UnknownRecord(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t first  = 1;
+    const uint32_t second = 2;
+
+    {
+        ChipLinuxLogStore store;
+        NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, store.Put("before", &first, sizeof(first)) == CHIP_NO_ERROR);
+    }
+    AppendUnknownRecord();
+    const off_t unknownSize = FileSize();
+
+    // The unknown record is kept, and the records on either side of it still apply.
+    {
+        ChipLinuxLogStore store;
+        NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, FileSize() == unknownSize);
+        NL_TEST_ASSERT(inSuite, store.Put("after", &second, sizeof(second)) == CHIP_NO_ERROR);
+    }
+
+    uint32_t value = 0;
+    ChipLinuxLogStore store;
+    NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("before", &value, sizeof(value)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value == first);
+    NL_TEST_ASSERT(inSuite, store.Get("after", &value, sizeof(value)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value == second);
+    NL_TEST_ASSERT(inSuite, store.Get("new", &value, sizeof(value)) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+void TestLogStore_ImportIni(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t fabric[]  = { 0x00, 0x15, 0x30, 0x01, 0xff };
+    const uint8_t counter[] = { 0x2a, 0x00, 0x00, 0x00 };
+    const std::string journalPath = std::string(sPath) + ".journal";
+
+    {
+        ChipLinuxStorage ini;
+        NL_TEST_ASSERT(inSuite, ini.Init(sPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("fabric", fabric, sizeof(fabric)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+
+        // A change that only reached the journal is imported as well.
+        NL_TEST_ASSERT(inSuite, ini.EnableJournal() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("counter", counter, sizeof(counter)) == CHIP_NO_ERROR);
+    }
+
+    uint8_t value[8];
+    size_t readSize = 0;
+    {
+        ChipLinuxLogStore store;
+        NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, store.Get("fabric", value, sizeof(value), &readSize) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == sizeof(fabric) && memcmp(value, fabric, sizeof(fabric)) == 0);
+        NL_TEST_ASSERT(inSuite, store.Get("counter", value, sizeof(value), &readSize) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == sizeof(counter) && memcmp(value, counter, sizeof(counter)) == 0);
+        NL_TEST_ASSERT(inSuite, static_cast<size_t>(FileSize()) == store.GetLogSize());
+    }
+    NL_TEST_ASSERT(inSuite, access(journalPath.c_str(), F_OK) != 0);
+
+    // The file is now a log, and is not imported again.
+    ChipLinuxLogStore reloaded;
+    NL_TEST_ASSERT(inSuite, reloaded.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reloaded.Get("fabric", value, sizeof(value), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(fabric) && memcmp(value, fabric, sizeof(fabric)) == 0);
+}
+
+void TestLogStore_Compaction(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxLogStore store;
+    NL_TEST_ASSERT(inSuite, store.Init(sPath) == CHIP_NO_ERROR);
+
+    uint8_t block[1024];
+    memset(block, 0xa5, sizeof(block));
+
+    // Overwriting one key keeps the file bounded, rather than growing with every write.
+    for (uint32_t i = 0; i < 4 * CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE / sizeof(block); i++)
+    {
+        memcpy(block, &i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, store.Put("block", block, sizeof(block)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, store.GetLogSize() < 2 * CHIP_DEVICE_CONFIG_KVS_LOG_MIN_COMPACTION_SIZE + 2 * sizeof(block));
+    NL_TEST_ASSERT(inSuite, static_cast<size_t>(FileSize()) == store.GetLogSize());
+
+    NL_TEST_ASSERT(inSuite, store.Compact() == CHIP_NO_ERROR);
+    const size_t compactSize = store.GetLogSize();
+
+    uint8_t value[sizeof(block)];
+    ChipLinuxLogStore reloaded;
+    NL_TEST_ASSERT(inSuite, reloaded.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reloaded.GetLogSize() == compactSize);
+    NL_TEST_ASSERT(inSuite, reloaded.Get("block", value, sizeof(value)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(value, block, sizeof(block)) == 0);
+}
+
+int TestSetup(void * inContext)
+{
+    // The INI store, which the import reads, allocates through the platform memory.
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+
+    const int fd = mkstemp(sPath);
+    VerifyOrReturnError(fd >= 0, FAILURE);
+    close(fd);
+    return SUCCESS;
+}
+
+int TestTeardown(void * inContext)
+{
+    unlink(sPath);
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// Each test starts from an empty file.
+int TestInitialize(void * inContext)
+{
+    return (truncate(sPath, 0) == 0) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Test ChipLinuxLogStore Put/Get/Delete", TestLogStore_PutGetDelete),
+    NL_TEST_DEF("Test ChipLinuxLogStore Reload", TestLogStore_Reload),
+    NL_TEST_DEF("Test ChipLinuxLogStore TornRecord", TestLogStore_TornRecord),
+    NL_TEST_DEF("Test ChipLinuxLogStore UnknownRecord", TestLogStore_UnknownRecord),
+    NL_TEST_DEF("Test ChipLinuxLogStore ImportIni", TestLogStore_ImportIni),
+    NL_TEST_DEF("Test ChipLinuxLogStore Compaction", TestLogStore_Compaction),
+    NL_TEST_SENTINEL()
+};
+
+int TestLinuxLogStore()
+{
+    nlTestSuite theSuite = { "CHIP Linux log store tests", &sTests[0], TestSetup, TestTeardown, TestInitialize, nullptr };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxLogStore)
@@ -0,0 +1,216 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the journal and
+ *      write-back of the Linux INI key-value store.
+ *
+ */
+
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/KeyValueStoreManager.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+char sPath[] = "/tmp/chip-kvs-ini-XXXXXX";
+std::string sJournalPath;
+
+off_t JournalSize()
+{
+    struct stat st;
+    return (stat(sJournalPath.c_str(), &st) == 0) ? st.st_size : -1;
+}
+
+// Whether the config file itself, rather than the journal, holds the key.
+bool IsCommitted(const char * key)
+{
+    std::ifstream ifs(sPath, std::ifstream::in | std::ifstream::binary);
+    const std::string config((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    return config.find(std::string(key) + "=") != std::string::npos;
+}
+
+void TestStorage_JournalReplay(nlTestSuite * inSuite, void * inContext)
+{
+    char buf[16];
+    size_t readSize;
+
+    {
+        ChipLinuxStorage storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("gone", "1") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, storage.EnableJournal() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("kept", "2") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.ClearValue("gone") == CHIP_NO_ERROR);
+
+        // Destroyed without a commit, as by a crash.
+    }
+
+    NL_TEST_ASSERT(inSuite, JournalSize() > 0);
+    NL_TEST_ASSERT(inSuite, IsCommitted("gone") && !IsCommitted("kept"));
+
+    // Cut off in the middle of a record, which must not be applied.
+    FILE * journal = fopen(sJournalPath.c_str(), "a");
+    NL_TEST_ASSERT(inSuite, journal != nullptr);
+    VerifyOrReturn(journal != nullptr);
+    fputs("+torn=3", journal);
+    fclose(journal);
+
+    ChipLinuxStorage storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, JournalSize() < 0);
+    NL_TEST_ASSERT(inSuite, IsCommitted("kept") && !IsCommitted("gone") && !IsCommitted("torn"));
+
+    NL_TEST_ASSERT(inSuite, storage.ReadValueStr("kept", buf, sizeof(buf), readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(buf, "2") == 0);
+    NL_TEST_ASSERT(inSuite, storage.ReadValueStr("gone", buf, sizeof(buf), readSize) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, storage.ReadValueStr("torn", buf, sizeof(buf), readSize) == CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+void TestStorage_CommitEmptiesJournal(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorage storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.EnableJournal() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "1") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, JournalSize() > 0 && !IsCommitted("key"));
+
+    NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, JournalSize() == 0 && IsCommitted("key"));
+}
+
+#if !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
+constexpr uint32_t kWriteBackIntervalMs = 10;
+
+void StopTheLoop(System::Layer * aLayer, void * aAppState, CHIP_ERROR aError)
+{
+    PlatformMgr().StopEventLoopTask();
+}
+
+void TestKeyValueStoreMgr_WriteBackTimer(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t value = 1;
+
+    NL_TEST_ASSERT(inSuite, PlatformMgr().InitChipStack() == CHIP_NO_ERROR);
+
+    PersistedStorage::KeyValueStoreMgrImpl().Init(sPath);
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgrImpl().SetWriteBackInterval(kWriteBackIntervalMs) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgr().Put("timed", value) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, JournalSize() > 0 && !IsCommitted("timed"));
+
+    NL_TEST_ASSERT(inSuite, SystemLayer.StartTimer(10 * kWriteBackIntervalMs, StopTheLoop, nullptr) == CHIP_NO_ERROR);
+    PlatformMgr().RunEventLoop();
+
+    NL_TEST_ASSERT(inSuite, JournalSize() == 0 && IsCommitted("timed"));
+
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgrImpl().SetWriteBackInterval(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PlatformMgr().Shutdown() == CHIP_NO_ERROR);
+}
+
+void TestKeyValueStoreMgr_Flush(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t value = 1;
+
+    NL_TEST_ASSERT(inSuite, PlatformMgr().InitChipStack() == CHIP_NO_ERROR);
+
+    // Long enough that only Flush() can commit the change while the test runs.
+    PersistedStorage::KeyValueStoreMgrImpl().Init(sPath);
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgrImpl().SetWriteBackInterval(60 * 1000) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgr().Put("flushed", value) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !IsCommitted("flushed"));
+
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgrImpl().Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, JournalSize() == 0 && IsCommitted("flushed"));
+
+    NL_TEST_ASSERT(inSuite, PersistedStorage::KeyValueStoreMgrImpl().SetWriteBackInterval(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PlatformMgr().Shutdown() == CHIP_NO_ERROR);
+}
+
+#endif // !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
+int TestSetup(void * inContext)
+{
+    const int fd = mkstemp(sPath);
+    VerifyOrReturnError(fd >= 0, FAILURE);
+    close(fd);
+    sJournalPath = std::string(sPath) + ".journal";
+    return SUCCESS;
+}
+
+int TestTeardown(void * inContext)
+{
+    unlink(sJournalPath.c_str());
+    unlink(sPath);
+    return SUCCESS;
+}
+
+// Each test starts from an empty file and no journal.
+int TestInitialize(void * inContext)
+{
+    unlink(sJournalPath.c_str());
+    return (truncate(sPath, 0) == 0) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Test ChipLinuxStorage JournalReplay", TestStorage_JournalReplay),
+    NL_TEST_DEF("Test ChipLinuxStorage CommitEmptiesJournal", TestStorage_CommitEmptiesJournal),
+#if !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+    NL_TEST_DEF("Test KeyValueStoreMgr WriteBackTimer", TestKeyValueStoreMgr_WriteBackTimer),
+    NL_TEST_DEF("Test KeyValueStoreMgr Flush", TestKeyValueStoreMgr_Flush),
+#endif // !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+    NL_TEST_SENTINEL()
+};
+
+int TestLinuxStorage()
+{
+    nlTestSuite theSuite = { "CHIP Linux storage tests", &sTests[0], TestSetup, TestTeardown, TestInitialize, nullptr };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxStorage)
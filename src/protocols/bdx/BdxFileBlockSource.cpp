@@ -0,0 +1,109 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/bdx/BdxFileBlockSource.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace bdx {
+
+namespace {
+// An empty file cannot be mapped, but a BlockEOF still needs data to point at.
+const uint8_t kNoData[1] = { 0 };
+} // anonymous namespace
+
+CHIP_ERROR FileBlockSource::Open(const char * path)
+{
+    VerifyOrReturnError(path != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    Close();
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        ChipLogError(BDX, "Failed to open %s: %s (%d)", path, strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    struct stat st;
+    VerifyOrExit(fstat(fd, &st) == 0, err = CHIP_ERROR_OPEN_FAILED);
+    VerifyOrExit(st.st_size >= 0 && static_cast<uint64_t>(st.st_size) <= SIZE_MAX, err = CHIP_ERROR_OPEN_FAILED);
+    mSize = static_cast<size_t>(st.st_size);
+
+    if (mSize == 0)
+    {
+        mData = kNoData;
+        ExitNow();
+    }
+
+    mMapping = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mMapping == MAP_FAILED)
+    {
+        mMapping = nullptr;
+        ExitNow(err = CHIP_ERROR_OPEN_FAILED);
+    }
+
+    // Blocks are read once, front to back.
+    madvise(mMapping, mSize, MADV_SEQUENTIAL);
+    mData = static_cast<const uint8_t *>(mMapping);
+
+exit:
+    // The mapping does not need the file to stay open.
+    close(fd);
+    if (err != CHIP_NO_ERROR)
+    {
+        mSize = 0;
+    }
+    return err;
+}
+
+void FileBlockSource::Close()
+{
+    if (mMapping != nullptr)
+    {
+        munmap(mMapping, mSize);
+    }
+    mMapping = nullptr;
+    mData    = nullptr;
+    mSize    = 0;
+}
+
+CHIP_ERROR FileBlockSource::GetBlock(uint64_t offset, uint16_t maxLength, TransferSession::BlockData & block)
+{
+    VerifyOrReturnError(mData != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(offset <= mSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint64_t remaining = mSize - offset;
+    block.Data               = mData + offset;
+    block.Length             = static_cast<uint16_t>(::chip::min<uint64_t>(maxLength, remaining));
+    block.IsEof              = (block.Length == remaining);
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace bdx
+} // namespace chip
@@ -0,0 +1,60 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a BlockSource that sends a file, e.g. an OTA image, for POSIX platforms.
+ *
+ *      The file is mapped into memory, and each Block points into the mapping, so the only copy of the data the sender makes is
+ *      the one into the message buffer that the Block message is encoded (and then encrypted in place) in.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+#include <protocols/bdx/BdxTransferFacilitator.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace bdx {
+
+class DLL_EXPORT FileBlockSource : public BlockSource
+{
+public:
+    FileBlockSource() {}
+    ~FileBlockSource() override { Close(); }
+
+    /**
+     * @brief
+     *   Map the file at the given path. The file must not be truncated while it is mapped.
+     */
+    CHIP_ERROR Open(const char * path);
+    void Close();
+
+    uint64_t GetSize() const { return mSize; }
+
+    CHIP_ERROR GetBlock(uint64_t offset, uint16_t maxLength, TransferSession::BlockData & block) override;
+
+private:
+    void * mMapping       = nullptr;
+    const uint8_t * mData = nullptr; ///< The start of the file data, or nullptr if no file is open.
+    size_t mSize          = 0;
+};
+
+} // namespace bdx
+} // namespace chip
@@ -0,0 +1,275 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/bdx/BdxTransferFacilitator.h>
+
+#include <protocols/Protocols.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <transport/raw/MessageHeader.h>
+
+namespace chip {
+namespace bdx {
+
+TransferFacilitator::~TransferFacilitator()
+{
+    ResetTransfer();
+}
+
+void TransferFacilitator::PollForOutput()
+{
+    // Output that shows up while it is handled, e.g. a message received while one is sent, is taken care of by the outer call.
+    VerifyOrReturn(!mPolling);
+    mPolling = true;
+
+    TransferSession::OutputEvent event;
+    for (;;)
+    {
+        if (mBlockSource != nullptr && mTransfer.CanPrepareBlock())
+        {
+            CHIP_ERROR err = PrepareNextBlock();
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(BDX, "Failed to prepare Block: %s", ErrorStr(err));
+                mBlockSource = nullptr;
+                mTransfer.AbortTransfer(StatusCode::kTransferFailedUnknownError);
+            }
+        }
+
+        mTransfer.PollOutput(event, System::Clock::GetMonotonicMilliseconds());
+        if (event.EventType == TransferSession::OutputEventType::kNone)
+        {
+            break;
+        }
+
+        if (event.EventType == TransferSession::OutputEventType::kMsgToSend)
+        {
+            bool isLastMessage = false;
+            CHIP_ERROR err     = SendMessage(std::move(event.MsgData), isLastMessage);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(BDX, "Failed to send message: %s", ErrorStr(err));
+                TransferSession::StatusReportData status = { StatusCode::kFailureToSend };
+                event = TransferSession::OutputEvent::StatusReportEvent(TransferSession::OutputEventType::kInternalError, status);
+                HandleTransferSessionOutput(event);
+                mTransferEnded = true;
+            }
+            mTransferEnded = mTransferEnded || isLastMessage;
+        }
+        else
+        {
+            HandleTransferSessionOutput(event);
+            switch (event.EventType)
+            {
+            case TransferSession::OutputEventType::kAckEOFReceived:
+            case TransferSession::OutputEventType::kStatusReceived:
+            case TransferSession::OutputEventType::kInternalError:
+            case TransferSession::OutputEventType::kTransferTimeout:
+                mTransferEnded = true;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (mTransferEnded)
+        {
+            break;
+        }
+    }
+
+    mPolling = false;
+
+    if (mTransferEnded)
+    {
+        ResetTransfer();
+    }
+    else if (mExchangeCtx != nullptr && mSystemLayer != nullptr)
+    {
+        // Poll again later, to notice timeouts.
+        mSystemLayer->StartTimer(mPollFreqMs, PollTimerHandler, this);
+    }
+}
+
+void TransferFacilitator::SetBlockSource(BlockSource * source)
+{
+    mBlockSource = source;
+    mBlockOffset = mTransfer.GetStartOffset();
+}
+
+void TransferFacilitator::ResetTransfer()
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(PollTimerHandler, this);
+    }
+
+    if (mExchangeCtx != nullptr)
+    {
+        mExchangeCtx->Close();
+        mExchangeCtx = nullptr;
+    }
+
+    mTransfer.Reset();
+    mBlockSource   = nullptr;
+    mBlockOffset   = 0;
+    mTransferEnded = false;
+}
+
+CHIP_ERROR TransferFacilitator::Start(System::Layer * layer, uint8_t windowSize, uint32_t pollFreqMs)
+{
+    VerifyOrReturnError(layer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(pollFreqMs > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer = layer;
+    mPollFreqMs  = pollFreqMs;
+
+    return mTransfer.SetWindowSize(windowSize);
+}
+
+CHIP_ERROR TransferFacilitator::OnMessageReceived(Messaging::ExchangeContext * ec, const PacketHeader & packetHeader,
+                                                  const PayloadHeader & payloadHeader, System::PacketBufferHandle && payload)
+{
+    VerifyOrReturnError(ec != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // A Responder takes the exchange that its TransferInit message arrives on.
+    if (mExchangeCtx == nullptr)
+    {
+        mExchangeCtx = ec;
+    }
+    VerifyOrReturnError(ec == mExchangeCtx, CHIP_ERROR_INCORRECT_STATE);
+
+    // The TransferSession decodes the payload header itself.
+    CHIP_ERROR err = payloadHeader.EncodeBeforeData(payload);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = mTransfer.HandleMessageReceived(std::move(payload), System::Clock::GetMonotonicMilliseconds());
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(BDX, "Failed to handle message: %s", ErrorStr(err));
+    }
+
+    PollForOutput();
+
+    // Keep the exchange open for the rest of the transfer, which closes it once it ended. Sending a message clears the flag.
+    if (mExchangeCtx != nullptr)
+    {
+        mExchangeCtx->WillSendMessage();
+    }
+
+    return err;
+}
+
+void TransferFacilitator::OnExchangeClosing(Messaging::ExchangeContext * ec)
+{
+    if (ec == mExchangeCtx)
+    {
+        mExchangeCtx = nullptr;
+    }
+}
+
+void TransferFacilitator::PollTimerHandler(System::Layer * layer, void * appState, CHIP_ERROR error)
+{
+    VerifyOrReturn(appState != nullptr);
+    static_cast<TransferFacilitator *>(appState)->PollForOutput();
+}
+
+CHIP_ERROR TransferFacilitator::SendMessage(System::PacketBufferHandle msg, bool & isLastMessage)
+{
+    VerifyOrReturnError(mExchangeCtx != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // The ExchangeContext adds its own payload header.
+    PayloadHeader payloadHeader;
+    ReturnErrorOnFailure(payloadHeader.DecodeAndConsume(msg));
+
+    const bool isBdx       = payloadHeader.HasProtocol(Protocols::BDX::Id);
+    const MessageType type = static_cast<MessageType>(payloadHeader.GetMessageType());
+    isLastMessage          = isBdx && (type == MessageType::BlockAckEOF);
+    Messaging::SendFlags flags(Messaging::SendMessageFlags::kNone);
+
+    // The reliable message layer tracks one unacknowledged message per exchange, e.g. a ReceiveAccept that the first Block
+    // follows right away, and cannot track all Blocks and BlockAcks of a window. The TransferSession sends windowed Blocks
+    // that are not acknowledged again itself.
+    const bool isWindowedMsg = isBdx && (type == MessageType::Block || type == MessageType::BlockAck);
+    if ((isWindowedMsg && mTransfer.GetWindowSize() > 1) || mExchangeCtx->GetReliableMessageContext()->IsOccupied())
+    {
+        flags.Set(Messaging::SendMessageFlags::kNoAutoRequestAck);
+    }
+
+    return mExchangeCtx->SendMessage(payloadHeader.GetProtocolID(), payloadHeader.GetMessageType(), std::move(msg), flags);
+}
+
+CHIP_ERROR TransferFacilitator::PrepareNextBlock()
+{
+    uint16_t maxLength = mTransfer.GetTransferBlockSize();
+    uint64_t remaining = UINT64_MAX;
+    if (mTransfer.GetTransferLength() > 0)
+    {
+        VerifyOrReturnError(mBlockOffset - mTransfer.GetStartOffset() <= mTransfer.GetTransferLength(), CHIP_ERROR_INTERNAL);
+        remaining = mTransfer.GetTransferLength() - (mBlockOffset - mTransfer.GetStartOffset());
+        maxLength = static_cast<uint16_t>(::chip::min<uint64_t>(maxLength, remaining));
+    }
+
+    TransferSession::BlockData block;
+    ReturnErrorOnFailure(mBlockSource->GetBlock(mBlockOffset, maxLength, block));
+    VerifyOrReturnError(block.Length <= maxLength, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(block.Length > 0 || block.IsEof, CHIP_ERROR_INTERNAL);
+
+    block.IsEof = block.IsEof || (block.Length == remaining);
+
+    ReturnErrorOnFailure(mTransfer.PrepareBlock(block));
+
+    mBlockOffset += block.Length;
+    if (block.IsEof)
+    {
+        mBlockSource = nullptr;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Responder::PrepareForTransfer(System::Layer * layer, TransferRole role, BitFlags<TransferControlFlags> xferControlOpts,
+                                         uint16_t maxBlockSize, uint32_t timeoutMs, uint8_t windowSize, uint32_t pollFreqMs)
+{
+    VerifyOrReturnError(mExchangeCtx == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    ReturnErrorOnFailure(Start(layer, windowSize, pollFreqMs));
+    return mTransfer.WaitForTransfer(role, xferControlOpts, maxBlockSize, timeoutMs);
+}
+
+CHIP_ERROR Initiator::InitiateTransfer(System::Layer * layer, Messaging::ExchangeContext * exchangeCtx, TransferRole role,
+                                       const TransferSession::TransferInitData & initData, uint32_t timeoutMs, uint8_t windowSize,
+                                       uint32_t pollFreqMs)
+{
+    VerifyOrReturnError(exchangeCtx != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mExchangeCtx == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    ReturnErrorOnFailure(Start(layer, windowSize, pollFreqMs));
+    ReturnErrorOnFailure(mTransfer.StartTransfer(role, initData, timeoutMs));
+
+    mExchangeCtx = exchangeCtx;
+    mExchangeCtx->SetDelegate(this);
+
+    PollForOutput();
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace bdx
+} // namespace chip
@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the classes that run a BDX TransferSession over an ExchangeContext: they pass received messages to the
+ *      TransferSession, send the messages it outputs, poll it for timeouts, and optionally feed it Blocks from a BlockSource.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <protocols/bdx/BdxTransferSession.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace bdx {
+
+/**
+ * Provides the data of a transfer to a TransferFacilitator that is sending it.
+ */
+class DLL_EXPORT BlockSource
+{
+public:
+    virtual ~BlockSource() {}
+
+    /**
+     * @brief
+     *   Point block at the data at the given offset, at most maxLength bytes of it, and set block.IsEof if that data ends the
+     *   source. The data has to remain valid until the next call.
+     */
+    virtual CHIP_ERROR GetBlock(uint64_t offset, uint16_t maxLength, TransferSession::BlockData & block) = 0;
+};
+
+/**
+ * An ExchangeDelegate that runs a TransferSession. Subclasses receive all output of the TransferSession other than messages to
+ * send, and act on it through the TransferSession, e.g. by accepting a transfer or acknowledging a Block. The exchange is closed
+ * and the TransferSession reset once the transfer ended, successfully or not.
+ *
+ * The TransferSession is polled whenever a message was received and every pollFreqMs milliseconds. A subclass that calls one of
+ * its Prepare*() methods outside of HandleTransferSessionOutput() calls PollForOutput() to have the message sent right away.
+ *
+ * The reliable message layer only tracks one unacknowledged message per exchange. Messages sent while it waits for an
+ * acknowledgement, and with a window larger than one Block all Block and BlockAck messages, are sent without requesting one.
+ * BlockAcks and the transfer timeout cover them instead: a lost BlockAck is made up for by the next one, while a lost Block
+ * stalls the transfer until it times out.
+ */
+class DLL_EXPORT TransferFacilitator : public Messaging::ExchangeDelegate
+{
+public:
+    static constexpr uint32_t kDefaultPollFreqMs = 500;
+
+    ~TransferFacilitator() override;
+
+    /**
+     * @brief
+     *   Process all pending output of the TransferSession.
+     */
+    void PollForOutput();
+
+    /**
+     * @brief
+     *   Send Blocks from the given source while the TransferSession allows, starting at the transfer's start offset, until the
+     *   end of the source or of the transfer length, if it is definite.
+     */
+    void SetBlockSource(BlockSource * source);
+
+    /**
+     * @brief
+     *   End the transfer without notifying the peer: close the exchange and reset the TransferSession.
+     */
+    void ResetTransfer();
+
+protected:
+    /**
+     * @brief
+     *   Handle output of the TransferSession other than kMsgToSend. The transfer ends after kAckEOFReceived, kStatusReceived,
+     *   kInternalError and kTransferTimeout events, as well as after a Receiver acknowledged the BlockEOF.
+     */
+    virtual void HandleTransferSessionOutput(TransferSession::OutputEvent & event) = 0;
+
+    CHIP_ERROR Start(System::Layer * layer, uint8_t windowSize, uint32_t pollFreqMs);
+
+    TransferSession mTransfer;
+    Messaging::ExchangeContext * mExchangeCtx = nullptr;
+
+private:
+    // ExchangeDelegate
+    CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PacketHeader & packetHeader,
+                                 const PayloadHeader & payloadHeader, System::PacketBufferHandle && payload) override;
+    void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
+    void OnExchangeClosing(Messaging::ExchangeContext * ec) override;
+
+    static void PollTimerHandler(System::Layer * layer, void * appState, CHIP_ERROR error);
+
+    CHIP_ERROR SendMessage(System::PacketBufferHandle msg, bool & isLastMessage);
+    CHIP_ERROR PrepareNextBlock();
+
+    System::Layer * mSystemLayer = nullptr;
+    BlockSource * mBlockSource   = nullptr;
+    uint64_t mBlockOffset        = 0;
+    uint32_t mPollFreqMs         = kDefaultPollFreqMs;
+    bool mPolling                = false;
+    bool mTransferEnded          = false;
+};
+
+/**
+ * Waits for a TransferInit message on an exchange created for it, i.e. it is to be registered as the unsolicited message handler
+ * for SendInit or ReceiveInit messages.
+ */
+class DLL_EXPORT Responder : public TransferFacilitator
+{
+public:
+    CHIP_ERROR PrepareForTransfer(System::Layer * layer, TransferRole role, BitFlags<TransferControlFlags> xferControlOpts,
+                                  uint16_t maxBlockSize, uint32_t timeoutMs, uint8_t windowSize = 1,
+                                  uint32_t pollFreqMs = kDefaultPollFreqMs);
+};
+
+/**
+ * Starts a transfer with a TransferInit message on the given exchange, whose delegate it becomes.
+ */
+class DLL_EXPORT Initiator : public TransferFacilitator
+{
+public:
+    CHIP_ERROR InitiateTransfer(System::Layer * layer, Messaging::ExchangeContext * exchangeCtx, TransferRole role,
+                                const TransferSession::TransferInitData & initData, uint32_t timeoutMs, uint8_t windowSize = 1,
+                                uint32_t pollFreqMs = kDefaultPollFreqMs);
+};
+
+} // namespace bdx
+} // namespace chip
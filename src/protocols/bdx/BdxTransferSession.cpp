@@ -78,12 +78,26 @@ void TransferSession::PollOutput(OutputEvent & event, uint64_t curTimeMs)
         mShouldInitTimeoutStart = false;
     }
 
-    if (mAwaitingResponse && ((curTimeMs - mTimeoutStartTimeMs) >= mTimeoutMs))
+    if (mAwaitingResponse && ((curTimeMs - mTimeoutStartTimeMs) >= GetResponseTimeoutMs()))
     {
-        event             = OutputEvent(OutputEventType::kTransferTimeout);
-        mState            = TransferState::kErrorState;
-        mAwaitingResponse = false;
-        return;
+        if (!CanResendBlocks())
+        {
+            event             = OutputEvent(OutputEventType::kTransferTimeout);
+            mState            = TransferState::kErrorState;
+            mAwaitingResponse = false;
+            return;
+        }
+
+        // Go back to the first Block that was not acknowledged, and send it and the ones after it again.
+        mResendCount++;
+        mNextResendNum      = mNextAckNum;
+        mTimeoutStartTimeMs = curTimeMs;
+    }
+
+    if (mPendingOutput == OutputEventType::kNone)
+    {
+        ReleaseHeldBlock();
+        ResendBlock();
     }
 
     switch (mPendingOutput)
@@ -190,6 +204,16 @@ CHIP_ERROR TransferSession::WaitForTransfer(TransferRole role, BitFlags<Transfer
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TransferSession::SetWindowSize(uint8_t windowSize)
+{
+    VerifyOrReturnError(mState == TransferState::kUnitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError((windowSize > 0) && (windowSize <= CHIP_CONFIG_BDX_MAX_WINDOW_SIZE), CHIP_ERROR_INVALID_ARGUMENT);
+
+    mWindowSize = windowSize;
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData)
 {
     const BitFlags<TransferControlFlags> proposedControlOpts(mTransferRequestData.TransferCtlFlags);
@@ -276,7 +300,7 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
     VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mRole == TransferRole::kSender, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanPrepareBlock(), CHIP_ERROR_INCORRECT_STATE);
 
     // Verify non-zero data is provided and is no longer than MaxBlockSize (BlockEOF may contain 0 length data)
     VerifyOrReturnError((inData.Data != nullptr) && (inData.Length <= mTransferMaxBlockSize), CHIP_ERROR_INVALID_ARGUMENT);
@@ -291,6 +315,14 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
     const MessageType msgType = inData.IsEof ? MessageType::BlockEOF : MessageType::Block;
     ReturnErrorOnFailure(AttachHeader(msgType, mPendingMsgHandle));
 
+    if (IsWindowed())
+    {
+        // Keep a copy until the Block is acknowledged, to send it again if the BlockAcks stop coming.
+        System::PacketBufferHandle & sentBlock = mSentBlocks[mNextBlockNum % CHIP_CONFIG_BDX_MAX_WINDOW_SIZE];
+        sentBlock                              = mPendingMsgHandle.CloneData();
+        VerifyOrReturnError(!sentBlock.IsNull(), CHIP_ERROR_NO_MEMORY);
+    }
+
     mPendingOutput = OutputEventType::kMsgToSend;
 
     if (msgType == MessageType::BlockEOF)
@@ -300,10 +332,27 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 
     mAwaitingResponse = true;
     mLastBlockNum     = mNextBlockNum++;
+    mNextResendNum    = mNextBlockNum;
 
     return CHIP_NO_ERROR;
 }
 
+bool TransferSession::CanPrepareBlock() const
+{
+    if (mState != TransferState::kTransferInProgress || mRole != TransferRole::kSender || mPendingOutput != OutputEventType::kNone)
+    {
+        return false;
+    }
+
+    if (IsWindowed())
+    {
+        // Blocks that are sent again go first.
+        return (mNextResendNum == mNextBlockNum) && (mNextBlockNum - mNextAckNum < mWindowSize);
+    }
+
+    return !mAwaitingResponse;
+}
+
 CHIP_ERROR TransferSession::PrepareBlockAck()
 {
     VerifyOrReturnError(mRole == TransferRole::kReceiver, CHIP_ERROR_INCORRECT_STATE);
@@ -369,6 +418,20 @@ void TransferSession::Reset()
     mNextBlockNum      = 0;
     mLastQueryNum      = 0;
     mNextQueryNum      = 0;
+    mNextAckNum        = 0;
+    mWindowSize        = 1;
+
+    for (HeldBlock & held : mHeldBlocks)
+    {
+        held.Msg = nullptr;
+    }
+
+    for (System::PacketBufferHandle & sentBlock : mSentBlocks)
+    {
+        sentBlock = nullptr;
+    }
+    mNextResendNum = 0;
+    mResendCount   = 0;
 
     mTimeoutMs              = 0;
     mTimeoutStartTimeMs     = 0;
@@ -592,13 +655,25 @@ void TransferSession::HandleBlockQuery(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kReceiver, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     Block blockMsg;
     const CHIP_ERROR err = blockMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
+    if (HandleResentBlock(blockMsg.BlockCounter))
+    {
+        return;
+    }
+
+    VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    if (IsWindowed() && blockMsg.BlockCounter != mLastQueryNum)
+    {
+        HoldBlock(MessageType::Block, blockMsg.BlockCounter, std::move(msgData));
+        return;
+    }
+
     VerifyOrReturn(blockMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn((blockMsg.DataLength > 0) && (blockMsg.DataLength <= mTransferMaxBlockSize),
                    PrepareStatusReport(StatusCode::kBadMessageContents));
@@ -618,20 +693,34 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
 
     mNumBytesProcessed += blockMsg.DataLength;
     mLastBlockNum = blockMsg.BlockCounter;
+    mLastQueryNum = blockMsg.BlockCounter + 1;
 
-    mAwaitingResponse = false;
+    // With a window, the next Blocks are already on their way.
+    mAwaitingResponse = IsWindowed();
 }
 
 void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kReceiver, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockEOF blockEOFMsg;
     const CHIP_ERROR err = blockEOFMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
+    if (HandleResentBlock(blockEOFMsg.BlockCounter))
+    {
+        return;
+    }
+
+    VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    if (IsWindowed() && blockEOFMsg.BlockCounter != mLastQueryNum)
+    {
+        HoldBlock(MessageType::BlockEOF, blockEOFMsg.BlockCounter, std::move(msgData));
+        return;
+    }
+
     VerifyOrReturn(blockEOFMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn(blockEOFMsg.DataLength <= mTransferMaxBlockSize, PrepareStatusReport(StatusCode::kBadMessageContents));
 
@@ -652,6 +741,11 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockAck(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    if (IsWindowed())
+    {
+        HandleWindowedBlockAck(std::move(msgData));
+        return;
+    }
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
@@ -667,6 +761,36 @@ void TransferSession::HandleBlockAck(System::PacketBufferHandle msgData)
     mAwaitingResponse = (mControlMode == TransferControlFlags::kReceiverDrive);
 }
 
+void TransferSession::HandleWindowedBlockAck(System::PacketBufferHandle msgData)
+{
+    // Blocks sent before the BlockEOF are acknowledged separately, and their BlockAcks may be overtaken by the BlockAckEOF.
+    VerifyOrReturn((mState == TransferState::kTransferInProgress) || (mState == TransferState::kAwaitingEOFAck) ||
+                       (mState == TransferState::kTransferDone),
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    BlockAck ackMsg;
+    const CHIP_ERROR err = ackMsg.Parse(std::move(msgData));
+    VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
+
+    // A BlockAck acknowledges all Blocks up to its counter, so there is nothing left to do for one that was overtaken by a later
+    // one.
+    VerifyOrReturn(ackMsg.BlockCounter >= mNextAckNum);
+    VerifyOrReturn(ackMsg.BlockCounter < mNextBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(!(mState == TransferState::kAwaitingEOFAck && ackMsg.BlockCounter == mLastBlockNum),
+                   PrepareStatusReport(StatusCode::kBadBlockCounter));
+
+    mPendingOutput = OutputEventType::kAckReceived;
+
+    for (uint32_t blockCounter = mNextAckNum; blockCounter <= ackMsg.BlockCounter; blockCounter++)
+    {
+        mSentBlocks[blockCounter % CHIP_CONFIG_BDX_MAX_WINDOW_SIZE] = nullptr;
+    }
+    mResendCount = 0;
+
+    mNextAckNum       = ackMsg.BlockCounter + 1;
+    mAwaitingResponse = (mNextAckNum != mNextBlockNum);
+}
+
 void TransferSession::HandleBlockAckEOF(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
@@ -680,11 +804,140 @@ void TransferSession::HandleBlockAckEOF(System::PacketBufferHandle msgData)
 
     mPendingOutput = OutputEventType::kAckEOFReceived;
 
+    for (System::PacketBufferHandle & sentBlock : mSentBlocks)
+    {
+        sentBlock = nullptr;
+    }
+
+    mNextAckNum       = mNextBlockNum;
     mAwaitingResponse = false;
 
     mState = TransferState::kTransferDone;
 }
 
+void TransferSession::HoldBlock(MessageType msgType, uint32_t blockCounter, System::PacketBufferHandle msgData)
+{
+    // Only Blocks within the window, i.e. sent before the one that is missing was acknowledged, can arrive ahead of it.
+    // Blocks that are held already were handled by HandleResentBlock().
+    VerifyOrReturn((blockCounter > mLastQueryNum) && (blockCounter - mLastQueryNum < mWindowSize),
+                   PrepareStatusReport(StatusCode::kBadBlockCounter));
+
+    HeldBlock * freeSlot = nullptr;
+    for (HeldBlock & held : mHeldBlocks)
+    {
+        if (held.Msg.IsNull())
+        {
+            freeSlot = &held;
+            break;
+        }
+    }
+    VerifyOrReturn(freeSlot != nullptr, PrepareStatusReport(StatusCode::kBadBlockCounter));
+
+    freeSlot->Msg          = std::move(msgData);
+    freeSlot->Type         = msgType;
+    freeSlot->BlockCounter = blockCounter;
+}
+
+void TransferSession::ReleaseHeldBlock()
+{
+    VerifyOrReturn(mRole == TransferRole::kReceiver && mState == TransferState::kTransferInProgress);
+
+    for (HeldBlock & held : mHeldBlocks)
+    {
+        if (!held.Msg.IsNull() && held.BlockCounter == mLastQueryNum)
+        {
+            if (held.Type == MessageType::BlockEOF)
+            {
+                HandleBlockEOF(std::move(held.Msg));
+            }
+            else
+            {
+                HandleBlock(std::move(held.Msg));
+            }
+            held.Msg = nullptr;
+            return;
+        }
+    }
+}
+
+bool TransferSession::HandleResentBlock(uint32_t blockCounter)
+{
+    if (!IsWindowed())
+    {
+        return false;
+    }
+
+    if (mState == TransferState::kTransferInProgress)
+    {
+        if (blockCounter < mLastQueryNum)
+        {
+            // The BlockAcks for it were lost, so acknowledge the Blocks received so far again.
+            PrepareBlockAck();
+            return true;
+        }
+
+        for (HeldBlock & held : mHeldBlocks)
+        {
+            if (!held.Msg.IsNull() && held.BlockCounter == blockCounter)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if (mState == TransferState::kTransferDone && blockCounter == mLastBlockNum)
+    {
+        // The BlockAckEOF was lost, so send it again.
+        CounterMessage ackMsg;
+        ackMsg.BlockCounter = mLastBlockNum;
+        if ((WriteToPacketBuffer(ackMsg, mPendingMsgHandle) == CHIP_NO_ERROR) &&
+            (AttachHeader(MessageType::BlockAckEOF, mPendingMsgHandle) == CHIP_NO_ERROR))
+        {
+            mPendingOutput = OutputEventType::kMsgToSend;
+        }
+        return true;
+    }
+
+    // The Blocks before the BlockEOF can still arrive again after it.
+    return ((mState == TransferState::kReceivedEOF) || (mState == TransferState::kTransferDone)) && (blockCounter <= mLastBlockNum);
+}
+
+void TransferSession::ResendBlock()
+{
+    VerifyOrReturn(IsWindowed() && mRole == TransferRole::kSender);
+    VerifyOrReturn((mState == TransferState::kTransferInProgress) || (mState == TransferState::kAwaitingEOFAck));
+
+    // Blocks that were acknowledged in the meantime need not be sent again.
+    mNextResendNum = ::chip::max(mNextResendNum, mNextAckNum);
+    VerifyOrReturn(mNextResendNum != mNextBlockNum);
+
+    // If there is no buffer for the copy, try again on the next poll.
+    mPendingMsgHandle = mSentBlocks[mNextResendNum % CHIP_CONFIG_BDX_MAX_WINDOW_SIZE].CloneData();
+    VerifyOrReturn(!mPendingMsgHandle.IsNull());
+
+    mPendingOutput = OutputEventType::kMsgToSend;
+    mNextResendNum++;
+}
+
+bool TransferSession::CanResendBlocks() const
+{
+    return IsWindowed() && (mRole == TransferRole::kSender) &&
+        ((mState == TransferState::kTransferInProgress) || (mState == TransferState::kAwaitingEOFAck)) &&
+        (mNextAckNum != mNextBlockNum) && (mResendCount < CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS);
+}
+
+uint64_t TransferSession::GetResponseTimeoutMs() const
+{
+    // A Receiver with a window gives the Sender time to send the Blocks that were lost again.
+    if (IsWindowed() && mRole == TransferRole::kReceiver)
+    {
+        return static_cast<uint64_t>(mTimeoutMs) * (CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS + 1);
+    }
+
+    return mTimeoutMs;
+}
+
 void TransferSession::ResolveTransferControlOptions(const BitFlags<TransferControlFlags> & proposed)
 {
     // Must specify at least one synchronous option
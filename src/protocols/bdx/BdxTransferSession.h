@@ -12,6 +12,33 @@
 #include <system/SystemPacketBuffer.h>
 #include <transport/raw/MessageHeader.h>
 
+/**
+ *  @def CHIP_CONFIG_BDX_MAX_WINDOW_SIZE
+ *
+ *  @brief
+ *    The largest number of Blocks a TransferSession can be allowed to have in
+ *    flight (see TransferSession::SetWindowSize()). A Receiver keeps a buffer
+ *    for each Block it holds back, and a Sender a copy of each Block until it
+ *    is acknowledged, so this also bounds the memory a transfer uses; with a
+ *    fixed packet buffer pool, leave room for a full window of copies on top
+ *    of the Blocks in flight.
+ */
+#ifndef CHIP_CONFIG_BDX_MAX_WINDOW_SIZE
+#define CHIP_CONFIG_BDX_MAX_WINDOW_SIZE 8
+#endif // CHIP_CONFIG_BDX_MAX_WINDOW_SIZE
+
+/**
+ *  @def CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS
+ *
+ *  @brief
+ *    The number of times in a row a Sender with a window resends the Blocks
+ *    that were not acknowledged before the response timeout, before it gives
+ *    up on the transfer (see TransferSession::SetWindowSize()).
+ */
+#ifndef CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS
+#define CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS 3
+#endif // CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS
+
 namespace chip {
 namespace bdx {
 
@@ -163,6 +190,29 @@ public:
     CHIP_ERROR WaitForTransfer(TransferRole role, BitFlags<TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
                                uint32_t timeoutMs);
 
+    /**
+     * @brief
+     *   Set the number of Blocks that may be in flight at once if the transfer is in Sender Drive mode. The default of 1 sends
+     *   one Block per round trip. Must be called before StartTransfer() or WaitForTransfer(), and again after Reset().
+     *
+     *   A Sender then prepares Blocks until windowSize of them are unacknowledged, and takes each BlockAck as acknowledging all
+     *   Blocks up to its counter. A Receiver accepts Blocks before it has acknowledged the previous ones, and holds back up to
+     *   windowSize - 1 Blocks that arrive ahead of a missing one until the missing one arrives. BDX messages have no field for
+     *   the window, so the peers have to agree on it beforehand; a Receiver that acknowledges each Block as it is received only
+     *   needs a window if Blocks may arrive out of order.
+     *
+     *   Windowed Blocks and BlockAcks are not sent reliably, so the Sender keeps a copy of each Block until it is acknowledged.
+     *   When the response timeout passes without a BlockAck, it sends the Blocks again, starting from the first one that was not
+     *   acknowledged, up to CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS times in a row. The Receiver acknowledges Blocks it has already
+     *   received again, and waits for the Sender to use up its resends before it times out.
+     *
+     * @param windowSize The number of Blocks in flight, from 1 to CHIP_CONFIG_BDX_MAX_WINDOW_SIZE
+     *
+     * @return CHIP_ERROR CHIP_ERROR_INVALID_ARGUMENT if the window is out of range, or CHIP_ERROR_INCORRECT_STATE if a transfer
+     *                    was already started.
+     */
+    CHIP_ERROR SetWindowSize(uint8_t windowSize);
+
     /**
      * @brief
      *   Indicate that all transfer parameters are acceptable and prepare a SendAccept or ReceiveAccept message (depending on role).
@@ -205,6 +255,13 @@ public:
      */
     CHIP_ERROR PrepareBlock(const BlockData & inData);
 
+    /**
+     * @brief
+     *   Indicates whether PrepareBlock() can be called now, i.e. this object is sending a transfer in progress, has no pending
+     *   output, and has room in its window or (in Receiver Drive) has received a BlockQuery.
+     */
+    bool CanPrepareBlock() const;
+
     /**
      * @brief
      *   Prepare a BlockAck message. The Block counter will be populated automatically.
@@ -248,6 +305,7 @@ public:
     uint64_t GetStartOffset() const { return mStartOffset; }
     uint64_t GetTransferLength() const { return mTransferLength; }
     uint16_t GetTransferBlockSize() const { return mTransferMaxBlockSize; }
+    uint8_t GetWindowSize() const { return mWindowSize; }
 
     TransferSession();
 
@@ -275,8 +333,43 @@ private:
     void HandleBlock(System::PacketBufferHandle msgData);
     void HandleBlockEOF(System::PacketBufferHandle msgData);
     void HandleBlockAck(System::PacketBufferHandle msgData);
+    void HandleWindowedBlockAck(System::PacketBufferHandle msgData);
     void HandleBlockAckEOF(System::PacketBufferHandle msgData);
 
+    /**
+     * @brief
+     *   Used by a Receiver with a window to keep a Block or BlockEOF that arrived ahead of the one it expects.
+     */
+    void HoldBlock(MessageType msgType, uint32_t blockCounter, System::PacketBufferHandle msgData);
+
+    /**
+     * @brief
+     *   Handle the held Block that the Receiver expects next, if there is one.
+     */
+    void ReleaseHeldBlock();
+
+    /**
+     * @brief
+     *   Used by a Receiver with a window to handle a Block or BlockEOF that it already received, which the Sender sends again
+     *   when the BlockAcks for it are lost. Returns false if the Block was not received before.
+     */
+    bool HandleResentBlock(uint32_t blockCounter);
+
+    /**
+     * @brief
+     *   Used by a Sender with a window to send the next of the Blocks that were not acknowledged before the timeout again.
+     */
+    void ResendBlock();
+
+    /**
+     * @brief
+     *   Used by a Sender with a window to decide whether to send the Blocks that were not acknowledged again when the timeout
+     *   passes, rather than fail the transfer.
+     */
+    bool CanResendBlocks() const;
+
+    uint64_t GetResponseTimeoutMs() const;
+
     /**
      * @brief
      *   Used when handling a TransferInit message. Determines if there are any compatible Transfer control modes between the two
@@ -292,6 +385,7 @@ private:
 
     void PrepareStatusReport(StatusCode code);
     bool IsTransferLengthDefinite();
+    bool IsWindowed() const { return mWindowSize > 1 && mControlMode == TransferControlFlags::kSenderDrive; }
 
     OutputEventType mPendingOutput = OutputEventType::kNone;
     TransferState mState           = TransferState::kUnitialized;
@@ -320,6 +414,20 @@ private:
     uint32_t mNextBlockNum = 0;
     uint32_t mLastQueryNum = 0;
     uint32_t mNextQueryNum = 0;
+    uint32_t mNextAckNum   = 0; ///< The first Block the Sender has not received an acknowledgement for
+    uint8_t mWindowSize    = 1;
+
+    struct HeldBlock
+    {
+        System::PacketBufferHandle Msg;
+        MessageType Type;
+        uint32_t BlockCounter;
+    };
+    HeldBlock mHeldBlocks[CHIP_CONFIG_BDX_MAX_WINDOW_SIZE];
+
+    System::PacketBufferHandle mSentBlocks[CHIP_CONFIG_BDX_MAX_WINDOW_SIZE]; ///< Copies of the unacknowledged Blocks, by counter
+    uint32_t mNextResendNum = 0; ///< The next Block to send again, mNextBlockNum if there is none
+    uint8_t mResendCount    = 0;
 
     uint32_t mTimeoutMs          = 0;
     uint64_t mTimeoutStartTimeMs = 0;
@@ -0,0 +1,276 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the transport and the transfer ends that the BDX TransferFacilitator tests and benchmarks run
+ *      transfers over.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/ReliableMessageMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/bdx/BdxFileBlockSource.h>
+#include <protocols/bdx/BdxTransferFacilitator.h>
+#include <support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/Base.h>
+#include <transport/raw/PeerAddress.h>
+
+#include <string.h>
+
+namespace chip {
+namespace bdx {
+namespace Test {
+
+constexpr uint32_t kLoopbackLatencyMs = 2;
+
+/**
+ * A loopback transport that delivers each message kLoopbackLatencyMs after it was sent, so that the round trips a transfer waits
+ * for take time, as they do on a real network. It can also lose every so many messages.
+ */
+class DelayedLoopbackTransport : public Transport::Base
+{
+public:
+    void SetSystemLayer(System::Layer * layer) { mSystemLayer = layer; }
+
+    /**
+     * Lose every dropInterval-th message that is sent from now on, or none if dropInterval is 0.
+     */
+    void SetDropInterval(uint32_t dropInterval)
+    {
+        mDropInterval = dropInterval;
+        mSentCount    = 0;
+    }
+
+    CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override
+    {
+        VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+        mSentCount++;
+        if (mDropInterval > 0 && mSentCount % mDropInterval == 0)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        VerifyOrReturnError(mQueueLength < ArraySize(mQueue), CHIP_ERROR_NO_MEMORY);
+
+        PendingMessage & pending = mQueue[(mQueueStart + mQueueLength) % ArraySize(mQueue)];
+        pending.mMsg             = msgBuf.CloneData();
+        VerifyOrReturnError(!pending.mMsg.IsNull(), CHIP_ERROR_NO_MEMORY);
+        pending.mAddress   = address;
+        pending.mDueTimeMs = System::Clock::GetMonotonicMilliseconds() + kLoopbackLatencyMs;
+        mQueueLength++;
+
+        if (mQueueLength == 1)
+        {
+            return mSystemLayer->StartTimer(kLoopbackLatencyMs, DeliverDueMessages, this);
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    bool CanSendToPeer(const Transport::PeerAddress & address) override { return true; }
+
+private:
+    struct PendingMessage
+    {
+        Transport::PeerAddress mAddress;
+        System::PacketBufferHandle mMsg;
+        uint64_t mDueTimeMs;
+    };
+
+    static void DeliverDueMessages(System::Layer * layer, void * appState, CHIP_ERROR error)
+    {
+        auto * self  = static_cast<DelayedLoopbackTransport *>(appState);
+        uint64_t now = System::Clock::GetMonotonicMilliseconds();
+
+        while (self->mQueueLength > 0 && self->mQueue[self->mQueueStart].mDueTimeMs <= now)
+        {
+            // Dequeue first: handling the message may send new ones.
+            PendingMessage & pending           = self->mQueue[self->mQueueStart];
+            Transport::PeerAddress address     = pending.mAddress;
+            System::PacketBufferHandle message = std::move(pending.mMsg);
+            self->mQueueStart                  = (self->mQueueStart + 1) % ArraySize(self->mQueue);
+            self->mQueueLength--;
+
+            self->HandleMessageReceived(address, std::move(message));
+        }
+
+        if (self->mQueueLength > 0)
+        {
+            uint64_t dueTimeMs = self->mQueue[self->mQueueStart].mDueTimeMs;
+            uint32_t delayMs   = static_cast<uint32_t>(dueTimeMs > now ? dueTimeMs - now : 0);
+            layer->StartTimer(delayMs, DeliverDueMessages, self);
+        }
+    }
+
+    System::Layer * mSystemLayer = nullptr;
+    uint32_t mDropInterval       = 0;
+    uint32_t mSentCount          = 0;
+    PendingMessage mQueue[32];
+    size_t mQueueStart  = 0;
+    size_t mQueueLength = 0;
+};
+
+/**
+ * Sends the file that mSource is open on to the TestReceiver that asks for it, in Sender Drive mode.
+ */
+class TestSender : public Responder
+{
+public:
+    FileBlockSource mSource;
+    bool mDone   = false;
+    bool mFailed = false;
+
+protected:
+    void HandleTransferSessionOutput(TransferSession::OutputEvent & event) override
+    {
+        switch (event.EventType)
+        {
+        case TransferSession::OutputEventType::kInitReceived: {
+            TransferSession::TransferAcceptData acceptData;
+            acceptData.ControlMode  = TransferControlFlags::kSenderDrive;
+            acceptData.MaxBlockSize = event.transferInitData.MaxBlockSize;
+            acceptData.StartOffset  = event.transferInitData.StartOffset;
+            acceptData.Length       = mSource.GetSize();
+            mFailed                 = mFailed || (mTransfer.AcceptTransfer(acceptData) != CHIP_NO_ERROR);
+            SetBlockSource(&mSource);
+            break;
+        }
+        case TransferSession::OutputEventType::kAckEOFReceived:
+            mDone = true;
+            break;
+        case TransferSession::OutputEventType::kAckReceived:
+            break;
+        default:
+            mFailed = true;
+            break;
+        }
+    }
+};
+
+/**
+ * Asks for a file in Sender Drive mode and keeps what it receives.
+ */
+class TestReceiver : public Initiator
+{
+public:
+    /**
+     * Set the buffer that the received data is written to.
+     */
+    void SetBuffer(uint8_t * data, size_t capacity)
+    {
+        mData     = data;
+        mCapacity = capacity;
+    }
+
+    uint8_t * mData  = nullptr;
+    size_t mCapacity = 0;
+    size_t mLength   = 0;
+    bool mDone       = false;
+    bool mFailed     = false;
+
+protected:
+    void HandleTransferSessionOutput(TransferSession::OutputEvent & event) override
+    {
+        switch (event.EventType)
+        {
+        case TransferSession::OutputEventType::kAcceptReceived:
+            break;
+        case TransferSession::OutputEventType::kBlockReceived:
+            if (event.blockdata.Length > mCapacity - mLength)
+            {
+                mFailed = true;
+                break;
+            }
+            memcpy(mData + mLength, event.blockdata.Data, event.blockdata.Length);
+            mLength += event.blockdata.Length;
+            mDone   = event.blockdata.IsEof;
+            mFailed = mFailed || (mTransfer.PrepareBlockAck() != CHIP_NO_ERROR);
+            break;
+        default:
+            mFailed = true;
+            break;
+        }
+    }
+};
+
+
+/**
+ * Transfer the file at filePath from sender to receiver in Sender Drive mode, with the given window size and response timeout.
+ * Return false if either end failed, or if the transfer did not finish within maxWaitMs.
+ */
+inline bool RunLoopbackTransfer(chip::Test::MessagingContext & ctx, TestSender & sender, TestReceiver & receiver,
+                                const char * filePath, uint16_t blockSize, uint8_t windowSize, uint32_t timeoutMs,
+                                uint32_t pollFreqMs, unsigned maxWaitMs)
+{
+    static constexpr uint8_t kFileDesignator[] = "image.bin";
+
+    sender.mDone     = false;
+    sender.mFailed   = false;
+    receiver.mLength = 0;
+    receiver.mDone   = false;
+    receiver.mFailed = false;
+
+    Messaging::ExchangeManager & exchangeMgr = ctx.GetExchangeManager();
+    VerifyOrReturnError(sender.mSource.Open(filePath) == CHIP_NO_ERROR, false);
+    VerifyOrReturnError(sender.PrepareForTransfer(&ctx.GetSystemLayer(), TransferRole::kSender, TransferControlFlags::kSenderDrive,
+                                                  blockSize, timeoutMs, windowSize, pollFreqMs) == CHIP_NO_ERROR,
+                        false);
+    VerifyOrReturnError(exchangeMgr.RegisterUnsolicitedMessageHandlerForType(MessageType::ReceiveInit, &sender) == CHIP_NO_ERROR,
+                        false);
+
+    TransferSession::TransferInitData initData;
+    initData.TransferCtlFlags = TransferControlFlags::kSenderDrive;
+    initData.MaxBlockSize     = blockSize;
+    initData.FileDesignator   = kFileDesignator;
+    initData.FileDesLength    = static_cast<uint16_t>(sizeof(kFileDesignator) - 1);
+
+    Messaging::ExchangeContext * ec = ctx.NewExchangeToPeer(&receiver);
+    bool started                    = (ec != nullptr) &&
+        (receiver.InitiateTransfer(&ctx.GetSystemLayer(), ec, TransferRole::kReceiver, initData, timeoutMs, windowSize,
+                                   pollFreqMs) == CHIP_NO_ERROR);
+    if (started)
+    {
+        ctx.DriveIOUntil(maxWaitMs, [&sender, &receiver] {
+            return (sender.mDone && receiver.mDone) || sender.mFailed || receiver.mFailed;
+        });
+    }
+    const bool succeeded = started && sender.mDone && !sender.mFailed && receiver.mDone && !receiver.mFailed;
+
+    // Let the last acknowledgements arrive before the next transfer.
+    Messaging::ReliableMessageMgr * rm = exchangeMgr.GetReliableMessageMgr();
+    ctx.DriveIOUntil(1000, [rm] { return rm->TestGetCountRetransTable() == 0; });
+
+    exchangeMgr.UnregisterUnsolicitedMessageHandlerForType(MessageType::ReceiveInit);
+    sender.ResetTransfer();
+    receiver.ResetTransfer();
+    sender.mSource.Close();
+
+    return succeeded && rm->TestGetCountRetransTable() == 0;
+}
+
+} // namespace Test
+} // namespace bdx
+} // namespace chip
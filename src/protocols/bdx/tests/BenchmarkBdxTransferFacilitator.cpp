@@ -0,0 +1,164 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the throughput of BDX transfers
+ *      against the window size, over a loopback transport with latency. It is
+ *      built with chip_build_benchmarks and is not part of the unit tests.
+ */
+
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/bdx/tests/BdxTransferTestHelpers.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <transport/TransportMgr.h>
+
+#include <nlunit-test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::bdx;
+using namespace chip::bdx::Test;
+
+using TestContext = chip::Test::MessagingContext;
+
+TestContext sContext;
+
+constexpr uint16_t kBlockSize = 1024;
+constexpr size_t kFileSize    = 1024 * 1024;
+constexpr uint32_t kTimeoutMs = 5000;
+constexpr unsigned kMaxWaitMs = 60000;
+
+TransportMgrBase gTransportMgr;
+DelayedLoopbackTransport gTransport;
+
+uint8_t gFileData[kFileSize];
+uint8_t gReceivedData[kFileSize];
+char gFilePath[] = "/tmp/BenchmarkBdxTransferFacilitator.XXXXXX";
+
+void BenchmarkWindowThroughput(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    static TestSender sender;
+    static TestReceiver receiver;
+    receiver.SetBuffer(gReceivedData, sizeof(gReceivedData));
+
+    const uint8_t windowSizes[] = { 1, 2, 4, 8 };
+    for (uint8_t windowSize : windowSizes)
+    {
+        VerifyOrReturn(windowSize <= CHIP_CONFIG_BDX_MAX_WINDOW_SIZE);
+
+        uint64_t start = System::Clock::GetMonotonicMilliseconds();
+        bool succeeded = RunLoopbackTransfer(ctx, sender, receiver, gFilePath, kBlockSize, windowSize, kTimeoutMs,
+                                             TransferFacilitator::kDefaultPollFreqMs, kMaxWaitMs);
+        uint64_t elapsedMs = chip::max<uint64_t>(System::Clock::GetMonotonicMilliseconds() - start, 1);
+
+        NL_TEST_ASSERT(inSuite, succeeded);
+        NL_TEST_ASSERT(inSuite, receiver.mLength == kFileSize && memcmp(gReceivedData, gFileData, kFileSize) == 0);
+
+        double megabytesPerSecond = static_cast<double>(kFileSize) / 1000.0 / static_cast<double>(elapsedMs);
+        printf("BDX window %u with %u ms latency: %u bytes in %u ms, %.2f MB/s\n", windowSize,
+               static_cast<unsigned>(kLoopbackLatencyMs), static_cast<unsigned>(kFileSize), static_cast<unsigned>(elapsedMs),
+               megabytesPerSecond);
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Benchmark BDX window throughput", BenchmarkWindowThroughput),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext);
+int Finalize(void * aContext);
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Benchmark-CHIP-BdxTransferFacilitator",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+int Initialize(void * aContext)
+{
+    CHIP_ERROR err = chip::Platform::MemoryInit();
+    if (err != CHIP_NO_ERROR)
+        return FAILURE;
+
+    for (size_t i = 0; i < kFileSize; i++)
+    {
+        gFileData[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+
+    int fd = mkstemp(gFilePath);
+    if (fd < 0)
+        return FAILURE;
+    ssize_t written = write(fd, gFileData, kFileSize);
+    close(fd);
+    if (written != static_cast<ssize_t>(kFileSize))
+        return FAILURE;
+
+    gTransportMgr.Init(&gTransport);
+
+    auto * ctx = reinterpret_cast<TestContext *>(aContext);
+    err        = ctx->Init(&sSuite, &gTransportMgr);
+    if (err != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    gTransportMgr.SetSecureSessionMgr(&ctx->GetSecureSessionManager());
+    gTransport.SetSystemLayer(&ctx->GetSystemLayer());
+    return SUCCESS;
+}
+
+int Finalize(void * aContext)
+{
+    unlink(gFilePath);
+
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    chip::Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+int BenchmarkBdxTransferFacilitator()
+{
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkBdxTransferFacilitator)
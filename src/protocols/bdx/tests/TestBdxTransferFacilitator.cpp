@@ -0,0 +1,214 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the BDX TransferFacilitator and FileBlockSource, with transfers over a transport
+ *      that has latency and may lose messages.
+ */
+
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/bdx/BdxFileBlockSource.h>
+#include <protocols/bdx/BdxTransferFacilitator.h>
+#include <protocols/bdx/tests/BdxTransferTestHelpers.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::bdx;
+using namespace chip::bdx::Test;
+using namespace chip::Messaging;
+
+using TestContext = chip::Test::MessagingContext;
+
+TestContext sContext;
+
+constexpr uint16_t kBlockSize       = 1024;
+constexpr size_t kFileSize          = 128 * 1024 + 100;
+constexpr uint32_t kTimeoutMs       = 5000;
+constexpr uint32_t kLossyTimeoutMs  = 200;
+constexpr uint32_t kLossyPollFreqMs = 10;
+
+TransportMgrBase gTransportMgr;
+DelayedLoopbackTransport gTransport;
+
+uint8_t gFileData[kFileSize];
+char gFilePath[] = "/tmp/TestBdxTransferFacilitator.XXXXXX";
+
+void TestFileBlockSource(nlTestSuite * inSuite, void * inContext)
+{
+    FileBlockSource source;
+    TransferSession::BlockData block;
+
+    NL_TEST_ASSERT(inSuite, source.GetBlock(0, kBlockSize, block) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, source.Open("/nonexistent/TestBdxTransferFacilitator") == CHIP_ERROR_OPEN_FAILED);
+
+    NL_TEST_ASSERT(inSuite, source.Open(gFilePath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, source.GetSize() == kFileSize);
+
+    // Blocks point into the file, and the last one is marked as such.
+    NL_TEST_ASSERT(inSuite, source.GetBlock(kBlockSize, kBlockSize, block) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, block.Length == kBlockSize && !block.IsEof);
+    NL_TEST_ASSERT(inSuite, memcmp(block.Data, gFileData + kBlockSize, kBlockSize) == 0);
+
+    NL_TEST_ASSERT(inSuite, source.GetBlock(kFileSize - 100, kBlockSize, block) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, block.Length == 100 && block.IsEof);
+    NL_TEST_ASSERT(inSuite, memcmp(block.Data, gFileData + kFileSize - 100, 100) == 0);
+
+    NL_TEST_ASSERT(inSuite, source.GetBlock(kFileSize + 1, kBlockSize, block) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    source.Close();
+    NL_TEST_ASSERT(inSuite, source.GetBlock(0, kBlockSize, block) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+/**
+ * Transfer the test file from a TestSender to a TestReceiver with the given window size and response timeout.
+ */
+void RunTransfer(nlTestSuite * inSuite, TestContext & ctx, uint8_t windowSize, uint32_t timeoutMs = kTimeoutMs,
+                 uint32_t pollFreqMs = TransferFacilitator::kDefaultPollFreqMs)
+{
+    static TestSender sender;
+    static TestReceiver receiver;
+    static uint8_t receivedData[kFileSize];
+
+    receiver.SetBuffer(receivedData, sizeof(receivedData));
+
+    const bool succeeded =
+        RunLoopbackTransfer(ctx, sender, receiver, gFilePath, kBlockSize, windowSize, timeoutMs, pollFreqMs, kTimeoutMs);
+    NL_TEST_ASSERT(inSuite, succeeded);
+    NL_TEST_ASSERT(inSuite, receiver.mLength == kFileSize);
+    NL_TEST_ASSERT(inSuite, memcmp(receiver.mData, gFileData, kFileSize) == 0);
+}
+
+void TestTransfer(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    const uint8_t windowSizes[] = { 1, 4 };
+    for (uint8_t windowSize : windowSizes)
+    {
+        RunTransfer(inSuite, ctx, windowSize);
+    }
+}
+
+void TestLossyTransfer(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Lost Blocks and BlockAcks are sent again by the TransferSession, and lost messages that are sent reliably by the
+    // ExchangeContext.
+    gTransport.SetDropInterval(41);
+    RunTransfer(inSuite, ctx, 4, kLossyTimeoutMs, kLossyPollFreqMs);
+    gTransport.SetDropInterval(0);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("FileBlockSource", TestFileBlockSource),
+    NL_TEST_DEF("Transfer", TestTransfer),
+    NL_TEST_DEF("LossyTransfer", TestLossyTransfer),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext);
+int Finalize(void * aContext);
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Test-CHIP-BdxTransferFacilitator",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+/**
+ *  Initialize the test suite, and write the file that is transferred.
+ */
+int Initialize(void * aContext)
+{
+    CHIP_ERROR err = chip::Platform::MemoryInit();
+    if (err != CHIP_NO_ERROR)
+        return FAILURE;
+
+    for (size_t i = 0; i < kFileSize; i++)
+    {
+        gFileData[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+
+    int fd = mkstemp(gFilePath);
+    if (fd < 0)
+        return FAILURE;
+    ssize_t written = write(fd, gFileData, kFileSize);
+    close(fd);
+    if (written != static_cast<ssize_t>(kFileSize))
+        return FAILURE;
+
+    gTransportMgr.Init(&gTransport);
+
+    auto * ctx = reinterpret_cast<TestContext *>(aContext);
+    err        = ctx->Init(&sSuite, &gTransportMgr);
+    if (err != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    gTransportMgr.SetSecureSessionMgr(&ctx->GetSecureSessionManager());
+    gTransport.SetSystemLayer(&ctx->GetSystemLayer());
+    return SUCCESS;
+}
+
+/**
+ *  Finalize the test suite.
+ */
+int Finalize(void * aContext)
+{
+    unlink(gFilePath);
+
+    CHIP_ERROR err = reinterpret_cast<TestContext *>(aContext)->Shutdown();
+    chip::Platform::MemoryShutdown();
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+} // namespace
+
+/**
+ *  Main
+ */
+int TestBdxTransferFacilitator()
+{
+    nlTestRunner(&sSuite, &sContext);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBdxTransferFacilitator)
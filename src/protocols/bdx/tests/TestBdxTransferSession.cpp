@@ -129,10 +129,11 @@ void VerifyStatusReport(nlTestSuite * inSuite, void * inContext, const System::P
     NL_TEST_ASSERT(inSuite, report.GetProtocolCode() == static_cast<uint16_t>(code));
 }
 
-void VerifyNoMoreOutput(nlTestSuite * inSuite, void * inContext, TransferSession & transferSession)
+void VerifyNoMoreOutput(nlTestSuite * inSuite, void * inContext, TransferSession & transferSession,
+                        uint64_t curTimeMs = kNoAdvanceTime)
 {
     TransferSession::OutputEvent event;
-    transferSession.PollOutput(event, kNoAdvanceTime);
+    transferSession.PollOutput(event, curTimeMs);
     NL_TEST_ASSERT(inSuite, event.EventType == TransferSession::OutputEventType::kNone);
 }
 
@@ -348,6 +349,52 @@ void SendAndVerifyBlockAck(nlTestSuite * inSuite, void * inContext, TransferSess
     VerifyNoMoreOutput(inSuite, inContext, ackReceiver);
 }
 
+// Helper method for preparing a Block message whose data is a single byte with the value of its block counter, and returning the
+// message instead of passing it to a receiver.
+System::PacketBufferHandle PrepareCountedBlock(nlTestSuite * inSuite, void * inContext, TransferSession & sender, uint8_t counter,
+                                               bool isEof)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession::BlockData blockData;
+    blockData.Data   = &counter;
+    blockData.Length = 1;
+    blockData.IsEof  = isEof;
+
+    NL_TEST_ASSERT(inSuite, sender.CanPrepareBlock());
+    CHIP_ERROR err = sender.PrepareBlock(blockData);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    sender.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kMsgToSend);
+    VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, isEof ? MessageType::BlockEOF : MessageType::Block);
+    VerifyNoMoreOutput(inSuite, inContext, sender);
+
+    return std::move(outEvent.MsgData);
+}
+
+// Helper method for verifying that the receiver outputs the Block prepared by PrepareCountedBlock() for the given counter.
+void VerifyCountedBlock(nlTestSuite * inSuite, void * inContext, TransferSession & receiver, uint8_t counter, bool isEof,
+                        uint64_t curTimeMs = kNoAdvanceTime)
+{
+    TransferSession::OutputEvent outEvent;
+    receiver.PollOutput(outEvent, curTimeMs);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kBlockReceived);
+    if (outEvent.EventType == TransferSession::OutputEventType::kBlockReceived)
+    {
+        NL_TEST_ASSERT(inSuite, outEvent.blockdata.Length == 1 && outEvent.blockdata.Data[0] == counter);
+        NL_TEST_ASSERT(inSuite, outEvent.blockdata.IsEof == isEof);
+    }
+}
+
+// Helper method for passing a message to a TransferSession at the given time, and verifying the event it outputs.
+void PassAndVerifyOutput(nlTestSuite * inSuite, TransferSession & session, System::PacketBufferHandle msg, uint64_t curTimeMs,
+                         TransferSession::OutputEvent & outEvent, TransferSession::OutputEventType expected)
+{
+    CHIP_ERROR err = session.HandleMessageReceived(std::move(msg), curTimeMs);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    session.PollOutput(outEvent, curTimeMs);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == expected);
+}
+
 // Test a full transfer using a responding receiver and an initiating sender, receiver drive.
 void TestInitiatingReceiverReceiverDrive(nlTestSuite * inSuite, void * inContext)
 {
@@ -720,6 +767,325 @@ void TestDuplicateBlockError(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+// Test a Sender Drive transfer with a window of Blocks in flight, where Blocks arrive out of order and BlockAcks are cumulative.
+void TestWindowedSenderDrive(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+    System::PacketBufferHandle blocks[5];
+    System::PacketBufferHandle staleAck;
+
+    // Chosen arbitrarily for this test
+    uint16_t blockSize = 16;
+    uint32_t timeoutMs = 1000 * 24;
+    uint8_t windowSize = 4;
+
+    // Chosen specifically for this test
+    TransferControlFlags driveMode = TransferControlFlags::kSenderDrive;
+
+    NL_TEST_ASSERT(inSuite, respondingSender.SetWindowSize(0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, respondingSender.SetWindowSize(CHIP_CONFIG_BDX_MAX_WINDOW_SIZE + 1) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, respondingSender.SetWindowSize(windowSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, initiatingReceiver.SetWindowSize(windowSize) == CHIP_NO_ERROR);
+
+    // ReceiveInit parameters
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> senderOpts;
+    senderOpts.Set(driveMode);
+
+    SendAndVerifyTransferInit(inSuite, inContext, outEvent, timeoutMs, initiatingReceiver, TransferRole::kReceiver, initOptions,
+                              respondingSender, senderOpts, blockSize);
+    NL_TEST_ASSERT(inSuite, respondingSender.SetWindowSize(1) == CHIP_ERROR_INCORRECT_STATE);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = respondingSender.GetControlMode();
+    acceptData.MaxBlockSize = blockSize;
+    acceptData.StartOffset  = 0;
+    acceptData.Length       = 0;
+
+    SendAndVerifyAcceptMsg(inSuite, inContext, outEvent, respondingSender, TransferRole::kSender, acceptData, initiatingReceiver,
+                           initOptions);
+
+    // The sender fills its window without waiting for BlockAcks
+    for (uint8_t i = 0; i < windowSize; i++)
+    {
+        blocks[i] = PrepareCountedBlock(inSuite, inContext, respondingSender, i, false);
+    }
+    NL_TEST_ASSERT(inSuite, !respondingSender.CanPrepareBlock());
+    uint8_t extraData = 0;
+    TransferSession::BlockData blockData;
+    blockData.Data   = &extraData;
+    blockData.Length = 1;
+    NL_TEST_ASSERT(inSuite, respondingSender.PrepareBlock(blockData) == CHIP_ERROR_INCORRECT_STATE);
+
+    // Block 0 is acknowledged, which makes room for the BlockEOF
+    err = initiatingReceiver.HandleMessageReceived(std::move(blocks[0]), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyCountedBlock(inSuite, inContext, initiatingReceiver, 0, false);
+    err = initiatingReceiver.PrepareBlockAck();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kMsgToSend);
+    staleAck = outEvent.MsgData.CloneData();
+    err      = respondingSender.HandleMessageReceived(std::move(outEvent.MsgData), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    respondingSender.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kAckReceived);
+    blocks[4] = PrepareCountedBlock(inSuite, inContext, respondingSender, 4, true);
+    NL_TEST_ASSERT(inSuite, !respondingSender.CanPrepareBlock());
+
+    // Block 2 arrives ahead of Block 1, and is held back until Block 1 is received
+    err = initiatingReceiver.HandleMessageReceived(std::move(blocks[2]), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyNoMoreOutput(inSuite, inContext, initiatingReceiver);
+    err = initiatingReceiver.HandleMessageReceived(std::move(blocks[1]), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyCountedBlock(inSuite, inContext, initiatingReceiver, 1, false);
+    VerifyCountedBlock(inSuite, inContext, initiatingReceiver, 2, false);
+    VerifyNoMoreOutput(inSuite, inContext, initiatingReceiver);
+
+    // One BlockAck acknowledges both
+    SendAndVerifyBlockAck(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, false);
+
+    // The BlockEOF also arrives ahead of Block 3
+    err = initiatingReceiver.HandleMessageReceived(std::move(blocks[4]), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyNoMoreOutput(inSuite, inContext, initiatingReceiver);
+    err = initiatingReceiver.HandleMessageReceived(std::move(blocks[3]), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyCountedBlock(inSuite, inContext, initiatingReceiver, 3, false);
+    VerifyCountedBlock(inSuite, inContext, initiatingReceiver, 4, true);
+    SendAndVerifyBlockAck(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, true);
+
+    // A BlockAck overtaken by later ones is ignored
+    err = respondingSender.HandleMessageReceived(std::move(staleAck), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyNoMoreOutput(inSuite, inContext, respondingSender);
+}
+
+// Test that a windowed receiver rejects Blocks that are outside of its window.
+void TestWindowedBadBlockCounter(nlTestSuite * inSuite, void * inContext)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+    System::PacketBufferHandle blocks[3];
+
+    // Chosen arbitrarily for this test
+    uint16_t blockSize = 16;
+    uint32_t timeoutMs = 1000 * 24;
+
+    // Chosen specifically for this test
+    TransferControlFlags driveMode = TransferControlFlags::kSenderDrive;
+
+    // The sender's window is larger than the receiver's
+    NL_TEST_ASSERT(inSuite, initiatingSender.SetWindowSize(3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, respondingReceiver.SetWindowSize(2) == CHIP_NO_ERROR);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> receiverOpts;
+    receiverOpts.Set(driveMode);
+
+    SendAndVerifyTransferInit(inSuite, inContext, outEvent, timeoutMs, initiatingSender, TransferRole::kSender, initOptions,
+                              respondingReceiver, receiverOpts, blockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = respondingReceiver.GetControlMode();
+    acceptData.MaxBlockSize = blockSize;
+
+    SendAndVerifyAcceptMsg(inSuite, inContext, outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender,
+                           initOptions);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        blocks[i] = PrepareCountedBlock(inSuite, inContext, initiatingSender, i, false);
+    }
+
+    // Block 2 is too far ahead of Block 0 for the receiver to hold it
+    CHIP_ERROR err = respondingReceiver.HandleMessageReceived(std::move(blocks[2]), kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    respondingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kMsgToSend);
+    VerifyStatusReport(inSuite, inContext, outEvent.MsgData, StatusCode::kBadBlockCounter);
+    respondingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kInternalError);
+}
+
+// Test that a windowed sender sends the Blocks that were not acknowledged again when the timeout passes, and that the receiver
+// acknowledges the ones it already received again.
+void TestWindowedResend(nlTestSuite * inSuite, void * inContext)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+    System::PacketBufferHandle blocks[4];
+    System::PacketBufferHandle resent[3];
+
+    // Chosen arbitrarily for this test
+    uint16_t blockSize = 16;
+    uint32_t timeoutMs = 24;
+    uint8_t windowSize = 3;
+
+    // Chosen specifically for this test
+    TransferControlFlags driveMode = TransferControlFlags::kSenderDrive;
+    using OutputEventType          = TransferSession::OutputEventType;
+
+    NL_TEST_ASSERT(inSuite, initiatingSender.SetWindowSize(windowSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, respondingReceiver.SetWindowSize(windowSize) == CHIP_NO_ERROR);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> receiverOpts;
+    receiverOpts.Set(driveMode);
+
+    SendAndVerifyTransferInit(inSuite, inContext, outEvent, timeoutMs, initiatingSender, TransferRole::kSender, initOptions,
+                              respondingReceiver, receiverOpts, blockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = respondingReceiver.GetControlMode();
+    acceptData.MaxBlockSize = blockSize;
+
+    SendAndVerifyAcceptMsg(inSuite, inContext, outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender,
+                           initOptions);
+
+    for (uint8_t i = 0; i < windowSize; i++)
+    {
+        blocks[i] = PrepareCountedBlock(inSuite, inContext, initiatingSender, i, false);
+    }
+
+    // Block 0 is acknowledged, Block 1 is lost, and Block 2 is held back by the receiver
+    PassAndVerifyOutput(inSuite, respondingReceiver, std::move(blocks[0]), kNoAdvanceTime, outEvent,
+                        OutputEventType::kBlockReceived);
+    NL_TEST_ASSERT(inSuite, respondingReceiver.PrepareBlockAck() == CHIP_NO_ERROR);
+    respondingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == OutputEventType::kMsgToSend);
+    PassAndVerifyOutput(inSuite, initiatingSender, std::move(outEvent.MsgData), kNoAdvanceTime, outEvent,
+                        OutputEventType::kAckReceived);
+    PassAndVerifyOutput(inSuite, respondingReceiver, std::move(blocks[2]), kNoAdvanceTime, outEvent, OutputEventType::kNone);
+
+    // The BlockEOF is lost too
+    blocks[3] = PrepareCountedBlock(inSuite, inContext, initiatingSender, 3, true);
+    blocks[3] = nullptr;
+
+    // When the timeout passes, the sender sends the Blocks from the first one that was not acknowledged again, before any new one
+    uint64_t curTimeMs = timeoutMs - 1;
+    VerifyNoMoreOutput(inSuite, inContext, initiatingSender, curTimeMs);
+    curTimeMs = timeoutMs;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        initiatingSender.PollOutput(outEvent, curTimeMs);
+        NL_TEST_ASSERT(inSuite, outEvent.EventType == OutputEventType::kMsgToSend);
+        VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, (i == 2) ? MessageType::BlockEOF : MessageType::Block);
+        resent[i] = std::move(outEvent.MsgData);
+    }
+    VerifyNoMoreOutput(inSuite, inContext, initiatingSender, curTimeMs);
+
+    // The receiver takes Block 1 and the Block it held back, and acknowledges them again when Block 2 arrives a second time
+    PassAndVerifyOutput(inSuite, respondingReceiver, std::move(resent[0]), curTimeMs, outEvent, OutputEventType::kBlockReceived);
+    VerifyCountedBlock(inSuite, inContext, respondingReceiver, 2, false, curTimeMs);
+    VerifyNoMoreOutput(inSuite, inContext, respondingReceiver, curTimeMs);
+    PassAndVerifyOutput(inSuite, respondingReceiver, std::move(resent[1]), curTimeMs, outEvent, OutputEventType::kMsgToSend);
+    VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, MessageType::BlockAck);
+    PassAndVerifyOutput(inSuite, initiatingSender, std::move(outEvent.MsgData), curTimeMs, outEvent, OutputEventType::kAckReceived);
+
+    // The BlockAckEOF is lost, so the sender sends the BlockEOF again, and the receiver acknowledges it again
+    PassAndVerifyOutput(inSuite, respondingReceiver, std::move(resent[2]), curTimeMs, outEvent, OutputEventType::kBlockReceived);
+    NL_TEST_ASSERT(inSuite, outEvent.blockdata.IsEof);
+    NL_TEST_ASSERT(inSuite, respondingReceiver.PrepareBlockAck() == CHIP_NO_ERROR);
+    respondingReceiver.PollOutput(outEvent, curTimeMs);
+    VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, MessageType::BlockAckEOF);
+
+    curTimeMs += timeoutMs;
+    initiatingSender.PollOutput(outEvent, curTimeMs);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == OutputEventType::kMsgToSend);
+    VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, MessageType::BlockEOF);
+    VerifyNoMoreOutput(inSuite, inContext, initiatingSender, curTimeMs);
+
+    PassAndVerifyOutput(inSuite, respondingReceiver, std::move(outEvent.MsgData), curTimeMs, outEvent, OutputEventType::kMsgToSend);
+    VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, MessageType::BlockAckEOF);
+    PassAndVerifyOutput(inSuite, initiatingSender, std::move(outEvent.MsgData), curTimeMs, outEvent,
+                        OutputEventType::kAckEOFReceived);
+    VerifyNoMoreOutput(inSuite, inContext, initiatingSender, curTimeMs + timeoutMs);
+}
+
+// Test that a windowed sender gives up after CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS resends, and that the receiver waits for them.
+void TestWindowedResendTimeout(nlTestSuite * inSuite, void * inContext)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+
+    // Chosen arbitrarily for this test
+    uint16_t blockSize = 16;
+    uint32_t timeoutMs = 24;
+    uint8_t windowSize = 2;
+
+    // Chosen specifically for this test
+    TransferControlFlags driveMode = TransferControlFlags::kSenderDrive;
+
+    NL_TEST_ASSERT(inSuite, initiatingSender.SetWindowSize(windowSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, respondingReceiver.SetWindowSize(windowSize) == CHIP_NO_ERROR);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> receiverOpts;
+    receiverOpts.Set(driveMode);
+
+    SendAndVerifyTransferInit(inSuite, inContext, outEvent, timeoutMs, initiatingSender, TransferRole::kSender, initOptions,
+                              respondingReceiver, receiverOpts, blockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = respondingReceiver.GetControlMode();
+    acceptData.MaxBlockSize = blockSize;
+
+    SendAndVerifyAcceptMsg(inSuite, inContext, outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender,
+                           initOptions);
+
+    // Block 0 and all of its resends are lost
+    PrepareCountedBlock(inSuite, inContext, initiatingSender, 0, false);
+
+    uint64_t curTimeMs = kNoAdvanceTime;
+    for (int i = 0; i < CHIP_CONFIG_BDX_MAX_WINDOW_RESENDS; i++)
+    {
+        curTimeMs += timeoutMs;
+        initiatingSender.PollOutput(outEvent, curTimeMs);
+        NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kMsgToSend);
+        VerifyBdxMessageType(inSuite, inContext, outEvent.MsgData, MessageType::Block);
+        VerifyNoMoreOutput(inSuite, inContext, initiatingSender, curTimeMs);
+        VerifyNoMoreOutput(inSuite, inContext, respondingReceiver, curTimeMs);
+    }
+
+    curTimeMs += timeoutMs;
+    initiatingSender.PollOutput(outEvent, curTimeMs);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kTransferTimeout);
+    respondingReceiver.PollOutput(outEvent, curTimeMs);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kTransferTimeout);
+}
+
 // Test Suite
 
 /**
@@ -733,6 +1099,10 @@ static const nlTest sTests[] =
     NL_TEST_DEF("TestBadAcceptMessageFields", TestBadAcceptMessageFields),
     NL_TEST_DEF("TestTimeout", TestTimeout),
     NL_TEST_DEF("TestDuplicateBlockError", TestDuplicateBlockError),
+    NL_TEST_DEF("TestWindowedSenderDrive", TestWindowedSenderDrive),
+    NL_TEST_DEF("TestWindowedBadBlockCounter", TestWindowedBadBlockCounter),
+    NL_TEST_DEF("TestWindowedResend", TestWindowedResend),
+    NL_TEST_DEF("TestWindowedResendTimeout", TestWindowedResendTimeout),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -18,6 +18,7 @@
 #include <protocols/secure_channel/CASEServer.h>
 
 #include <core/CHIPError.h>
+#include <protocols/secure_channel/StatusReport.h>
 #include <support/CodeUtils.h>
 #include <support/SafeInt.h>
 #include <support/logging/CHIPLogging.h>
@@ -31,19 +32,26 @@ namespace chip {
 
 CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, TransportMgrBase * transportMgr,
                                                      SecureSessionMgr * sessionMgr, Transport::AdminPairingTable * admins,
-                                                     SessionIDAllocator * idAllocator)
+                                                     SessionIDAllocator * idAllocator,
+                                                     SessionResumptionStorage * resumptionStorage)
 {
     VerifyOrReturnError(transportMgr != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(exchangeManager != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(sessionMgr != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(admins != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    mSessionMgr      = sessionMgr;
-    mAdmins          = admins;
-    mExchangeManager = exchangeManager;
-    mIDAllocator     = idAllocator;
+    mSessionMgr        = sessionMgr;
+    mAdmins            = admins;
+    mExchangeManager   = exchangeManager;
+    mIDAllocator       = idAllocator;
+    mResumptionStorage = resumptionStorage;
 
-    ReturnErrorOnFailure(mPairingSession.MessageDispatch().Init(transportMgr));
+    for (Handshake & handshake : mHandshakes)
+    {
+        handshake.mServer = this;
+        ReturnErrorOnFailure(handshake.mPairingSession.MessageDispatch().Init(transportMgr));
+    }
+    ReturnErrorOnFailure(mBusyDispatch.Init(transportMgr));
 
     ExchangeDelegate * delegate = this;
     ReturnErrorOnFailure(
@@ -51,75 +59,170 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec)
+CHIP_ERROR CASEServer::InitCASEHandshake(Handshake & handshake, Messaging::ExchangeContext * ec)
 {
     ReturnErrorCodeIf(ec == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    Cleanup();
+    handshake.Cleanup();
 
     // TODO - Use PK of the root CA for the initiator to figure out the admin.
-    mAdminId = ec->GetSecureSession().GetAdminId();
+    handshake.mAdminId = ec->GetSecureSession().GetAdminId();
 
     // TODO - Use section [4.368] and definition of `Destination Identifier` to find admin ID for CASE SigmaR1 message
-    //    ReturnErrorCodeIf(mAdminId == Transport::kUndefinedAdminId, CHIP_ERROR_INVALID_ARGUMENT);
-    mAdminId = 0;
+    //    ReturnErrorCodeIf(handshake.mAdminId == Transport::kUndefinedAdminId, CHIP_ERROR_INVALID_ARGUMENT);
+    handshake.mAdminId = 0;
 
-    Transport::AdminPairingInfo * admin = mAdmins->FindAdminWithId(mAdminId);
+    Transport::AdminPairingInfo * admin = mAdmins->FindAdminWithId(handshake.mAdminId);
 
     if (admin == nullptr)
     {
-        ReturnErrorOnFailure(mAdmins->LoadFromStorage(mAdminId));
-        admin = mAdmins->FindAdminWithId(mAdminId);
+        ReturnErrorOnFailure(mAdmins->LoadFromStorage(handshake.mAdminId));
+        admin = mAdmins->FindAdminWithId(handshake.mAdminId);
     }
     ReturnErrorCodeIf(admin == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    ReturnErrorOnFailure(admin->GetCredentials(mCredentials, mCertificates, mRootKeyId));
+    ReturnErrorOnFailure(admin->GetCachedCredentials(handshake.mCredentials));
 
-    ReturnErrorOnFailure(mIDAllocator->Allocate(mSessionKeyId));
+    ReturnErrorOnFailure(mIDAllocator->Allocate(handshake.mSessionKeyId));
 
     // Setup CASE state machine using the credentials for the current admin.
-    ReturnErrorOnFailure(mPairingSession.ListenForSessionEstablishment(&mCredentials, mSessionKeyId, this));
+    CHIP_ERROR err =
+        handshake.mPairingSession.ListenForSessionEstablishment(handshake.mCredentials->GetOperationalCredentialSet(),
+                                                                handshake.mSessionKeyId, &handshake);
+    if (err != CHIP_NO_ERROR)
+    {
+        mIDAllocator->Free(handshake.mSessionKeyId);
+        handshake.Cleanup();
+        return err;
+    }
+
+    handshake.mPairingSession.EnableSessionResumption(mResumptionStorage, handshake.mAdminId);
 
     // Hand over the exchange context to the CASE session.
-    ec->SetDelegate(&mPairingSession);
+    ec->SetDelegate(&handshake.mPairingSession);
+    handshake.mInUse = true;
 
     return CHIP_NO_ERROR;
 }
 
+Messaging::ExchangeMessageDispatch * CASEServer::GetMessageDispatch(Messaging::ReliableMessageMgr * reliableMessageManager,
+                                                                    SecureSessionMgr * sessionMgr)
+{
+    // This is asked for when the exchange of a SigmaR1 message is created, just before the message is delivered to
+    // OnMessageReceived, so the handshake found here is still free when the message gets there.
+    Handshake * handshake = FindFreeHandshake();
+    if (handshake == nullptr)
+    {
+        return &mBusyDispatch;
+    }
+
+    return handshake->mPairingSession.GetMessageDispatch(reliableMessageManager, sessionMgr);
+}
+
 CHIP_ERROR CASEServer::OnMessageReceived(Messaging::ExchangeContext * ec, const PacketHeader & packetHeader,
                                          const PayloadHeader & payloadHeader, System::PacketBufferHandle && payload)
 {
+    Handshake * handshake = FindHandshake(ec->GetMessageDispatch());
+    if (handshake == nullptr || handshake->mInUse)
+    {
+        // Shed the new handshake rather than dropping one that is already in progress.
+        ChipLogError(Inet, "CASE Server received SigmaR1 message with all handshakes in progress. EC %p", ec);
+        SendBusyStatusReport(ec);
+        return CHIP_NO_ERROR;
+    }
+
     ChipLogProgress(Inet, "CASE Server received SigmaR1 message. Starting handshake. EC %p", ec);
-    ReturnErrorOnFailure(InitCASEHandshake(ec));
+    ReturnErrorOnFailure(InitCASEHandshake(*handshake, ec));
 
-    mPairingSession.OnMessageReceived(ec, packetHeader, payloadHeader, std::move(payload));
+    handshake->mPairingSession.OnMessageReceived(ec, packetHeader, payloadHeader, std::move(payload));
 
     return CHIP_NO_ERROR;
-    // TODO - Enable multiple concurrent CASE session establishment
 }
 
-void CASEServer::Cleanup()
+size_t CASEServer::GetActiveHandshakeCount() const
 {
-    // Let's re-register for CASE SigmaR1 message, so that the next CASE session setup request can be processed.
+    size_t count = 0;
+    for (const Handshake & handshake : mHandshakes)
+    {
+        if (handshake.mInUse)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+CASEServer::Handshake * CASEServer::FindFreeHandshake()
+{
+    for (Handshake & handshake : mHandshakes)
+    {
+        if (!handshake.mInUse)
+        {
+            return &handshake;
+        }
+    }
+    return nullptr;
+}
+
+CASEServer::Handshake * CASEServer::FindHandshake(const Messaging::ExchangeMessageDispatch * dispatch)
+{
+    for (Handshake & handshake : mHandshakes)
+    {
+        if (dispatch == &handshake.mPairingSession.MessageDispatch())
+        {
+            return &handshake;
+        }
+    }
+    return nullptr;
+}
+
+void CASEServer::SendBusyStatusReport(Messaging::ExchangeContext * ec)
+{
+    Protocols::SecureChannel::StatusReport report(Protocols::SecureChannel::GeneralStatusCode::kBusy,
+                                                  Protocols::SecureChannel::Id.ToFullyQualifiedSpecForm(),
+                                                  Protocols::SecureChannel::kProtocolCodeGeneralFailure);
+    size_t msgSize = report.Size();
+    Encoding::LittleEndian::PacketBufferWriter bbuf(System::PacketBufferHandle::New(msgSize), msgSize);
+    VerifyOrReturn(!bbuf.IsNull(), ChipLogError(Inet, "Failed to allocate busy status report"));
+
+    report.WriteToBuffer(bbuf);
+    System::PacketBufferHandle msg = bbuf.Finalize();
+    VerifyOrReturn(!msg.IsNull(), ChipLogError(Inet, "Failed to encode busy status report"));
+
+    // Nothing is kept for the rejected peer, so do not ask it for an acknowledgment that would be retransmitted for.
+    CHIP_ERROR err = ec->SendMessage(Protocols::SecureChannel::MsgType::StatusReport, std::move(msg),
+                                     Messaging::SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to send busy status report: err %s", ErrorStr(err));
+    }
+}
+
+void CASEServer::Handshake::Cleanup()
+{
+    mInUse   = false;
     mAdminId = Transport::kUndefinedAdminId;
-    mCredentials.Release();
-    mCertificates.Release();
     mPairingSession.Clear();
+    if (mCredentials != nullptr)
+    {
+        mCredentials->Release();
+        mCredentials = nullptr;
+    }
 }
 
-void CASEServer::OnSessionEstablishmentError(CHIP_ERROR err)
+void CASEServer::Handshake::OnSessionEstablishmentError(CHIP_ERROR err)
 {
     ChipLogProgress(Inet, "CASE Session establishment failed: %s", ErrorStr(err));
-    mIDAllocator->Free(mSessionKeyId);
+    mServer->mIDAllocator->Free(mSessionKeyId);
     Cleanup();
 }
 
-void CASEServer::OnSessionEstablished()
+void CASEServer::Handshake::OnSessionEstablished()
 {
     ChipLogProgress(Inet, "CASE Session established. Setting up the secure channel.");
-    mSessionMgr->ExpireAllPairings(mPairingSession.PeerConnection().GetPeerNodeId(), mAdminId);
+    mServer->mSessionMgr->ExpireAllPairings(mPairingSession.PeerConnection().GetPeerNodeId(), mAdminId);
 
-    CHIP_ERROR err = mSessionMgr->NewPairing(
+    CHIP_ERROR err = mServer->mSessionMgr->NewPairing(
         Optional<Transport::PeerAddress>::Value(mPairingSession.PeerConnection().GetPeerAddress()),
         mPairingSession.PeerConnection().GetPeerNodeId(), &mPairingSession, SecureSession::SessionRole::kResponder, mAdminId);
     if (err != CHIP_NO_ERROR)
@@ -21,10 +21,11 @@
 #include <messaging/ExchangeMgr.h>
 #include <protocols/secure_channel/CASESession.h>
 #include <protocols/secure_channel/SessionIDAllocator.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
 
 namespace chip {
 
-class CASEServer : public SessionEstablishmentDelegate, public Messaging::ExchangeDelegate
+class CASEServer : public Messaging::ExchangeDelegate
 {
 public:
     CASEServer() {}
@@ -35,48 +36,78 @@ public:
             mExchangeManager->UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1);
         }
 
-        mCredentials.Release();
+        for (Handshake & handshake : mHandshakes)
+        {
+            handshake.Cleanup();
+        }
     }
 
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, TransportMgrBase * transportMgr,
                                              SecureSessionMgr * sessionMgr, Transport::AdminPairingTable * admins,
-                                             SessionIDAllocator * idAllocator);
-
-    //////////// SessionEstablishmentDelegate Implementation ///////////////
-    void OnSessionEstablishmentError(CHIP_ERROR error) override;
-    void OnSessionEstablished() override;
+                                             SessionIDAllocator * idAllocator,
+                                             SessionResumptionStorage * resumptionStorage = nullptr);
 
     //// ExchangeDelegate Implementation ////
     CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PacketHeader & packetHeader,
                                  const PayloadHeader & payloadHeader, System::PacketBufferHandle && payload) override;
     void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
     Messaging::ExchangeMessageDispatch * GetMessageDispatch(Messaging::ReliableMessageMgr * reliableMessageManager,
-                                                            SecureSessionMgr * sessionMgr) override
-    {
-        return mPairingSession.GetMessageDispatch(reliableMessageManager, sessionMgr);
-    }
+                                                            SecureSessionMgr * sessionMgr) override;
 
-    CASESession & GetSession() { return mPairingSession; }
+    /**
+     * The number of CASE handshakes currently in progress.
+     */
+    size_t GetActiveHandshakeCount() const;
 
 private:
+    /**
+     * The state of one CASE handshake in progress. Each handshake has its own
+     * CASE session, and with it the message dispatch that the exchange carrying
+     * the handshake was created with, so that responses go back to the right peer.
+     */
+    class Handshake : public SessionEstablishmentDelegate
+    {
+    public:
+        //////////// SessionEstablishmentDelegate Implementation ///////////////
+        void OnSessionEstablishmentError(CHIP_ERROR error) override;
+        void OnSessionEstablished() override;
+
+        void Cleanup();
+
+        CASEServer * mServer = nullptr;
+        bool mInUse          = false;
+
+        CASESession mPairingSession;
+        uint16_t mSessionKeyId = 0;
+
+        Transport::AdminId mAdminId = Transport::kUndefinedAdminId;
+
+        // The credentials of the admin, shared with the other handshakes.
+        Transport::AdminCredentials * mCredentials = nullptr;
+    };
+
     Messaging::ExchangeManager * mExchangeManager = nullptr;
 
-    CASESession mPairingSession;
-    uint16_t mSessionKeyId         = 0;
-    SecureSessionMgr * mSessionMgr = nullptr;
+    Handshake mHandshakes[CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES];
 
-    Transport::AdminId mAdminId = Transport::kUndefinedAdminId;
+    // Used by the exchanges of SigmaR1 messages that arrive while all handshakes are in progress,
+    // only to send them a busy status report.
+    SessionEstablishmentExchangeDispatch mBusyDispatch;
 
-    Transport::AdminPairingTable * mAdmins = nullptr;
-    Credentials::ChipCertificateSet mCertificates;
-    Credentials::OperationalCredentialSet mCredentials;
-    Credentials::CertificateKeyId mRootKeyId;
+    SecureSessionMgr * mSessionMgr = nullptr;
 
-    CHIP_ERROR InitCASEHandshake(Messaging::ExchangeContext * ec);
+    Transport::AdminPairingTable * mAdmins = nullptr;
 
     SessionIDAllocator * mIDAllocator = nullptr;
 
-    void Cleanup();
+    // Lets initiators resume their previous sessions with this node, if set.
+    SessionResumptionStorage * mResumptionStorage = nullptr;
+
+    Handshake * FindFreeHandshake();
+    Handshake * FindHandshake(const Messaging::ExchangeMessageDispatch * dispatch);
+
+    CHIP_ERROR InitCASEHandshake(Handshake & handshake, Messaging::ExchangeContext * ec);
+    void SendBusyStatusReport(Messaging::ExchangeContext * ec);
 };
 
 } // namespace chip
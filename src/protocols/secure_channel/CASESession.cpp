@@ -31,6 +31,7 @@
 #include <core/CHIPEncoding.h>
 #include <core/CHIPSafeCasts.h>
 #include <protocols/Protocols.h>
+#include <protocols/secure_channel/StatusReport.h>
 #include <support/CHIPMem.h>
 #include <support/CodeUtils.h>
 #include <support/SafeInt.h>
@@ -53,6 +54,9 @@ constexpr size_t kKDFInfoLength   = sizeof(kKDFSR2Info);
 constexpr uint8_t kKDFSEInfo[]    = { 0x53, 0x65, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x4b, 0x65, 0x79, 0x73 };
 constexpr size_t kKDFSEInfoLength = sizeof(kKDFSEInfo);
 
+constexpr uint8_t kKDFS1RKeyInfo[] = { 0x53, 0x69, 0x67, 0x6d, 0x61, 0x31, 0x5f, 0x52, 0x65, 0x73, 0x75, 0x6d, 0x65 };
+constexpr uint8_t kKDFS2RKeyInfo[] = { 0x53, 0x69, 0x67, 0x6d, 0x61, 0x32, 0x5f, 0x52, 0x65, 0x73, 0x75, 0x6d, 0x65 };
+
 constexpr uint8_t kIVSR2[] = { 0x4e, 0x43, 0x41, 0x53, 0x45, 0x5f, 0x53, 0x69, 0x67, 0x6d, 0x61, 0x52, 0x32 };
 constexpr uint8_t kIVSR3[] = { 0x4e, 0x43, 0x41, 0x53, 0x45, 0x5f, 0x53, 0x69, 0x67, 0x6d, 0x61, 0x52, 0x33 };
 constexpr size_t kIVLength = sizeof(kIVSR2);
@@ -101,8 +105,23 @@ enum CASETLVTag : uint8_t
     // TODO: Remove tag 11
     /*! \brief Tag 11. The packet contains the total number of Trusted Root IDs. */
     kNumberofTrustedRootIDs = 11,
+    /*! \brief Tag 12. The packet contains a session resumption ID. */
+    kResumptionID = 12,
+    /*! \brief Tag 13. The packet contains a session resumption MIC. */
+    kResumeMIC = 13,
 };
 
+// Compares resumption MICs in constant time, so that the time taken does not tell how much of a forged MIC is right.
+static bool ResumeMICEqual(const uint8_t * a, const uint8_t * b, size_t len)
+{
+    uint8_t diff = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        diff = static_cast<uint8_t>(diff | (a[i] ^ b[i]));
+    }
+    return diff == 0;
+}
+
 CASESession::CASESession()
 {
     mTrustedRootId = CertificateKeyId();
@@ -128,6 +147,9 @@ void CASESession::Clear()
     mCommissioningHash.Clear();
     mPairingComplete = false;
     mConnectionState.Reset();
+    mHasResumptionId     = false;
+    mResumptionRequested = false;
+    mSessionResumed      = false;
     if (!mTrustedRootId.empty())
     {
         chip::Platform::MemoryFree(const_cast<uint8_t *>(mTrustedRootId.data()));
@@ -336,21 +358,37 @@ CHIP_ERROR CASESession::DeriveSecureSession(SecureSession & session, SecureSessi
 
 CHIP_ERROR CASESession::SendSigmaR1()
 {
-    uint16_t data_len =
-        static_cast<uint16_t>(kSigmaParamRandomNumberSize + sizeof(uint16_t) + sizeof(uint16_t) +
-                              mOpCredSet->GetCertCount() * kTrustedRootIdSize + kP256_PublicKey_Length + sizeof(uint64_t) * 4);
+    uint16_t data_len = static_cast<uint16_t>(kSigmaParamRandomNumberSize + sizeof(uint16_t) + sizeof(uint16_t) +
+                                              mOpCredSet->GetCertCount() * kTrustedRootIdSize + kP256_PublicKey_Length +
+                                              kCASEResumptionIdSize + kTAGSize + sizeof(uint64_t) * 6);
 
     System::PacketBufferTLVWriter tlvWriter;
     System::PacketBufferHandle msg_R1;
-    TLV::TLVType outerContainerType                      = TLV::kTLVType_NotSpecified;
-    uint8_t initiatorRandom[kSigmaParamRandomNumberSize] = { 0 };
+    TLV::TLVType outerContainerType                           = TLV::kTLVType_NotSpecified;
+    const SessionResumptionStorage::Record * resumptionRecord = nullptr;
+    uint8_t resume1MIC[kTAGSize];
 
     msg_R1 = System::PacketBufferHandle::New(data_len);
     VerifyOrReturnError(!msg_R1.IsNull(), CHIP_ERROR_NO_MEMORY);
 
     // Step 1
     // Fill in the random value
-    ReturnErrorOnFailure(DRBG_get_bytes(initiatorRandom, kSigmaParamRandomNumberSize));
+    ReturnErrorOnFailure(DRBG_get_bytes(mInitiatorRandom, kSigmaParamRandomNumberSize));
+
+    // Offer to resume the last session with the peer. All the fields of a full SigmaR1 are still sent,
+    // so that the responder can fall back to a full handshake.
+    if (mResumptionStorage != nullptr)
+    {
+        resumptionRecord = mResumptionStorage->FindByPeer(mConnectionState.GetPeerNodeId(), mAdminId);
+    }
+    if (resumptionRecord != nullptr)
+    {
+        ReturnErrorOnFailure(mSharedSecret.SetLength(resumptionRecord->GetSharedSecret().size()));
+        memcpy(mSharedSecret, resumptionRecord->GetSharedSecret().data(), mSharedSecret.Length());
+        ReturnErrorOnFailure(ComputeResumeMIC(resumptionRecord->GetSharedSecret(), resumptionRecord->GetResumptionId(),
+                                              kKDFS1RKeyInfo, sizeof(kKDFS1RKeyInfo), resume1MIC, sizeof(resume1MIC)));
+        mResumptionRequested = true;
+    }
 
 // Step 4
 #ifdef ENABLE_HSM_CASE_EPHERMAL_KEY
@@ -361,7 +399,7 @@ CHIP_ERROR CASESession::SendSigmaR1()
     // Start writing TLV
     tlvWriter.Init(std::move(msg_R1));
     ReturnErrorOnFailure(tlvWriter.StartContainer(TLV::AnonymousTag, TLV::kTLVType_Structure, outerContainerType));
-    ReturnErrorOnFailure(tlvWriter.PutBytes(CASETLVTag::kRandom, initiatorRandom, sizeof(initiatorRandom)));
+    ReturnErrorOnFailure(tlvWriter.PutBytes(CASETLVTag::kRandom, mInitiatorRandom, sizeof(mInitiatorRandom)));
 
     // Step 5
     uint16_t n_trusted_roots = mOpCredSet->GetCertCount();
@@ -379,6 +417,12 @@ CHIP_ERROR CASESession::SendSigmaR1()
     }
     ReturnErrorOnFailure(tlvWriter.PutBytes(CASETLVTag::kInitiatorEphPubKey, mEphemeralKey.Pubkey(),
                                             static_cast<uint32_t>(mEphemeralKey.Pubkey().Length())));
+    if (resumptionRecord != nullptr)
+    {
+        ReturnErrorOnFailure(tlvWriter.PutBytes(CASETLVTag::kResumptionID, resumptionRecord->GetResumptionId().data(),
+                                                static_cast<uint32_t>(resumptionRecord->GetResumptionId().size())));
+        ReturnErrorOnFailure(tlvWriter.PutBytes(CASETLVTag::kResumeMIC, resume1MIC, sizeof(resume1MIC)));
+    }
 
     ReturnErrorOnFailure(tlvWriter.EndContainer(outerContainerType));
     ReturnErrorOnFailure(tlvWriter.Finalize(&msg_R1));
@@ -401,7 +445,14 @@ CHIP_ERROR CASESession::SendSigmaR1()
 CHIP_ERROR CASESession::HandleSigmaR1_and_SendSigmaR2(System::PacketBufferHandle & msg)
 {
     ReturnErrorOnFailure(HandleSigmaR1(msg));
-    ReturnErrorOnFailure(SendSigmaR2());
+    if (mSessionResumed)
+    {
+        ReturnErrorOnFailure(SendSigmaR2Resume());
+    }
+    else
+    {
+        ReturnErrorOnFailure(SendSigmaR2());
+    }
 
     return CHIP_NO_ERROR;
 }
@@ -449,6 +500,16 @@ CHIP_ERROR CASESession::HandleSigmaR1(System::PacketBufferHandle & msg)
     err = suppTlvReader.GetBytes(mRemotePubKey, static_cast<uint32_t>(mRemotePubKey.Length()));
     SuccessOrExit(err);
 
+    // The resumption MICs are bound to the initiator's random value
+    err = tlvReader.FindElementWithTag(CASETLVTag::kRandom, suppTlvReader);
+    SuccessOrExit(err);
+    VerifyOrExit(kSigmaParamRandomNumberSize == suppTlvReader.GetLength(), err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+    VerifyOrExit(suppTlvReader.GetType() == TLV::kTLVType_ByteString, err = CHIP_ERROR_WRONG_TLV_TYPE);
+    err = suppTlvReader.GetBytes(mInitiatorRandom, sizeof(mInitiatorRandom));
+    SuccessOrExit(err);
+
+    mSessionResumed = ResumeSessionFromSigmaR1(tlvReader);
+
     ChipLogDetail(SecureChannel, "Peer assigned session key ID %d", encryptionKeyId);
     mConnectionState.SetPeerKeyID(encryptionKeyId);
 
@@ -557,10 +618,18 @@ CHIP_ERROR CASESession::SendSigmaR2()
 
     // Step 8
     msg_r2_signed_enc_len = static_cast<uint16_t>(sizeof(uint16_t) + mOpCredSet->GetDevOpCredLen(mTrustedRootId) +
-                                                  sigmaR2Signature.Length() + sizeof(uint64_t) * 2);
+                                                  sigmaR2Signature.Length() + kCASEResumptionIdSize + sizeof(uint64_t) * 3);
 
     VerifyOrExit(msg_R2_Encrypted.Alloc(msg_r2_signed_enc_len), err = CHIP_ERROR_NO_MEMORY);
 
+    // Issue the ID the initiator can resume this session with
+    if (mResumptionStorage != nullptr)
+    {
+        err = DRBG_get_bytes(mResumptionId, sizeof(mResumptionId));
+        SuccessOrExit(err);
+        mHasResumptionId = true;
+    }
+
     // Generate Sigma2 TBE Data
     {
         TLV::TLVWriter tlvWriter;
@@ -572,6 +641,10 @@ CHIP_ERROR CASESession::SendSigmaR2()
                                                mOpCredSet->GetDevOpCredLen(mTrustedRootId)));
         SuccessOrExit(
             err = tlvWriter.PutBytes(CASETLVTag::kSignature, sigmaR2Signature, static_cast<uint32_t>(sigmaR2Signature.Length())));
+        if (mHasResumptionId)
+        {
+            SuccessOrExit(err = tlvWriter.PutBytes(CASETLVTag::kResumptionID, mResumptionId, sizeof(mResumptionId)));
+        }
         SuccessOrExit(err = tlvWriter.EndContainer(outerContainerType));
         SuccessOrExit(err = tlvWriter.Finalize());
     }
@@ -789,6 +862,16 @@ CHIP_ERROR CASESession::HandleSigmaR2(System::PacketBufferHandle & msg)
     err = remoteCredential.ECDSA_validate_msg_signature(msg_R2_Signed.Get(), msg_r2_signed_len, sigmaR2SignedData);
     SuccessOrExit(err);
 
+    // A responder that keeps resumption records issues an ID to resume this session with
+    if (decryptedDataTlvReader.FindElementWithTag(CASETLVTag::kResumptionID, suppTlvReader) == CHIP_NO_ERROR)
+    {
+        VerifyOrExit(suppTlvReader.GetType() == TLV::kTLVType_ByteString, err = CHIP_ERROR_WRONG_TLV_TYPE);
+        VerifyOrExit(sizeof(mResumptionId) == suppTlvReader.GetLength(), err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+        err = suppTlvReader.GetBytes(mResumptionId, sizeof(mResumptionId));
+        SuccessOrExit(err);
+        mHasResumptionId = true;
+    }
+
 exit:
     if (err == CHIP_ERROR_INVALID_SIGNATURE)
     {
@@ -936,6 +1019,8 @@ CHIP_ERROR CASESession::SendSigmaR3()
 
     mPairingComplete = true;
 
+    SaveResumptionRecord();
+
     // Forget our exchange, as no additional messages are expected from the peer
     mExchangeCtxt = nullptr;
 
@@ -1080,6 +1165,8 @@ CHIP_ERROR CASESession::HandleSigmaR3(System::PacketBufferHandle & msg)
 
     mPairingComplete = true;
 
+    SaveResumptionRecord();
+
     // Forget our exchange, as no additional messages are expected from the peer
     mExchangeCtxt = nullptr;
 
@@ -1098,6 +1185,235 @@ exit:
     return err;
 }
 
+bool CASESession::ResumeSessionFromSigmaR1(const System::PacketBufferTLVReader & tlvReader)
+{
+    System::PacketBufferTLVReader suppTlvReader;
+    uint8_t resumptionId[kCASEResumptionIdSize];
+    uint8_t resume1MIC[kTAGSize];
+    uint8_t expectedMIC[kTAGSize];
+
+    VerifyOrReturnError(mResumptionStorage != nullptr, false);
+
+    // An initiator that has no session to resume does not send these.
+    VerifyOrReturnError(tlvReader.FindElementWithTag(CASETLVTag::kResumptionID, suppTlvReader) == CHIP_NO_ERROR, false);
+    VerifyOrReturnError(suppTlvReader.GetType() == TLV::kTLVType_ByteString, false);
+    VerifyOrReturnError(sizeof(resumptionId) == suppTlvReader.GetLength(), false);
+    VerifyOrReturnError(suppTlvReader.GetBytes(resumptionId, sizeof(resumptionId)) == CHIP_NO_ERROR, false);
+
+    VerifyOrReturnError(tlvReader.FindElementWithTag(CASETLVTag::kResumeMIC, suppTlvReader) == CHIP_NO_ERROR, false);
+    VerifyOrReturnError(suppTlvReader.GetType() == TLV::kTLVType_ByteString, false);
+    VerifyOrReturnError(sizeof(resume1MIC) == suppTlvReader.GetLength(), false);
+    VerifyOrReturnError(suppTlvReader.GetBytes(resume1MIC, sizeof(resume1MIC)) == CHIP_NO_ERROR, false);
+
+    const SessionResumptionStorage::Record * record = mResumptionStorage->FindByResumptionId(ByteSpan(resumptionId));
+    if (record == nullptr || record->mAdminId != mAdminId)
+    {
+        ChipLogProgress(SecureChannel, "Unknown resumption ID, falling back to a full CASE handshake");
+        return false;
+    }
+
+    VerifyOrReturnError(ComputeResumeMIC(record->GetSharedSecret(), record->GetResumptionId(), kKDFS1RKeyInfo,
+                                         sizeof(kKDFS1RKeyInfo), expectedMIC, sizeof(expectedMIC)) == CHIP_NO_ERROR,
+                        false);
+    if (!ResumeMICEqual(resume1MIC, expectedMIC, sizeof(expectedMIC)))
+    {
+        ChipLogError(SecureChannel, "Invalid resumption MIC, falling back to a full CASE handshake");
+        return false;
+    }
+
+    VerifyOrReturnError(mSharedSecret.SetLength(record->GetSharedSecret().size()) == CHIP_NO_ERROR, false);
+    memcpy(mSharedSecret, record->GetSharedSecret().data(), mSharedSecret.Length());
+    mConnectionState.SetPeerNodeId(record->mPeerNodeId);
+
+    return true;
+}
+
+CHIP_ERROR CASESession::SendSigmaR2Resume()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    System::PacketBufferHandle msg_R2_Resume;
+    uint16_t data_len = static_cast<uint16_t>(kCASEResumptionIdSize + kTAGSize + sizeof(uint16_t) + sizeof(uint64_t) * 4);
+
+    uint8_t resume2MIC[kTAGSize];
+
+    // A resumption ID is only ever accepted once, so issue a new one for the resumed session
+    err = DRBG_get_bytes(mResumptionId, sizeof(mResumptionId));
+    SuccessOrExit(err);
+    mHasResumptionId = true;
+
+    err = ComputeResumeMIC(ByteSpan(mSharedSecret, mSharedSecret.Length()), ByteSpan(mResumptionId), kKDFS2RKeyInfo,
+                           sizeof(kKDFS2RKeyInfo), resume2MIC, sizeof(resume2MIC));
+    SuccessOrExit(err);
+
+    msg_R2_Resume = System::PacketBufferHandle::New(data_len);
+    VerifyOrExit(!msg_R2_Resume.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+
+    {
+        System::PacketBufferTLVWriter tlvWriter;
+        TLV::TLVType outerContainerType = TLV::kTLVType_NotSpecified;
+
+        tlvWriter.Init(std::move(msg_R2_Resume));
+        SuccessOrExit(err = tlvWriter.StartContainer(TLV::AnonymousTag, TLV::kTLVType_Structure, outerContainerType));
+        SuccessOrExit(err = tlvWriter.PutBytes(CASETLVTag::kResumptionID, mResumptionId, sizeof(mResumptionId)));
+        SuccessOrExit(err = tlvWriter.PutBytes(CASETLVTag::kResumeMIC, resume2MIC, sizeof(resume2MIC)));
+        SuccessOrExit(err = tlvWriter.Put(CASETLVTag::kSessionID, mConnectionState.GetLocalKeyID(), true));
+        SuccessOrExit(err = tlvWriter.EndContainer(outerContainerType));
+        SuccessOrExit(err = tlvWriter.Finalize(&msg_R2_Resume));
+    }
+
+    err = mCommissioningHash.AddData(msg_R2_Resume->Start(), msg_R2_Resume->DataLength());
+    SuccessOrExit(err);
+
+    mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
+
+    // Call delegate to send the msg to peer
+    err = mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume, std::move(msg_R2_Resume));
+    SuccessOrExit(err);
+
+    ChipLogDetail(SecureChannel, "Sent SigmaR2Resume msg");
+
+    err = mCommissioningHash.Finish(mMessageDigest);
+    SuccessOrExit(err);
+
+    mPairingComplete = true;
+
+    SaveResumptionRecord();
+
+    // Forget our exchange, as no additional messages are expected from the peer
+    mExchangeCtxt = nullptr;
+
+    // Call delegate to indicate pairing completion
+    mDelegate->OnSessionEstablished();
+
+exit:
+
+    if (err != CHIP_NO_ERROR)
+    {
+        SendErrorMsg(SigmaErrorType::kUnexpected);
+    }
+    return err;
+}
+
+CHIP_ERROR CASESession::HandleSigmaR2Resume(System::PacketBufferHandle & msg)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader tlvReader;
+    System::PacketBufferTLVReader suppTlvReader;
+    TLV::TLVType containerType = TLV::kTLVType_Structure;
+
+    const uint8_t * buf = msg->Start();
+    size_t buflen       = msg->DataLength();
+
+    uint8_t resumptionId[kCASEResumptionIdSize];
+    uint8_t resume2MIC[kTAGSize];
+    uint8_t expectedMIC[kTAGSize];
+
+    uint16_t encryptionKeyId = 0;
+
+    VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+
+    ChipLogDetail(SecureChannel, "Received SigmaR2Resume msg");
+
+    mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
+
+    tlvReader.Init(std::move(msg));
+    SuccessOrExit(err = tlvReader.Next(containerType, TLV::AnonymousTag));
+    SuccessOrExit(err = tlvReader.EnterContainer(containerType));
+
+    SuccessOrExit(err = tlvReader.FindElementWithTag(CASETLVTag::kResumptionID, suppTlvReader));
+    VerifyOrExit(suppTlvReader.GetType() == TLV::kTLVType_ByteString, err = CHIP_ERROR_WRONG_TLV_TYPE);
+    VerifyOrExit(sizeof(resumptionId) == suppTlvReader.GetLength(), err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+    SuccessOrExit(err = suppTlvReader.GetBytes(resumptionId, sizeof(resumptionId)));
+
+    SuccessOrExit(err = tlvReader.FindElementWithTag(CASETLVTag::kResumeMIC, suppTlvReader));
+    VerifyOrExit(suppTlvReader.GetType() == TLV::kTLVType_ByteString, err = CHIP_ERROR_WRONG_TLV_TYPE);
+    VerifyOrExit(sizeof(resume2MIC) == suppTlvReader.GetLength(), err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+    SuccessOrExit(err = suppTlvReader.GetBytes(resume2MIC, sizeof(resume2MIC)));
+
+    SuccessOrExit(err = tlvReader.FindElementWithTag(CASETLVTag::kSessionID, suppTlvReader));
+    SuccessOrExit(err = suppTlvReader.Get(encryptionKeyId));
+
+    // The responder proves it holds the shared secret of the resumed session
+    err = ComputeResumeMIC(ByteSpan(mSharedSecret, mSharedSecret.Length()), ByteSpan(resumptionId), kKDFS2RKeyInfo,
+                           sizeof(kKDFS2RKeyInfo), expectedMIC, sizeof(expectedMIC));
+    SuccessOrExit(err);
+    VerifyOrExit(ResumeMICEqual(resume2MIC, expectedMIC, sizeof(expectedMIC)), err = CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    ChipLogDetail(SecureChannel, "Peer assigned session key ID %d", encryptionKeyId);
+    mConnectionState.SetPeerKeyID(encryptionKeyId);
+
+    memcpy(mResumptionId, resumptionId, sizeof(mResumptionId));
+    mHasResumptionId = true;
+    mSessionResumed  = true;
+
+    err = mCommissioningHash.AddData(buf, buflen);
+    SuccessOrExit(err);
+
+    err = mCommissioningHash.Finish(mMessageDigest);
+    SuccessOrExit(err);
+
+    mPairingComplete = true;
+
+    SaveResumptionRecord();
+
+    // Forget our exchange, as no additional messages are expected from the peer
+    mExchangeCtxt = nullptr;
+
+    // Call delegate to indicate pairing completion
+    mDelegate->OnSessionEstablished();
+
+exit:
+    if (err == CHIP_ERROR_INTEGRITY_CHECK_FAILED)
+    {
+        // Do not offer to resume the session again, the next attempt will be a full handshake
+        mResumptionStorage->Delete(mConnectionState.GetPeerNodeId(), mAdminId);
+        SendErrorMsg(SigmaErrorType::kInvalidResumptionTag);
+    }
+    else if (err != CHIP_NO_ERROR)
+    {
+        SendErrorMsg(SigmaErrorType::kUnexpected);
+    }
+    return err;
+}
+
+CHIP_ERROR CASESession::ComputeResumeMIC(const ByteSpan & sharedSecret, const ByteSpan & resumptionId, const uint8_t * info,
+                                         size_t infoLen, uint8_t * mic, size_t micLen)
+{
+    HKDF_sha_crypto mHKDF;
+    uint8_t salt[kSigmaParamRandomNumberSize + kCASEResumptionIdSize];
+
+    VerifyOrReturnError(resumptionId.size() == kCASEResumptionIdSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Salting with the initiator's random value makes the MICs of each handshake different
+    memcpy(salt, mInitiatorRandom, kSigmaParamRandomNumberSize);
+    memcpy(salt + kSigmaParamRandomNumberSize, resumptionId.data(), resumptionId.size());
+
+    return mHKDF.HKDF_SHA256(sharedSecret.data(), sharedSecret.size(), salt, sizeof(salt), info, infoLen, mic, micLen);
+}
+
+void CASESession::SaveResumptionRecord()
+{
+    VerifyOrReturn(mResumptionStorage != nullptr);
+
+    if (!mHasResumptionId)
+    {
+        // The responder does not resume sessions, so do not offer to resume one again.
+        if (mResumptionRequested)
+        {
+            mResumptionStorage->Delete(mConnectionState.GetPeerNodeId(), mAdminId);
+        }
+        return;
+    }
+
+    CHIP_ERROR err = mResumptionStorage->Save(mConnectionState.GetPeerNodeId(), mAdminId, ByteSpan(mResumptionId),
+                                              ByteSpan(mSharedSecret, mSharedSecret.Length()));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Failed to save CASE resumption record: %s", ErrorStr(err));
+    }
+}
+
 void CASESession::SendErrorMsg(SigmaErrorType errorCode)
 {
     System::PacketBufferHandle msg;
@@ -1192,31 +1508,36 @@ CHIP_ERROR CASESession::Validate_and_RetrieveResponderID(const uint8_t * respond
 {
     ChipCertificateData * resultCert = nullptr;
 
+    // The operational credentials may be shared with other sessions, so the certificates of the peer are validated
+    // in a set of their own, against copies of the trusted certificates of the credentials.
+    const ChipCertificateSet * trustedCerts = mOpCredSet->FindCertSet(mTrustedRootId);
+    VerifyOrReturnError(trustedCerts != nullptr, CHIP_ERROR_CERT_NOT_TRUSTED);
+
     ChipCertificateSet certSet;
-    // Certificate set can contain up to 3 certs (NOC, ICA cert, and Root CA cert)
-    ReturnErrorOnFailure(certSet.Init(3, kMaxCHIPCertDecodeBufLength));
+    // Certificate set can contain up to 3 certs (NOC, ICA cert, and Root CA cert) in addition to the trusted ones
+    ReturnErrorOnFailure(certSet.Init(static_cast<uint8_t>(trustedCerts->GetCertCount() + 3), kMaxCHIPCertDecodeBufLength));
 
-    Encoding::LittleEndian::BufferWriter bbuf(responderID, responderID.Length());
+    for (uint8_t i = 0; i < trustedCerts->GetCertCount(); i++)
+    {
+        ReturnErrorOnFailure(certSet.LoadCert(trustedCerts->GetCertSet()[i]));
+    }
+
+    // The NOC is the first certificate of the peer, so it is loaded right after the trusted ones.
+    const uint8_t nocIndex = certSet.GetCertCount();
     ReturnErrorOnFailure(
         certSet.LoadCerts(responderOpCert, responderOpCertLen, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+    VerifyOrReturnError(certSet.GetCertCount() > nocIndex, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const ChipCertificateData & noc = certSet.GetCertSet()[nocIndex];
 
-    bbuf.Put(certSet.GetCertSet()[0].mPublicKey.data(), certSet.GetCertSet()[0].mPublicKey.size());
+    Encoding::LittleEndian::BufferWriter bbuf(responderID, responderID.Length());
+    bbuf.Put(noc.mPublicKey.data(), noc.mPublicKey.size());
 
     VerifyOrReturnError(bbuf.Fit(), CHIP_ERROR_NO_MEMORY);
 
     // Validate responder identity located in msg_r2_encrypted
-    ReturnErrorOnFailure(
-        mOpCredSet->FindCertSet(mTrustedRootId)
-            ->LoadCerts(responderOpCert, responderOpCertLen, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
-
     ReturnErrorOnFailure(SetEffectiveTime());
-    // Locate the subject DN and key id that will be used as input the FindValidCert() method.
-    {
-        const ChipDN & subjectDN              = certSet.GetCertSet()[0].mSubjectDN;
-        const CertificateKeyId & subjectKeyId = certSet.GetCertSet()[0].mSubjectKeyId;
-
-        ReturnErrorOnFailure(mOpCredSet->FindValidCert(mTrustedRootId, subjectDN, subjectKeyId, mValidContext, resultCert));
-    }
+    ReturnErrorOnFailure(certSet.FindValidCert(noc.mSubjectDN, noc.mSubjectKeyId, mValidContext, resultCert));
 
     return CHIP_NO_ERROR;
 }
@@ -1321,6 +1642,23 @@ CHIP_ERROR CASESession::HandleErrorMsg(const System::PacketBufferHandle & msg)
     return err;
 }
 
+CHIP_ERROR CASESession::HandleStatusReport(System::PacketBufferHandle && msg)
+{
+    Protocols::SecureChannel::StatusReport report;
+    ReturnErrorOnFailure(report.Parse(std::move(msg)));
+
+    ChipLogError(SecureChannel, "Received status report (%d) during CASE pairing process",
+                 static_cast<int>(report.GetGeneralCode()));
+
+    // A responder that is busy with other handshakes may be retried later.
+    if (report.GetGeneralCode() == Protocols::SecureChannel::GeneralStatusCode::kBusy)
+    {
+        return CHIP_ERROR_SECURITY_MANAGER_BUSY;
+    }
+
+    return CHIP_ERROR_INTERNAL;
+}
+
 CHIP_ERROR CASESession::ValidateReceivedMessage(ExchangeContext * ec, const PacketHeader & packetHeader,
                                                 const PayloadHeader & payloadHeader, System::PacketBufferHandle & msg)
 {
@@ -1342,9 +1680,14 @@ CHIP_ERROR CASESession::ValidateReceivedMessage(ExchangeContext * ec, const Pack
         mExchangeCtxt->SetResponseTimeout(kSigma_Response_Timeout);
     }
 
+    // An initiator that offered to resume the session may get either kind of SigmaR2.
+    bool isExpectedResume = mResumptionRequested && mNextExpectedMsg == Protocols::SecureChannel::MsgType::CASE_SigmaR2 &&
+        payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume);
+
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrReturnError(payloadHeader.HasMessageType(mNextExpectedMsg) ||
-                            payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::CASE_SigmaErr),
+    VerifyOrReturnError(isExpectedResume || payloadHeader.HasMessageType(mNextExpectedMsg) ||
+                            payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::CASE_SigmaErr) ||
+                            payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::StatusReport),
                         CHIP_ERROR_INVALID_MESSAGE_TYPE);
 
     if (packetHeader.GetSourceNodeId().HasValue())
@@ -1385,10 +1728,18 @@ CHIP_ERROR CASESession::OnMessageReceived(ExchangeContext * ec, const PacketHead
         err = HandleSigmaR3(msg);
         break;
 
+    case Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume:
+        err = HandleSigmaR2Resume(msg);
+        break;
+
     case Protocols::SecureChannel::MsgType::CASE_SigmaErr:
         err = HandleErrorMsg(msg);
         break;
 
+    case Protocols::SecureChannel::MsgType::StatusReport:
+        err = HandleStatusReport(std::move(msg));
+        break;
+
     default:
         SendErrorMsg(SigmaErrorType::kUnexpected);
         err = CHIP_ERROR_INVALID_MESSAGE_TYPE;
@@ -36,6 +36,7 @@
 #include <protocols/secure_channel/Constants.h>
 #include <protocols/secure_channel/SessionEstablishmentDelegate.h>
 #include <protocols/secure_channel/SessionEstablishmentExchangeDispatch.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
 #include <support/Base64.h>
 #include <system/SystemPacketBuffer.h>
 #include <system/TLVPacketBufferBackingStore.h>
@@ -88,8 +89,8 @@ public:
      * @brief
      *   Initialize using operational credentials code and wait for session establishment requests.
      *
-     * @param operationalCredentialSet      CHIP Certificate Set used to store the chain root of trust an validate peer node
-     *                                      certificates
+     * @param operationalCredentialSet      CHIP Certificate Set holding the chain root of trust to validate peer node
+     *                                      certificates against. It is not modified, so it can be shared by sessions.
      * @param myKeyId                       Key ID to be assigned to the secure session on the peer node
      * @param delegate                      Callback object
      *
@@ -103,8 +104,8 @@ public:
      *   Create and send session establishment request using device's operational credentials.
      *
      * @param peerAddress                   Address of peer with which to establish a session.
-     * @param operationalCredentialSet      CHIP Certificate Set used to store the chain root of trust an validate peer node
-     *                                      certificates
+     * @param operationalCredentialSet      CHIP Certificate Set holding the chain root of trust to validate peer node
+     *                                      certificates against. It is not modified, so it can be shared by sessions.
      * @param peerNodeId                    Node id of the peer node
      * @param myKeyId                       Key ID to be assigned to the secure session on the peer node
      * @param exchangeCtxt                  The exchange context to send and receive messages with the peer
@@ -117,6 +118,27 @@ public:
                                 uint16_t myKeyId, Messaging::ExchangeContext * exchangeCtxt,
                                 SessionEstablishmentDelegate * delegate);
 
+    /**
+     * @brief
+     *   Resume, rather than fully establish, the session if the peer and this node established one before, and
+     *   record the established session so that it can be resumed in turn. An initiator calls this before
+     *   EstablishSession(), a responder after ListenForSessionEstablishment(). The setting is kept until changed.
+     *
+     * @param storage     The resumption records of this node, or nullptr to always establish the session in full
+     * @param adminId     The admin the session is established for
+     */
+    void EnableSessionResumption(SessionResumptionStorage * storage, Transport::AdminId adminId)
+    {
+        mResumptionStorage = storage;
+        mAdminId           = adminId;
+    }
+
+    /**
+     * @brief
+     *   Return whether the established session was resumed from a previous one, without a full Sigma handshake.
+     */
+    bool IsSessionResumed() const { return mSessionResumed; }
+
     /**
      * @brief
      *   Derive a secure session from the established session. The API will return error
@@ -217,8 +239,13 @@ private:
     CHIP_ERROR SendSigmaR3();
     CHIP_ERROR HandleSigmaR3(System::PacketBufferHandle & msg);
 
-    CHIP_ERROR SendSigmaR1Resume();
-    CHIP_ERROR HandleSigmaR1Resume_and_SendSigmaR2Resume(const PacketHeader & header, const System::PacketBufferHandle & msg);
+    CHIP_ERROR SendSigmaR2Resume();
+    CHIP_ERROR HandleSigmaR2Resume(System::PacketBufferHandle & msg);
+
+    bool ResumeSessionFromSigmaR1(const System::PacketBufferTLVReader & tlvReader);
+    CHIP_ERROR ComputeResumeMIC(const ByteSpan & sharedSecret, const ByteSpan & resumptionId, const uint8_t * info, size_t infoLen,
+                                uint8_t * mic, size_t micLen);
+    void SaveResumptionRecord();
 
     CHIP_ERROR FindValidTrustedRoot(const System::PacketBufferTLVReader & tlvReader, uint32_t nTrustedRoots);
     CHIP_ERROR ConstructSaltSigmaR2(const ByteSpan & rand, const Crypto::P256PublicKey & pubkey, const uint8_t * ipk, size_t ipkLen,
@@ -239,6 +266,10 @@ private:
     // in a more seamless manner.
     CHIP_ERROR HandleErrorMsg(const System::PacketBufferHandle & msg);
 
+    // Like HandleErrorMsg, this always returns an error: CHIP_ERROR_SECURITY_MANAGER_BUSY if the responder
+    // turned the handshake down because it is busy.
+    CHIP_ERROR HandleStatusReport(System::PacketBufferHandle && msg);
+
     void CloseExchange();
 
     // TODO: Remove this and replace with system method to retrieve current time
@@ -269,6 +300,15 @@ private:
     uint8_t mIPK[kIPKSize];
     uint8_t mRemoteIPK[kIPKSize];
 
+    SessionResumptionStorage * mResumptionStorage = nullptr;
+    Transport::AdminId mAdminId                   = Transport::kUndefinedAdminId;
+    uint8_t mInitiatorRandom[kSigmaParamRandomNumberSize];
+    // The resumption ID the responder issued for this session, valid if mHasResumptionId is set.
+    uint8_t mResumptionId[kCASEResumptionIdSize];
+    bool mHasResumptionId     = false;
+    bool mResumptionRequested = false;
+    bool mSessionResumed      = false;
+
     Messaging::ExchangeContext * mExchangeCtxt = nullptr;
     SessionEstablishmentExchangeDispatch mMessageDispatch;
 
@@ -63,10 +63,11 @@ enum class MsgType : uint8_t
     PASE_Spake2pError  = 0x2F,
 
     // Certificate-based session establishment Message Types
-    CASE_SigmaR1  = 0x30,
-    CASE_SigmaR2  = 0x31,
-    CASE_SigmaR3  = 0x32,
-    CASE_SigmaErr = 0x3F,
+    CASE_SigmaR1       = 0x30,
+    CASE_SigmaR2       = 0x31,
+    CASE_SigmaR3       = 0x32,
+    CASE_SigmaR2Resume = 0x33,
+    CASE_SigmaErr      = 0x3F,
 
     StatusReport = 0x40,
 };
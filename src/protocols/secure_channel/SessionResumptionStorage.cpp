@@ -0,0 +1,215 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/SessionResumptionStorage.h>
+
+#include <core/CHIPEncoding.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace chip {
+
+using namespace Crypto;
+
+CHIP_ERROR SessionResumptionStorage::Init(PersistentStorageDelegate * storage)
+{
+    Clear();
+    mStorage = storage;
+    mNextUse = 0;
+
+    VerifyOrReturnError(mStorage != nullptr, CHIP_NO_ERROR);
+
+    StorableRecord stored;
+    for (size_t i = 0; i < ArraySize(mRecords); i++)
+    {
+        char key[KeySize()];
+        ReturnErrorOnFailure(GenerateKey(i, key, sizeof(key)));
+
+        uint16_t size = sizeof(stored);
+        if (mStorage->SyncGetKeyValue(key, &stored, size) != CHIP_NO_ERROR || size != sizeof(stored))
+        {
+            continue;
+        }
+
+        Record & record = mRecords[i];
+        if (record.mSharedSecret.SetLength(Encoding::LittleEndian::HostSwap16(stored.mSharedSecretLength)) != CHIP_NO_ERROR)
+        {
+            ChipLogError(SecureChannel, "Dropping malformed CASE resumption record %u", static_cast<unsigned>(i));
+            continue;
+        }
+
+        record.mPeerNodeId = Encoding::LittleEndian::HostSwap64(stored.mPeerNodeId);
+        record.mAdminId    = Encoding::LittleEndian::HostSwap16(stored.mAdminId);
+        record.mLastUse    = Encoding::LittleEndian::HostSwap32(stored.mLastUse);
+        record.mInUse      = true;
+        memcpy(record.mResumptionId, stored.mResumptionId, sizeof(record.mResumptionId));
+        memcpy(record.mSharedSecret, stored.mSharedSecret, record.mSharedSecret.Length());
+
+        if (record.mLastUse >= mNextUse)
+        {
+            mNextUse = record.mLastUse + 1;
+        }
+    }
+
+    ClearSecretData(reinterpret_cast<uint8_t *>(&stored), sizeof(stored));
+    return CHIP_NO_ERROR;
+}
+
+const SessionResumptionStorage::Record * SessionResumptionStorage::FindByPeer(NodeId peerNodeId, Transport::AdminId adminId) const
+{
+    for (const Record & record : mRecords)
+    {
+        if (record.mInUse && record.mPeerNodeId == peerNodeId && record.mAdminId == adminId)
+        {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+const SessionResumptionStorage::Record * SessionResumptionStorage::FindByResumptionId(const ByteSpan & resumptionId) const
+{
+    VerifyOrReturnError(resumptionId.size() == kCASEResumptionIdSize, nullptr);
+
+    for (const Record & record : mRecords)
+    {
+        if (record.mInUse && record.GetResumptionId().data_equal(resumptionId))
+        {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR SessionResumptionStorage::Save(NodeId peerNodeId, Transport::AdminId adminId, const ByteSpan & resumptionId,
+                                          const ByteSpan & sharedSecret)
+{
+    VerifyOrReturnError(resumptionId.size() == kCASEResumptionIdSize, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(sharedSecret.size() <= kMax_ECDH_Secret_Length, CHIP_ERROR_INVALID_ARGUMENT);
+
+    Record * record = FindRecord(peerNodeId, adminId);
+    if (record == nullptr)
+    {
+        // Take a free record, or else the least recently used one.
+        record = &mRecords[0];
+        for (Record & candidate : mRecords)
+        {
+            if (!candidate.mInUse)
+            {
+                record = &candidate;
+                break;
+            }
+            if (candidate.mLastUse < record->mLastUse)
+            {
+                record = &candidate;
+            }
+        }
+    }
+
+    ReturnErrorOnFailure(record->mSharedSecret.SetLength(sharedSecret.size()));
+    memcpy(record->mSharedSecret, sharedSecret.data(), sharedSecret.size());
+    memcpy(record->mResumptionId, resumptionId.data(), kCASEResumptionIdSize);
+    record->mPeerNodeId = peerNodeId;
+    record->mAdminId    = adminId;
+    record->mLastUse    = mNextUse++;
+    record->mInUse      = true;
+
+    return Store(static_cast<size_t>(record - mRecords));
+}
+
+CHIP_ERROR SessionResumptionStorage::Delete(NodeId peerNodeId, Transport::AdminId adminId)
+{
+    Record * record = FindRecord(peerNodeId, adminId);
+    VerifyOrReturnError(record != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    ClearSecretData(record->mSharedSecret, static_cast<uint32_t>(record->mSharedSecret.Capacity()));
+    *record = Record();
+
+    return Store(static_cast<size_t>(record - mRecords));
+}
+
+size_t SessionResumptionStorage::GetRecordCount() const
+{
+    size_t count = 0;
+    for (const Record & record : mRecords)
+    {
+        if (record.mInUse)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+SessionResumptionStorage::Record * SessionResumptionStorage::FindRecord(NodeId peerNodeId, Transport::AdminId adminId)
+{
+    return const_cast<Record *>(FindByPeer(peerNodeId, adminId));
+}
+
+CHIP_ERROR SessionResumptionStorage::Store(size_t index)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_NO_ERROR);
+
+    char key[KeySize()];
+    ReturnErrorOnFailure(GenerateKey(index, key, sizeof(key)));
+
+    const Record & record = mRecords[index];
+    if (!record.mInUse)
+    {
+        return mStorage->SyncDeleteKeyValue(key);
+    }
+
+    StorableRecord stored;
+    memset(&stored, 0, sizeof(stored));
+    stored.mPeerNodeId         = Encoding::LittleEndian::HostSwap64(record.mPeerNodeId);
+    stored.mAdminId            = Encoding::LittleEndian::HostSwap16(record.mAdminId);
+    stored.mLastUse            = Encoding::LittleEndian::HostSwap32(record.mLastUse);
+    stored.mSharedSecretLength = Encoding::LittleEndian::HostSwap16(static_cast<uint16_t>(record.mSharedSecret.Length()));
+    memcpy(stored.mResumptionId, record.mResumptionId, sizeof(stored.mResumptionId));
+    memcpy(stored.mSharedSecret, record.mSharedSecret, record.mSharedSecret.Length());
+
+    CHIP_ERROR err = mStorage->SyncSetKeyValue(key, &stored, sizeof(stored));
+    ClearSecretData(reinterpret_cast<uint8_t *>(&stored), sizeof(stored));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Failed to store CASE resumption record: %s", ErrorStr(err));
+    }
+    return err;
+}
+
+void SessionResumptionStorage::Clear()
+{
+    for (Record & record : mRecords)
+    {
+        ClearSecretData(record.mSharedSecret, static_cast<uint32_t>(record.mSharedSecret.Capacity()));
+        record = Record();
+    }
+}
+
+CHIP_ERROR SessionResumptionStorage::GenerateKey(size_t index, char * key, size_t len)
+{
+    VerifyOrReturnError(len >= KeySize(), CHIP_ERROR_INVALID_ARGUMENT);
+    int keySize = snprintf(key, len, "%s%x", kSessionResumptionKeyPrefix, static_cast<unsigned>(index));
+    VerifyOrReturnError(keySize > 0, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(len > (size_t) keySize, CHIP_ERROR_INTERNAL);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace chip
@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the storage of the records that let a CASE session
+ *      with a peer be resumed without a full Sigma handshake.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+#include <core/CHIPPersistentStorageDelegate.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <support/Span.h>
+#include <transport/AdminPairingTable.h>
+#include <transport/raw/MessageHeader.h>
+
+namespace chip {
+
+/**
+ *  @def CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE
+ *
+ *  @brief
+ *    The number of peers for which a CASE session resumption record is kept.
+ *    When the storage is full, the least recently used record makes room for
+ *    a new one.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE
+#define CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE 16
+#endif // CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE
+
+constexpr size_t kCASEResumptionIdSize = 16;
+
+// KVS store is sensitive to length of key strings, based on the underlying
+// platform. Keeping them short.
+constexpr char kSessionResumptionKeyPrefix[] = "CASERes";
+
+/**
+ * Keeps, for each peer node and admin, the shared secret of the last CASE
+ * session established with it and the resumption ID the responder issued
+ * for it. A record is replaced each time a session with the peer is
+ * established, since the resumption ID changes every time.
+ *
+ * If a PersistentStorageDelegate is given, the records are loaded from it on
+ * Init() and written through to it, so that sessions can also be resumed
+ * after a restart.
+ */
+class DLL_EXPORT SessionResumptionStorage
+{
+public:
+    struct Record
+    {
+        NodeId mPeerNodeId          = kUndefinedNodeId;
+        Transport::AdminId mAdminId = Transport::kUndefinedAdminId;
+        uint8_t mResumptionId[kCASEResumptionIdSize];
+        Crypto::P256ECDHDerivedSecret mSharedSecret;
+
+        ByteSpan GetResumptionId() const { return ByteSpan(mResumptionId, sizeof(mResumptionId)); }
+        ByteSpan GetSharedSecret() const { return ByteSpan(mSharedSecret, mSharedSecret.Length()); }
+
+    private:
+        friend class SessionResumptionStorage;
+
+        bool mInUse       = false;
+        uint32_t mLastUse = 0;
+    };
+
+    SessionResumptionStorage() {}
+    ~SessionResumptionStorage() { Clear(); }
+
+    /**
+     * Load the records kept in the given storage. Without a storage the
+     * records only live as long as this object.
+     */
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    /**
+     * The record of the last session with the given peer, or nullptr if there is none.
+     */
+    const Record * FindByPeer(NodeId peerNodeId, Transport::AdminId adminId) const;
+
+    /**
+     * The record a resumption ID was issued for, or nullptr if there is none.
+     */
+    const Record * FindByResumptionId(const ByteSpan & resumptionId) const;
+
+    /**
+     * Record a session established with the given peer, replacing the previous record for it.
+     */
+    CHIP_ERROR Save(NodeId peerNodeId, Transport::AdminId adminId, const ByteSpan & resumptionId, const ByteSpan & sharedSecret);
+
+    /**
+     * Forget the record for the given peer, e.g. after it failed to resume a session.
+     */
+    CHIP_ERROR Delete(NodeId peerNodeId, Transport::AdminId adminId);
+
+    size_t GetRecordCount() const;
+
+private:
+    struct StorableRecord
+    {
+        uint64_t mPeerNodeId;         /* This field is serialized in LittleEndian byte order */
+        uint16_t mAdminId;            /* This field is serialized in LittleEndian byte order */
+        uint16_t mSharedSecretLength; /* This field is serialized in LittleEndian byte order */
+        uint32_t mLastUse;            /* This field is serialized in LittleEndian byte order */
+        uint8_t mResumptionId[kCASEResumptionIdSize];
+        uint8_t mSharedSecret[Crypto::kMax_ECDH_Secret_Length];
+    };
+
+    static constexpr size_t KeySize() { return sizeof(kSessionResumptionKeyPrefix) + 2 * sizeof(uint16_t); }
+    static CHIP_ERROR GenerateKey(size_t index, char * key, size_t len);
+
+    Record * FindRecord(NodeId peerNodeId, Transport::AdminId adminId);
+    CHIP_ERROR Store(size_t index);
+    void Clear();
+
+    Record mRecords[CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE];
+    uint32_t mNextUse                        = 0;
+    PersistentStorageDelegate * mStorage = nullptr;
+};
+
+} // namespace chip
@@ -53,8 +53,24 @@ using namespace chip::Protocols;
 using TestContext = chip::Test::MessagingContext;
 
 namespace {
+// Loses every message after the first mNumMessagesToDeliver, so that handshakes can be held halfway.
+class TestLoopbackTransport : public Test::LoopbackTransport
+{
+public:
+    CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override
+    {
+        if (mSentMessageCount >= mNumMessagesToDeliver)
+        {
+            mNumMessagesToDrop = 1;
+        }
+        return Test::LoopbackTransport::SendMessage(address, std::move(msgBuf));
+    }
+
+    uint32_t mNumMessagesToDeliver = UINT32_MAX;
+};
+
 TransportMgrBase gTransportMgr;
-Test::LoopbackTransport gLoopback;
+TestLoopbackTransport gLoopback;
 
 OperationalCredentialSet commissionerDevOpCred;
 OperationalCredentialSet accessoryDevOpCred;
@@ -77,12 +93,17 @@ enum
 class TestCASESecurePairingDelegate : public SessionEstablishmentDelegate
 {
 public:
-    void OnSessionEstablishmentError(CHIP_ERROR error) override { mNumPairingErrors++; }
+    void OnSessionEstablishmentError(CHIP_ERROR error) override
+    {
+        mNumPairingErrors++;
+        mLastError = error;
+    }
 
     void OnSessionEstablished() override { mNumPairingComplete++; }
 
     uint32_t mNumPairingErrors   = 0;
     uint32_t mNumPairingComplete = 0;
+    CHIP_ERROR mLastError        = CHIP_NO_ERROR;
 };
 
 static CHIP_ERROR InitCredentialSets()
@@ -311,22 +332,8 @@ private:
 
 CASEServer gPairingServer;
 
-void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inContext)
+void CASE_InitServerAdmin(nlTestSuite * inSuite, AdminPairingTable & adminTable, TestPersistentStorageDelegate & storageDelegate)
 {
-    TestCASESecurePairingDelegate delegateCommissioner;
-
-    auto * pairingCommissioner = chip::Platform::New<CASESession>();
-
-    AdminPairingTable adminTable;
-    TestPersistentStorageDelegate storageDelegate;
-    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
-
-    gLoopback.mSentMessageCount = 0;
-    NL_TEST_ASSERT(inSuite, pairingCommissioner->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, gPairingServer.GetSession().MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
-
-    SessionIDAllocator idAllocator;
-
     adminTable.Init(&storageDelegate);
 
     AdminPairingInfo * admin = adminTable.AssignAdminId(0);
@@ -347,7 +354,25 @@ void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inConte
     adminTable.ReleaseAdminId(0);
 
     adminTable.LoadFromStorage(0);
-    admin = adminTable.FindAdminWithId(0);
+}
+
+void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestCASESecurePairingDelegate delegateCommissioner;
+
+    auto * pairingCommissioner = chip::Platform::New<CASESession>();
+
+    AdminPairingTable adminTable;
+    TestPersistentStorageDelegate storageDelegate;
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    gLoopback.mSentMessageCount = 0;
+    NL_TEST_ASSERT(inSuite, pairingCommissioner->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+
+    SessionIDAllocator idAllocator;
+
+    CASE_InitServerAdmin(inSuite, adminTable, storageDelegate);
+    AdminPairingInfo * admin = adminTable.FindAdminWithId(0);
 
     ChipCertificateSet certificates;
     OperationalCredentialSet credentials;
@@ -367,6 +392,7 @@ void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inConte
 
     NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 3);
     NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, gPairingServer.GetActiveHandshakeCount() == 0);
 
     auto * pairingCommissioner1 = chip::Platform::New<CASESession>();
     NL_TEST_ASSERT(inSuite, pairingCommissioner1->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
@@ -380,6 +406,175 @@ void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inConte
     chip::Platform::Delete(pairingCommissioner1);
 }
 
+void CASE_SecurePairingConcurrentServerTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestCASESecurePairingDelegate delegateCommissioner;
+
+    AdminPairingTable adminTable;
+    TestPersistentStorageDelegate storageDelegate;
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    SessionIDAllocator idAllocator;
+
+    CASE_InitServerAdmin(inSuite, adminTable, storageDelegate);
+    AdminPairingInfo * admin = adminTable.FindAdminWithId(0);
+
+    ChipCertificateSet certificates;
+    OperationalCredentialSet credentials;
+    CertificateKeyId rootKeyId;
+    NL_TEST_ASSERT(inSuite, admin->GetCredentials(credentials, certificates, rootKeyId) == CHIP_NO_ERROR);
+
+    auto * server = chip::Platform::New<CASEServer>();
+    NL_TEST_ASSERT(inSuite,
+                   server->ListenForSessionEstablishment(&ctx.GetExchangeManager(), &gTransportMgr, &ctx.GetSecureSessionManager(),
+                                                         &adminTable, &idAllocator) == CHIP_NO_ERROR);
+
+    CASESession * pairingCommissioners[CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES + 1];
+    for (auto & pairingCommissioner : pairingCommissioners)
+    {
+        pairingCommissioner = chip::Platform::New<CASESession>();
+        NL_TEST_ASSERT(inSuite, pairingCommissioner->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    }
+
+    // Hold every handshake the server can run halfway, by delivering SigmaR1 and losing SigmaR2.
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES; i++)
+    {
+        gLoopback.Reset();
+        gLoopback.mNumMessagesToDeliver = 1;
+
+        ExchangeContext * contextCommissioner = ctx.NewExchangeToLocal(pairingCommissioners[i]);
+        NL_TEST_ASSERT(inSuite,
+                       pairingCommissioners[i]->EstablishSession(Transport::PeerAddress(Transport::Type::kBle), &credentials, 1,
+                                                                 0, contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 2);
+        NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 1);
+        NL_TEST_ASSERT(inSuite, server->GetActiveHandshakeCount() == i + 1);
+    }
+
+    // One more SigmaR1 is turned down as busy, and leaves the handshakes in progress alone.
+    gLoopback.Reset();
+    gLoopback.mNumMessagesToDeliver = UINT32_MAX;
+
+    CASESession * rejectedCommissioner    = pairingCommissioners[CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES];
+    ExchangeContext * contextCommissioner = ctx.NewExchangeToLocal(rejectedCommissioner);
+    NL_TEST_ASSERT(inSuite,
+                   rejectedCommissioner->EstablishSession(Transport::PeerAddress(Transport::Type::kBle), &credentials, 1, 0,
+                                                          contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 2);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingErrors == 1);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mLastError == CHIP_ERROR_SECURITY_MANAGER_BUSY);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 0);
+    NL_TEST_ASSERT(inSuite, server->GetActiveHandshakeCount() == CHIP_CONFIG_MAX_CONCURRENT_CASE_HANDSHAKES);
+
+    for (auto & pairingCommissioner : pairingCommissioners)
+    {
+        chip::Platform::Delete(pairingCommissioner);
+    }
+    chip::Platform::Delete(server);
+}
+
+void CASE_ResumableHandshake(nlTestSuite * inSuite, TestContext & ctx, SessionResumptionStorage & commissionerStorage,
+                             SessionResumptionStorage * accessoryStorage, uint32_t expectedMessageCount, bool expectResumed)
+{
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+    CASESession pairingCommissioner;
+    CASESession pairingAccessory;
+    CASESessionSerializable serializableCommissioner;
+    CASESessionSerializable serializableAccessory;
+
+    gLoopback.Reset();
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                       Protocols::SecureChannel::MsgType::CASE_SigmaR1, &pairingAccessory) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.ListenForSessionEstablishment(&accessoryDevOpCred, 0, &delegateAccessory) == CHIP_NO_ERROR);
+    pairingAccessory.EnableSessionResumption(accessoryStorage, 0);
+
+    ExchangeContext * contextCommissioner = ctx.NewExchangeToLocal(&pairingCommissioner);
+    pairingCommissioner.EnableSessionResumption(&commissionerStorage, 0);
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner.EstablishSession(Transport::PeerAddress(Transport::Type::kBle), &commissionerDevOpCred, 1, 0,
+                                                        contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == expectedMessageCount);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.IsSessionResumed() == expectResumed);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.IsSessionResumed() == expectResumed);
+
+    // Both sides derive the same session keys from these
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.ToSerializable(serializableCommissioner) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.ToSerializable(serializableAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, serializableCommissioner.mSharedSecretLen == serializableAccessory.mSharedSecretLen);
+    NL_TEST_ASSERT(inSuite,
+                   memcmp(serializableCommissioner.mSharedSecret, serializableAccessory.mSharedSecret,
+                          serializableCommissioner.mSharedSecretLen) == 0);
+    NL_TEST_ASSERT(inSuite,
+                   memcmp(serializableCommissioner.mMessageDigest, serializableAccessory.mMessageDigest,
+                          sizeof(serializableCommissioner.mMessageDigest)) == 0);
+
+    ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1);
+}
+
+void CASE_SecurePairingResumptionTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    SessionResumptionStorage commissionerStorage;
+    SessionResumptionStorage accessoryStorage;
+    SessionResumptionStorage restartedAccessoryStorage;
+
+    NL_TEST_ASSERT(inSuite, InitCredentialSets() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, commissionerStorage.Init(nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessoryStorage.Init(nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, restartedAccessoryStorage.Init(nullptr) == CHIP_NO_ERROR);
+
+    // The first session is established in full, and recorded on both sides.
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, &accessoryStorage, 3, false);
+    NL_TEST_ASSERT(inSuite, commissionerStorage.GetRecordCount() == 1);
+    NL_TEST_ASSERT(inSuite, accessoryStorage.GetRecordCount() == 1);
+
+    uint8_t resumptionId[kCASEResumptionIdSize];
+    memcpy(resumptionId, commissionerStorage.FindByPeer(1, 0)->GetResumptionId().data(), sizeof(resumptionId));
+    NL_TEST_ASSERT(inSuite, accessoryStorage.FindByResumptionId(ByteSpan(resumptionId)) != nullptr);
+
+    // The next one is resumed with SigmaR1 and SigmaR2Resume, under a new resumption ID.
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, &accessoryStorage, 2, true);
+    NL_TEST_ASSERT(inSuite, accessoryStorage.GetRecordCount() == 1);
+    NL_TEST_ASSERT(inSuite, accessoryStorage.FindByResumptionId(ByteSpan(resumptionId)) == nullptr);
+    NL_TEST_ASSERT(inSuite,
+                   accessoryStorage.FindByResumptionId(commissionerStorage.FindByPeer(1, 0)->GetResumptionId()) != nullptr);
+
+    // A responder that lost its records falls back to a full handshake, which can be resumed in turn.
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, &restartedAccessoryStorage, 3, false);
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, &restartedAccessoryStorage, 2, true);
+
+    // A resumption MIC that does not check out, here from a corrupted shared secret, falls back to a full handshake too.
+    const SessionResumptionStorage::Record * record = commissionerStorage.FindByPeer(1, 0);
+    NL_TEST_ASSERT(inSuite, record != nullptr);
+    VerifyOrReturn(record != nullptr);
+    uint8_t sharedSecret[Crypto::kMax_ECDH_Secret_Length];
+    const size_t sharedSecretLength = record->GetSharedSecret().size();
+    memcpy(resumptionId, record->GetResumptionId().data(), sizeof(resumptionId));
+    memcpy(sharedSecret, record->GetSharedSecret().data(), sharedSecretLength);
+    sharedSecret[0] ^= 0xFF;
+    NL_TEST_ASSERT(inSuite,
+                   commissionerStorage.Save(1, 0, ByteSpan(resumptionId), ByteSpan(sharedSecret, sharedSecretLength)) ==
+                       CHIP_NO_ERROR);
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, &restartedAccessoryStorage, 3, false);
+    NL_TEST_ASSERT(inSuite, restartedAccessoryStorage.FindByResumptionId(ByteSpan(resumptionId)) == nullptr);
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, &restartedAccessoryStorage, 2, true);
+
+    // A responder that does not resume sessions is no longer offered to.
+    CASE_ResumableHandshake(inSuite, ctx, commissionerStorage, nullptr, 3, false);
+    NL_TEST_ASSERT(inSuite, commissionerStorage.GetRecordCount() == 0);
+}
+
 void CASE_SecurePairingDeserialize(nlTestSuite * inSuite, void * inContext, CASESession & pairingCommissioner,
                                    CASESession & deserialized)
 {
@@ -447,6 +642,8 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Start",       CASE_SecurePairingStartTest),
     NL_TEST_DEF("Handshake",   CASE_SecurePairingHandshakeTest),
     NL_TEST_DEF("ServerHandshake", CASE_SecurePairingHandshakeServerTest),
+    NL_TEST_DEF("ConcurrentServerHandshakes", CASE_SecurePairingConcurrentServerTest),
+    NL_TEST_DEF("Resumption",  CASE_SecurePairingResumptionTest),
     NL_TEST_DEF("Serialize",   CASE_SecurePairingSerializeTest),
 
     NL_TEST_SENTINEL()
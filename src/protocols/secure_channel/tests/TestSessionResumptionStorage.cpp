@@ -0,0 +1,265 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/SessionResumptionStorage.h>
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr Transport::AdminId kAdminId = 1;
+
+class TestStorage : public PersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        Entry * entry = Find(key);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(size >= entry->mSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+        memcpy(buffer, entry->mValue, entry->mSize);
+        size = entry->mSize;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        VerifyOrReturnError(size <= sizeof(Entry::mValue), CHIP_ERROR_BUFFER_TOO_SMALL);
+        Entry * entry = Find(key);
+        if (entry == nullptr)
+        {
+            entry = Find("");
+        }
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NO_MEMORY);
+        strncpy(entry->mKey, key, sizeof(entry->mKey) - 1);
+        memcpy(entry->mValue, value, size);
+        entry->mSize = size;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override
+    {
+        Entry * entry = Find(key);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        *entry = Entry();
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetKeyCount()
+    {
+        size_t count = 0;
+        for (Entry & entry : mEntries)
+        {
+            if (entry.mKey[0] != '\0')
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+private:
+    struct Entry
+    {
+        char mKey[16]       = { 0 };
+        uint8_t mValue[128] = { 0 };
+        uint16_t mSize      = 0;
+    };
+
+    Entry * Find(const char * key)
+    {
+        for (Entry & entry : mEntries)
+        {
+            if (strcmp(entry.mKey, key) == 0)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    Entry mEntries[CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE + 1];
+};
+
+void MakeRecord(uint8_t seed, uint8_t (&resumptionId)[kCASEResumptionIdSize], uint8_t (&sharedSecret)[32])
+{
+    memset(resumptionId, seed, sizeof(resumptionId));
+    memset(sharedSecret, static_cast<uint8_t>(~seed), sizeof(sharedSecret));
+}
+
+CHIP_ERROR SaveRecord(SessionResumptionStorage & storage, NodeId peer, uint8_t seed)
+{
+    uint8_t resumptionId[kCASEResumptionIdSize];
+    uint8_t sharedSecret[32];
+    MakeRecord(seed, resumptionId, sharedSecret);
+    return storage.Save(peer, kAdminId, ByteSpan(resumptionId), ByteSpan(sharedSecret));
+}
+
+void TestSaveAndFind(nlTestSuite * inSuite, void * inContext)
+{
+    SessionResumptionStorage storage;
+    uint8_t resumptionId[kCASEResumptionIdSize];
+    uint8_t sharedSecret[32];
+
+    NL_TEST_ASSERT(inSuite, storage.Init(nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(100, kAdminId) == nullptr);
+
+    MakeRecord(1, resumptionId, sharedSecret);
+    NL_TEST_ASSERT(inSuite, storage.Save(100, kAdminId, ByteSpan(resumptionId), ByteSpan(sharedSecret)) == CHIP_NO_ERROR);
+
+    const SessionResumptionStorage::Record * record = storage.FindByPeer(100, kAdminId);
+    NL_TEST_ASSERT(inSuite, record != nullptr);
+    NL_TEST_ASSERT(inSuite, record == storage.FindByResumptionId(ByteSpan(resumptionId)));
+    NL_TEST_ASSERT(inSuite, record->GetSharedSecret().data_equal(ByteSpan(sharedSecret)));
+    NL_TEST_ASSERT(inSuite, record->mPeerNodeId == 100);
+
+    // Records are per admin
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(100, kAdminId + 1) == nullptr);
+
+    // A new session with the peer replaces its record, and the old resumption ID with it
+    NL_TEST_ASSERT(inSuite, SaveRecord(storage, 100, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.GetRecordCount() == 1);
+    NL_TEST_ASSERT(inSuite, storage.FindByResumptionId(ByteSpan(resumptionId)) == nullptr);
+
+    NL_TEST_ASSERT(inSuite, storage.Delete(100, kAdminId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(100, kAdminId) == nullptr);
+    NL_TEST_ASSERT(inSuite, storage.Delete(100, kAdminId) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, storage.GetRecordCount() == 0);
+}
+
+void TestEvictLeastRecentlyUsed(nlTestSuite * inSuite, void * inContext)
+{
+    SessionResumptionStorage storage;
+    constexpr size_t kSize = CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE;
+
+    NL_TEST_ASSERT(inSuite, storage.Init(nullptr) == CHIP_NO_ERROR);
+
+    for (uint8_t i = 0; i < kSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, SaveRecord(storage, i, i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetRecordCount() == kSize);
+
+    // Peer 0 reconnects, which leaves peer 1 as the least recently used
+    NL_TEST_ASSERT(inSuite, SaveRecord(storage, 0, 0x80) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, SaveRecord(storage, kSize, 0x81) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, storage.GetRecordCount() == kSize);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(0, kAdminId) != nullptr);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(1, kAdminId) == nullptr);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(2, kAdminId) != nullptr);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(kSize, kAdminId) != nullptr);
+}
+
+void TestPersist(nlTestSuite * inSuite, void * inContext)
+{
+    TestStorage kvs;
+    uint8_t resumptionId[kCASEResumptionIdSize];
+    uint8_t sharedSecret[32];
+
+    MakeRecord(7, resumptionId, sharedSecret);
+
+    {
+        SessionResumptionStorage storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(&kvs) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, SaveRecord(storage, 200, 6) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Save(300, kAdminId, ByteSpan(resumptionId), ByteSpan(sharedSecret)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete(200, kAdminId) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, kvs.GetKeyCount() == 1);
+    }
+
+    // The records outlive a restart
+    SessionResumptionStorage storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(&kvs) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.GetRecordCount() == 1);
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(200, kAdminId) == nullptr);
+
+    const SessionResumptionStorage::Record * record = storage.FindByResumptionId(ByteSpan(resumptionId));
+    NL_TEST_ASSERT(inSuite, record != nullptr);
+    NL_TEST_ASSERT(inSuite, record == storage.FindByPeer(300, kAdminId));
+    NL_TEST_ASSERT(inSuite, record->mAdminId == kAdminId);
+    NL_TEST_ASSERT(inSuite, record->GetSharedSecret().data_equal(ByteSpan(sharedSecret)));
+
+    // Records saved after the restart are still more recent than the loaded ones
+    for (uint8_t i = 0; i < CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE; i++)
+    {
+        NL_TEST_ASSERT(inSuite, SaveRecord(storage, 400 + i, i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.FindByPeer(300, kAdminId) == nullptr);
+    NL_TEST_ASSERT(inSuite, kvs.GetKeyCount() == CHIP_CONFIG_CASE_SESSION_RESUMPTION_STORAGE_SIZE);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("SaveAndFind", TestSaveAndFind),
+    NL_TEST_DEF("EvictLeastRecentlyUsed", TestEvictLeastRecentlyUsed),
+    NL_TEST_DEF("Persist", TestPersist),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+static nlTestSuite sSuite =
+{
+    "Test-CHIP-SessionResumptionStorage",
+    &sTests[0],
+    TestSetup,
+    TestTeardown,
+};
+// clang-format on
+
+/**
+ *  Main
+ */
+int TestSessionResumptionStorage()
+{
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSessionResumptionStorage)
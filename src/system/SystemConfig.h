@@ -319,6 +319,21 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+ *
+ *  @brief
+ *      This is the number of freed packet buffers, per size class, that are kept for reuse when packet buffers are allocated
+ *      from the heap, i.e. when #CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is zero (0).
+ *
+ *      Heap allocations are rounded up to one of a few size classes, the largest of which is
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX. This may be set to zero (0) to allocate exact sizes and return every
+ *      freed buffer to the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE 8
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
  *
@@ -655,3 +670,14 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS 0
 #endif
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      The maximum number of ready sockets retrieved by a single call to epoll_wait() when the epoll socket event loop
+ *      is in use. Sockets beyond this limit remain ready and are reported on the next iteration of the event loop.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
@@ -30,6 +30,7 @@
 
 // Include local headers
 #include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
 #include <system/SystemTimer.h>
 
 // Include additional CHIP headers
@@ -129,7 +130,6 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(nullptr), mPl
         sSystemEventHandlerDelegate.Init(HandleSystemLayerEvent);
 
     this->mEventDelegateList = NULL;
-    this->mTimerList         = NULL;
     this->mTimerComplete     = false;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -209,6 +209,8 @@ CHIP_ERROR Layer::Shutdown()
     mWatchableEvents.Shutdown();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+    PacketBuffer::ReleaseCachedBuffers();
+
     this->mContext    = nullptr;
     this->mLayerState = kLayerState_NotInitialized;
 
@@ -361,15 +363,11 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void * aAppState)
     if (this->State() != kLayerState_Initialized)
         return;
 
-    for (size_t i = 0; i < Timer::sPool.Size(); ++i)
-    {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+    Timer * lTimer = mTimerQueue.Find(aOnComplete, aAppState);
 
-        if (lTimer != nullptr && lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState)
-        {
-            lTimer->Cancel();
-            break;
-        }
+    if (lTimer != nullptr)
+    {
+        lTimer->Cancel();
     }
 }
 
@@ -456,23 +454,20 @@ bool Layer::GetTimeout(struct timeval & aSleepTime)
     Clock::MonotonicMilliseconds lAwakenTime = kCurrentTime + static_cast<Clock::MonotonicMilliseconds>(aSleepTime.tv_sec) * 1000 +
         static_cast<uint32_t>(aSleepTime.tv_usec) / 1000;
 
-    bool anyTimer = false;
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
+    bool anyTimer  = false;
+    Timer * lTimer = mTimerQueue.Earliest();
+
+    if (lTimer != nullptr)
     {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+        anyTimer = true;
 
-        if (lTimer != nullptr)
+        if (!Timer::IsEarlier(kCurrentTime, lTimer->mAwakenTime))
         {
-            anyTimer = true;
-
-            if (!Timer::IsEarlier(kCurrentTime, lTimer->mAwakenTime))
-            {
-                lAwakenTime = kCurrentTime;
-                break;
-            }
-
-            if (Timer::IsEarlier(lTimer->mAwakenTime, lAwakenTime))
-                lAwakenTime = lTimer->mAwakenTime;
+            lAwakenTime = kCurrentTime;
+        }
+        else if (Timer::IsEarlier(lTimer->mAwakenTime, lAwakenTime))
+        {
+            lAwakenTime = lTimer->mAwakenTime;
         }
     }
 
@@ -504,14 +499,16 @@ void Layer::HandleTimeout()
 
     const Clock::MonotonicMilliseconds kCurrentTime = Clock::GetMonotonicMilliseconds();
 
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
-    {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+    // Expire every due timer in one pass, earliest first. The pass is bounded by the number of timers queued on entry, so
+    // timers re-armed with a zero delay by the callbacks are left for the next pass instead of starving the event loop.
+    size_t lTimersToHandle = mTimerQueue.Count();
+    Timer * lTimer;
 
-        if (lTimer != nullptr && !Timer::IsEarlier(kCurrentTime, lTimer->mAwakenTime))
-        {
-            lTimer->HandleComplete();
-        }
+    while (lTimersToHandle-- > 0 && (lTimer = mTimerQueue.Earliest()) != nullptr &&
+           !Timer::IsEarlier(kCurrentTime, lTimer->mAwakenTime))
+    {
+        mTimerQueue.Remove(*lTimer);
+        lTimer->HandleComplete();
     }
 
     DispatchTimerCallbacks(kCurrentTime);
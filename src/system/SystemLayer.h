@@ -189,13 +189,13 @@ private:
     void * mContext;
     void * mPlatformData;
     chip::Callback::CallbackDeque mTimerCallbacks;
+    TimerQueue<CHIP_SYSTEM_CONFIG_NUM_TIMERS> mTimerQueue;
     Clock mClock;
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     static LwIPEventHandlerDelegate sSystemEventHandlerDelegate;
 
     const LwIPEventHandlerDelegate * mEventDelegateList;
-    Timer * mTimerList;
     bool mTimerComplete;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -123,6 +123,177 @@ void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 }
 #endif // CHIP_CONFIG_MEMORY_DEBUG_CHECKS
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+
+namespace {
+
+constexpr uint16_t LimitAllocSize(uint16_t aSize)
+{
+    return (aSize < PacketBuffer::kMaxSizeWithoutReserve) ? aSize : PacketBuffer::kMaxSizeWithoutReserve;
+}
+
+// Allocation sizes that heap allocations are rounded up to, so that freed buffers can be reused for later allocations.
+constexpr uint16_t kHeapCacheAllocSizes[] = { LimitAllocSize(128), LimitAllocSize(512), PacketBuffer::kMaxSizeWithoutReserve };
+constexpr size_t kHeapCacheClassCount     = sizeof(kHeapCacheAllocSizes) / sizeof(kHeapCacheAllocSizes[0]);
+
+/**
+ * Bounded free lists of heap-allocated packet buffers, one for each size class.
+ */
+class HeapCache
+{
+public:
+    HeapCache()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        Mutex::Init(mMutex);
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    void Lock()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        mMutex.Lock();
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    void Unlock()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        mMutex.Unlock();
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    // Returns the size class of buffers with the given allocation size, or kHeapCacheClassCount if they are not cached.
+    static size_t ClassOf(uint16_t aAllocSize)
+    {
+        size_t i = 0;
+        while (i < kHeapCacheClassCount && kHeapCacheAllocSizes[i] != aAllocSize)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    struct FreeList
+    {
+        PacketBuffer * mHead = nullptr;
+        size_t mCount        = 0;
+    };
+
+    FreeList mFreeLists[kHeapCacheClassCount];
+
+private:
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    Mutex mMutex;
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+};
+
+HeapCache sHeapCache;
+
+} // namespace
+
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+
+/**
+ * Return the allocation size to request from the heap for the given packet buffer data size, which is no larger than
+ * PacketBuffer::kMaxSizeWithoutReserve.
+ */
+uint16_t PacketBuffer::HeapAllocSize(size_t aSize)
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+    for (uint16_t allocSize : kHeapCacheAllocSizes)
+    {
+        if (aSize <= allocSize)
+        {
+            return allocSize;
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+    return static_cast<uint16_t>(aSize);
+}
+
+PacketBuffer * PacketBuffer::HeapAlloc(uint16_t aAllocSize)
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+    const size_t sizeClass = HeapCache::ClassOf(aAllocSize);
+    if (sizeClass < kHeapCacheClassCount)
+    {
+        HeapCache::FreeList & freeList = sHeapCache.mFreeLists[sizeClass];
+        PacketBuffer * packet          = nullptr;
+
+        sHeapCache.Lock();
+        if (freeList.mHead != nullptr)
+        {
+            packet         = freeList.mHead;
+            freeList.mHead = packet->ChainedBuffer();
+            freeList.mCount--;
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufsCached);
+        }
+        sHeapCache.Unlock();
+
+        if (packet != nullptr)
+        {
+            return packet;
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+
+    return reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(kStructureSize + aAllocSize));
+}
+
+void PacketBuffer::HeapFree(PacketBuffer * aPacket, uint16_t aAllocSize)
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+    const size_t sizeClass = HeapCache::ClassOf(aAllocSize);
+    if (sizeClass < kHeapCacheClassCount)
+    {
+        HeapCache::FreeList & freeList = sHeapCache.mFreeLists[sizeClass];
+        bool cached                    = false;
+
+        sHeapCache.Lock();
+        if (freeList.mCount < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE)
+        {
+            aPacket->next  = freeList.mHead;
+            freeList.mHead = aPacket;
+            freeList.mCount++;
+            cached = true;
+            SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufsCached);
+        }
+        sHeapCache.Unlock();
+
+        if (cached)
+        {
+            return;
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+
+    chip::Platform::MemoryFree(aPacket);
+}
+
+void PacketBuffer::ReleaseCachedBuffers()
+{
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+    for (HeapCache::FreeList & freeList : sHeapCache.mFreeLists)
+    {
+        sHeapCache.Lock();
+        PacketBuffer * packet = freeList.mHead;
+        freeList.mHead        = nullptr;
+        SYSTEM_STATS_DECREMENT_BY_N(chip::System::Stats::kSystemLayer_NumPacketBufsCached,
+                                    static_cast<chip::System::Stats::count_t>(freeList.mCount));
+        freeList.mCount = 0;
+        sHeapCache.Unlock();
+
+        while (packet != nullptr)
+        {
+            PacketBuffer * next = packet->ChainedBuffer();
+            chip::Platform::MemoryFree(packet);
+            packet = next;
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+}
+
 // Number of unused bytes below which \c RightSize() won't bother reallocating.
 constexpr uint16_t kRightSizingThreshold = 16;
 
@@ -138,13 +309,13 @@ void PacketBufferHandle::InternalRightSize()
     uint8_t * const start   = reinterpret_cast<uint8_t *>(mBuffer) + PacketBuffer::kStructureSize;
     uint8_t * const payload = reinterpret_cast<uint8_t *>(mBuffer->payload);
     const uint16_t usedSize = static_cast<uint16_t>(payload - start + mBuffer->len);
-    if (usedSize + kRightSizingThreshold > mBuffer->alloc_size)
+    const uint16_t newSize  = PacketBuffer::HeapAllocSize(usedSize);
+    if (newSize + kRightSizingThreshold > mBuffer->alloc_size)
     {
         return;
     }
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
-    PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+    PacketBuffer * newBuffer = PacketBuffer::HeapAlloc(newSize);
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -157,7 +328,7 @@ void PacketBufferHandle::InternalRightSize()
     newBuffer->tot_len       = mBuffer->tot_len;
     newBuffer->len           = mBuffer->len;
     newBuffer->ref           = 1;
-    newBuffer->alloc_size    = static_cast<uint16_t>(usedSize);
+    newBuffer->alloc_size    = newSize;
     memcpy(reinterpret_cast<uint8_t *>(newBuffer) + PacketBuffer::kStructureSize, start, usedSize);
 
     PacketBuffer::Free(mBuffer);
@@ -179,6 +350,10 @@ void PacketBufferHandle::InternalRightSize()
 
 #endif // CHIP_SYSTEM_PACKETBUFFER_STORE
 
+#if CHIP_SYSTEM_PACKETBUFFER_STORE != CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+void PacketBuffer::ReleaseCachedBuffers() {}
+#endif // CHIP_SYSTEM_PACKETBUFFER_STORE != CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+
 #ifndef LOCK_BUF_POOL
 #define LOCK_BUF_POOL()                                                                                                            \
     do                                                                                                                             \
@@ -487,7 +662,10 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
 #elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
 
-    lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+    static_cast<void>(lBlockSize);
+
+    const uint16_t lHeapAllocSize = PacketBuffer::HeapAllocSize(lAllocSize);
+    lPacket                       = PacketBuffer::HeapAlloc(lHeapAllocSize);
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
 #else
@@ -505,7 +683,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     lPacket->next                   = nullptr;
     lPacket->ref                    = 1;
 #if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
-    lPacket->alloc_size = static_cast<uint16_t>(lAllocSize);
+    lPacket->alloc_size = lHeapAllocSize;
 #endif
 
     return PacketBufferHandle(lPacket);
@@ -568,13 +746,14 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+            const uint16_t lAllocSize = aPacket->alloc_size;
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
-            chip::Platform::MemoryFree(aPacket);
+            HeapFree(aPacket, lAllocSize);
 #endif // CHIP_SYSTEM_PACKETBUFFER_STORE
             aPacket       = lNextPacket;
         }
@@ -376,6 +376,14 @@ public:
 #endif
     }
 
+    /**
+     * Return the freed packet buffers kept for reuse to the underlying allocator.
+     *
+     * Packet buffers allocated from the heap are cached when freed (see #CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE).
+     * The System Layer releases them when it shuts down; in other configurations, this function does nothing.
+     */
+    static void ReleaseCachedBuffers();
+
 private:
     // Memory required for a maximum-size PacketBuffer.
     static constexpr uint16_t kBlockSize = PacketBuffer::kStructureSize + PacketBuffer::kMaxSizeWithoutReserve;
@@ -392,6 +400,12 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+    static uint16_t HeapAllocSize(size_t aSize);
+    static PacketBuffer * HeapAlloc(uint16_t aAllocSize);
+    static void HeapFree(PacketBuffer * aPacket, uint16_t aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -46,6 +46,7 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+    "SystemLayer_NumPacketBufsCached",
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -56,6 +56,7 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+    kSystemLayer_NumPacketBufsCached,
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
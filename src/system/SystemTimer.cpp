@@ -125,42 +125,21 @@ CHIP_ERROR Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete
     }
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
-    // add to the sorted list of timers. Earliest timer appears first.
-    if (lLayer.mTimerList == NULL || this->IsEarlier(this->mAwakenTime, lLayer.mTimerList->mAwakenTime))
-    {
-        this->mNextTimer  = lLayer.mTimerList;
-        lLayer.mTimerList = this;
+    lLayer.mTimerQueue.Insert(*this);
 
-        // this is the new earliest timer and so the timer needs (re-)starting provided that
-        // the system is not currently processing expired timers, in which case it is left to
-        // HandleExpiredTimers() to re-start the timer.
-        if (!lLayer.mTimerComplete)
-        {
-            lLayer.StartPlatformTimer(aDelayMilliseconds);
-        }
-    }
-    else
+    // if this is the new earliest timer, the platform timer needs (re-)starting provided that the system is not currently
+    // processing expired timers, in which case it is left to HandleExpiredTimers() to re-start the timer.
+    if (lLayer.mTimerQueue.Earliest() == this && !lLayer.mTimerComplete)
     {
-        Timer * lTimer = lLayer.mTimerList;
-
-        while (lTimer->mNextTimer)
-        {
-            if (this->IsEarlier(this->mAwakenTime, lTimer->mNextTimer->mAwakenTime))
-            {
-                // found the insert location.
-                break;
-            }
-
-            lTimer = lTimer->mNextTimer;
-        }
-
-        this->mNextTimer   = lTimer->mNextTimer;
-        lTimer->mNextTimer = this;
+        lLayer.StartPlatformTimer(aDelayMilliseconds);
     }
     return CHIP_NO_ERROR;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+    // Timers that run on a dispatch queue are queued as well, so that Layer::CancelTimer() finds them.
+    lLayer.mTimerQueue.Insert(*this);
+
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
     dispatch_queue_t dispatchQueue = lLayer.GetDispatchQueue();
     if (dispatchQueue)
@@ -205,6 +184,7 @@ CHIP_ERROR Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
     }
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
+    // Not queued: the posted event is the only thing that completes it, and it is released as is if posting fails.
     err = lLayer.PostEvent(*this, chip::System::kEvent_ScheduleWork, 0);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -220,6 +200,8 @@ CHIP_ERROR Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
     else
     {
 #endif // CHIP_SYSTEM_CONFIG_USE_DISPATCH
+        // Due immediately; Layer::HandleTimeout() completes it on the next pass of the event loop.
+        lLayer.mTimerQueue.Insert(*this);
         lLayer.WakeIOThread();
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
     }
@@ -236,9 +218,7 @@ CHIP_ERROR Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
  */
 CHIP_ERROR Timer::Cancel()
 {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    Layer & lLayer = this->SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+    Layer & lLayer              = this->SystemLayer();
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -249,32 +229,7 @@ CHIP_ERROR Timer::Cancel()
     // Since this thread changed the state of OnComplete, release the timer.
     this->AppState = nullptr;
 
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    if (lLayer.mTimerList)
-    {
-        if (this == lLayer.mTimerList)
-        {
-            lLayer.mTimerList = this->mNextTimer;
-        }
-        else
-        {
-            Timer * lTimer = lLayer.mTimerList;
-
-            while (lTimer->mNextTimer)
-            {
-                if (this == lTimer->mNextTimer)
-                {
-                    lTimer->mNextTimer = this->mNextTimer;
-                    break;
-                }
-
-                lTimer = lTimer->mNextTimer;
-            }
-        }
-
-        this->mNextTimer = NULL;
-    }
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+    lLayer.mTimerQueue.Remove(*this);
 
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
     if (mTimerSource != nullptr)
@@ -306,6 +261,7 @@ void Timer::HandleComplete()
 
     // Since this thread changed the state of OnComplete, release the timer.
     AppState = nullptr;
+    lLayer.mTimerQueue.Remove(*this);
     this->Release();
 
     // Invoke the app's callback, if it's still valid.
@@ -340,17 +296,17 @@ CHIP_ERROR Timer::HandleExpiredTimers(Layer & aLayer)
     // regardless how long the processing of the currently expired timers took
     Clock::MonotonicMilliseconds currentTime = Clock::GetMonotonicMilliseconds();
 
-    while (aLayer.mTimerList)
+    while (!aLayer.mTimerQueue.IsEmpty())
     {
+        Timer & lTimer = *aLayer.mTimerQueue.Earliest();
+
         // limit the number of timers handled before the control is returned to the event queue.  The bound is similar to
         // (though not exactly same) as that on the sockets-based systems.
 
         // The platform timer API has MSEC resolution so expire any timer with less than 1 msec remaining.
-        if ((timersHandled < Timer::sPool.Size()) && Timer::IsEarlier(aLayer.mTimerList->mAwakenTime, currentTime + 1))
+        if ((timersHandled < Timer::sPool.Size()) && Timer::IsEarlier(lTimer.mAwakenTime, currentTime + 1))
         {
-            Timer & lTimer    = *aLayer.mTimerList;
-            aLayer.mTimerList = lTimer.mNextTimer;
-            lTimer.mNextTimer = NULL;
+            aLayer.mTimerQueue.Remove(lTimer);
 
             aLayer.mTimerComplete = true;
             lTimer.HandleComplete();
@@ -366,9 +322,9 @@ CHIP_ERROR Timer::HandleExpiredTimers(Layer & aLayer)
             currentTime = Clock::GetMonotonicMilliseconds();
 
             // the next timer expires in the future, so set the delayMilliseconds to a non-zero value
-            if (currentTime < aLayer.mTimerList->mAwakenTime)
+            if (currentTime < lTimer.mAwakenTime)
             {
-                delayMilliseconds = aLayer.mTimerList->mAwakenTime - currentTime;
+                delayMilliseconds = lTimer.mAwakenTime - currentTime;
             }
             /*
              * StartPlatformTimer() accepts a 32bit value in milliseconds. Timestamps are 64bit numbers. The only way in which this
@@ -387,5 +343,138 @@ CHIP_ERROR Timer::HandleExpiredTimers(Layer & aLayer)
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+TimerQueueBase::TimerQueueBase(Timer ** aHeap, size_t aCapacity, Timer ** aBuckets, size_t aBucketCount) :
+    mHeap(aHeap), mCapacity(aCapacity), mBuckets(aBuckets), mBucketMask(aBucketCount - 1), mCount(0)
+{
+    for (size_t i = 0; i < aBucketCount; i++)
+    {
+        mBuckets[i] = nullptr;
+    }
+}
+
+/**
+ *  Adds an armed timer to the queue, keyed by its current awaken time, completion function and application state.
+ *
+ *  @note
+ *      The queue is sized for the whole timer pool, so running out of room means the queue is corrupt.
+ */
+void TimerQueueBase::Insert(Timer & aTimer)
+{
+    VerifyOrDie(aTimer.mQueueSlot == 0);
+    VerifyOrDie(mCount < mCapacity);
+
+    aTimer.mQueueBucket           = BucketFor(aTimer.OnComplete, aTimer.AppState);
+    aTimer.mNextInBucket          = mBuckets[aTimer.mQueueBucket];
+    mBuckets[aTimer.mQueueBucket] = &aTimer;
+
+    SetAt(mCount++, &aTimer);
+    SiftUp(mCount - 1);
+}
+
+/**
+ *  Removes a timer from the queue. Harmless if the timer is not queued.
+ */
+void TimerQueueBase::Remove(Timer & aTimer)
+{
+    VerifyOrReturn(aTimer.mQueueSlot != 0);
+
+    for (Timer ** lLink = &mBuckets[aTimer.mQueueBucket]; *lLink != nullptr; lLink = &(*lLink)->mNextInBucket)
+    {
+        if (*lLink == &aTimer)
+        {
+            *lLink = aTimer.mNextInBucket;
+            break;
+        }
+    }
+    aTimer.mNextInBucket = nullptr;
+
+    const size_t lIndex = aTimer.mQueueSlot - 1;
+    aTimer.mQueueSlot   = 0;
+
+    Timer * lLast = mHeap[--mCount];
+    if (lIndex != mCount)
+    {
+        // Move the last element into the hole, then restore the heap property in whichever direction is needed.
+        SetAt(lIndex, lLast);
+        SiftUp(lIndex);
+        SiftDown(lLast->mQueueSlot - 1);
+    }
+}
+
+/**
+ *  Finds the queued timer started with the given completion function and application state, if any.
+ */
+Timer * TimerQueueBase::Find(Timer::OnCompleteFunct aOnComplete, void * aAppState) const
+{
+    for (Timer * lTimer = mBuckets[BucketFor(aOnComplete, aAppState)]; lTimer != nullptr; lTimer = lTimer->mNextInBucket)
+    {
+        if (lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState)
+        {
+            return lTimer;
+        }
+    }
+    return nullptr;
+}
+
+size_t TimerQueueBase::BucketFor(Timer::OnCompleteFunct aOnComplete, void * aAppState) const
+{
+    uint64_t lHash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(aOnComplete)) * 31 +
+        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(aAppState));
+
+    // 64-bit finalizer from MurmurHash3.
+    lHash ^= lHash >> 33;
+    lHash *= 0xff51afd7ed558ccdULL;
+    lHash ^= lHash >> 33;
+    return static_cast<size_t>(lHash) & mBucketMask;
+}
+
+void TimerQueueBase::SetAt(size_t aIndex, Timer * aTimer)
+{
+    mHeap[aIndex]      = aTimer;
+    aTimer->mQueueSlot = aIndex + 1;
+}
+
+void TimerQueueBase::SiftUp(size_t aIndex)
+{
+    Timer * lTimer = mHeap[aIndex];
+
+    while (aIndex > 0)
+    {
+        const size_t lParent = (aIndex - 1) / 2;
+        if (!Timer::IsEarlier(lTimer->mAwakenTime, mHeap[lParent]->mAwakenTime))
+        {
+            break;
+        }
+        SetAt(aIndex, mHeap[lParent]);
+        aIndex = lParent;
+    }
+    SetAt(aIndex, lTimer);
+}
+
+void TimerQueueBase::SiftDown(size_t aIndex)
+{
+    Timer * lTimer = mHeap[aIndex];
+
+    while (true)
+    {
+        size_t lChild = 2 * aIndex + 1;
+        if (lChild >= mCount)
+        {
+            break;
+        }
+        if (lChild + 1 < mCount && Timer::IsEarlier(mHeap[lChild + 1]->mAwakenTime, mHeap[lChild]->mAwakenTime))
+        {
+            lChild++;
+        }
+        if (!Timer::IsEarlier(mHeap[lChild]->mAwakenTime, lTimer->mAwakenTime))
+        {
+            break;
+        }
+        SetAt(aIndex, mHeap[lChild]);
+        aIndex = lChild;
+    }
+    SetAt(aIndex, lTimer);
+}
+
 } // namespace System
 } // namespace chip
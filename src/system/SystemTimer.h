@@ -44,6 +44,7 @@ namespace chip {
 namespace System {
 
 class Layer;
+class TimerQueueBase;
 
 /**
  * @class Timer
@@ -57,6 +58,8 @@ class Layer;
 class DLL_EXPORT Timer : public Object
 {
     friend class Layer;
+    friend class TimerQueueBase;
+    friend class TestTimer;
 
 public:
     static bool IsEarlier(const Clock::MonotonicMilliseconds & first, const Clock::MonotonicMilliseconds & second);
@@ -74,13 +77,16 @@ private:
 
     Clock::MonotonicMilliseconds mAwakenTime;
 
+    // Bookkeeping for TimerQueueBase. Timers are zeroed on allocation, so a zero mQueueSlot means "not queued".
+    size_t mQueueSlot;     /**< One-based position in the queue heap, zero if not queued. */
+    size_t mQueueBucket;   /**< Hash bucket of (OnComplete, AppState) in the queue. */
+    Timer * mNextInBucket; /**< Next timer in the same hash bucket. */
+
     void HandleComplete();
 
     CHIP_ERROR ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState);
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
-    Timer * mNextTimer;
-
     static CHIP_ERROR HandleExpiredTimers(Layer & aLayer);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -93,6 +99,75 @@ private:
     Timer & operator=(const Timer &) = delete;
 };
 
+/**
+ * @class TimerQueueBase
+ *
+ * @brief
+ *  The set of armed timers of a Layer.
+ *
+ *  Timers are kept in an intrusive binary min-heap ordered by awaken time, so that starting and cancelling a timer costs
+ *  O(log n) and the next timer to expire is found in O(1). A hash on (OnComplete, AppState) lets Layer::CancelTimer find a
+ *  timer without scanning the timer pool.
+ *
+ *  Storage is provided by the TimerQueue class template. Like the rest of the timer API, the queue must only be used with the
+ *  CHIP stack lock held.
+ */
+class DLL_EXPORT TimerQueueBase
+{
+public:
+    void Insert(Timer & aTimer);
+    void Remove(Timer & aTimer);
+    Timer * Find(Timer::OnCompleteFunct aOnComplete, void * aAppState) const;
+
+    Timer * Earliest() const { return (mCount > 0) ? mHeap[0] : nullptr; }
+    size_t Count() const { return mCount; }
+    bool IsEmpty() const { return mCount == 0; }
+
+protected:
+    TimerQueueBase(Timer ** aHeap, size_t aCapacity, Timer ** aBuckets, size_t aBucketCount);
+
+private:
+    size_t BucketFor(Timer::OnCompleteFunct aOnComplete, void * aAppState) const;
+    void SetAt(size_t aIndex, Timer * aTimer);
+    void SiftUp(size_t aIndex);
+    void SiftDown(size_t aIndex);
+
+    Timer ** const mHeap;
+    const size_t mCapacity;
+    Timer ** const mBuckets;
+    const size_t mBucketMask;
+    size_t mCount;
+
+    // Not defined
+    TimerQueueBase(const TimerQueueBase &) = delete;
+    TimerQueueBase & operator=(const TimerQueueBase &) = delete;
+};
+
+/**
+ *  @brief
+ *      A TimerQueueBase with room for \c N timers.
+ *
+ *  @tparam     N   the maximum number of simultaneously queued timers.
+ */
+template <size_t N>
+class TimerQueue : public TimerQueueBase
+{
+public:
+    TimerQueue() : TimerQueueBase(mHeapStorage, N, mBucketStorage, kBucketCount) {}
+
+private:
+    static constexpr size_t BucketCountFor(size_t aCount, size_t aBuckets = 1)
+    {
+        return (aBuckets >= aCount) ? aBuckets : BucketCountFor(aCount, aBuckets << 1);
+    }
+
+    // Power of two, so that hashes can be reduced with a mask.
+    static constexpr size_t kBucketCount = BucketCountFor(N);
+
+    Timer * mHeapStorage[N];
+    Timer * mBucketStorage[kBucketCount];
+};
+
 inline void Timer::GetStatistics(chip::System::Stats::count_t & aNumInUse, chip::System::Stats::count_t & aHighWatermark)
 {
     sPool.GetStatistics(aNumInUse, aHighWatermark);
@@ -0,0 +1,261 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements WatchableEvents using Linux epoll.
+ */
+
+#include <platform/LockTracker.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <system/SystemSockets.h>
+
+#include <errno.h>
+#include <limits.h>
+
+#define DEFAULT_MIN_SLEEP_PERIOD (60 * 60 * 24 * 30) // Month [sec]
+
+#if CHIP_DEVICE_CONFIG_ENABLE_MDNS && !__ZEPHYR__
+
+namespace chip {
+namespace Mdns {
+void GetMdnsTimeout(timeval & timeout);
+void HandleMdnsTimeout();
+} // namespace Mdns
+} // namespace chip
+
+#endif // CHIP_DEVICE_CONFIG_ENABLE_MDNS && !__ZEPHYR__
+
+namespace chip {
+namespace System {
+
+namespace {
+
+// Round up, so that we never wake before the earliest timer is due and spin.
+int EpollTimeoutFromTimeval(const timeval & timeout)
+{
+    if (timeout.tv_sec < 0 || (timeout.tv_sec == 0 && timeout.tv_usec <= 0))
+    {
+        return 0;
+    }
+    if (timeout.tv_sec >= INT_MAX / 1000 - 1)
+    {
+        return INT_MAX;
+    }
+    return static_cast<int>(timeout.tv_sec * 1000 + (timeout.tv_usec + 999) / 1000);
+}
+
+} // anonymous namespace
+
+void WatchableEventManager::Init(Layer & systemLayer)
+{
+    mSystemLayer   = &systemLayer;
+    mEpollResult   = 0;
+    mHandledEvents = 0;
+    mEpollFd       = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrDieWithMsg(mEpollFd >= 0, DeviceLayer, "epoll_create1 failed: %s", ErrorStr(System::MapErrorPOSIX(errno)));
+}
+
+void WatchableEventManager::Shutdown()
+{
+    if (mEpollFd >= 0)
+    {
+        close(mEpollFd);
+        mEpollFd = -1;
+    }
+    mEpollResult   = 0;
+    mHandledEvents = 0;
+    mSystemLayer   = nullptr;
+}
+
+/**
+ *  Translate the events reported by epoll_wait() for a socket into SocketEvents.
+ *
+ *  select() reports a hung-up or failed socket as ready for whichever operations were requested, and socket
+ *  callbacks rely on the subsequent recv() or send() to pick up the error, so the same is done here.
+ *
+ *  @param[in]    epollEvents   The events member of the epoll_event returned by epoll_wait().
+ *
+ *  @param[in]    requested     The epoll event mask requested for the socket.
+ */
+SocketEvents WatchableEventManager::SocketEventsFromEpollEvents(uint32_t epollEvents, uint32_t requested)
+{
+    SocketEvents res;
+
+    if (epollEvents & (EPOLLERR | EPOLLHUP))
+    {
+        res.Set(SocketEventFlags::kError);
+        epollEvents |= requested & (EPOLLIN | EPOLLOUT);
+    }
+    if (epollEvents & EPOLLIN)
+        res.Set(SocketEventFlags::kRead);
+    if (epollEvents & EPOLLOUT)
+        res.Set(SocketEventFlags::kWrite);
+    if (epollEvents & EPOLLPRI)
+        res.Set(SocketEventFlags::kExcept);
+
+    return res;
+}
+
+void WatchableEventManager::UpdateWatch(WatchableSocket & watcher, uint32_t requested)
+{
+    VerifyOrDie(watcher.mFD >= 0);
+
+    if (requested == watcher.mRequested)
+    {
+        return;
+    }
+
+    if (requested == 0)
+    {
+        // epoll always reports EPOLLERR and EPOLLHUP, so an idle socket must be removed rather than left with an
+        // empty mask, or a hung-up peer would wake the loop on every iteration.
+        if (watcher.mRegistered && epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watcher.mFD, nullptr) != 0)
+        {
+            ChipLogError(DeviceLayer, "epoll_ctl(DEL) failed for fd %d: %s", watcher.mFD, ErrorStr(System::MapErrorPOSIX(errno)));
+        }
+        watcher.mRequested  = 0;
+        watcher.mRegistered = false;
+        return;
+    }
+
+    // Unlike select(), epoll picks up registration changes made while another thread is blocked in epoll_wait(),
+    // so there is no need to wake the event loop here.
+    struct epoll_event event;
+    event.events   = requested;
+    event.data.ptr = &watcher;
+
+    const int op = watcher.mRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(mEpollFd, op, watcher.mFD, &event) != 0)
+    {
+        ChipLogError(DeviceLayer, "epoll_ctl(%d) failed for fd %d: %s", op, watcher.mFD, ErrorStr(System::MapErrorPOSIX(errno)));
+        return;
+    }
+
+    watcher.mRequested  = requested;
+    watcher.mRegistered = true;
+}
+
+void WatchableEventManager::Unwatch(WatchableSocket & watcher)
+{
+    if (watcher.mRegistered)
+    {
+        // The file descriptor is still open at this point, so the registration must be removed explicitly.
+        epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watcher.mFD, nullptr);
+        watcher.mRegistered = false;
+    }
+    watcher.mRequested = 0;
+
+    // A callback may close other sockets that have already been reported ready on this iteration.
+    for (int i = mHandledEvents; i < mEpollResult; i++)
+    {
+        if (mEvents[i].data.ptr == &watcher)
+        {
+            mEvents[i].data.ptr = nullptr;
+        }
+    }
+}
+
+void WatchableEventManager::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    // Max out this duration and let CHIP set it appropriately.
+    mNextTimeout.tv_sec  = DEFAULT_MIN_SLEEP_PERIOD;
+    mNextTimeout.tv_usec = 0;
+    PrepareEventsWithTimeout(mNextTimeout);
+}
+
+void WatchableEventManager::PrepareEventsWithTimeout(struct timeval & nextTimeout)
+{
+    // TODO(#5556): Integrate timer platform details with WatchableEventManager.
+    mSystemLayer->GetTimeout(nextTimeout);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_MDNS && !__ZEPHYR__ && !__MBED__
+    chip::Mdns::GetMdnsTimeout(nextTimeout);
+#endif // CHIP_DEVICE_CONFIG_ENABLE_MDNS && !__ZEPHYR__
+
+    mNextTimeout   = nextTimeout;
+    mEpollResult   = 0;
+    mHandledEvents = 0;
+}
+
+void WatchableEventManager::WaitForEvents()
+{
+    mEpollResult = epoll_wait(mEpollFd, mEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, EpollTimeoutFromTimeval(mNextTimeout));
+    mEpollErrno  = (mEpollResult < 0) ? errno : 0;
+}
+
+void WatchableEventManager::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (mEpollResult < 0)
+    {
+        if (mEpollErrno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %s\n", ErrorStr(System::MapErrorPOSIX(mEpollErrno)));
+        }
+        mEpollResult = 0;
+        return;
+    }
+
+    VerifyOrDie(mSystemLayer != nullptr);
+    mSystemLayer->HandleTimeout();
+
+    for (mHandledEvents = 0; mHandledEvents < mEpollResult; mHandledEvents++)
+    {
+        WatchableSocket * const watchable = static_cast<WatchableSocket *>(mEvents[mHandledEvents].data.ptr);
+        if (watchable == nullptr || watchable->mRequested == 0)
+        {
+            continue;
+        }
+        watchable->SetPendingIO(SocketEventsFromEpollEvents(mEvents[mHandledEvents].events, watchable->mRequested));
+        if (watchable->mPendingIO.HasAny())
+        {
+            watchable->InvokeCallback();
+        }
+    }
+    mEpollResult   = 0;
+    mHandledEvents = 0;
+
+#if CHIP_DEVICE_CONFIG_ENABLE_MDNS && !__ZEPHYR__ && !__MBED__
+    chip::Mdns::HandleMdnsTimeout();
+#endif // CHIP_DEVICE_CONFIG_ENABLE_MDNS && !__ZEPHYR__
+}
+
+void WatchableSocket::OnInit()
+{
+    mRequested  = 0;
+    mRegistered = false;
+}
+
+void WatchableSocket::OnAttach()
+{
+    VerifyOrDie(!mRegistered);
+    mRequested = 0;
+}
+
+void WatchableSocket::OnClose()
+{
+    VerifyOrDie(mFD >= 0);
+    mSharedState->Unwatch(*this);
+}
+
+} // namespace System
+} // namespace chip
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of WatchableEvents using Linux epoll.
+ */
+
+#pragma once
+
+#include <sys/epoll.h>
+#include <sys/time.h>
+
+#include <support/BitFlags.h>
+
+#if !INCLUDING_CHIP_SYSTEM_WATCHABLE_SOCKET_CONFIG_FILE
+#error "This file should only be included from <system/SystemSockets.h>"
+#endif //  !INCLUDING_CHIP_SYSTEM_WATCHABLE_SOCKET_CONFIG_FILE
+
+namespace chip {
+
+namespace System {
+
+class WatchableEventManager
+{
+public:
+    void Init(System::Layer & systemLayer);
+    void Shutdown();
+
+    void EventLoopBegins() {}
+    void PrepareEvents();
+    void WaitForEvents();
+    void HandleEvents();
+    void EventLoopEnds() {}
+
+    // TODO(#5556): Some unit tests supply a timeout at low level, due to originally using select(); these should a proper timer.
+    void PrepareEventsWithTimeout(timeval & nextTimeout);
+
+    static SocketEvents SocketEventsFromEpollEvents(uint32_t epollEvents, uint32_t requested);
+
+protected:
+    friend class WatchableSocket;
+
+    /*
+     * Each WatchableSocket is registered with the epoll instance individually, carrying a pointer to itself
+     * as the event data, so that a wakeup costs O(ready sockets) rather than O(max fd). The sockets are
+     * level-triggered, matching the select() implementation, so a callback that does not drain its socket
+     * is invoked again on the next iteration.
+     */
+    void UpdateWatch(WatchableSocket & watcher, uint32_t requested);
+    void Unwatch(WatchableSocket & watcher);
+
+    Layer * mSystemLayer = nullptr;
+    int mEpollFd         = -1;
+
+    // TODO(#5556): Integrate timer platform details with WatchableEventManager.
+    struct timeval mNextTimeout;
+
+    // Members for epoll loop
+    struct epoll_event mEvents[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+    int mEpollResult   = 0; ///< return value from epoll_wait()
+    int mEpollErrno    = 0; ///< errno from epoll_wait(), valid when mEpollResult < 0
+    int mHandledEvents = 0; ///< index of the next entry of mEvents to be handled by HandleEvents()
+};
+
+class WatchableSocket : public WatchableSocketBasis<WatchableSocket>
+{
+public:
+    void OnInit();
+    void OnAttach();
+    void OnClose();
+
+    void OnRequestCallbackOnPendingRead() { mSharedState->UpdateWatch(*this, mRequested | EPOLLIN); }
+    void OnRequestCallbackOnPendingWrite() { mSharedState->UpdateWatch(*this, mRequested | EPOLLOUT); }
+    void OnClearCallbackOnPendingRead() { mSharedState->UpdateWatch(*this, mRequested & ~static_cast<uint32_t>(EPOLLIN)); }
+    void OnClearCallbackOnPendingWrite() { mSharedState->UpdateWatch(*this, mRequested & ~static_cast<uint32_t>(EPOLLOUT)); }
+
+    void SetPendingIO(SocketEvents events) { mPendingIO = events; }
+
+private:
+    friend class WatchableEventManager;
+
+    uint32_t mRequested; ///< epoll event mask currently requested for this socket.
+    bool mRegistered;    ///< Whether mFD has been added to the epoll instance.
+};
+
+} // namespace System
+} // namespace chip
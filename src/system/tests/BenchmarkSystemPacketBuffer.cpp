@@ -0,0 +1,136 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks of the allocation of
+ *      <tt>chip::System::PacketBuffer</tt>. They are built with
+ *      chip_build_benchmarks and are not part of the unit tests.
+ */
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+namespace {
+
+using ::chip::System::PacketBuffer;
+using ::chip::System::PacketBufferHandle;
+
+constexpr uint64_t kIterations = 100000;
+
+uint64_t NanosecondsEach(uint64_t aElapsedUs)
+{
+    return aElapsedUs * 1000 / kIterations;
+}
+
+/**
+ *  Measure the cost of allocating and freeing packet buffers, as every received and sent message does, against that of the
+ *  platform allocator.
+ */
+void BenchmarkAllocation(nlTestSuite * inSuite, void * inContext)
+{
+    const uint16_t kSizes[] = { 64, PacketBuffer::kMaxSize };
+
+    for (uint16_t size : kSizes)
+    {
+        uint64_t failures = 0;
+        uint64_t start    = chip::System::Clock::GetMonotonicMicroseconds();
+        for (uint64_t i = 0; i < kIterations; i++)
+        {
+            PacketBufferHandle handle = PacketBufferHandle::New(size);
+            failures += handle.IsNull() ? 1 : 0;
+        }
+        const uint64_t packetBufferElapsed = chip::System::Clock::GetMonotonicMicroseconds() - start;
+
+        PacketBufferHandle original = PacketBufferHandle::New(size);
+        NL_TEST_ASSERT(inSuite, !original.IsNull());
+        VerifyOrReturn(!original.IsNull());
+        original->SetDataLength(size);
+        start = chip::System::Clock::GetMonotonicMicroseconds();
+        for (uint64_t i = 0; i < kIterations; i++)
+        {
+            PacketBufferHandle clone = original.CloneData();
+            failures += clone.IsNull() ? 1 : 0;
+        }
+        const uint64_t cloneElapsed = chip::System::Clock::GetMonotonicMicroseconds() - start;
+
+        start = chip::System::Clock::GetMonotonicMicroseconds();
+        for (uint64_t i = 0; i < kIterations; i++)
+        {
+            void * block = chip::Platform::MemoryAlloc(sizeof(PacketBuffer) + PacketBuffer::kDefaultHeaderReserve + size);
+            failures += (block == nullptr) ? 1 : 0;
+            chip::Platform::MemoryFree(block);
+        }
+        const uint64_t heapElapsed = chip::System::Clock::GetMonotonicMicroseconds() - start;
+
+        NL_TEST_ASSERT(inSuite, failures == 0);
+        printf("PacketBuffer of %u bytes: New/Free %" PRIu64 " ns, CloneData %" PRIu64 " ns, MemoryAlloc/MemoryFree %" PRIu64
+               " ns\n",
+               size, NanosecondsEach(packetBufferElapsed), NanosecondsEach(cloneElapsed), NanosecondsEach(heapElapsed));
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Benchmark PacketBuffer allocation", BenchmarkAllocation),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Finalize(void * aContext)
+{
+    PacketBuffer::ReleaseCachedBuffers();
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Benchmark-CHIP-SystemPacketBuffer",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+} // namespace
+
+int BenchmarkSystemPacketBuffer()
+{
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkSystemPacketBuffer)
@@ -29,6 +29,7 @@
 
 #include <errno.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
@@ -38,6 +39,7 @@
 #include <support/CodeUtils.h>
 #include <support/UnitTestRegistration.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -131,6 +133,7 @@ public:
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
+    static void CheckHeapCache(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
@@ -1952,6 +1955,58 @@ void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, memcmp(yayBuffer->Start(), kPayload, sizeof kPayload) == 0);
 }
 
+void PacketBufferTest::CheckHeapCache(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP &&                                                  \
+    CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0
+    PacketBuffer::ReleaseCachedBuffers();
+
+    // A freed buffer is reused for the next allocation of its size class.
+    PacketBufferHandle handle = PacketBufferHandle::New(100, 0);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    const PacketBuffer * const smallBuffer = handle.Get();
+    const uint16_t smallAllocSize          = handle->AllocSize();
+    NL_TEST_ASSERT(inSuite, smallAllocSize >= 100);
+
+    handle = nullptr;
+    handle = PacketBufferHandle::New(smallAllocSize, 0);
+    NL_TEST_ASSERT(inSuite, handle.Get() == smallBuffer);
+    handle = nullptr;
+
+    // RightSize() takes its buffer from the cache too, and caches the one it replaces.
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    const PacketBuffer * const largeBuffer = handle.Get();
+    handle->SetDataLength(10);
+    handle.RightSize();
+    NL_TEST_ASSERT(inSuite, handle.Get() == smallBuffer);
+    NL_TEST_ASSERT(inSuite, handle->DataLength() == 10);
+
+    PacketBufferHandle clone = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, clone.Get() == largeBuffer);
+    handle = nullptr;
+    clone  = nullptr;
+    PacketBuffer::ReleaseCachedBuffers();
+
+    // The cache is bounded.
+    std::vector<PacketBufferHandle> buffers;
+    for (size_t i = 0; i < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE + 2; i++)
+    {
+        buffers.push_back(PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0));
+        NL_TEST_ASSERT(inSuite, !buffers.back().IsNull());
+    }
+    buffers.clear();
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    const chip::System::Stats::count_t * const inUse = chip::System::Stats::GetResourcesInUse();
+    NL_TEST_ASSERT(inSuite,
+                   inUse[chip::System::Stats::kSystemLayer_NumPacketBufsCached] == CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE);
+    PacketBuffer::ReleaseCachedBuffers();
+    NL_TEST_ASSERT(inSuite, inUse[chip::System::Stats::kSystemLayer_NumPacketBufsCached] == 0);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+#endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP && ...
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -1992,6 +2047,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::HeapCache",              PacketBufferTest::CheckHeapCache),
 
     NL_TEST_SENTINEL()
 };
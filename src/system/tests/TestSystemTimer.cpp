@@ -33,6 +33,7 @@
 #include <support/CodeUtils.h>
 #include <support/ErrorStr.h>
 #include <support/UnitTestRegistration.h>
+#include <support/logging/CHIPLogging.h>
 #include <system/SystemError.h>
 #include <system/SystemLayer.h>
 #include <system/SystemTimer.h>
@@ -50,6 +51,33 @@
 using chip::ErrorStr;
 using namespace chip::System;
 
+namespace chip {
+namespace System {
+
+// Gives the tests direct access to timer internals, so that the timer queue can be exercised without a running event loop.
+class TestTimer
+{
+public:
+    static void Arm(Timer & aTimer, Clock::MonotonicMilliseconds aAwakenTime, Timer::OnCompleteFunct aOnComplete,
+                    void * aAppState)
+    {
+        aTimer.mAwakenTime = aAwakenTime;
+        aTimer.OnComplete  = aOnComplete;
+        aTimer.AppState    = aAppState;
+    }
+
+    static void Disarm(Timer & aTimer)
+    {
+        aTimer.OnComplete = nullptr;
+        aTimer.AppState   = nullptr;
+    }
+
+    static Clock::MonotonicMilliseconds GetAwakenTime(const Timer & aTimer) { return aTimer.mAwakenTime; }
+};
+
+} // namespace System
+} // namespace chip
+
 static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -182,6 +210,155 @@ static void CheckStarvation(nlTestSuite * inSuite, void * aContext)
     ServiceEvents(lSys, sleepTime);
 }
 
+// Leave room in the timer pool for the timers of the other tests, which may still be running.
+static const size_t kNumOrderedTimers = CHIP_SYSTEM_CONFIG_NUM_TIMERS / 2;
+
+struct OrderedTimerState
+{
+    size_t mFired[kNumOrderedTimers];
+    size_t mNumFired;
+};
+
+static OrderedTimerState sOrderedTimerState;
+static size_t sOrderedTimerIndexes[kNumOrderedTimers];
+
+void HandleOrderedTimer(Layer * aLayer, void * aState, CHIP_ERROR aError)
+{
+    size_t lIndex = *static_cast<size_t *>(aState);
+
+    if (sOrderedTimerState.mNumFired < kNumOrderedTimers)
+    {
+        sOrderedTimerState.mFired[sOrderedTimerState.mNumFired++] = lIndex;
+    }
+}
+
+static void CheckOrdering(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+
+    sOrderedTimerState.mNumFired = 0;
+
+    // Start the timers out of order: timer i fires after 2 * i milliseconds.
+    for (size_t i = 0; i < kNumOrderedTimers; i++)
+    {
+        size_t lIndex                = (i * 7) % kNumOrderedTimers;
+        sOrderedTimerIndexes[lIndex] = lIndex;
+        NL_TEST_ASSERT(inSuite,
+                       lSys.StartTimer(static_cast<uint32_t>(2 * lIndex), HandleOrderedTimer, &sOrderedTimerIndexes[lIndex]) ==
+                           CHIP_NO_ERROR);
+    }
+
+    // Cancel every third timer, and restart one with the same arguments, which replaces it.
+    for (size_t i = 0; i < kNumOrderedTimers; i += 3)
+    {
+        lSys.CancelTimer(HandleOrderedTimer, &sOrderedTimerIndexes[i]);
+    }
+    NL_TEST_ASSERT(inSuite, lSys.StartTimer(1, HandleOrderedTimer, &sOrderedTimerIndexes[1]) == CHIP_NO_ERROR);
+
+    const size_t kExpectedFired = kNumOrderedTimers - (kNumOrderedTimers + 2) / 3;
+
+    const Clock::MonotonicMilliseconds kDeadline = Clock::GetMonotonicMilliseconds() + 1000;
+
+    while (sOrderedTimerState.mNumFired < kExpectedFired && Clock::GetMonotonicMilliseconds() < kDeadline)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sOrderedTimerState.mNumFired == kExpectedFired);
+    for (size_t i = 0; i < sOrderedTimerState.mNumFired; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sOrderedTimerState.mFired[i] % 3 != 0);
+        NL_TEST_ASSERT(inSuite, i == 0 || sOrderedTimerState.mFired[i - 1] < sOrderedTimerState.mFired[i]);
+    }
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+// Stress benchmark of the timer queue itself, with many more concurrent timers than the system timer pool holds.
+static const size_t kNumStressTimers = 10000;
+
+static ObjectPool<Timer, kNumStressTimers> sStressTimerPool;
+static TimerQueue<kNumStressTimers> sStressTimerQueue;
+static Timer * sStressTimers[kNumStressTimers];
+static uint8_t sStressAppStates[kNumStressTimers];
+
+void HandleStressTimer(Layer * aLayer, void * aState, CHIP_ERROR aError) {}
+
+static void CheckStress(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    uint32_t lRandom       = 12345;
+    uint64_t lStart;
+    uint64_t lInsertUs, lCancelUs, lExpireUs;
+
+    for (size_t i = 0; i < kNumStressTimers; i++)
+    {
+        sStressTimers[i] = sStressTimerPool.TryCreate(lSys);
+        NL_TEST_ASSERT(inSuite, sStressTimers[i] != nullptr);
+        if (sStressTimers[i] == nullptr)
+        {
+            return;
+        }
+
+        lRandom = lRandom * 1103515245 + 12345;
+        TestTimer::Arm(*sStressTimers[i], 1000 + (lRandom >> 8) % 60000, HandleStressTimer, &sStressAppStates[i]);
+    }
+
+    lStart = Clock::GetMonotonicMicroseconds();
+    for (size_t i = 0; i < kNumStressTimers; i++)
+    {
+        sStressTimerQueue.Insert(*sStressTimers[i]);
+    }
+    lInsertUs = Clock::GetMonotonicMicroseconds() - lStart;
+    NL_TEST_ASSERT(inSuite, sStressTimerQueue.Count() == kNumStressTimers);
+
+    // Cancel every other timer, finding it the way Layer::CancelTimer() does.
+    lStart = Clock::GetMonotonicMicroseconds();
+    for (size_t i = 0; i < kNumStressTimers; i += 2)
+    {
+        Timer * lTimer = sStressTimerQueue.Find(HandleStressTimer, &sStressAppStates[i]);
+        NL_TEST_ASSERT(inSuite, lTimer == sStressTimers[i]);
+        if (lTimer != nullptr)
+        {
+            sStressTimerQueue.Remove(*lTimer);
+        }
+    }
+    lCancelUs = Clock::GetMonotonicMicroseconds() - lStart;
+    NL_TEST_ASSERT(inSuite, sStressTimerQueue.Count() == kNumStressTimers / 2);
+
+    // Expire everything that is left, checking that timers come out in order.
+    Clock::MonotonicMilliseconds lPrevious = 0;
+    size_t lExpired                        = 0;
+    lStart                                 = Clock::GetMonotonicMicroseconds();
+    while (!sStressTimerQueue.IsEmpty())
+    {
+        Timer & lTimer = *sStressTimerQueue.Earliest();
+        NL_TEST_ASSERT(inSuite, !Timer::IsEarlier(TestTimer::GetAwakenTime(lTimer), lPrevious));
+        lPrevious = TestTimer::GetAwakenTime(lTimer);
+        sStressTimerQueue.Remove(lTimer);
+        lExpired++;
+    }
+    lExpireUs = Clock::GetMonotonicMicroseconds() - lStart;
+    NL_TEST_ASSERT(inSuite, lExpired == kNumStressTimers / 2);
+
+    ChipLogProgress(chipSystemLayer, "%u timers: insert %u us, cancel half %u us, expire rest %u us",
+                    static_cast<unsigned>(kNumStressTimers), static_cast<unsigned>(lInsertUs), static_cast<unsigned>(lCancelUs),
+                    static_cast<unsigned>(lExpireUs));
+
+    for (size_t i = 0; i < kNumStressTimers; i++)
+    {
+        TestTimer::Disarm(*sStressTimers[i]);
+        sStressTimers[i]->Release();
+    }
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 // Test Suite
 
 /**
@@ -191,7 +368,11 @@ static void CheckStarvation(nlTestSuite * inSuite, void * aContext)
 static const nlTest sTests[] =
 {
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
+    NL_TEST_DEF("Timer::TestTimerOrdering",        CheckOrdering),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    NL_TEST_DEF("Timer::TestTimerStress",          CheckStress),
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
     NL_TEST_SENTINEL()
 };
 // clang-format on
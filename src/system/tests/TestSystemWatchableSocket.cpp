@@ -0,0 +1,251 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::WatchableSocket</tt>,
+ *      exercising whichever socket event loop the System Layer is built with.
+ */
+
+#include <system/SystemConfig.h>
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemLayer.h>
+#include <system/SystemSockets.h>
+
+#include <unistd.h>
+
+using namespace chip::System;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+namespace {
+
+struct TestContext
+{
+    Layer mSystemLayer;
+    int mPipeA[2];
+    int mPipeB[2];
+    WatchableSocket mSocketA;
+    WatchableSocket mSocketB;
+    int mCallbackCount;
+    SocketEvents mLastEvents;
+
+    void ServiceEvents()
+    {
+        timeval timeout = {};
+        mSystemLayer.WatchableEvents().PrepareEventsWithTimeout(timeout);
+        mSystemLayer.WatchableEvents().WaitForEvents();
+        mSystemLayer.WatchableEvents().HandleEvents();
+    }
+};
+
+void RecordCallback(WatchableSocket & socket)
+{
+    TestContext & lContext = *reinterpret_cast<TestContext *>(socket.GetCallbackData());
+    lContext.mCallbackCount++;
+    lContext.mLastEvents = socket.GetPendingEvents();
+    if (socket.HasPendingRead())
+    {
+        char c;
+        IgnoreUnusedVariable(read(socket.GetFD(), &c, 1));
+    }
+}
+
+void CloseOtherCallback(WatchableSocket & socket)
+{
+    TestContext & lContext = *reinterpret_cast<TestContext *>(socket.GetCallbackData());
+    lContext.mCallbackCount++;
+    WatchableSocket & other = (&socket == &lContext.mSocketA) ? lContext.mSocketB : lContext.mSocketA;
+    if (other.HasFD())
+    {
+        other.Close();
+    }
+}
+
+void Write(int fd)
+{
+    const char c = 0;
+    IgnoreUnusedVariable(write(fd, &c, 1));
+}
+
+void TestPendingRead(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+
+    lContext.mSocketA.Init(lContext.mSystemLayer.WatchableEvents());
+    lContext.mSocketA.Attach(lContext.mPipeA[0]);
+    lContext.mSocketA.SetCallback(RecordCallback, reinterpret_cast<intptr_t>(&lContext));
+    lContext.mSocketA.RequestCallbackOnPendingRead();
+
+    lContext.mCallbackCount = 0;
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 0);
+
+    Write(lContext.mPipeA[1]);
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 1);
+    NL_TEST_ASSERT(inSuite, lContext.mLastEvents.Has(SocketEventFlags::kRead));
+    NL_TEST_ASSERT(inSuite, !lContext.mLastEvents.Has(SocketEventFlags::kWrite));
+
+    // The byte was consumed by the callback, so nothing is pending now.
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 1);
+
+    // Once the request is cleared, pending data must not invoke the callback.
+    lContext.mSocketA.ClearCallbackOnPendingRead();
+    Write(lContext.mPipeA[1]);
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 1);
+
+    // Requesting again picks up the data that arrived in the meantime.
+    lContext.mSocketA.RequestCallbackOnPendingRead();
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 2);
+
+    lContext.mPipeA[0] = lContext.mSocketA.ReleaseFD();
+}
+
+void TestPendingWrite(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+
+    lContext.mSocketB.Init(lContext.mSystemLayer.WatchableEvents());
+    lContext.mSocketB.Attach(lContext.mPipeB[1]);
+    lContext.mSocketB.SetCallback(RecordCallback, reinterpret_cast<intptr_t>(&lContext));
+
+    lContext.mCallbackCount = 0;
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 0);
+
+    lContext.mSocketB.RequestCallbackOnPendingWrite();
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 1);
+    NL_TEST_ASSERT(inSuite, lContext.mLastEvents.Has(SocketEventFlags::kWrite));
+
+    lContext.mSocketB.ClearCallbackOnPendingWrite();
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 1);
+
+    lContext.mPipeB[1] = lContext.mSocketB.ReleaseFD();
+}
+
+void TestCloseFromCallback(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+
+    // Both sockets are ready on the same iteration, and whichever callback runs first closes the other socket,
+    // whose callback must then not be invoked.
+    lContext.mSocketA.Init(lContext.mSystemLayer.WatchableEvents());
+    lContext.mSocketA.Attach(lContext.mPipeA[0]);
+    lContext.mSocketA.SetCallback(CloseOtherCallback, reinterpret_cast<intptr_t>(&lContext));
+    lContext.mSocketA.RequestCallbackOnPendingRead();
+
+    lContext.mSocketB.Init(lContext.mSystemLayer.WatchableEvents());
+    lContext.mSocketB.Attach(lContext.mPipeB[0]);
+    lContext.mSocketB.SetCallback(CloseOtherCallback, reinterpret_cast<intptr_t>(&lContext));
+    lContext.mSocketB.RequestCallbackOnPendingRead();
+
+    Write(lContext.mPipeA[1]);
+    Write(lContext.mPipeB[1]);
+
+    lContext.mCallbackCount = 0;
+    lContext.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, lContext.mCallbackCount == 1);
+    NL_TEST_ASSERT(inSuite, lContext.mSocketA.HasFD() != lContext.mSocketB.HasFD());
+
+    // Close() closes the pipe read ends as well.
+    WatchableSocket & survivor = lContext.mSocketA.HasFD() ? lContext.mSocketA : lContext.mSocketB;
+    survivor.Close();
+    lContext.mPipeA[0] = lContext.mPipeB[0] = -1;
+}
+
+int TestSetup(void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+
+    if (lContext.mSystemLayer.Init(nullptr) != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+    if (pipe(lContext.mPipeA) != 0 || pipe(lContext.mPipeB) != 0)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int TestTeardown(void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+
+    for (int fd : { lContext.mPipeA[0], lContext.mPipeA[1], lContext.mPipeB[0], lContext.mPipeB[1] })
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    lContext.mSystemLayer.Shutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("WatchableSocket::TestPendingRead",          TestPendingRead),
+    NL_TEST_DEF("WatchableSocket::TestPendingWrite",         TestPendingWrite),
+    NL_TEST_DEF("WatchableSocket::TestCloseFromCallback",    TestCloseFromCallback),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+static nlTestSuite kTheSuite =
+{
+    "chip-system-watchable-socket",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+// clang-format on
+
+int TestSystemWatchableSocket(void)
+{
+    TestContext context;
+
+    // Run test suit againt one lContext.
+    nlTestRunner(&kTheSuite, &context);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSystemWatchableSocket)
+#else  // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+int TestSystemWatchableSocket(void)
+{
+    return SUCCESS;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -216,11 +216,13 @@ CHIP_ERROR AdminPairingInfo::SetOperationalKey(const P256Keypair & key)
 #endif
     }
     VerifyOrReturnError(mOperationalKey != nullptr, CHIP_ERROR_NO_MEMORY);
+    ReleaseCachedCredentials();
     return mOperationalKey->Deserialize(serialized);
 }
 
 void AdminPairingInfo::ReleaseRootCert()
 {
+    ReleaseCachedCredentials();
     if (mRootCert != nullptr)
     {
         chip::Platform::MemoryFree(mRootCert);
@@ -232,6 +234,9 @@ void AdminPairingInfo::ReleaseRootCert()
 
 CHIP_ERROR AdminPairingInfo::SetRootCert(const ByteSpan & cert)
 {
+    // The buffer of the root certificate may be reused below without being released.
+    ReleaseCachedCredentials();
+
     if (cert.size() == 0)
     {
         ReleaseRootCert();
@@ -259,6 +264,7 @@ CHIP_ERROR AdminPairingInfo::SetRootCert(const ByteSpan & cert)
 
 void AdminPairingInfo::ReleaseICACert()
 {
+    ReleaseCachedCredentials();
     if (mICACert != nullptr)
     {
         chip::Platform::MemoryFree(mICACert);
@@ -269,6 +275,9 @@ void AdminPairingInfo::ReleaseICACert()
 
 CHIP_ERROR AdminPairingInfo::SetICACert(const ByteSpan & cert)
 {
+    // The cached credentials were built without this certificate, even when there was none before.
+    ReleaseCachedCredentials();
+
     if (cert.size() == 0)
     {
         ReleaseICACert();
@@ -295,6 +304,7 @@ CHIP_ERROR AdminPairingInfo::SetICACert(const ByteSpan & cert)
 
 void AdminPairingInfo::ReleaseNOCCert()
 {
+    ReleaseCachedCredentials();
     if (mNOCCert != nullptr)
     {
         chip::Platform::MemoryFree(mNOCCert);
@@ -383,6 +393,86 @@ CHIP_ERROR AdminPairingInfo::GetCredentials(OperationalCredentialSet & credentia
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR AdminPairingInfo::GetCachedCredentials(AdminCredentials *& credentials)
+{
+    if (mCachedCredentials == nullptr)
+    {
+        VerifyOrReturnError(AreCredentialsAvailable() && mOperationalKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+        AdminCredentials * newCredentials = chip::Platform::New<AdminCredentials>();
+        VerifyOrReturnError(newCredentials != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        CHIP_ERROR err = newCredentials->Init(ByteSpan(mRootCert, mRootCertLen), ByteSpan(mICACert, mICACertLen),
+                                              ByteSpan(mNOCCert, mNOCCertLen), mOperationalKey);
+        if (err != CHIP_NO_ERROR)
+        {
+            newCredentials->Release();
+            return err;
+        }
+        mCachedCredentials = newCredentials;
+    }
+
+    credentials = mCachedCredentials->Retain();
+    return CHIP_NO_ERROR;
+}
+
+void AdminPairingInfo::ReleaseCachedCredentials()
+{
+    // Sessions still using the credentials keep their own references to them.
+    if (mCachedCredentials != nullptr)
+    {
+        mCachedCredentials->Release();
+        mCachedCredentials = nullptr;
+    }
+}
+
+CHIP_ERROR AdminCredentials::Init(const ByteSpan & rootCert, const ByteSpan & icaCert, const ByteSpan & nocCert,
+                                  P256Keypair * operationalKey)
+{
+    constexpr uint8_t kMaxNumCertsInOpCreds = 2;
+
+    VerifyOrReturnError(rootCert.size() <= sizeof(mRootCert) && icaCert.size() <= sizeof(mICACert), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(CanCastTo<uint16_t>(nocCert.size()), CHIP_ERROR_INVALID_ARGUMENT);
+    memcpy(mRootCert, rootCert.data(), rootCert.size());
+    mRootCertLen = static_cast<uint16_t>(rootCert.size());
+    if (!icaCert.empty())
+    {
+        memcpy(mICACert, icaCert.data(), icaCert.size());
+    }
+    mICACertLen = static_cast<uint16_t>(icaCert.size());
+
+    ReturnErrorOnFailure(mCertificates.Init(kMaxNumCertsInOpCreds, kMaxCHIPCertDecodeBufLength));
+
+    const BitFlags<CertDecodeFlags> trustedCertFlags =
+        BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor).Set(CertDecodeFlags::kGenerateTBSHash);
+    ReturnErrorOnFailure(mCertificates.LoadCert(mRootCert, mRootCertLen, trustedCertFlags));
+
+    if (mICACertLen > 0)
+    {
+        ReturnErrorOnFailure(mCertificates.LoadCert(mICACert, mICACertLen, trustedCertFlags));
+        VerifyOrReturnError(mCertificates.GetCertCount() == kMaxNumCertsInOpCreds, CHIP_ERROR_INVALID_ARGUMENT);
+
+        // Do the part of the validation of a chain through the ICA certificate that concerns the root, once.
+        // What concerns the ICA certificate itself is still checked whenever a chain is validated.
+        const ChipCertificateData & root = mCertificates.GetCertSet()[0];
+        const ChipCertificateData & ica  = mCertificates.GetCertSet()[1];
+        VerifyOrReturnError(ica.mIssuerDN.IsEqual(root.mSubjectDN) && ica.mAuthKeyId.data_equal(root.mSubjectKeyId),
+                            CHIP_ERROR_CA_CERT_NOT_FOUND);
+        VerifyOrReturnError(!root.mCertFlags.Has(CertFlags::kPathLenConstraintPresent) || root.mPathLenConstraint >= 1,
+                            CHIP_ERROR_CERT_PATH_LEN_CONSTRAINT_EXCEEDED);
+        ReturnErrorOnFailure(ChipCertificateSet::VerifySignature(&ica, &root));
+    }
+
+    ReturnErrorOnFailure(mCredentials.Init(&mCertificates, 1));
+
+    mRootKeyId = mCredentials.GetTrustedRootId(0);
+
+    ReturnErrorOnFailure(mCredentials.SetDevOpCred(mRootKeyId, nocCert.data(), static_cast<uint16_t>(nocCert.size())));
+    ReturnErrorOnFailure(mCredentials.SetDevOpCredKeypair(mRootKeyId, operationalKey));
+
+    return CHIP_NO_ERROR;
+}
+
 AdminPairingInfo * AdminPairingTable::AssignAdminId(AdminId adminId)
 {
     for (size_t i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
@@ -23,6 +23,7 @@
 
 #include <app/util/basic-types.h>
 #include <core/CHIPPersistentStorageDelegate.h>
+#include <core/ReferenceCounted.h>
 #include <credentials/CHIPOperationalCredentials.h>
 #include <crypto/CHIPCryptoPAL.h>
 #if CHIP_CRYPTO_HSM
@@ -55,6 +56,42 @@ struct AccessControlList
     uint32_t placeholder;
 };
 
+/**
+ * The operational credentials of an admin, decoded once and then shared read-only by
+ * the CASE sessions that use them.
+ *
+ * The root and ICA certificates are copied, so that sessions holding a reference keep
+ * working after the admin's credentials change. The ICA certificate is verified against
+ * the root when the credentials are decoded, and then trusted as well, so that the chain
+ * of a peer issued by the same ICA is not verified up to the root again on every session.
+ */
+class DLL_EXPORT AdminCredentials : public ReferenceCounted<AdminCredentials>
+{
+public:
+    /**
+     * The credentials to establish CASE sessions with. They must not be modified.
+     */
+    Credentials::OperationalCredentialSet * GetOperationalCredentialSet() { return &mCredentials; }
+
+    const Credentials::CertificateKeyId & GetRootKeyId() const { return mRootKeyId; }
+
+private:
+    friend class AdminPairingInfo;
+
+    CHIP_ERROR Init(const ByteSpan & rootCert, const ByteSpan & icaCert, const ByteSpan & nocCert,
+                    Crypto::P256Keypair * operationalKey);
+
+    uint8_t mRootCert[Credentials::kMaxCHIPCertLength];
+    uint16_t mRootCertLen = 0;
+    uint8_t mICACert[Credentials::kMaxCHIPCertLength];
+    uint16_t mICACertLen = 0;
+
+    // Declared before mCredentials, which refers to it.
+    Credentials::ChipCertificateSet mCertificates;
+    Credentials::OperationalCredentialSet mCredentials;
+    Credentials::CertificateKeyId mRootKeyId;
+};
+
 /**
  * Defines state of a pairing established by an admin.
  * ACL data can be mutated throughout the lifetime of the admin pairing.
@@ -126,6 +163,13 @@ public:
     CHIP_ERROR GetCredentials(Credentials::OperationalCredentialSet & credentials, Credentials::ChipCertificateSet & certSet,
                               Credentials::CertificateKeyId & rootKeyId);
 
+    /**
+     * Get the credentials of this admin for CASE sessions. They are decoded the first time they are
+     * needed, and then shared until the certificates or the operational key change. The caller gets
+     * a reference to them, that it must Release() when it is done with them.
+     */
+    CHIP_ERROR GetCachedCredentials(AdminCredentials *& credentials);
+
     const uint8_t * GetTrustedRoot(uint16_t & size)
     {
         size = mRootCertLen;
@@ -190,6 +234,8 @@ private:
     uint8_t * mNOCCert             = nullptr;
     uint16_t mNOCCertLen           = 0;
 
+    AdminCredentials * mCachedCredentials = nullptr;
+
     static constexpr size_t KeySize();
 
     static CHIP_ERROR GenerateKey(AdminId id, char * key, size_t len);
@@ -201,6 +247,7 @@ private:
     void ReleaseNOCCert();
     void ReleaseICACert();
     void ReleaseRootCert();
+    void ReleaseCachedCredentials();
 
     struct StorableAdminPairingInfo
     {
@@ -0,0 +1,493 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <core/CHIPError.h>
+#include <support/CodeUtils.h>
+#include <system/TimeSource.h>
+#include <transport/AdminPairingTable.h>
+#include <transport/PeerConnectionState.h>
+#include <transport/PeerConnections.h>
+
+#include <initializer_list>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Handles a set of peer connection states, like PeerConnections, but maintains
+ * hash indexes so that lookups by local key id, peer key id, peer node id and
+ * peer address do not scan the whole pool.
+ *
+ * Lookup results (including iteration via the `begin` argument) are returned in
+ * pool order, exactly as PeerConnections does, so both classes can be used
+ * interchangeably.
+ *
+ * Since the index is keyed on state content, the peer node id and peer address
+ * of a pooled state MUST be changed through UpdatePeerNodeId/UpdatePeerAddress
+ * rather than through the PeerConnectionState setters.
+ */
+template <size_t kMaxConnectionCount, Time::Source kTimeSource = Time::Source::kSystem>
+class IndexedPeerConnections
+{
+public:
+    IndexedPeerConnections() { ClearIndex(); }
+
+    /**
+     * Allocates a new peer connection state state object out of the internal resource pool.
+     *
+     * @param address represents the connection state address
+     * @param state [out] will contain the connection state if one was available. May be null if no return value is desired.
+     *
+     * @note the newly created state will have an 'active' time set based on the current time source.
+     *
+     * @returns CHIP_NO_ERROR if state could be initialized. May fail if maximum connection count
+     *          has been reached (with CHIP_ERROR_NO_MEMORY).
+     */
+    CHECK_RETURN_VALUE
+    CHIP_ERROR CreateNewPeerConnectionState(const PeerAddress & address, PeerConnectionState ** state)
+    {
+        if (state)
+        {
+            *state = nullptr;
+        }
+
+        Slot slot = AllocateSlot();
+        VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_NO_MEMORY);
+
+        mStates[slot] = PeerConnectionState(address);
+        mStates[slot].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+        IndexInsert(slot);
+
+        if (state)
+        {
+            *state = &mStates[slot];
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Allocates a new peer connection state state object out of the internal resource pool.
+     *
+     * @param peerNode represents optional peer Node's ID
+     * @param peerKeyId represents the encryption key ID assigned by peer node
+     * @param localKeyId represents the encryption key ID assigned by local node
+     * @param state [out] will contain the connection state if one was available. May be null if no return value is desired.
+     *
+     * @note the newly created state will have an 'active' time set based on the current time source.
+     *
+     * @returns CHIP_NO_ERROR if state could be initialized. May fail if maximum connection count
+     *          has been reached (with CHIP_ERROR_NO_MEMORY).
+     */
+    CHECK_RETURN_VALUE
+    CHIP_ERROR CreateNewPeerConnectionState(const Optional<NodeId> & peerNode, uint16_t peerKeyId, uint16_t localKeyId,
+                                            PeerConnectionState ** state)
+    {
+        if (state)
+        {
+            *state = nullptr;
+        }
+
+        Slot slot = AllocateSlot();
+        VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_NO_MEMORY);
+
+        mStates[slot] = PeerConnectionState();
+        mStates[slot].SetPeerKeyID(peerKeyId);
+        mStates[slot].SetLocalKeyID(localKeyId);
+        mStates[slot].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+
+        if (peerNode.ValueOr(kUndefinedNodeId) != kUndefinedNodeId)
+        {
+            mStates[slot].SetPeerNodeId(peerNode.Value());
+        }
+
+        IndexInsert(slot);
+
+        if (state)
+        {
+            *state = &mStates[slot];
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Get a peer connection state given a Peer address.
+     *
+     * @param address is the connection to find (based on address)
+     * @param begin If a member of the pool, will start search from the next item. Can be nullptr to search from start.
+     *
+     * @return the state found, nullptr if not found
+     */
+    CHECK_RETURN_VALUE
+    PeerConnectionState * FindPeerConnectionState(const PeerAddress & address, PeerConnectionState * begin)
+    {
+        VerifyOrReturnError(address.IsInitialized(), nullptr);
+
+        for (Slot slot = FirstAfter(mAddressIndex, HashAddress(address), begin); slot != kInvalidSlot;
+             slot      = mAddressIndex.mNext[slot])
+        {
+            if (mStates[slot].GetPeerAddress() == address)
+            {
+                return &mStates[slot];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Get a peer connection state given a Node Id.
+     *
+     * @param nodeId is the connection to find (based on nodeId). Note that initial connections
+     *        do not have a node id set. Use this if you know the node id should be set.
+     * @param begin If a member of the pool, will start search from the next item. Can be nullptr to search from start.
+     *
+     * @return the state found, nullptr if not found
+     */
+    CHECK_RETURN_VALUE
+    PeerConnectionState * FindPeerConnectionState(NodeId nodeId, PeerConnectionState * begin)
+    {
+        for (Slot slot = FirstAfter(mNodeIdIndex, HashNodeId(nodeId), begin); slot != kInvalidSlot;
+             slot      = mNodeIdIndex.mNext[slot])
+        {
+            if (mStates[slot].GetPeerNodeId() == nodeId)
+            {
+                return &mStates[slot];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Get a peer connection state given a Node Id and Peer's Encryption Key Id.
+     *
+     * @param nodeId is the connection to find (based on nodeId). Note that initial connections
+     *        do not have a node id set. Use this if you know the node id should be set.
+     * @param peerKeyId Encryption key ID used by the peer node.
+     * @param begin If a member of the pool, will start search from the next item. Can be nullptr to search from start.
+     *
+     * @return the state found, nullptr if not found
+     */
+    CHECK_RETURN_VALUE
+    PeerConnectionState * FindPeerConnectionState(Optional<NodeId> nodeId, uint16_t peerKeyId, PeerConnectionState * begin)
+    {
+        if (peerKeyId == kAnyKeyId)
+        {
+            // Wildcard key lookups are not indexed; they only exist until InteractionModel
+            // is migrated to the messaging layer.
+            for (Slot slot = IsMember(begin) ? static_cast<Slot>(SlotOf(begin) + 1) : 0; slot < kMaxConnectionCount; slot++)
+            {
+                if (mStates[slot].IsInitialized() && NodeIdMatches(mStates[slot], nodeId))
+                {
+                    return &mStates[slot];
+                }
+            }
+            return nullptr;
+        }
+
+        for (Slot slot = FirstAfter(mPeerKeyIndex, HashKeyId(peerKeyId), begin); slot != kInvalidSlot;
+             slot      = mPeerKeyIndex.mNext[slot])
+        {
+            if (mStates[slot].GetPeerKeyID() == peerKeyId && NodeIdMatches(mStates[slot], nodeId))
+            {
+                return &mStates[slot];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Get a peer connection state given the local Encryption Key Id.
+     *
+     * @param keyId Encryption key ID assigned by the local node.
+     * @param begin If a member of the pool, will start search from the next item. Can be nullptr to search from start.
+     *
+     * @return the state found, nullptr if not found
+     */
+    CHECK_RETURN_VALUE
+    PeerConnectionState * FindPeerConnectionState(uint16_t keyId, PeerConnectionState * begin)
+    {
+        assert(begin == nullptr || IsMember(begin));
+
+        return FindPeerConnectionStateByLocalKey(Optional<NodeId>::Missing(), keyId, begin);
+    }
+
+    /**
+     * Get a peer connection state given a Node Id and Peer's Encryption Key Id.
+     *
+     * @param nodeId is the connection to find (based on peer nodeId). Note that initial connections
+     *        do not have a node id set. Use this if you know the node id should be set.
+     * @param localKeyId Encryption key ID used by the local node.
+     * @param begin If a member of the pool, will start search from the next item. Can be nullptr to search from start.
+     *
+     * @return the state found, nullptr if not found
+     */
+    CHECK_RETURN_VALUE
+    PeerConnectionState * FindPeerConnectionStateByLocalKey(Optional<NodeId> nodeId, uint16_t localKeyId,
+                                                            PeerConnectionState * begin)
+    {
+        for (Slot slot = FirstAfter(mLocalKeyIndex, HashKeyId(localKeyId), begin); slot != kInvalidSlot;
+             slot      = mLocalKeyIndex.mNext[slot])
+        {
+            if (mStates[slot].GetLocalKeyID() == localKeyId && NodeIdMatches(mStates[slot], nodeId))
+            {
+                return &mStates[slot];
+            }
+        }
+        return nullptr;
+    }
+
+    /// Updates the peer node id of a pooled state, keeping the node id index consistent
+    void UpdatePeerNodeId(PeerConnectionState * state, NodeId peerNodeId)
+    {
+        Slot slot = SlotOf(state);
+        IndexRemove(mNodeIdIndex, HashNodeId(state->GetPeerNodeId()), slot);
+        state->SetPeerNodeId(peerNodeId);
+        IndexInsert(mNodeIdIndex, HashNodeId(peerNodeId), slot);
+    }
+
+    /// Updates the peer address of a pooled state, keeping the address index consistent
+    void UpdatePeerAddress(PeerConnectionState * state, const PeerAddress & address)
+    {
+        Slot slot = SlotOf(state);
+        if (state->GetPeerAddress().IsInitialized())
+        {
+            IndexRemove(mAddressIndex, HashAddress(state->GetPeerAddress()), slot);
+        }
+        state->SetPeerAddress(address);
+        if (address.IsInitialized())
+        {
+            IndexInsert(mAddressIndex, HashAddress(address), slot);
+        }
+    }
+
+    /// Convenience method to mark a peer connection state as active
+    void MarkConnectionActive(PeerConnectionState * state)
+    {
+        state->SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+    }
+
+    /// Convenience method to expired a peer connection state and fired the related callback
+    template <typename Callback>
+    void MarkConnectionExpired(PeerConnectionState * state, Callback callback)
+    {
+        callback(*state);
+        IndexRemove(SlotOf(state));
+        *state = PeerConnectionState(PeerAddress::Uninitialized());
+    }
+
+    /**
+     * Iterates through all active connections and expires any connection with an idle time
+     * larger than the given amount.
+     *
+     * Expiring a connection involves callback execution and then clearing the internal state.
+     */
+    template <typename Callback>
+    void ExpireInactiveConnections(uint64_t maxIdleTimeMs, Callback callback)
+    {
+        const uint64_t currentTime = mTimeSource.GetCurrentMonotonicTimeMs();
+
+        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        {
+            if (!mStates[i].GetPeerAddress().IsInitialized())
+            {
+                continue; // not an active connection
+            }
+
+            uint64_t connectionActiveTime = mStates[i].GetLastActivityTimeMs();
+            if (connectionActiveTime + maxIdleTimeMs >= currentTime)
+            {
+                continue; // not expired
+            }
+
+            MarkConnectionExpired(&mStates[i], callback);
+        }
+    }
+
+    /// Allows access to the underlying time source used for keeping track of connection active time
+    Time::TimeSource<kTimeSource> & GetTimeSource() { return mTimeSource; }
+
+private:
+    using Slot = uint16_t;
+
+    static_assert(kMaxConnectionCount < UINT16_MAX, "Connection pool too large for 16-bit slot indexes");
+
+    static constexpr Slot kInvalidSlot = UINT16_MAX;
+
+    static constexpr size_t BucketCountFor(size_t count, size_t buckets = 1)
+    {
+        return (buckets >= count) ? buckets : BucketCountFor(count, buckets << 1);
+    }
+
+    // Power of two, so that hashes can be reduced with a mask.
+    static constexpr size_t kBucketCount = BucketCountFor(kMaxConnectionCount);
+
+    /**
+     * A chained hash index over pool slots. Each chain is kept sorted by slot
+     * number so that iteration order matches a linear walk of the pool.
+     */
+    struct Index
+    {
+        Slot mHeads[kBucketCount];
+        Slot mNext[kMaxConnectionCount];
+    };
+
+    static size_t Mix(uint64_t value)
+    {
+        // 64-bit finalizer from MurmurHash3.
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return static_cast<size_t>(value) & (kBucketCount - 1);
+    }
+
+    static size_t HashKeyId(uint16_t keyId) { return Mix(keyId); }
+    static size_t HashNodeId(NodeId nodeId) { return Mix(nodeId); }
+    static size_t HashAddress(const PeerAddress & address)
+    {
+        // The interface is left out of the hash since it is not portably convertible to an integer.
+        // Equality is still checked on the full address by the callers.
+        const Inet::IPAddress & ip = address.GetIPAddress();
+        uint64_t value = (static_cast<uint64_t>(address.GetTransportType()) << 16) | address.GetPort();
+        for (uint32_t word : ip.Addr)
+        {
+            value = (value * 31) ^ word;
+        }
+        return Mix(value);
+    }
+
+    static bool NodeIdMatches(const PeerConnectionState & state, const Optional<NodeId> & nodeId)
+    {
+        return nodeId.ValueOr(kUndefinedNodeId) == kUndefinedNodeId || state.GetPeerNodeId() == kUndefinedNodeId ||
+            state.GetPeerNodeId() == nodeId.Value();
+    }
+
+    bool IsMember(const PeerConnectionState * state) const
+    {
+        return state >= &mStates[0] && state < &mStates[kMaxConnectionCount];
+    }
+
+    Slot SlotOf(const PeerConnectionState * state) const { return static_cast<Slot>(state - &mStates[0]); }
+
+    Slot AllocateSlot()
+    {
+        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        {
+            size_t slot = (mNextFreeHint + i) % kMaxConnectionCount;
+            if (!mStates[slot].IsInitialized())
+            {
+                mNextFreeHint = static_cast<Slot>((slot + 1) % kMaxConnectionCount);
+                return static_cast<Slot>(slot);
+            }
+        }
+        return kInvalidSlot;
+    }
+
+    /// Returns the first slot in the given bucket located after `begin` in pool order.
+    Slot FirstAfter(const Index & index, size_t bucket, const PeerConnectionState * begin) const
+    {
+        Slot slot = index.mHeads[bucket];
+        if (IsMember(begin))
+        {
+            Slot beginSlot = SlotOf(begin);
+            while (slot != kInvalidSlot && slot <= beginSlot)
+            {
+                slot = index.mNext[slot];
+            }
+        }
+        return slot;
+    }
+
+    static void IndexInsert(Index & index, size_t bucket, Slot slot)
+    {
+        Slot * link = &index.mHeads[bucket];
+        while (*link != kInvalidSlot && *link < slot)
+        {
+            link = &index.mNext[*link];
+        }
+        index.mNext[slot] = *link;
+        *link             = slot;
+    }
+
+    static void IndexRemove(Index & index, size_t bucket, Slot slot)
+    {
+        Slot * link = &index.mHeads[bucket];
+        while (*link != kInvalidSlot && *link != slot)
+        {
+            link = &index.mNext[*link];
+        }
+        if (*link == slot)
+        {
+            *link             = index.mNext[slot];
+            index.mNext[slot] = kInvalidSlot;
+        }
+    }
+
+    void IndexInsert(Slot slot)
+    {
+        const PeerConnectionState & state = mStates[slot];
+        IndexInsert(mLocalKeyIndex, HashKeyId(state.GetLocalKeyID()), slot);
+        IndexInsert(mPeerKeyIndex, HashKeyId(state.GetPeerKeyID()), slot);
+        IndexInsert(mNodeIdIndex, HashNodeId(state.GetPeerNodeId()), slot);
+        if (state.GetPeerAddress().IsInitialized())
+        {
+            IndexInsert(mAddressIndex, HashAddress(state.GetPeerAddress()), slot);
+        }
+    }
+
+    void IndexRemove(Slot slot)
+    {
+        const PeerConnectionState & state = mStates[slot];
+        IndexRemove(mLocalKeyIndex, HashKeyId(state.GetLocalKeyID()), slot);
+        IndexRemove(mPeerKeyIndex, HashKeyId(state.GetPeerKeyID()), slot);
+        IndexRemove(mNodeIdIndex, HashNodeId(state.GetPeerNodeId()), slot);
+        if (state.GetPeerAddress().IsInitialized())
+        {
+            IndexRemove(mAddressIndex, HashAddress(state.GetPeerAddress()), slot);
+        }
+    }
+
+    void ClearIndex()
+    {
+        for (Index * index : { &mLocalKeyIndex, &mPeerKeyIndex, &mNodeIdIndex, &mAddressIndex })
+        {
+            for (Slot & head : index->mHeads)
+            {
+                head = kInvalidSlot;
+            }
+            for (Slot & next : index->mNext)
+            {
+                next = kInvalidSlot;
+            }
+        }
+    }
+
+    Time::TimeSource<kTimeSource> mTimeSource;
+    PeerConnectionState mStates[kMaxConnectionCount];
+    Index mLocalKeyIndex;
+    Index mPeerKeyIndex;
+    Index mNodeIdIndex;
+    Index mAddressIndex;
+    Slot mNextFreeHint = 0;
+};
+
+} // namespace Transport
+} // namespace chip
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <transport/AdminPairingTable.h>
+#include <transport/RoundTripTimeEstimator.h>
 #include <transport/SecureSession.h>
 #include <transport/SessionMessageCounter.h>
 #include <transport/raw/Base.h>
@@ -43,6 +44,8 @@ static constexpr uint32_t kUndefinedMessageIndex = UINT32_MAX;
  *   - LastActivityTimeMs is a monotonic timestamp of when this connection was
  *     last used. Inactive connections can expire.
  *   - SecureSession contains the encryption context of a connection
+ *   - RoundTripTimeEstimator tracks how long the peer takes to acknowledge
+ *     messages, so that retransmissions can be timed to it
  *
  * TODO: to add any message ACK information
  */
@@ -95,6 +98,7 @@ public:
         mLastActivityTimeMs = 0;
         mSecureSession.Reset();
         mSessionMessageCounter.Reset();
+        mRoundTripTimeEstimator.Reset();
     }
 
     CHIP_ERROR EncryptBeforeSend(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
@@ -103,6 +107,12 @@ public:
         return mSecureSession.Encrypt(input, input_length, output, header, mac);
     }
 
+    CHIP_ERROR EncryptBeforeSend(const System::PacketBufferHandle & msg, PacketHeader & header,
+                                 MessageAuthenticationCode & mac) const
+    {
+        return mSecureSession.Encrypt(msg, header, mac);
+    }
+
     CHIP_ERROR DecryptOnReceive(const uint8_t * input, size_t input_length, uint8_t * output, const PacketHeader & header,
                                 const MessageAuthenticationCode & mac) const
     {
@@ -111,6 +121,9 @@ public:
 
     SessionMessageCounter & GetSessionMessageCounter() { return mSessionMessageCounter; }
 
+    RoundTripTimeEstimator & GetRoundTripTimeEstimator() { return mRoundTripTimeEstimator; }
+    const RoundTripTimeEstimator & GetRoundTripTimeEstimator() const { return mRoundTripTimeEstimator; }
+
 private:
     PeerAddress mPeerAddress;
     NodeId mPeerNodeId           = kUndefinedNodeId;
@@ -119,6 +132,7 @@ private:
     uint64_t mLastActivityTimeMs = 0;
     SecureSession mSecureSession;
     SessionMessageCounter mSessionMessageCounter;
+    RoundTripTimeEstimator mRoundTripTimeEstimator;
     Transport::AdminId mAdmin = kUndefinedAdminId;
 };
 
@@ -316,6 +316,12 @@ public:
         return state;
     }
 
+    /// Updates the peer node id of a pooled state
+    void UpdatePeerNodeId(PeerConnectionState * state, NodeId peerNodeId) { state->SetPeerNodeId(peerNodeId); }
+
+    /// Updates the peer address of a pooled state
+    void UpdatePeerAddress(PeerConnectionState * state, const PeerAddress & address) { state->SetPeerAddress(address); }
+
     /// Convenience method to mark a peer connection state as active
     void MarkConnectionActive(PeerConnectionState * state)
     {
@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @brief Defines the round trip time estimate kept for each peer connection.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Tracks the smoothed round trip time (SRTT) to a peer and its variation
+ * (RTTVAR), and derives a retransmission timeout from them, following
+ * RFC 6298.
+ *
+ * As in most TCP implementations, SRTT is kept scaled by 8 and RTTVAR by 4,
+ * so that the smoothing gains of 1/8 and 1/4 do not lose the low bits of
+ * millisecond samples.
+ */
+class RoundTripTimeEstimator
+{
+public:
+    /// Clock granularity G of RFC 6298, the lowest RTTVAR term of the timeout.
+    static constexpr uint32_t kClockGranularityMs = 1;
+
+    void Reset()
+    {
+        mScaledSmoothedRtt  = 0;
+        mScaledRttVariation = 0;
+        mSampleCount        = 0;
+    }
+
+    /**
+     *  Account for a round trip time measurement. Callers should only take
+     *  samples from messages that were not retransmitted (Karn's algorithm),
+     *  since the ack of a retransmitted message is ambiguous.
+     */
+    void AddSample(uint32_t rttMs)
+    {
+        if (mSampleCount == 0)
+        {
+            // SRTT <- R, RTTVAR <- R/2
+            mScaledSmoothedRtt  = rttMs << kSmoothedRttShift;
+            mScaledRttVariation = rttMs << (kRttVariationShift - 1);
+        }
+        else
+        {
+            // RTTVAR <- 3/4 * RTTVAR + 1/4 * |SRTT - R|, SRTT <- 7/8 * SRTT + 1/8 * R
+            int64_t delta      = static_cast<int64_t>(rttMs) - static_cast<int64_t>(GetSmoothedRttMs());
+            mScaledSmoothedRtt = static_cast<uint32_t>(static_cast<int64_t>(mScaledSmoothedRtt) + delta);
+            if (delta < 0)
+            {
+                delta = -delta;
+            }
+            mScaledRttVariation = static_cast<uint32_t>(static_cast<int64_t>(mScaledRttVariation) + delta -
+                                                        (mScaledRttVariation >> kRttVariationShift));
+        }
+
+        if (mSampleCount < UINT16_MAX)
+        {
+            mSampleCount++;
+        }
+    }
+
+    bool HasSample() const { return mSampleCount != 0; }
+    uint16_t GetSampleCount() const { return mSampleCount; }
+
+    uint32_t GetSmoothedRttMs() const { return mScaledSmoothedRtt >> kSmoothedRttShift; }
+    uint32_t GetRttVariationMs() const { return mScaledRttVariation >> kRttVariationShift; }
+
+    /**
+     *  The retransmission timeout, SRTT + max(G, 4 * RTTVAR), or 0 if there
+     *  are no samples yet. Bounding the timeout is left to the caller.
+     */
+    uint32_t GetRetransmitTimeoutMs() const
+    {
+        if (!HasSample())
+        {
+            return 0;
+        }
+
+        // The scaled RTTVAR is 4 * RTTVAR already.
+        uint32_t variation = (mScaledRttVariation > kClockGranularityMs) ? mScaledRttVariation : kClockGranularityMs;
+        return GetSmoothedRttMs() + variation;
+    }
+
+private:
+    static constexpr uint8_t kSmoothedRttShift  = 3;
+    static constexpr uint8_t kRttVariationShift = 2;
+
+    uint32_t mScaledSmoothedRtt  = 0;
+    uint32_t mScaledRttVariation = 0;
+    uint16_t mSampleCount        = 0;
+};
+
+} // namespace Transport
+} // namespace chip
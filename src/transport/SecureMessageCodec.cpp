@@ -40,7 +40,6 @@ CHIP_ERROR Encode(NodeId localNodeId, Transport::PeerConnectionState * state, Pa
                   PacketHeader & packetHeader, System::PacketBufferHandle & msgBuf, MessageCounter & counter)
 {
     VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrReturnError(!msgBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
     VerifyOrReturnError(msgBuf->TotalLength() <= kMaxAppMessageLen, CHIP_ERROR_MESSAGE_TOO_LONG);
 
     uint32_t msgId = counter.Value();
@@ -62,17 +61,27 @@ CHIP_ERROR Encode(NodeId localNodeId, Transport::PeerConnectionState * state, Pa
 
     ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(msgBuf));
 
-    uint8_t * data    = msgBuf->Start();
-    uint16_t totalLen = msgBuf->TotalLength();
-
+    // A chain of buffers is encrypted buffer by buffer, and stays a chain.
     MessageAuthenticationCode mac;
-    ReturnErrorOnFailure(state->EncryptBeforeSend(data, totalLen, data, packetHeader, mac));
+    ReturnErrorOnFailure(state->EncryptBeforeSend(msgBuf, packetHeader, mac));
 
-    uint16_t taglen = 0;
-    ReturnErrorOnFailure(mac.Encode(packetHeader, &data[totalLen], msgBuf->AvailableDataLength(), &taglen));
+    // The tag follows the data, in the last buffer if it has room for it, or else in one added to the chain.
+    const uint16_t footerLen = MessageAuthenticationCode::TagLenForEncryptionType(packetHeader.GetEncryptionType());
+    PacketBufferHandle last  = msgBuf->Last();
+    if (last->AvailableDataLength() < footerLen)
+    {
+        PacketBufferHandle tagBuf = PacketBufferHandle::New(footerLen, 0);
+        VerifyOrReturnError(!tagBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+        last = tagBuf.Retain();
+        msgBuf->AddToEnd(std::move(tagBuf));
+    }
+
+    const uint16_t dataLen = last->DataLength();
+    uint16_t taglen        = 0;
+    ReturnErrorOnFailure(mac.Encode(packetHeader, last->Start() + dataLen, last->AvailableDataLength(), &taglen));
 
-    VerifyOrReturnError(CanCastTo<uint16_t>(totalLen + taglen), CHIP_ERROR_INTERNAL);
-    msgBuf->SetDataLength(static_cast<uint16_t>(totalLen + taglen));
+    VerifyOrReturnError(CanCastTo<uint16_t>(msgBuf->TotalLength() + taglen), CHIP_ERROR_INTERNAL);
+    last->SetDataLength(static_cast<uint16_t>(dataLen + taglen), msgBuf);
 
     ChipLogDetail(Inet, "Secure message was encrypted: Msg ID %" PRIu32, msgId);
 
@@ -56,6 +56,25 @@ using HKDF_sha_crypto = HKDF_sha;
 
 SecureSession::SecureSession() : mKeyAvailable(false) {}
 
+SecureSession::SecureSession(const SecureSession & other) :
+    mSessionRole(other.mSessionRole), mKeyAvailable(other.mKeyAvailable)
+{
+    memcpy(mKeys, other.mKeys, sizeof(mKeys));
+}
+
+SecureSession & SecureSession::operator=(const SecureSession & other)
+{
+    if (this != &other)
+    {
+        mSessionRole  = other.mSessionRole;
+        mKeyAvailable = other.mKeyAvailable;
+        memcpy(mKeys, other.mKeys, sizeof(mKeys));
+        mEncryptContext.Clear();
+        mDecryptContext.Clear();
+    }
+    return *this;
+}
+
 CHIP_ERROR SecureSession::InitFromSecret(const ByteSpan & secret, const ByteSpan & salt, SessionInfoType infoType, SessionRole role)
 {
     HKDF_sha_crypto mHKDF;
@@ -76,6 +95,8 @@ CHIP_ERROR SecureSession::InitFromSecret(const ByteSpan & secret, const ByteSpan
     ReturnErrorOnFailure(
         mHKDF.HKDF_SHA256(secret.data(), secret.size(), salt.data(), salt.size(), info, infoLen, &mKeys[0][0], sizeof(mKeys)));
 
+    mEncryptContext.Clear();
+    mDecryptContext.Clear();
     mKeyAvailable = true;
     mSessionRole  = role;
 
@@ -98,6 +119,8 @@ void SecureSession::Reset()
 {
     mKeyAvailable = false;
     memset(mKeys, 0, sizeof(mKeys));
+    mEncryptContext.Clear();
+    mDecryptContext.Clear();
 }
 
 CHIP_ERROR SecureSession::GetIV(const PacketHeader & header, uint8_t * iv, size_t len)
@@ -151,6 +174,62 @@ CHIP_ERROR SecureSession::Encrypt(const uint8_t * input, size_t input_length, ui
     ReturnErrorOnFailure(GetIV(header, IV, sizeof(IV)));
     ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
 
+    ReturnErrorOnFailure(InitEncryptContext());
+    ReturnErrorOnFailure(mEncryptContext.Encrypt(input, input_length, AAD, aadLen, IV, sizeof(IV), output, tag, taglen));
+
+    mac.SetTag(&header, encType, tag, taglen);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SecureSession::Encrypt(const System::PacketBufferHandle & msg, PacketHeader & header,
+                                  MessageAuthenticationCode & mac) const
+{
+    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // A single buffer takes the one-shot path, which is the faster one.
+    if (!msg->HasChainedBuffer())
+    {
+        return Encrypt(msg->Start(), msg->DataLength(), msg->Start(), header, mac);
+    }
+
+    constexpr Header::EncryptionType encType = Header::EncryptionType::kAESCCMTagLen16;
+
+    const size_t taglen = MessageAuthenticationCode::TagLenForEncryptionType(encType);
+    assert(taglen <= kMaxTagLen);
+
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    VerifyOrReturnError(msg->TotalLength() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t AAD[kMaxAADLen];
+    uint8_t IV[kAESCCMIVLen];
+    uint16_t aadLen = sizeof(AAD);
+    uint8_t tag[kMaxTagLen];
+
+    ReturnErrorOnFailure(GetIV(header, IV, sizeof(IV)));
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+
+    ReturnErrorOnFailure(InitEncryptContext());
+    ReturnErrorOnFailure(mEncryptContext.StartEncrypt(msg->TotalLength(), AAD, aadLen, IV, sizeof(IV), taglen));
+    for (System::PacketBufferHandle buf = msg.Retain(); !buf.IsNull(); buf.Advance())
+    {
+        ReturnErrorOnFailure(mEncryptContext.Update(buf->Start(), buf->DataLength(), buf->Start()));
+    }
+    ReturnErrorOnFailure(mEncryptContext.FinishEncrypt(tag, taglen));
+
+    mac.SetTag(&header, encType, tag, taglen);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SecureSession::InitEncryptContext() const
+{
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    if (mEncryptContext.IsInitialized())
+    {
+        return CHIP_NO_ERROR;
+    }
+
     KeyUsage usage = kR2IKey;
 
     // Message is encrypted before sending. If the secure session was created by session
@@ -161,12 +240,7 @@ CHIP_ERROR SecureSession::Encrypt(const uint8_t * input, size_t input_length, ui
         usage = kI2RKey;
     }
 
-    ReturnErrorOnFailure(AES_CCM_encrypt(input, input_length, AAD, aadLen, mKeys[usage], kAES_CCM128_Key_Length, IV, sizeof(IV),
-                                         output, tag, taglen));
-
-    mac.SetTag(&header, encType, tag, taglen);
-
-    return CHIP_NO_ERROR;
+    return mEncryptContext.Init(mKeys[usage], kAES_CCM128_Key_Length);
 }
 
 CHIP_ERROR SecureSession::Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, const PacketHeader & header,
@@ -196,8 +270,11 @@ CHIP_ERROR SecureSession::Decrypt(const uint8_t * input, size_t input_length, ui
         usage = kR2IKey;
     }
 
-    return AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mKeys[usage], kAES_CCM128_Key_Length, IV, sizeof(IV),
-                           output);
+    if (!mDecryptContext.IsInitialized())
+    {
+        ReturnErrorOnFailure(mDecryptContext.Init(mKeys[usage], kAES_CCM128_Key_Length));
+    }
+    return mDecryptContext.Decrypt(input, input_length, AAD, aadLen, tag, taglen, IV, sizeof(IV), output);
 }
 
 } // namespace chip
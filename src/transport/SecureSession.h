@@ -28,6 +28,7 @@
 #include <core/CHIPCore.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <support/Span.h>
+#include <system/SystemPacketBuffer.h>
 #include <transport/raw/MessageHeader.h>
 
 namespace chip {
@@ -36,10 +37,10 @@ class DLL_EXPORT SecureSession
 {
 public:
     SecureSession();
-    SecureSession(SecureSession &&)      = default;
-    SecureSession(const SecureSession &) = default;
-    SecureSession & operator=(const SecureSession &) = default;
-    SecureSession & operator=(SecureSession &&) = default;
+
+    // Copies carry the session keys but not the cached cipher contexts, which are set up again on first use.
+    SecureSession(const SecureSession & other);
+    SecureSession & operator=(const SecureSession & other);
 
     /**
      *    Whether the current node initiated the session, or it is responded to a session request.
@@ -99,6 +100,19 @@ public:
     CHIP_ERROR Encrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                        MessageAuthenticationCode & mac) const;
 
+    /**
+     * @brief
+     *   Encrypt the data of a buffer chain in place, using keys established in the secure channel. The buffers are
+     *   encrypted one after the other, so the chain need not be made contiguous.
+     *
+     * @param msg Buffer chain holding the unencrypted data
+     * @param header message header structure. Encryption type will be set on the header.
+     * @param mac - output the resulting mac
+     *
+     * @return CHIP_ERROR The result of encryption
+     */
+    CHIP_ERROR Encrypt(const System::PacketBufferHandle & msg, PacketHeader & header, MessageAuthenticationCode & mac) const;
+
     /**
      * @brief
      *   Decrypt the input data using keys established in the secure channel
@@ -145,6 +159,14 @@ private:
     bool mKeyAvailable;
     CryptoKey mKeys[KeyUsage::kNumCryptoKeys];
 
+    // Keyed AES-CCM contexts for the send (I2R or R2I, per mSessionRole) and receive keys, so that the key schedule is
+    // computed once per session rather than once per message. Encrypt() and Decrypt() set them up lazily.
+    mutable Crypto::AES_CCM_keyed mEncryptContext;
+    mutable Crypto::AES_CCM_keyed mDecryptContext;
+
+    // Sets up mEncryptContext with the key for messages that this side sends, unless it already is.
+    CHIP_ERROR InitEncryptContext() const;
+
     static CHIP_ERROR GetIV(const PacketHeader & header, uint8_t * iv, size_t len);
 
     // Use unencrypted header as additional authenticated data (AAD) during encryption and decryption.
@@ -159,7 +159,6 @@ CHIP_ERROR SecureSessionMgr::SendPreparedMessage(SecureSessionHandle session, co
     VerifyOrExit(!preparedMessage.IsNull(), err = CHIP_ERROR_INVALID_ARGUMENT);
     msgBuf = preparedMessage.CastToWritable();
     VerifyOrExit(!msgBuf.IsNull(), err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(!msgBuf->HasChainedBuffer(), err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
     // Find an active connection to the specified peer node
     state = GetPeerConnectionState(session);
@@ -250,11 +249,11 @@ CHIP_ERROR SecureSessionMgr::NewPairing(const Optional<Transport::PeerAddress> &
 
     if (peerAddr.HasValue() && peerAddr.Value().GetIPAddress() != Inet::IPAddress::Any)
     {
-        state->SetPeerAddress(peerAddr.Value());
+        mPeerConnections.UpdatePeerAddress(state, peerAddr.Value());
     }
     else if (peerAddr.HasValue() && peerAddr.Value().GetTransportType() == Transport::Type::kBle)
     {
-        state->SetPeerAddress(peerAddr.Value());
+        mPeerConnections.UpdatePeerAddress(state, peerAddr.Value());
     }
     else if (peerAddr.HasValue() &&
              (peerAddr.Value().GetTransportType() == Transport::Type::kTcp ||
@@ -442,7 +441,7 @@ void SecureSessionMgr::SecureMessageDispatch(const PacketHeader & packetHeader,
     {
         if (state->GetPeerNodeId() == kUndefinedNodeId)
         {
-            state->SetPeerNodeId(packetHeader.GetSourceNodeId().Value());
+            mPeerConnections.UpdatePeerNodeId(state, packetHeader.GetSourceNodeId().Value());
         }
     }
 
@@ -482,7 +481,7 @@ void SecureSessionMgr::SecureMessageDispatch(const PacketHeader & packetHeader,
     // and serves as a way to auto-detect peer changing IPs.
     if (state->GetPeerAddress() != peerAddress)
     {
-        state->SetPeerAddress(peerAddress);
+        mPeerConnections.UpdatePeerAddress(state, peerAddress);
     }
 
     if (mCB != nullptr)
@@ -529,4 +528,13 @@ PeerConnectionState * SecureSessionMgr::GetPeerConnectionState(SecureSessionHand
     return mPeerConnections.FindPeerConnectionState(Optional<NodeId>::Value(session.mPeerNodeId), session.mPeerKeyId, nullptr);
 }
 
+CHIP_ERROR SecureSessionMgr::UpdatePeerAddress(SecureSessionHandle session, const Transport::PeerAddress & address)
+{
+    PeerConnectionState * state = GetPeerConnectionState(session);
+    VerifyOrReturnError(state != nullptr, CHIP_ERROR_NOT_CONNECTED);
+
+    mPeerConnections.UpdatePeerAddress(state, address);
+    return CHIP_NO_ERROR;
+}
+
 } // namespace chip
@@ -34,6 +34,7 @@
 #include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
 #include <transport/AdminPairingTable.h>
+#include <transport/IndexedPeerConnections.h>
 #include <transport/MessageCounterManagerInterface.h>
 #include <transport/PairingSession.h>
 #include <transport/PeerConnections.h>
@@ -202,6 +203,13 @@ public:
 
     Transport::PeerConnectionState * GetPeerConnectionState(SecureSessionHandle session);
 
+    /**
+     * @brief
+     *   Change the address of the peer of a session. Addresses of pooled connection states are
+     *   indexed, so they must not be changed on the state directly.
+     */
+    CHIP_ERROR UpdatePeerAddress(SecureSessionHandle session, const Transport::PeerAddress & address);
+
     /**
      * @brief
      *   Set the callback object.
@@ -291,7 +299,11 @@ private:
 
     System::Layer * mSystemLayer = nullptr;
     NodeId mLocalNodeId;                                                                // < Id of the current node
+#if CHIP_CONFIG_PEER_CONNECTION_INDEX
+    Transport::IndexedPeerConnections<CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE> mPeerConnections; // < Active connections to other peers
+#else
     Transport::PeerConnections<CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE> mPeerConnections; // < Active connections to other peers
+#endif
     State mState;                                                                       // < Initialization state of the object
 
     SecureSessionMgrDelegate * mCB                                     = nullptr;
@@ -98,7 +98,9 @@ CHIP_ERROR UDP::SendMessage(const Transport::PeerAddress & address, System::Pack
     addrInfo.DestPort    = address.GetPort();
     addrInfo.Interface   = address.GetInterface();
 
-    return mUDPEndPoint->SendMsg(&addrInfo, std::move(msgBuf));
+    // Coalesce the messages sent while handling one event into a single system call where the platform supports it. Such a
+    // send can fail after this call has returned; its error is then returned by a later call.
+    return mUDPEndPoint->SendMsg(&addrInfo, std::move(msgBuf), Inet::UDPEndPoint::kSendFlag_Deferred);
 }
 
 void UDP::OnUdpReceive(Inet::IPEndPointBasis * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo)
@@ -169,6 +169,173 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+void CheckMessageBurstTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // More messages than a single send or receive batch holds, all sent while handling one event.
+    constexpr int kBurstCount = 2 * INET_CONFIG_UDP_IO_BATCH_SIZE + 3;
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite);
+    TransportMgrBase gTransportMgrBase;
+    gTransportMgrBase.SetSecureSessionMgr(&gMockTransportMgrDelegate);
+    gTransportMgrBase.Init(&udp);
+
+    ReceiveHandlerCallCount = 0;
+
+    for (int i = 0; i < kBurstCount; i++)
+    {
+        chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+        PacketHeader header;
+        header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+        err = header.EncodeBeforeData(buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = udp.SendMessage(Transport::PeerAddress::UDP(addr), std::move(buffer));
+        if (err == System::MapErrorPOSIX(EADDRNOTAVAIL))
+        {
+            // TODO(#2698): the underlying system does not support IPV6. This early return
+            // should be removed and error should be made fatal.
+            printf("%s:%u: System does NOT support IPV6.\n", __FILE__, __LINE__);
+            return;
+        }
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return ReceiveHandlerCallCount == kBurstCount; });
+
+    NL_TEST_ASSERT(inSuite, ReceiveHandlerCallCount == kBurstCount);
+}
+
+void CheckMessageBurstTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckMessageBurstTest(inSuite, inContext, addr);
+}
+
+void CheckMessageBurstTest6(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckMessageBurstTest(inSuite, inContext, addr);
+}
+
+#if INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+void CheckDeferredSendErrorTest4(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Sending to port 0 fails, but only once the deferred message is flushed.
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    constexpr uint16_t kInvalidPort = 0;
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite);
+    TransportMgrBase gTransportMgrBase;
+    gTransportMgrBase.SetSecureSessionMgr(&gMockTransportMgrDelegate);
+    gTransportMgrBase.Init(&udp);
+
+    chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = udp.SendMessage(Transport::PeerAddress::UDP(addr, kInvalidPort), std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(10 /* ms */, []() { return false; });
+
+    // The failure is returned by the next send, which is not queued, and only once.
+    buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = udp.SendMessage(Transport::PeerAddress::UDP(addr, kInvalidPort), std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == System::MapErrorPOSIX(EINVAL));
+
+    buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    err = udp.SendMessage(Transport::PeerAddress::UDP(addr, kInvalidPort), std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+#endif // INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+
+void CheckChainedMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // The packet header and the payload are in separate buffers, which are sent as one datagram without being copied.
+    chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::New(0);
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    chip::System::PacketBufferHandle payload = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !payload.IsNull());
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(addr.Type()));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite);
+    TransportMgrBase gTransportMgrBase;
+    gTransportMgrBase.SetSecureSessionMgr(&gMockTransportMgrDelegate);
+    gTransportMgrBase.Init(&udp);
+
+    ReceiveHandlerCallCount = 0;
+
+    PacketHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+    err = header.EncodeBeforeData(buffer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    buffer->AddToEnd(std::move(payload));
+    NL_TEST_ASSERT(inSuite, buffer->HasChainedBuffer());
+
+    err = udp.SendMessage(Transport::PeerAddress::UDP(addr), std::move(buffer));
+    if (err == System::MapErrorPOSIX(EADDRNOTAVAIL))
+    {
+        // TODO(#2698): the underlying system does not support IPV6. This early return
+        // should be removed and error should be made fatal.
+        printf("%s:%u: System does NOT support IPV6.\n", __FILE__, __LINE__);
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return ReceiveHandlerCallCount != 0; });
+
+    NL_TEST_ASSERT(inSuite, ReceiveHandlerCallCount == 1);
+}
+
+void CheckChainedMessageTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckChainedMessageTest(inSuite, inContext, addr);
+}
+
+void CheckChainedMessageTest6(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckChainedMessageTest(inSuite, inContext, addr);
+}
+
 // Test Suite
 
 /**
@@ -178,12 +345,19 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
 static const nlTest sTests[] =
 {
 #if INET_CONFIG_ENABLE_IPV4
-    NL_TEST_DEF("Simple Init Test IPV4",   CheckSimpleInitTest4),
-    NL_TEST_DEF("Message Self Test IPV4",  CheckMessageTest4),
+    NL_TEST_DEF("Simple Init Test IPV4",     CheckSimpleInitTest4),
+    NL_TEST_DEF("Message Self Test IPV4",    CheckMessageTest4),
+    NL_TEST_DEF("Message Burst Test IPV4",   CheckMessageBurstTest4),
+    NL_TEST_DEF("Chained Message Test IPV4", CheckChainedMessageTest4),
+#endif
+#if INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_UDP_IO_BATCH_SIZE > 1
+    NL_TEST_DEF("Deferred Send Error Test IPV4", CheckDeferredSendErrorTest4),
 #endif
 
-    NL_TEST_DEF("Simple Init Test IPV6",   CheckSimpleInitTest6),
-    NL_TEST_DEF("Message Self Test IPV6",  CheckMessageTest6),
+    NL_TEST_DEF("Simple Init Test IPV6",     CheckSimpleInitTest6),
+    NL_TEST_DEF("Message Self Test IPV6",    CheckMessageTest6),
+    NL_TEST_DEF("Message Burst Test IPV6",   CheckMessageBurstTest6),
+    NL_TEST_DEF("Chained Message Test IPV6", CheckChainedMessageTest6),
 
     NL_TEST_SENTINEL()
 };
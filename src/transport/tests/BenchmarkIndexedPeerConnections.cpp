@@ -0,0 +1,159 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks of the lookup cost of the
+ *      IndexedPeerConnections class against the linear PeerConnections pool.
+ *      They are built with chip_build_benchmarks and are not part of the unit tests.
+ */
+
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+#include <transport/IndexedPeerConnections.h>
+#include <transport/PeerConnections.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+PeerAddress AddressFromIndex(uint32_t index)
+{
+    Inet::IPAddress addr;
+
+    addr.Addr[0] = 0xfd000000;
+    addr.Addr[1] = 0;
+    addr.Addr[2] = 0;
+    addr.Addr[3] = index;
+
+    return PeerAddress::UDP(addr, static_cast<uint16_t>(5540 + (index % 16)));
+}
+
+constexpr size_t kLookupIterations = 10000;
+
+template <typename Connections>
+uint64_t TimeLookups(nlTestSuite * inSuite, Connections & connections, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        PeerConnectionState * state = nullptr;
+        uint16_t keyId              = static_cast<uint16_t>(i);
+        NL_TEST_ASSERT(inSuite,
+                       connections.CreateNewPeerConnectionState(Optional<NodeId>::Value(1000 + i), keyId, keyId, &state) ==
+                           CHIP_NO_ERROR);
+        connections.UpdatePeerAddress(state, AddressFromIndex(static_cast<uint32_t>(i)));
+    }
+
+    // Walk keys with a stride co-prime with the pool size, so lookups do not all hit the start of the pool.
+    size_t found   = 0;
+    uint64_t start = System::Clock::GetMonotonicMicroseconds();
+    for (size_t i = 0; i < kLookupIterations; i++)
+    {
+        size_t index   = (i * 7919) % count;
+        uint16_t keyId = static_cast<uint16_t>(index);
+
+        found += (connections.FindPeerConnectionState(keyId, nullptr) != nullptr);
+        found += (connections.FindPeerConnectionState(Optional<NodeId>::Value(1000 + index), keyId, nullptr) != nullptr);
+        found += (connections.FindPeerConnectionState(AddressFromIndex(static_cast<uint32_t>(index)), nullptr) != nullptr);
+    }
+    uint64_t elapsed = System::Clock::GetMonotonicMicroseconds() - start;
+
+    NL_TEST_ASSERT(inSuite, found == 3 * kLookupIterations);
+    return elapsed;
+}
+
+template <size_t kCount>
+void BenchmarkPoolSize(nlTestSuite * inSuite)
+{
+    auto * linear  = chip::Platform::New<PeerConnections<kCount, Time::Source::kTest>>();
+    auto * indexed = chip::Platform::New<IndexedPeerConnections<kCount, Time::Source::kTest>>();
+
+    if (linear != nullptr && indexed != nullptr)
+    {
+        uint64_t linearUs  = TimeLookups(inSuite, *linear, kCount);
+        uint64_t indexedUs = TimeLookups(inSuite, *indexed, kCount);
+
+        printf("%u sessions, %u x 3 lookups: linear %" PRIu64 " us, indexed %" PRIu64 " us\n", static_cast<unsigned>(kCount),
+               static_cast<unsigned>(kLookupIterations), linearUs, indexedUs);
+    }
+    else
+    {
+        printf("Not enough memory to benchmark %u sessions, skipping\n", static_cast<unsigned>(kCount));
+    }
+
+    chip::Platform::Delete(linear);
+    chip::Platform::Delete(indexed);
+}
+
+/**
+ *  Measure the cost of looking sessions up by key, by node and by address, for growing numbers of sessions.
+ */
+void BenchmarkLookup(nlTestSuite * inSuite, void * inContext)
+{
+    BenchmarkPoolSize<16>(inSuite);
+    BenchmarkPoolSize<256>(inSuite);
+    BenchmarkPoolSize<4096>(inSuite);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Benchmark PeerConnections lookup", BenchmarkLookup),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int Initialize(void * aContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Finalize(void * aContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Benchmark-CHIP-IndexedPeerConnections",
+    &sTests[0],
+    Initialize,
+    Finalize
+};
+// clang-format on
+
+} // namespace
+
+int BenchmarkIndexedPeerConnections()
+{
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(BenchmarkIndexedPeerConnections)
@@ -0,0 +1,199 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the credentials cached by the AdminPairingTable.
+ *
+ */
+#include <credentials/CHIPCert.h>
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+#include <transport/AdminPairingTable.h>
+
+#include <nlunit-test.h>
+
+#include "credentials/tests/CHIPCert_test_vectors.h"
+
+namespace {
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace chip::Transport;
+using namespace TestCerts;
+
+class TestStorage : public PersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override { return CHIP_ERROR_KEY_NOT_FOUND; }
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override { return CHIP_NO_ERROR; }
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override { return CHIP_NO_ERROR; }
+};
+
+AdminPairingInfo * InitAdmin(nlTestSuite * inSuite, AdminPairingTable & adminTable, TestStorage & storage)
+{
+    Crypto::P256Keypair operationalKey;
+
+    NL_TEST_ASSERT(inSuite, adminTable.Init(&storage) == CHIP_NO_ERROR);
+    AdminPairingInfo * admin = adminTable.AssignAdminId(0);
+    NL_TEST_ASSERT(inSuite, admin != nullptr);
+
+    NL_TEST_ASSERT(inSuite, operationalKey.Initialize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->SetOperationalKey(operationalKey) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->SetRootCert(ByteSpan(sTestCert_Root01_Chip, sTestCert_Root01_Chip_Len)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->SetICACert(ByteSpan(sTestCert_ICA01_Chip, sTestCert_ICA01_Chip_Len)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->SetNOCCert(ByteSpan(sTestCert_Node01_01_Chip, sTestCert_Node01_01_Chip_Len)) == CHIP_NO_ERROR);
+
+    return admin;
+}
+
+uint8_t TrustedCertCount(AdminCredentials * credentials)
+{
+    const ChipCertificateSet * certSet = credentials->GetOperationalCredentialSet()->FindCertSet(credentials->GetRootKeyId());
+    return (certSet != nullptr) ? certSet->GetCertCount() : 0;
+}
+
+void TestCachedCredentials(nlTestSuite * inSuite, void * inContext)
+{
+    AdminPairingTable adminTable;
+    TestStorage storage;
+    AdminPairingInfo * admin = InitAdmin(inSuite, adminTable, storage);
+
+    AdminCredentials * credentials = nullptr;
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(credentials) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, credentials != nullptr);
+
+    OperationalCredentialSet * opCredSet = credentials->GetOperationalCredentialSet();
+    NL_TEST_ASSERT(inSuite, opCredSet->IsTrustedRootIn(credentials->GetRootKeyId()));
+    NL_TEST_ASSERT(inSuite, opCredSet->GetDevOpCredLen(credentials->GetRootKeyId()) == sTestCert_Node01_01_Chip_Len);
+
+    // The ICA certificate was checked against the root, and is trusted along with it.
+    const ChipCertificateSet * certSet = opCredSet->FindCertSet(credentials->GetRootKeyId());
+    NL_TEST_ASSERT(inSuite, certSet != nullptr);
+    NL_TEST_ASSERT(inSuite, certSet->GetCertCount() == 2);
+    for (uint8_t i = 0; i < certSet->GetCertCount(); i++)
+    {
+        NL_TEST_ASSERT(inSuite, certSet->GetCertSet()[i].mCertFlags.Has(CertFlags::kIsTrustAnchor));
+    }
+
+    // Later handshakes share the credentials.
+    AdminCredentials * sharedCredentials = nullptr;
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(sharedCredentials) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sharedCredentials == credentials);
+    NL_TEST_ASSERT(inSuite, credentials->GetReferenceCount() == 3);
+
+    sharedCredentials->Release();
+    credentials->Release();
+}
+
+void TestInvalidation(nlTestSuite * inSuite, void * inContext)
+{
+    AdminPairingTable adminTable;
+    TestStorage storage;
+    AdminPairingInfo * admin = InitAdmin(inSuite, adminTable, storage);
+
+    AdminCredentials * oldCredentials = nullptr;
+    AdminCredentials * newCredentials = nullptr;
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(oldCredentials) == CHIP_NO_ERROR);
+
+    // A new NOC gets new credentials, while the old ones remain usable by whoever holds them.
+    NL_TEST_ASSERT(inSuite, admin->SetNOCCert(ByteSpan(sTestCert_Node01_02_Chip, sTestCert_Node01_02_Chip_Len)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, oldCredentials->GetReferenceCount() == 1);
+    NL_TEST_ASSERT(inSuite,
+                   oldCredentials->GetOperationalCredentialSet()->GetDevOpCredLen(oldCredentials->GetRootKeyId()) ==
+                       sTestCert_Node01_01_Chip_Len);
+
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(newCredentials) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, newCredentials != oldCredentials);
+    NL_TEST_ASSERT(inSuite,
+                   newCredentials->GetOperationalCredentialSet()->GetDevOpCredLen(newCredentials->GetRootKeyId()) ==
+                       sTestCert_Node01_02_Chip_Len);
+    oldCredentials->Release();
+    oldCredentials = newCredentials;
+
+    // So does a new root, which the ICA certificate no longer chains to.
+    NL_TEST_ASSERT(inSuite, admin->SetRootCert(ByteSpan(sTestCert_Root02_Chip, sTestCert_Root02_Chip_Len)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(newCredentials) == CHIP_ERROR_CA_CERT_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, admin->SetRootCert(ByteSpan(sTestCert_Root01_Chip, sTestCert_Root01_Chip_Len)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(newCredentials) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, newCredentials != oldCredentials);
+    oldCredentials->Release();
+    oldCredentials = newCredentials;
+
+    // So does an ICA certificate added to a NOC that chains to the root directly.
+    NL_TEST_ASSERT(inSuite, admin->SetICACert(ByteSpan()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(newCredentials) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, TrustedCertCount(newCredentials) == 1);
+    oldCredentials->Release();
+    oldCredentials = newCredentials;
+
+    NL_TEST_ASSERT(inSuite, admin->SetICACert(ByteSpan(sTestCert_ICA01_Chip, sTestCert_ICA01_Chip_Len)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, oldCredentials->GetReferenceCount() == 1);
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(newCredentials) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, newCredentials != oldCredentials);
+    NL_TEST_ASSERT(inSuite, TrustedCertCount(newCredentials) == 2);
+    oldCredentials->Release();
+    oldCredentials = newCredentials;
+
+    // Deleting the admin drops its credentials.
+    NL_TEST_ASSERT(inSuite, adminTable.Delete(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, adminTable.FindAdminWithId(0) == nullptr);
+    NL_TEST_ASSERT(inSuite, oldCredentials->GetReferenceCount() == 1);
+    NL_TEST_ASSERT(inSuite, admin->GetCachedCredentials(newCredentials) == CHIP_ERROR_INCORRECT_STATE);
+    oldCredentials->Release();
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("CachedCredentials", TestCachedCredentials),
+    NL_TEST_DEF("Invalidation", TestInvalidation),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+int TestAdminPairingTable(void)
+{
+    nlTestSuite theSuite = { "Transport-AdminPairingTable", &sTests[0], TestSetup, TestTeardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAdminPairingTable)
@@ -0,0 +1,216 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a process to effect a functional test for
+ *      the IndexedPeerConnections class within the transport layer.
+ *
+ */
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/UnitTestRegistration.h>
+#include <transport/IndexedPeerConnections.h>
+#include <transport/PeerConnections.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+PeerAddress AddressFromString(const char * str)
+{
+    Inet::IPAddress addr;
+
+    VerifyOrDie(Inet::IPAddress::FromString(str, addr));
+
+    return PeerAddress::UDP(addr);
+}
+
+const PeerAddress kPeer1Addr = AddressFromString("10.1.2.3");
+const PeerAddress kPeer2Addr = AddressFromString("10.0.0.32");
+const PeerAddress kPeer3Addr = AddressFromString("100.200.0.1");
+
+const NodeId kPeer1NodeId = 123;
+const NodeId kPeer2NodeId = 6;
+const NodeId kPeer3NodeId = 81;
+
+void TestFindByAddress(nlTestSuite * inSuite, void * inContext)
+{
+    PeerConnectionState * statePtr;
+    IndexedPeerConnections<3, Time::Source::kTest> connections;
+
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer1Addr, nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer1Addr, nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer2Addr, nullptr) == CHIP_NO_ERROR);
+
+    // Pool is full
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer3Addr, nullptr) != CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, statePtr = connections.FindPeerConnectionState(kPeer1Addr, nullptr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer1Addr);
+
+    NL_TEST_ASSERT(inSuite, statePtr = connections.FindPeerConnectionState(kPeer1Addr, statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer1Addr);
+
+    NL_TEST_ASSERT(inSuite, (statePtr = connections.FindPeerConnectionState(kPeer1Addr, statePtr)) == nullptr);
+
+    NL_TEST_ASSERT(inSuite, statePtr = connections.FindPeerConnectionState(kPeer2Addr, nullptr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer2Addr);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3Addr, nullptr));
+
+    // Address updates move the state in the index
+    connections.UpdatePeerAddress(statePtr, kPeer3Addr);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer2Addr, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer3Addr, nullptr) == statePtr);
+}
+
+void TestFindByNodeId(nlTestSuite * inSuite, void * inContext)
+{
+    PeerConnectionState * state1;
+    PeerConnectionState * state2;
+    PeerConnectionState * state3;
+    PeerConnectionState * statePtr;
+    IndexedPeerConnections<3, Time::Source::kTest> connections;
+
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer1Addr, &state1) == CHIP_NO_ERROR);
+    connections.UpdatePeerNodeId(state1, kPeer1NodeId);
+
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer2Addr, &state2) == CHIP_NO_ERROR);
+    connections.UpdatePeerNodeId(state2, kPeer2NodeId);
+
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer2Addr, &state3) == CHIP_NO_ERROR);
+    connections.UpdatePeerNodeId(state3, kPeer1NodeId);
+
+    // Results come back in pool order, just like PeerConnections
+    NL_TEST_ASSERT(inSuite, (statePtr = connections.FindPeerConnectionState(kPeer1NodeId, nullptr)) == state1);
+    NL_TEST_ASSERT(inSuite, (statePtr = connections.FindPeerConnectionState(kPeer1NodeId, statePtr)) == state3);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1NodeId, statePtr) == nullptr);
+
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer2NodeId, nullptr) == state2);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3NodeId, nullptr));
+
+    // A begin state that does not carry the key still continues from its pool position
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1NodeId, state2) == state3);
+}
+
+void TestFindByKeyId(nlTestSuite * inSuite, void * inContext)
+{
+    PeerConnectionState * statePtr;
+    IndexedPeerConnections<2, Time::Source::kTest> connections;
+
+    // No Node ID, peer key 1, local key 2
+    NL_TEST_ASSERT(inSuite,
+                   connections.CreateNewPeerConnectionState(Optional<NodeId>::Missing(), 1, 2, &statePtr) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(Optional<NodeId>::Missing(), 1, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Missing(), 2, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(static_cast<uint16_t>(2), nullptr) == statePtr);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(Optional<NodeId>::Missing(), 2, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Missing(), 1, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(Optional<NodeId>::Value(kPeer1NodeId), 1, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Value(kPeer1NodeId), 2, nullptr));
+
+    // Some Node ID, peer key 3, local key 4
+    NL_TEST_ASSERT(inSuite,
+                   connections.CreateNewPeerConnectionState(Optional<NodeId>::Value(kPeer1NodeId), 3, 4, &statePtr) ==
+                       CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(Optional<NodeId>::Value(kPeer1NodeId), 3, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Value(kPeer1NodeId), 4, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(Optional<NodeId>::Missing(), 3, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Missing(), 4, nullptr));
+
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(Optional<NodeId>::Value(kPeer1NodeId), 4, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Value(kPeer1NodeId), 3, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(Optional<NodeId>::Value(kPeer2NodeId), 3, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Value(kPeer2NodeId), 4, nullptr));
+
+    // Wildcard key id
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(Optional<NodeId>::Value(kPeer1NodeId), kAnyKeyId, nullptr));
+}
+
+void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
+{
+    int callCount = 0;
+    PeerConnectionState * statePtr;
+    IndexedPeerConnections<2, Time::Source::kTest> connections;
+    auto onExpired = [&callCount](const PeerConnectionState & state) { callCount++; };
+
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(100);
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer1Addr, &statePtr) == CHIP_NO_ERROR);
+    connections.UpdatePeerNodeId(statePtr, kPeer1NodeId);
+
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(200);
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer2Addr, &statePtr) == CHIP_NO_ERROR);
+    connections.UpdatePeerNodeId(statePtr, kPeer2NodeId);
+
+    // at time 300, this expires peer 1
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(300);
+    connections.ExpireInactiveConnections(150, onExpired);
+    NL_TEST_ASSERT(inSuite, callCount == 1);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer1NodeId, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer1Addr, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer2NodeId, nullptr));
+
+    // The freed slot is reused and indexed again
+    NL_TEST_ASSERT(inSuite, connections.CreateNewPeerConnectionState(kPeer3Addr, &statePtr) == CHIP_NO_ERROR);
+    connections.UpdatePeerNodeId(statePtr, kPeer3NodeId);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer3NodeId, nullptr) == statePtr);
+
+    connections.MarkConnectionExpired(statePtr, onExpired);
+    NL_TEST_ASSERT(inSuite, callCount == 2);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3NodeId, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3Addr, nullptr));
+}
+
+int Initialize(void * aContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Finalize(void * aContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("FindByPeerAddress", TestFindByAddress),
+    NL_TEST_DEF("FindByNodeId", TestFindByNodeId),
+    NL_TEST_DEF("FindByKeyId", TestFindByKeyId),
+    NL_TEST_DEF("ExpireConnections", TestExpireConnections),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestIndexedPeerConnectionsFn(void)
+{
+    nlTestSuite theSuite = { "Transport-IndexedPeerConnections", &sTests[0], Initialize, Finalize };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestIndexedPeerConnectionsFn)
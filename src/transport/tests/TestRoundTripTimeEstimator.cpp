@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the RoundTripTimeEstimator class.
+ *
+ */
+#include <support/UnitTestRegistration.h>
+#include <transport/PeerConnectionState.h>
+#include <transport/RoundTripTimeEstimator.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+void TestFirstSample(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransmitTimeoutMs() == 0);
+
+    // SRTT = R, RTTVAR = R/2, RTO = SRTT + 4 * RTTVAR
+    estimator.AddSample(100);
+    NL_TEST_ASSERT(inSuite, estimator.HasSample());
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRttMs() == 100);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariationMs() == 50);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransmitTimeoutMs() == 300);
+}
+
+void TestSmoothing(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+
+    estimator.AddSample(100);
+
+    // SRTT = 7/8 * 100 + 1/8 * 180 = 110, RTTVAR = 3/4 * 50 + 1/4 * 80 = 57.5
+    estimator.AddSample(180);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRttMs() == 110);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariationMs() == 57);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransmitTimeoutMs() == 110 + 230);
+
+    // A steady round trip time converges, and the variation decays.
+    for (int i = 0; i < 100; i++)
+    {
+        estimator.AddSample(40);
+    }
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRttMs() == 40);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariationMs() == 0);
+    // What is left of 4 * RTTVAR is below the scaling resolution of a millisecond.
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransmitTimeoutMs() >= 40 + RoundTripTimeEstimator::kClockGranularityMs);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransmitTimeoutMs() < 40 + 4);
+    NL_TEST_ASSERT(inSuite, estimator.GetSampleCount() == 102);
+}
+
+void TestSmallSamples(nlTestSuite * inSuite, void * inContext)
+{
+    RoundTripTimeEstimator estimator;
+
+    // Samples below the clock granularity still give a usable timeout.
+    estimator.AddSample(0);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransmitTimeoutMs() == RoundTripTimeEstimator::kClockGranularityMs);
+
+    // Fractions of a millisecond accumulate rather than being truncated away.
+    for (int i = 0; i < 8; i++)
+    {
+        estimator.AddSample(3);
+    }
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRttMs() >= 1);
+}
+
+void TestReset(nlTestSuite * inSuite, void * inContext)
+{
+    PeerConnectionState state;
+
+    state.GetRoundTripTimeEstimator().AddSample(20);
+    NL_TEST_ASSERT(inSuite, state.GetRoundTripTimeEstimator().HasSample());
+
+    // A new session starts without any knowledge of the peer.
+    state.Reset();
+    NL_TEST_ASSERT(inSuite, !state.GetRoundTripTimeEstimator().HasSample());
+    NL_TEST_ASSERT(inSuite, state.GetRoundTripTimeEstimator().GetSmoothedRttMs() == 0);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("FirstSample", TestFirstSample),
+    NL_TEST_DEF("Smoothing", TestSmoothing),
+    NL_TEST_DEF("SmallSamples", TestSmallSamples),
+    NL_TEST_DEF("Reset", TestReset),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestRoundTripTimeEstimator(void)
+{
+    nlTestSuite theSuite = { "Transport-RoundTripTimeEstimator", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRoundTripTimeEstimator)
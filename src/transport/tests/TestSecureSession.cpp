@@ -28,8 +28,10 @@
 #include <transport/SecureSession.h>
 
 #include <stdarg.h>
+#include <support/CHIPMem.h>
 #include <support/CodeUtils.h>
 #include <support/UnitTestRegistration.h>
+#include <system/SystemPacketBuffer.h>
 
 using namespace chip;
 using namespace Crypto;
@@ -151,6 +153,86 @@ void SecureChannelDecryptTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
 }
 
+void SecureChannelEncryptChainTest(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSession channel;
+    SecureSession channel2;
+    uint8_t plain_text[100];
+    uint8_t encrypted[sizeof(plain_text)];
+    uint8_t output[sizeof(plain_text)];
+    PacketHeader packetHeader;
+    MessageAuthenticationCode mac;
+
+    for (size_t i = 0; i < sizeof(plain_text); i++)
+    {
+        plain_text[i] = static_cast<uint8_t>(i);
+    }
+
+    const char * salt = "Test Salt";
+
+    P256Keypair keypair;
+    NL_TEST_ASSERT(inSuite, keypair.Initialize() == CHIP_NO_ERROR);
+
+    P256Keypair keypair2;
+    NL_TEST_ASSERT(inSuite, keypair2.Initialize() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite,
+                   channel.Init(keypair, keypair2.Pubkey(), ByteSpan((const uint8_t *) salt, sizeof(salt)),
+                                SecureSession::SessionInfoType::kSessionEstablishment,
+                                SecureSession::SessionRole::kInitiator) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   channel2.Init(keypair2, keypair.Pubkey(), ByteSpan((const uint8_t *) salt, sizeof(salt)),
+                                 SecureSession::SessionInfoType::kSessionEstablishment,
+                                 SecureSession::SessionRole::kResponder) == CHIP_NO_ERROR);
+
+    // Split the message over buffers whose lengths are not multiples of the cipher's block size.
+    const uint16_t splits[] = { 7, 40, sizeof(plain_text) };
+    System::PacketBufferHandle msg;
+    uint16_t start = 0;
+    for (uint16_t end : splits)
+    {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::NewWithData(&plain_text[start], end - start);
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        if (msg.IsNull())
+        {
+            msg = std::move(buffer);
+        }
+        else
+        {
+            msg->AddToEnd(std::move(buffer));
+        }
+        start = end;
+    }
+    NL_TEST_ASSERT(inSuite, msg->HasChainedBuffer());
+
+    NL_TEST_ASSERT(inSuite, channel.Encrypt(msg, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, msg->TotalLength() == sizeof(plain_text));
+    NL_TEST_ASSERT(inSuite, msg->HasChainedBuffer());
+
+    start = 0;
+    for (System::PacketBufferHandle buffer = msg.Retain(); !buffer.IsNull(); buffer.Advance())
+    {
+        memcpy(&encrypted[start], buffer->Start(), buffer->DataLength());
+        start = static_cast<uint16_t>(start + buffer->DataLength());
+    }
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, encrypted, sizeof(plain_text)) != 0);
+
+    // The chain decrypts like a message encrypted in one go.
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(encrypted, sizeof(encrypted), output, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
+}
+
+int Initialize(void * aContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Finalize(void * aContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
 // Test Suite
 
 /**
@@ -159,9 +241,10 @@ void SecureChannelDecryptTest(nlTestSuite * inSuite, void * inContext)
 // clang-format off
 static const nlTest sTests[] =
 {
-    NL_TEST_DEF("Init",    SecureChannelInitTest),
-    NL_TEST_DEF("Encrypt", SecureChannelEncryptTest),
-    NL_TEST_DEF("Decrypt", SecureChannelDecryptTest),
+    NL_TEST_DEF("Init",          SecureChannelInitTest),
+    NL_TEST_DEF("Encrypt",       SecureChannelEncryptTest),
+    NL_TEST_DEF("Decrypt",       SecureChannelDecryptTest),
+    NL_TEST_DEF("Encrypt chain", SecureChannelEncryptChainTest),
 
     NL_TEST_SENTINEL()
 };
@@ -172,8 +255,8 @@ static nlTestSuite sSuite =
 {
     "Test-CHIP-SecureChannel",
     &sTests[0],
-    nullptr,
-    nullptr
+    Initialize,
+    Finalize
 };
 // clang-format on
 
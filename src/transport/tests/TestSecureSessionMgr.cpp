@@ -472,6 +472,55 @@ void SendBadEncryptedPacketTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 2);
 }
 
+void UpdatePeerAddressTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    IPAddress newAddr;
+    IPAddress::FromString("127.0.0.2", newAddr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    TransportMgr<LoopbackTransport> transportMgr;
+    SecureSessionMgr secureSessionMgr;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    TestSessMgrCallback sessionCallback;
+
+    err = transportMgr.Init("LOOPBACK");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    Transport::AdminPairingTable admins;
+    err = secureSessionMgr.Init(kSourceNodeId, ctx.GetInetLayer().SystemLayer(), &transportMgr, &admins, &gMessageCounterManager);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    secureSessionMgr.SetDelegate(&sessionCallback);
+
+    Transport::AdminPairingInfo * admin = admins.AssignAdminId(0, kSourceNodeId);
+    NL_TEST_ASSERT(inSuite, admin != nullptr);
+
+    Optional<Transport::PeerAddress> peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+    SecurePairingUsingTestSecret pairing(1, 2);
+    err = secureSessionMgr.NewPairing(peer, kDestinationNodeId, &pairing, SecureSession::SessionRole::kInitiator, 0);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionCallback.NewConnectionHandlerCallCount == 1);
+
+    // The session is still found after its peer moved, and it now sends to the new address.
+    SecureSessionHandle session          = sessionCallback.mRemoteToLocalSession;
+    const Transport::PeerAddress newPeer = Transport::PeerAddress::UDP(newAddr, CHIP_PORT + 1);
+    err                                  = secureSessionMgr.UpdatePeerAddress(session, newPeer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    Transport::PeerConnectionState * state = secureSessionMgr.GetPeerConnectionState(session);
+    NL_TEST_ASSERT(inSuite, state != nullptr);
+    NL_TEST_ASSERT(inSuite, state != nullptr && state->GetPeerAddress() == newPeer);
+
+    err = secureSessionMgr.UpdatePeerAddress(SecureSessionHandle(kDestinationNodeId, 42, 0), newPeer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NOT_CONNECTED);
+}
+
 // Test Suite
 
 /**
@@ -484,6 +533,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Message Self Test",              CheckMessageTest),
     NL_TEST_DEF("Send Encrypted Packet Test",     SendEncryptedPacketTest),
     NL_TEST_DEF("Send Bad Encrypted Packet Test", SendBadEncryptedPacketTest),
+    NL_TEST_DEF("Update Peer Address Test",       UpdatePeerAddressTest),
 
     NL_TEST_SENTINEL()
 };